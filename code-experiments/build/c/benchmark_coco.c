@@ -0,0 +1,330 @@
+/**
+ * Micro-benchmark of the COCO core.
+ *
+ * For each problem (function and dimension, first instance) of the given
+ * suites, the construction time of the problem and the evaluation time
+ * through the full transformation chain (with and without observer, point by
+ * point and in batches) are measured. In addition, the evaluation time of
+ * every level of the transformation chain is measured down to the raw
+ * function, so that the cost of each transformation is the difference of two
+ * consecutive levels.
+ *
+ * The results are written as JSON, so that the performance of the C core can
+ * be compared across releases. All times are CPU times as measured by clock().
+ *
+ * The file includes coco.c directly (instead of linking against the coco
+ * library) to get access to the transformation chain of the problems.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "coco.c"
+
+/**
+ * The number of random points that are evaluated in a cycle.
+ */
+#define BENCHMARK_NUMBER_OF_POINTS 100
+
+/**
+ * The random seed used to sample the points.
+ */
+static const uint32_t BENCHMARK_RANDOM_SEED = 0xdeadbeef;
+
+/**
+ * Settings of the benchmark that can be changed on the command line.
+ */
+typedef struct {
+  const char *suite_names;     /**< @brief comma-separated list of suite names */
+  const char *dimensions;      /**< @brief value of the suite option "dimensions" */
+  const char *functions;       /**< @brief value of the suite option "function_indices" */
+  const char *result_folder;   /**< @brief result folder of the observers */
+  const char *output_file;     /**< @brief file name of the JSON output (stdout if NULL) */
+  double min_time;             /**< @brief minimal time in seconds spent on each measurement */
+} benchmark_settings_t;
+
+static void usage(const char *program_name) {
+  fprintf(
+      stderr,
+      "COCO micro-benchmark\n"
+      "\n"
+      "Usage:\n"
+      "  %s [-s SUITES] [-d DIMENSIONS] [-f FUNCTIONS] [-t SECONDS]\n"
+      "     [-r RESULT_FOLDER] [-o OUTPUT]\n"
+      "\n",
+      program_name);
+  fprintf(
+      stderr,
+      "  -s SUITES         comma-separated list of suite names (default: bbob)\n"
+      "  -d DIMENSIONS     comma-separated list of dimensions (default: all)\n"
+      "  -f FUNCTIONS      list or range of function indices (default: all)\n");
+  fprintf(
+      stderr,
+      "  -t SECONDS        minimal time spent on each measurement (default: 0.05)\n"
+      "  -r RESULT_FOLDER  result folder of the observers (default: benchmark_coco)\n"
+      "  -o OUTPUT         name of the JSON output file (default: stdout)\n");
+}
+
+/**
+ * Returns the name of the observer to be used with the given suite.
+ */
+static const char *benchmark_observer_name(const char *suite_name) {
+  if (strcmp(suite_name, "bbob-constrained") == 0)
+    return "bbob";
+  return suite_name;
+}
+
+/**
+ * Returns the CPU time in seconds spent since start.
+ */
+static double benchmark_elapsed(const clock_t start) {
+  return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Returns the CPU time in seconds needed to evaluate a point with the given problem. The points are
+ * evaluated one by one with coco_evaluate_function() or all at once with coco_evaluate_function_batch().
+ */
+static double benchmark_evaluation_time(coco_problem_t *problem,
+                                        const double *points,
+                                        double *y,
+                                        const int use_batch,
+                                        const double min_time) {
+  const size_t dimension = coco_problem_get_dimension(problem);
+  const size_t number_of_objectives = coco_problem_get_number_of_objectives(problem);
+  size_t evaluations = 0, i;
+  double elapsed;
+  clock_t start = clock();
+
+  do {
+    if (use_batch) {
+      coco_evaluate_function_batch(problem, points, BENCHMARK_NUMBER_OF_POINTS, y);
+    } else {
+      for (i = 0; i < BENCHMARK_NUMBER_OF_POINTS; i++)
+        coco_evaluate_function(problem, points + i * dimension, y + i * number_of_objectives);
+    }
+    evaluations += BENCHMARK_NUMBER_OF_POINTS;
+  } while ((elapsed = benchmark_elapsed(start)) < min_time);
+
+  return elapsed / (double) evaluations;
+}
+
+/**
+ * Returns the CPU time in seconds needed to construct (and free) the given problem or a negative value if
+ * the problem cannot be constructed outside of its suite.
+ */
+static double benchmark_construction_time(const char *suite_name,
+                                          const size_t function,
+                                          const size_t dimension,
+                                          const size_t instance,
+                                          const double min_time) {
+  coco_problem_t *problem;
+  size_t constructions = 0;
+  double elapsed;
+  clock_t start = clock();
+
+  do {
+    problem = coco_get_suite_problem(suite_name, function, dimension, instance);
+    if (problem == NULL)
+      return -1;
+    coco_problem_free(problem);
+    constructions++;
+  } while ((elapsed = benchmark_elapsed(start)) < min_time);
+
+  return elapsed / (double) constructions;
+}
+
+/**
+ * Returns the inner problem if the problem is a transformed problem and NULL otherwise.
+ */
+static coco_problem_t *benchmark_inner_problem(coco_problem_t *problem) {
+  if (problem->problem_free_function != coco_problem_transformed_free)
+    return NULL;
+  return coco_problem_transformed_get_inner_problem(problem);
+}
+
+/**
+ * Writes the name of a level of the transformation chain, i.e. the name of the transformation or the
+ * problem name of the innermost level.
+ */
+static void benchmark_write_level_name(FILE *output, const coco_problem_t *problem) {
+  if (benchmark_inner_problem((coco_problem_t *) problem) != NULL)
+    fprintf(output, "\"%s\"", ((coco_problem_transformed_data_t *) problem->data)->name);
+  else
+    fprintf(output, "\"%s\"", problem->problem_name);
+}
+
+static void benchmark_write_time(FILE *output, const char *key, const double seconds, const int last) {
+  if (seconds < 0)
+    fprintf(output, "\"%s\": null%s", key, last ? "" : ", ");
+  else
+    fprintf(output, "\"%s\": %.6g%s", key, seconds, last ? "" : ", ");
+}
+
+static void benchmark_write_evaluation(FILE *output, const char *key, const double seconds, const int last) {
+  fprintf(output, "        \"%s\": {\"ns_per_evaluation\": %.6g, \"evaluations_per_second\": %.6g}%s\n",
+      key, 1e9 * seconds, 1 / seconds, last ? "" : ",");
+}
+
+/**
+ * Benchmarks the given problem of the suite and writes the results as a JSON object.
+ */
+static void benchmark_problem(FILE *output,
+                              const benchmark_settings_t *settings,
+                              const char *suite_name,
+                              coco_problem_t *problem,
+                              coco_observer_t *observer,
+                              coco_random_state_t *random_generator) {
+  const size_t dimension = coco_problem_get_dimension(problem);
+  const size_t number_of_objectives = coco_problem_get_number_of_objectives(problem);
+  const double *lower_bounds = coco_problem_get_smallest_values_of_interest(problem);
+  const double *upper_bounds = coco_problem_get_largest_values_of_interest(problem);
+  double *points = coco_allocate_vector(BENCHMARK_NUMBER_OF_POINTS * dimension);
+  double *y = coco_allocate_vector(BENCHMARK_NUMBER_OF_POINTS * number_of_objectives);
+  double construction, full, batch, observed, level_time, raw = -1;
+  coco_problem_t *level, *observed_problem;
+  size_t i, j;
+
+  for (i = 0; i < BENCHMARK_NUMBER_OF_POINTS; i++) {
+    for (j = 0; j < dimension; j++) {
+      points[i * dimension + j] = lower_bounds[j]
+          + coco_random_uniform(random_generator) * (upper_bounds[j] - lower_bounds[j]);
+    }
+  }
+
+  construction = benchmark_construction_time(suite_name, coco_problem_get_suite_dep_function(problem),
+      dimension, coco_problem_get_suite_dep_instance(problem), settings->min_time);
+  full = benchmark_evaluation_time(problem, points, y, 0, settings->min_time);
+  batch = benchmark_evaluation_time(problem, points, y, 1, settings->min_time);
+
+  fprintf(output, "    {\"suite\": \"%s\", \"problem_id\": \"%s\", \"function\": %lu, \"dimension\": %lu, "
+      "\"instance\": %lu, \"number_of_objectives\": %lu,\n",
+      suite_name, coco_problem_get_id(problem),
+      (unsigned long) coco_problem_get_suite_dep_function(problem), (unsigned long) dimension,
+      (unsigned long) coco_problem_get_suite_dep_instance(problem), (unsigned long) number_of_objectives);
+  fprintf(output, "      ");
+  benchmark_write_time(output, "construction_seconds", construction, 0);
+  fprintf(output, "\n      \"transformation_chain\": [");
+  for (level = problem; level != NULL; level = benchmark_inner_problem(level)) {
+    level_time = benchmark_evaluation_time(level, points, y, 0, settings->min_time);
+    /* The innermost level is the raw function unless it combines several problems */
+    if (benchmark_inner_problem(level) == NULL && level->problem_free_function != coco_problem_stacked_free)
+      raw = level_time;
+    fprintf(output, "%s\n        {\"name\": ", level == problem ? "" : ",");
+    benchmark_write_level_name(output, level);
+    fprintf(output, ", \"ns_per_evaluation\": %.6g}", 1e9 * level_time);
+  }
+  fprintf(output, "\n      ],\n      \"evaluation\": {\n");
+  benchmark_write_evaluation(output, "full", full, 0);
+  benchmark_write_evaluation(output, "full_batch", batch, 0);
+  if (observer != NULL) {
+    observed_problem = coco_problem_add_observer(problem, observer);
+    observed = benchmark_evaluation_time(observed_problem, points, y, 0, settings->min_time);
+    problem = coco_problem_remove_observer(observed_problem, observer);
+    benchmark_write_evaluation(output, "observed", observed, raw < 0);
+  }
+  if (raw >= 0)
+    benchmark_write_evaluation(output, "raw", raw, 1);
+  fprintf(output, "      }\n    }");
+
+  coco_free_memory(points);
+  coco_free_memory(y);
+}
+
+/**
+ * Benchmarks all problems of the given suite (first instance only).
+ */
+static void benchmark_suite(FILE *output,
+                            const benchmark_settings_t *settings,
+                            const char *suite_name,
+                            int *first_result) {
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  char *suite_options, *observer_options;
+
+  suite_options = coco_strdupf("instance_indices: 1 %s%s %s%s",
+      settings->dimensions ? "dimensions: " : "", settings->dimensions ? settings->dimensions : "",
+      settings->functions ? "function_indices: " : "", settings->functions ? settings->functions : "");
+  observer_options = coco_strdupf("result_folder: %s", settings->result_folder);
+  suite = coco_suite(suite_name, "", suite_options);
+  observer = coco_observer(benchmark_observer_name(suite_name), observer_options);
+  random_generator = coco_random_new(BENCHMARK_RANDOM_SEED);
+
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    fprintf(output, "%s\n", *first_result ? "" : ",");
+    benchmark_problem(output, settings, suite_name, problem, observer, random_generator);
+    *first_result = 0;
+  }
+
+  coco_random_free(random_generator);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_free_memory(observer_options);
+  coco_free_memory(suite_options);
+}
+
+int main(int argc, char **argv) {
+  benchmark_settings_t settings;
+  FILE *output = stdout;
+  char **suite_names;
+  size_t number_of_suites, i;
+  int first_result = 1;
+
+  settings.suite_names = "bbob";
+  settings.dimensions = NULL;
+  settings.functions = NULL;
+  settings.result_folder = "benchmark_coco";
+  settings.output_file = NULL;
+  settings.min_time = 0.05;
+
+  for (i = 1; i < (size_t) argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+    if (argv[i][0] != '-' || strlen(argv[i]) != 2 || i + 1 >= (size_t) argc) {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+    switch (argv[i][1]) {
+    case 's': settings.suite_names = argv[++i]; break;
+    case 'd': settings.dimensions = argv[++i]; break;
+    case 'f': settings.functions = argv[++i]; break;
+    case 'r': settings.result_folder = argv[++i]; break;
+    case 'o': settings.output_file = argv[++i]; break;
+    case 't': settings.min_time = atof(argv[++i]); break;
+    default:
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  coco_set_log_level("warning");
+
+  if (settings.output_file != NULL) {
+    output = fopen(settings.output_file, "w");
+    if (output == NULL) {
+      fprintf(stderr, "Could not open %s for writing\n", settings.output_file);
+      return EXIT_FAILURE;
+    }
+  }
+
+  suite_names = coco_string_split(settings.suite_names, ',');
+  for (number_of_suites = 0; suite_names[number_of_suites] != NULL; number_of_suites++);
+
+  fprintf(output, "{\n  \"coco_version\": \"%s\",\n  \"min_time_seconds\": %g,\n  \"results\": [",
+      coco_version, settings.min_time);
+  for (i = 0; i < number_of_suites; i++) {
+    benchmark_suite(output, &settings, suite_names[i], &first_result);
+    coco_free_memory(suite_names[i]);
+  }
+  fprintf(output, "\n  ]\n}\n");
+  coco_free_memory(suite_names);
+
+  if (output != stdout)
+    fclose(output);
+  return EXIT_SUCCESS;
+}
@@ -389,6 +389,165 @@ JNIEXPORT jdoubleArray JNICALL Java_CocoJNI_cocoEvaluateConstraint
   return jy;
 }
 
+/*
+ * Class:     CocoJNI
+ * Method:    cocoEvaluateFunctionInto
+ * Signature: (J[D[D)V
+ *
+ * Evaluates the function in x and writes the result into the given y, so that no array is allocated. The
+ * elements of the arrays are accessed like in cocoEvaluateFunction (outside of a critical region, so that the
+ * garbage collector is not blocked during the evaluation).
+ */
+JNIEXPORT void JNICALL Java_CocoJNI_cocoEvaluateFunctionInto
+(JNIEnv *jenv, jclass interface_cls, jlong jproblem_pointer, jdoubleArray jx, jdoubleArray jy) {
+
+  coco_problem_t *problem = NULL;
+  double *x = NULL;
+  double *y = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoEvaluateFunctionInto\n");
+  }
+
+  problem = (coco_problem_t *) jproblem_pointer;
+
+  /* Call coco_evaluate_function */
+  x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
+  if (x == NULL)
+    return;
+  y = (*jenv)->GetDoubleArrayElements(jenv, jy, NULL);
+  if (y == NULL) {
+    (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+    return;
+  }
+  coco_evaluate_function(problem, x, y);
+
+  /* Write the result back into jy */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jy, y, 0);
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+  return;
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoEvaluateFunctionBuffer
+ * Signature: (JLjava/nio/DoubleBuffer;Ljava/nio/DoubleBuffer;)V
+ *
+ * Evaluates the function in x and writes the result into y, where x and y are direct buffers (the memory
+ * of which is used as is).
+ */
+JNIEXPORT void JNICALL Java_CocoJNI_cocoEvaluateFunctionBuffer
+(JNIEnv *jenv, jclass interface_cls, jlong jproblem_pointer, jobject jx, jobject jy) {
+
+  coco_problem_t *problem = NULL;
+  double *x = NULL;
+  double *y = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoEvaluateFunctionBuffer\n");
+  }
+
+  problem = (coco_problem_t *) jproblem_pointer;
+
+  x = (double *) (*jenv)->GetDirectBufferAddress(jenv, jx);
+  y = (double *) (*jenv)->GetDirectBufferAddress(jenv, jy);
+  if ((x == NULL) || (y == NULL)) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/IllegalArgumentException");
+    (*jenv)->ThrowNew(jenv, Exception, "cocoEvaluateFunctionBuffer requires direct buffers\n");
+    return;
+  }
+  coco_evaluate_function(problem, x, y);
+  return;
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoEvaluateFunctionBatch
+ * Signature: (J[DI[D)V
+ *
+ * Evaluates the function in number_of_points points stored row-wise in x and writes the results row-wise
+ * into y (the elements of the arrays are accessed like in cocoEvaluateFunctionInto).
+ */
+JNIEXPORT void JNICALL Java_CocoJNI_cocoEvaluateFunctionBatch
+(JNIEnv *jenv, jclass interface_cls, jlong jproblem_pointer, jdoubleArray jx, jint jnumber_of_points,
+    jdoubleArray jy) {
+
+  coco_problem_t *problem = NULL;
+  double *x = NULL;
+  double *y = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoEvaluateFunctionBatch\n");
+  }
+
+  problem = (coco_problem_t *) jproblem_pointer;
+
+  if (jnumber_of_points <= 0)
+    return;
+
+  /* Call coco_evaluate_function_batch */
+  x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
+  if (x == NULL)
+    return;
+  y = (*jenv)->GetDoubleArrayElements(jenv, jy, NULL);
+  if (y == NULL) {
+    (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+    return;
+  }
+  coco_evaluate_function_batch(problem, x, (size_t) jnumber_of_points, y);
+
+  /* Write the results back into jy */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jy, y, 0);
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+  return;
+}
+
+/*
+ * Class:     CocoJNI
+ * Method:    cocoEvaluateConstraintInto
+ * Signature: (J[D[D)V
+ *
+ * Evaluates the constraints in x and writes the result into the given y (the elements of the arrays are
+ * accessed like in cocoEvaluateFunctionInto).
+ */
+JNIEXPORT void JNICALL Java_CocoJNI_cocoEvaluateConstraintInto
+(JNIEnv *jenv, jclass interface_cls, jlong jproblem_pointer, jdoubleArray jx, jdoubleArray jy) {
+
+  coco_problem_t *problem = NULL;
+  double *x = NULL;
+  double *y = NULL;
+
+  /* This test is both to prevent warning because interface_cls was not used and to check for exceptions */
+  if (interface_cls == NULL) {
+    jclass Exception = (*jenv)->FindClass(jenv, "java/lang/Exception");
+    (*jenv)->ThrowNew(jenv, Exception, "Exception in cocoEvaluateConstraintInto\n");
+  }
+
+  problem = (coco_problem_t *) jproblem_pointer;
+
+  /* Call coco_evaluate_constraint */
+  x = (*jenv)->GetDoubleArrayElements(jenv, jx, NULL);
+  if (x == NULL)
+    return;
+  y = (*jenv)->GetDoubleArrayElements(jenv, jy, NULL);
+  if (y == NULL) {
+    (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+    return;
+  }
+  coco_evaluate_constraint(problem, x, y);
+
+  /* Write the result back into jy */
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jy, y, 0);
+  (*jenv)->ReleaseDoubleArrayElements(jenv, jx, x, JNI_ABORT);
+  return;
+}
+
 /*
  * Class:     CocoJNI
  * Method:    cocoRecommendSolution
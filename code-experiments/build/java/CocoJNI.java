@@ -1,3 +1,5 @@
+import java.nio.DoubleBuffer;
+
 /**
  * This class contains the declaration of all the CocoJNI functions. 
  */
@@ -31,6 +33,10 @@ public class CocoJNI {
 	// Functions
 	public static native double[] cocoEvaluateFunction(long problemPointer, double[] x);
 	public static native double[] cocoEvaluateConstraint(long problemPointer, double[] x);
+	public static native void cocoEvaluateFunctionInto(long problemPointer, double[] x, double[] y);
+	public static native void cocoEvaluateFunctionBuffer(long problemPointer, DoubleBuffer x, DoubleBuffer y);
+	public static native void cocoEvaluateFunctionBatch(long problemPointer, double[] x, int numberOfPoints, double[] y);
+	public static native void cocoEvaluateConstraintInto(long problemPointer, double[] x, double[] y);
 	public static native void cocoRecommendSolution(long problemPointer, double[] x);
 
 	// Getters
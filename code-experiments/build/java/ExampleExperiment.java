@@ -34,8 +34,8 @@ public class ExampleExperiment {
 	 * Interface for function evaluation.
 	 */
 	public interface Function {
-		double[] evaluate(double[] x);
-		double[] evaluateConstraint(double[] x);
+		void evaluate(double[] x, double[] y);
+		void evaluateConstraint(double[] x, double[] z);
 		void recommendSolution(double[] x);
     }
 
@@ -43,11 +43,11 @@ public class ExampleExperiment {
 	 * Evaluate the static PROBLEM.
 	 */
     public static final Function evaluateFunction = new Function() {
-    	public double[] evaluate(double[] x) {
-    		return PROBLEM.evaluateFunction(x);
+    	public void evaluate(double[] x, double[] y) {
+    		PROBLEM.evaluateFunction(x, y);
     	}
-		public double[] evaluateConstraint(double[] x) {
-			return PROBLEM.evaluateConstraint(x);
+		public void evaluateConstraint(double[] x, double[] z) {
+			PROBLEM.evaluateConstraint(x, z);
         }
 		public void recommendSolution(double[] x) {
 			PROBLEM.recommendSolution(x);
@@ -201,10 +201,10 @@ public class ExampleExperiment {
 			}
 
 		    /* Call the evaluate function to evaluate x on the current problem (this is where all the COCO logging
-		     * is performed) */
+		     * is performed); the results are written into y and z, so that nothing is allocated per evaluation */
 			if (numberOfConstraints > 0)
-				z = f.evaluateConstraint(x);
-			y = f.evaluate(x);
+				f.evaluateConstraint(x, z);
+			f.evaluate(x, y);
 		}
 
 	}
@@ -1,3 +1,6 @@
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+
 /**
  * The problem contains some basic properties of the coco_problem_t structure that can be accessed
  * through its getter functions.
@@ -65,6 +68,72 @@ public class Problem {
 		return CocoJNI.cocoEvaluateConstraint(this.pointer, x);
 	}
 
+	/**
+	 * Evaluates the function in point x and writes the result into y, which must have room for
+	 * getNumberOfObjectives() values. Unlike evaluateFunction(x), this method allocates no Java array.
+	 * @param x
+	 * @param y the array receiving the result of the function evaluation in point x
+	 */
+	public void evaluateFunction(double[] x, double[] y) {
+		checkLengths(x.length, this.dimension, y.length, this.number_of_objectives);
+		CocoJNI.cocoEvaluateFunctionInto(this.pointer, x, y);
+	}
+
+	/**
+	 * Evaluates the function in point x and writes the result into y, where x and y are direct buffers in
+	 * native byte order (e.g. ByteBuffer.allocateDirect(8 * n).order(ByteOrder.nativeOrder()).asDoubleBuffer()),
+	 * whose contents are used from index 0 on, regardless of their positions.
+	 * @param x
+	 * @param y the buffer receiving the result of the function evaluation in point x
+	 */
+	public void evaluateFunction(DoubleBuffer x, DoubleBuffer y) {
+		if (!x.isDirect() || !y.isDirect() || (x.order() != ByteOrder.nativeOrder())
+				|| (y.order() != ByteOrder.nativeOrder()))
+			throw new IllegalArgumentException("The buffers must be direct and in native byte order.");
+		checkLengths(x.capacity(), this.dimension, y.capacity(), this.number_of_objectives);
+		CocoJNI.cocoEvaluateFunctionBuffer(this.pointer, x, y);
+	}
+
+	/**
+	 * Evaluates the function in a population of points stored one after the other in x and writes the
+	 * results one after the other into y. The evaluations are logged in this order.
+	 * @param x the flattened population (its length is a multiple of getDimension())
+	 * @param y the array receiving getNumberOfObjectives() values for each point
+	 */
+	public void evaluateFunctionBatch(double[] x, double[] y) {
+		int numberOfPoints = x.length / this.dimension;
+		if (x.length != numberOfPoints * this.dimension)
+			throw new IllegalArgumentException("The length of x (" + x.length
+					+ ") is not a multiple of the dimension (" + this.dimension + ").");
+		checkLengths(x.length, x.length, y.length, numberOfPoints * this.number_of_objectives);
+		CocoJNI.cocoEvaluateFunctionBatch(this.pointer, x, numberOfPoints, y);
+	}
+
+	/**
+	 * Evaluates the constraint in point x and writes the result into z, which must have room for
+	 * getNumberOfConstraints() values. Unlike evaluateConstraint(x), this method allocates no Java array.
+	 * @param x
+	 * @param z the array receiving the result of the constraint evaluation in point x
+	 */
+	public void evaluateConstraint(double[] x, double[] z) {
+		checkLengths(x.length, this.dimension, z.length, this.number_of_constraints);
+		CocoJNI.cocoEvaluateConstraintInto(this.pointer, x, z);
+	}
+
+	/**
+	 * Throws an IllegalArgumentException if the input or the output is too short (the native code relies
+	 * on their lengths).
+	 */
+	private static void checkLengths(int inputLength, int requiredInputLength, int outputLength,
+			int requiredOutputLength) {
+		if (inputLength < requiredInputLength)
+			throw new IllegalArgumentException("The input has length " + inputLength + " instead of "
+					+ requiredInputLength + ".");
+		if (outputLength < requiredOutputLength)
+			throw new IllegalArgumentException("The output has length " + outputLength + " instead of at least "
+					+ requiredOutputLength + ".");
+	}
+
 	/**
 	 * Recommends solution x (the solution is logged, but its function values are not returned)
 	 * @param x
@@ -1,8 +1,11 @@
 # -*- mode: cython -*-
 #cython: language_level=3, boundscheck=False, c_string_type=str, c_string_encoding=ascii
 
+from concurrent.futures import ThreadPoolExecutor
+
 import numpy as np
 cimport numpy as np
+from cpython.mem cimport PyMem_Malloc, PyMem_Free
 
 from .exceptions import NoSuchProblemException, NoSuchSuiteException
 
@@ -14,16 +17,26 @@ cdef extern from 'coco.h':
         pass
 
     char *coco_problem_get_id(coco_problem_t *p)
+    coco_problem_t *coco_get_suite_problem(const char *suite_name, size_t function, size_t dimension,
+                                           size_t instance)
+    size_t coco_problem_get_number_of_objectives(const coco_problem_t *p)
+    size_t coco_problem_get_number_of_constraints(const coco_problem_t *p)
     void coco_evaluate_function(coco_problem_t *p, double *x, double *y)
+    void coco_evaluate_function_batch(coco_problem_t *p, const double *x, size_t number_of_points,
+                                      double *y) nogil
+    void coco_evaluate_constraint(coco_problem_t *p, const double *x, double *y) nogil
     void coco_problem_free(coco_problem_t *p)
+    void coco_reset_seeds()
 
 # IMPORTANT: These functions are *not* declared public in coco.h so we have to
 # explicitly declare it as an external function. Otherwise Cython will *not*
 # add a declaration to the generated source files.
-cdef extern coco_problem_t *coco_get_bbob_problem(size_t function, size_t
-                                                  dimension, size_t instance)
 cdef extern double coco_problem_get_best_value(coco_problem_t *p)
 
+supported_suite_names = ["bbob", "bbob-biobj", "bbob-biobj-ext",
+                         "bbob-constrained", "bbob-constrained-active-only", "bbob-constrained-no-disguise",
+                         "bbob-largescale", "bbob-mixint", "bbob-biobj-mixint", "bbob-noisy"]
+
 
 cdef class BenchmarkFunction:
     """A bare benchmark function from one of the available suites.
@@ -49,6 +62,12 @@ cdef class BenchmarkFunction:
     >>> x = np.zeros(fn.dimension)
     >>> fn(x)
     124.61122368000001
+
+    or evaluate a whole population at once, possibly in several threads
+
+    >>> X = np.zeros((3, fn.dimension))
+    >>> fn(X, num_threads=2)
+    array([124.61122368, 124.61122368, 124.61122368])
     """
 
     cdef coco_problem_t *_problem
@@ -57,6 +76,12 @@ cdef class BenchmarkFunction:
     cdef readonly int function
     cdef readonly int dimension
     cdef readonly int instance
+    cdef readonly int number_of_objectives
+    cdef readonly int number_of_constraints
+    cdef bytes _suite
+    cdef coco_problem_t **_clones  # independent copies of _problem used by further threads
+    cdef Py_ssize_t _number_of_clones
+    cdef object _executor
 
     def __init__(self, suite: str, function: int, dimension: int, instance: int):
         """
@@ -65,10 +90,10 @@ cdef class BenchmarkFunction:
         Parameters
         ----------
         suite
-            Name of benchmark suite ("bbob" only currently)
+            Name of benchmark suite (one of `supported_suite_names`)
 
         function
-            ID of function from suite
+            ID of function from suite (101-130 for "bbob-noisy")
 
         dimension
             Dimension of instantiated function
@@ -76,6 +101,9 @@ cdef class BenchmarkFunction:
         instance
             Instance ID of instantiated function
 
+        As with `cocoex.Suite`, creating a "bbob-noisy" function restarts
+        the noise (which all of them share), so that its values can be
+        reproduced.
 
         Raises
         ------
@@ -91,17 +119,32 @@ cdef class BenchmarkFunction:
         self.dimension = dimension
         self.instance = instance
         self._problem = NULL
-        if suite == "bbob":
-            self._problem = coco_get_bbob_problem(function, dimension, instance)
-            if self._problem == NULL:
-                # FIXME: Possibly extend Exception to include dimension and instance?
-                raise NoSuchProblemException(suite, function)
-        else:
+        self._clones = NULL
+        self._number_of_clones = 0
+        self._executor = None
+        if suite not in supported_suite_names:
             raise NoSuchSuiteException(suite)
+        self._suite = suite.encode('ascii')
+        if self._suite == b"bbob-noisy":
+            coco_reset_seeds()
+        self._problem = coco_get_suite_problem(self._suite, function, dimension, instance)
+        if self._problem == NULL:
+            # FIXME: Possibly extend Exception to include dimension and instance?
+            raise NoSuchProblemException(suite, function)
 
         self.id = coco_problem_get_id(self._problem)
+        self.number_of_objectives = coco_problem_get_number_of_objectives(self._problem)
+        self.number_of_constraints = coco_problem_get_number_of_constraints(self._problem)
 
     def __del__(self):
+        cdef Py_ssize_t i
+        if self._executor is not None:
+            self._executor.shutdown()
+        for i in range(self._number_of_clones):
+            coco_problem_free(self._clones[i])
+        PyMem_Free(self._clones)
+        self._clones = NULL
+        self._number_of_clones = 0
         if self._problem != NULL:
             coco_problem_free(self._problem)
 
@@ -115,33 +158,134 @@ cdef class BenchmarkFunction:
     def __repr__(self):
         return f"BenchmarkFunction('{self.suite}', {self.function}, {self.dimension}, {self.instance})"
 
-    def __call__(self, x):
+    def __call__(self, x, out=None, num_threads=1):
+        """Evaluate the function in `x`.
+
+        `x` is either a single point or a 2-D array with one point per row.
+        Rows are evaluated in C without holding the GIL and their values
+        are written into `out` if given (a C-contiguous `float` array of
+        shape ``(len(x),)`` for single-objective functions and
+        ``(len(x), number_of_objectives)`` otherwise). With
+        ``num_threads > 1``, the rows are split among that many threads,
+        each of which evaluates its own copy of the function (except for
+        the "bbob-noisy" functions, which share one source of noise).
+        """
         cdef double[::1] xi
         cdef double[:, ::1] X
-        cdef Py_ssize_t N, D, i
         cdef double[::1] y_view
         cdef double y
+        cdef Py_ssize_t N
         if isinstance(x, list):
             x = np.array(x, dtype=float)
         if x.ndim == 1:
             # Evaluate a single parameter
             xi = np.array(x, dtype=float)
-            coco_evaluate_function(self._problem, &xi[0], &y)
-            return y
+            if self.number_of_objectives == 1:
+                coco_evaluate_function(self._problem, &xi[0], &y)
+                return y
+            Y = np.empty(self.number_of_objectives, dtype=np.float64)
+            y_view = Y
+            coco_evaluate_function(self._problem, &xi[0], &y_view[0])
+            return Y
         elif x.ndim == 2:
             # Evaluate several parameters at once
-            X = x
+            X = self._as_points(x)
             N = X.shape[0]
-            D = X.shape[1]
-            Y = np.zeros(N, dtype=np.float64)
-            y_view = Y
-            for i in range(N):
-                xi = X[i, :]
-                coco_evaluate_function(self._problem, &xi[0], &y)
-                y_view[i] = y
+            Y = self._output(out, N, self.number_of_objectives)
+            y_view = Y.reshape(-1)
+            num_threads = max(1, min(num_threads, N))
+            if self._suite == b"bbob-noisy":
+                num_threads = 1
+            if num_threads == 1:
+                self._evaluate_rows(0, X, y_view, 0, N)
+            else:
+                self._allocate_clones(num_threads - 1)
+                bounds = [N * t // num_threads for t in range(num_threads + 1)]
+                futures = [self._executor.submit(
+                               lambda t: self._evaluate_rows(t, X, y_view, bounds[t], bounds[t + 1]), t)
+                           for t in range(1, num_threads)]
+                self._evaluate_rows(0, X, y_view, bounds[0], bounds[1])
+                for future in futures:
+                    future.result()
             return Y
         else:
           return None
 
+    def constraint(self, x, out=None):
+        """Evaluate the constraints in `x`, a single point or a 2-D array with
+        one point per row.
 
-__all__ = ["BenchmarkFunction"]
+        Return `None` if the function has no constraints. For a 2-D array,
+        the rows are evaluated in C without holding the GIL and the values
+        are written into `out` if given (a C-contiguous `float` array of
+        shape ``(len(x), number_of_constraints)``).
+        """
+        cdef double[:, ::1] X
+        cdef double[::1] z_view
+        cdef Py_ssize_t N, i, m
+        if self.number_of_constraints <= 0:
+            return None
+        x = np.asarray(x, dtype=float)
+        X = self._as_points(x.reshape(1, -1) if x.ndim == 1 else x)
+        N = X.shape[0]
+        m = self.number_of_constraints
+        Z = self._output(out if x.ndim != 1 else None, N, m)
+        z_view = Z.reshape(-1)
+        with nogil:
+            for i in range(N):
+                coco_evaluate_constraint(self._problem, &X[i, 0], &z_view[i * m])
+        return Z[0] if x.ndim == 1 else Z
+
+    def _as_points(self, x):
+        """Return `x` as a C-contiguous 2-D array of points of the right dimension."""
+        if x.ndim != 2 or x.shape[1] != self.dimension:
+            raise ValueError(f"Points must have dimension {self.dimension}, not {x.shape[-1]}")
+        return np.ascontiguousarray(x, dtype=np.float64)
+
+    def _output(self, out, N, m):
+        """Return `out` (checked) or a new array for `N` vectors of length `m`."""
+        shape = (N,) if m == 1 else (N, m)
+        if out is None:
+            return np.empty(shape, dtype=np.float64)
+        if (not isinstance(out, np.ndarray) or out.shape != shape
+                or out.dtype != np.float64 or not out.flags.c_contiguous):
+            raise ValueError(f"Output must be a C-contiguous float array of shape {shape}")
+        return out
+
+    cdef void _evaluate_rows(self, Py_ssize_t clone, double[:, ::1] X, double[::1] Y, Py_ssize_t start,
+                             Py_ssize_t stop):
+        """Evaluate the rows `start` to `stop` of `X` with the given copy (0 for the function itself)."""
+        cdef coco_problem_t *problem = self._problem if clone == 0 else self._clones[clone - 1]
+        cdef Py_ssize_t offset = start * self.number_of_objectives
+        if stop > start:
+            with nogil:
+                coco_evaluate_function_batch(problem, &X[start, 0], stop - start, &Y[offset])
+
+    cdef _allocate_clones(self, Py_ssize_t number_of_clones):
+        """Make sure that there are at least `number_of_clones` copies of the function and as many
+        worker threads."""
+        cdef coco_problem_t **clones
+        cdef Py_ssize_t i, j
+        if number_of_clones <= self._number_of_clones:
+            return
+        clones = <coco_problem_t **>PyMem_Malloc(number_of_clones * sizeof(coco_problem_t *))
+        if clones == NULL:
+            raise MemoryError()
+        for i in range(self._number_of_clones):
+            clones[i] = self._clones[i]
+        for i in range(self._number_of_clones, number_of_clones):
+            clones[i] = coco_get_suite_problem(self._suite, self.function, self.dimension, self.instance)
+            if clones[i] == NULL:
+                for j in range(self._number_of_clones, i):
+                    coco_problem_free(clones[j])
+                PyMem_Free(clones)
+                raise NoSuchProblemException(self.suite, self.function)
+        PyMem_Free(self._clones)
+        self._clones = clones
+        self._number_of_clones = number_of_clones
+        if self._executor is not None:
+            self._executor.shutdown()
+        self._executor = ThreadPoolExecutor(max_workers=number_of_clones)
+
+
+__all__ = ["BenchmarkFunction", "supported_suite_names"]
@@ -48,6 +48,8 @@ cdef extern from "coco.h":
 
     void coco_problem_get_initial_solution(coco_problem_t *problem, double *x)
     void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
+    void coco_evaluate_function_batch(coco_problem_t *problem, const double *x, size_t number_of_points,
+                                      double *y) nogil
     void coco_evaluate_constraint(coco_problem_t *problem, const double *x, double *y)
     void coco_recommend_solution(coco_problem_t *problem, const double *x)
 
@@ -831,6 +833,52 @@ cdef class Problem:
             return self.y_values[0]
         return np.array(self.y_values, copy=True)
 
+    def evaluate_batch(self, X, out=None):
+        """return objective function values of the rows of the 2-D array `X`.
+
+        The rows are evaluated in C without holding the GIL, with the same
+        results and side effects (evaluation counts, logging) as calling
+        the problem on each row in turn.
+
+        The values are written into `out` if given, which must be a
+        C-contiguous `float` array of shape ``(len(X),)`` for
+        single-objective problems and ``(len(X), number_of_objectives)``
+        otherwise. Return `out` or a new array of this shape.
+        """
+        cdef np.ndarray[double, ndim=2, mode="c"] _X
+        cdef np.ndarray _Y
+        cdef double *x_data
+        cdef double *y_data
+        cdef size_t number_of_points
+        assert self.initialized
+        X = np.asarray(X, dtype=np.double, order='C')
+        if X.ndim != 2 or X.shape[1] != self.number_of_variables:
+            raise ValueError(
+                "Shape, `X.shape==%s`, of input `X` does not match " % str(X.shape) +
+                "`(number_of_points, number_of_variables==%d)`."
+                             % self.number_of_variables)
+        _X = X  # this is the final type conversion
+        if self.problem is NULL:
+            raise InvalidProblemException()
+        number_of_points = _X.shape[0]
+        if self._number_of_objectives == 1:
+            shape = (number_of_points,)
+        else:
+            shape = (number_of_points, self._number_of_objectives)
+        if out is None:
+            out = np.empty(shape, dtype=np.double)
+        elif (not isinstance(out, np.ndarray) or out.shape != shape
+              or out.dtype != np.double or not out.flags.c_contiguous):
+            raise ValueError(
+                "Output `out` must be a C-contiguous float array of shape %s." % str(shape))
+        _Y = out
+        if number_of_points > 0:
+            x_data = <double *>np.PyArray_DATA(_X)
+            y_data = <double *>np.PyArray_DATA(_Y)
+            with nogil:
+                coco_evaluate_function_batch(self.problem, x_data, number_of_points, y_data)
+        return out
+
     @property
     def id(self):
         "id as string without spaces or weird characters"
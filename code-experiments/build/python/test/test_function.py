@@ -2,7 +2,7 @@ import pytest
 import numpy as np
 
 from cocoex.function import BenchmarkFunction
-from cocoex.exceptions import NoSuchSuiteException
+from cocoex.exceptions import NoSuchProblemException, NoSuchSuiteException
 
 
 def test_bad_suite():
@@ -32,3 +32,46 @@ def test_multiple_parameters():
         y = fn(X)
         assert len(y) == n
         assert np.all(y >= fn.best_value())
+
+
+def test_multiple_parameters_threads_and_out():
+    fn = BenchmarkFunction("bbob", 15, 10, 3)
+    X = np.random.uniform(-5, 5, size=(101, 10))
+    expected = np.array([fn(x) for x in X])
+    for num_threads in [1, 2, 3, 200]:
+        out = np.empty(len(X))
+        y = fn(X, out=out, num_threads=num_threads)
+        assert y is out
+        assert np.array_equal(y, expected)
+    with pytest.raises(ValueError):
+        fn(X, out=np.empty(len(X) - 1))
+
+
+def test_other_suites():
+    for suite, function, dimension in [("bbob-largescale", 3, 40), ("bbob-mixint", 10, 5),
+                                       ("bbob-noisy", 101, 2), ("bbob-constrained", 5, 3),
+                                       ("bbob-biobj", 12, 3), ("bbob-biobj-ext", 70, 2),
+                                       ("bbob-biobj-mixint", 4, 10)]:
+        fn = BenchmarkFunction(suite, function, dimension, 2)
+        X = np.random.uniform(-4, 4, size=(5, dimension))
+        Y = fn(X, num_threads=2)
+        assert len(Y) == 5
+        if fn.number_of_objectives > 1:
+            assert Y.shape == (5, fn.number_of_objectives)
+        if suite == "bbob-noisy":
+            # A new function restarts the noise, which the rows share in turn
+            fn = BenchmarkFunction(suite, function, dimension, 2)
+        assert np.array_equal(Y, np.array([fn(x) for x in X]))
+        if fn.number_of_constraints > 0:
+            Z = fn.constraint(X)
+            assert Z.shape == (5, fn.number_of_constraints)
+            assert np.array_equal(Z, np.array([fn.constraint(x) for x in X]))
+        else:
+            assert fn.constraint(X) is None
+
+
+def test_bad_function():
+    with pytest.raises(NoSuchProblemException):
+        BenchmarkFunction("bbob", 25, 2, 1)
+    with pytest.raises(NoSuchProblemException):
+        BenchmarkFunction("bbob-noisy", 1, 2, 1)
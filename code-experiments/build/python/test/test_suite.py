@@ -41,3 +41,40 @@ def test_bbob2009():
             test_vector = test_vectors[int(test_vector_id)]
             y = problem(test_vector[:problem.number_of_variables])
             assert y == pytest.approx(float(expected_y))
+
+
+def test_evaluate_batch():
+    suite = Suite("bbob-biobj", "instances:1", "dimensions:5 function_indices:3")
+    problem = suite.get_problem(0)
+    X = np.random.uniform(-5, 5, size=(20, problem.dimension))
+    Y = problem.evaluate_batch(X)
+    assert Y.shape == (20, 2)
+    assert problem.evaluations == 20
+    for x, y in zip(X, Y):
+        assert np.array_equal(problem(x), y)
+    out = np.empty((20, 2))
+    assert problem.evaluate_batch(X, out=out) is out
+    assert np.array_equal(out, Y)
+    with pytest.raises(ValueError):
+        problem.evaluate_batch(X[:, :-1])
+
+    suite = Suite("bbob", "instances:1", "dimensions:10 function_indices:7")
+    problem = suite.get_problem(0)
+    X = np.random.uniform(-5, 5, size=(7, problem.dimension))
+    assert np.array_equal(problem.evaluate_batch(X), [problem(x) for x in X])
+
+
+def test_evaluate_batch_noisy_and_constrained():
+    # Creating the suite restarts the noise, so that the batch meets the same noise as the single points
+    X = np.random.uniform(-4, 4, size=(9, 5))
+    suite = Suite("bbob-noisy", "instances:1", "dimensions:5 function_indices:101")
+    Y = suite.get_problem(0).evaluate_batch(X)
+    suite = Suite("bbob-noisy", "instances:1", "dimensions:5 function_indices:101")
+    problem = suite.get_problem(0)
+    assert np.array_equal(Y, [problem(x) for x in X])
+
+    suite = Suite("bbob-constrained", "instances:1", "dimensions:5 function_indices:12")
+    problem = suite.get_problem(0)
+    Y = problem.evaluate_batch(X)
+    assert np.array_equal(Y, [problem(x) for x in X])
+    assert problem.evaluations == 18
@@ -28,6 +28,8 @@ fn main() {
     cc::Build::new()
         .file(src_path.join("coco.c"))
         .file("wrapper.c")
+        // Problems are moved between threads, so the shared data must be guarded
+        .define("COCO_USE_THREADS", None)
         .warnings(false)
         .compile("coco");
 }
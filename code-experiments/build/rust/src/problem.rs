@@ -12,11 +12,17 @@ use crate::{
 ///
 /// Instances can be optained using [Suite::next_problem]
 /// and [Suite::problem_by_function_dimension_instance].
+///
+/// Independent instances that are not tied to the lifetime of a suite
+/// can be obtained using [Suite::problem_handle], e.g. to evaluate
+/// a population on several threads.
 pub struct Problem<'suite> {
     pub(crate) inner: *mut coco_problem_t,
     _phantom: PhantomData<&'suite Suite>,
 }
 
+// The problems do not depend on any global state (the bbob-noisy problems, which do,
+// cannot be obtained as independent handles, see [Suite::problem_handle]).
 unsafe impl Send for Problem<'_> {}
 
 impl<'suite> Problem<'suite> {
@@ -28,6 +34,15 @@ impl<'suite> Problem<'suite> {
     }
 }
 
+impl Problem<'static> {
+    pub(crate) fn new_independent(inner: *mut coco_problem_t) -> Self {
+        Problem {
+            inner,
+            _phantom: PhantomData,
+        }
+    }
+}
+
 impl Problem<'_> {
     /// Returns the ID of the problem.
     ///
@@ -98,6 +113,28 @@ impl Problem<'_> {
         }
     }
 
+    /// Evaluates the problem at all points in `x` and returns the results in `y`.
+    ///
+    /// The points are stored row-major in `x`, i.e. `x` holds `n` consecutive
+    /// points of length [Problem::dimension], and the results are stored in the
+    /// same way in `y`, which must hold `n` rows of length [Problem::number_of_objectives].
+    pub fn evaluate_function_batch(&mut self, x: &[f64], y: &mut [f64]) {
+        let dimension = self.dimension();
+        let number_of_objectives = self.number_of_objectives();
+        assert_eq!(x.len() % dimension, 0);
+        let number_of_points = x.len() / dimension;
+        assert_eq!(number_of_points * number_of_objectives, y.len());
+
+        unsafe {
+            coco_sys::coco_evaluate_function_batch(
+                self.inner,
+                x.as_ptr(),
+                number_of_points,
+                y.as_mut_ptr(),
+            );
+        }
+    }
+
     /// Evaluates the problem constraints in point x and save the result in y.
     ///
     /// The length of `x` must match [Problem::dimension] and the
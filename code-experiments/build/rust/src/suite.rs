@@ -194,6 +194,36 @@ impl Suite {
         Some(Problem::new(inner, self))
     }
 
+    /// Returns an independent handle to the problem for the given function, dimension and instance.
+    ///
+    /// Unlike [Suite::problem_by_function_dimension_instance], the problem is constructed
+    /// without going through the suite and is not tied to its lifetime, so any number of
+    /// handles for the same problem can be created and moved to different threads.
+    /// Each handle counts its own evaluations and has no observer attached.
+    /// Returns `None` if the suite does not contain the given function, for the `toy` suite
+    /// and for the `bbob-noisy` suite, whose problems share the global state of their noise
+    /// generators and can therefore not be evaluated on several threads.
+    pub fn problem_handle(
+        &self,
+        function: usize,
+        dimension: usize,
+        instance: usize,
+    ) -> Option<Problem<'static>> {
+        if self.name.as_bytes() == b"bbob-noisy" {
+            return None;
+        }
+
+        let inner = unsafe {
+            coco_sys::coco_get_suite_problem(self.name.as_ptr(), function, dimension, instance)
+        };
+
+        if inner.is_null() {
+            return None;
+        }
+
+        Some(Problem::new_independent(inner))
+    }
+
     /// Returns the total number of problems in the suite.
     pub fn number_of_problems(&self) -> usize {
         unsafe {
@@ -211,3 +241,43 @@ impl Drop for Suite {
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::thread;
+
+    #[test]
+    fn problem_handles_evaluate_like_the_suite_on_several_threads() {
+        let mut suite = Suite::new(Name::Bbob, "", "dimensions: 5").unwrap();
+        let x = [0.5, -1.0, 2.0, 0.0, 3.5];
+        let mut expected = [0.0];
+        suite
+            .problem_by_function_dimension_instance(8, 5, 1)
+            .unwrap()
+            .evaluate_function(&x, &mut expected);
+
+        let handles: Vec<_> = (0..4)
+            .map(|_| suite.problem_handle(8, 5, 1).unwrap())
+            .collect();
+        let results: Vec<f64> = thread::scope(|scope| {
+            let threads: Vec<_> = handles
+                .into_iter()
+                .map(|mut problem| {
+                    scope.spawn(move || {
+                        let mut y = [0.0];
+                        for _ in 0..100 {
+                            problem.evaluate_function(&x, &mut y);
+                        }
+                        assert_eq!(problem.evaluations(), 100);
+                        y[0]
+                    })
+                })
+                .collect();
+            threads.into_iter().map(|t| t.join().unwrap()).collect()
+        });
+        assert!(results.iter().all(|&y| y == expected[0]));
+
+        assert!(suite.problem_handle(25, 5, 1).is_none());
+    }
+}
@@ -46,6 +46,13 @@
 
 typedef double (*callback_type)(double, void*);
 
+/*
+  The suites invert tosz_uv and tasy_uv with tosz_uv_inv and tasy_uv_inv, so
+  brentq and brentinv are only compiled if COCO_BRENTQ is defined (as done by
+  the unit tests that compare the inverses to brentinv).
+*/
+#if defined(COCO_BRENTQ)
+
 static double brentq(callback_type f, double y, double xa, double xb, double xtol,
                      double rtol, int iter, void *func_data);
 
@@ -226,3 +233,5 @@ double brentinv(callback_type f, double y, void *func_data) {
     xres = brentq(f, y, xmin, xmax, 1E-14, 1E-10, 200, func_data);
     return xres;
 }
+
+#endif /* COCO_BRENTQ */
@@ -21,6 +21,7 @@ typedef struct {
   double *x;
   double x_shift_factor; /* shift solution by - factor * gradient */
   double gradient_norm;
+  size_t *number_of_owners; /**< @brief Number of clones sharing the gradient (NULL if not shared) */
 } linear_constraint_data_t;	
 
 static void c_sum_variables_evaluate(coco_problem_t *self, 
@@ -156,8 +157,23 @@ static coco_problem_t *c_guarantee_feasible_point(coco_problem_t *problem,
 static void c_linear_gradient_free(void *thing) {
 	
   linear_constraint_data_t *data = (linear_constraint_data_t *) thing;
-  coco_free_memory(data->gradient);
   coco_free_memory(data->x);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->gradient);
+  }
+}
+
+/**
+ * @brief Clones the data object, sharing the gradient.
+ */
+static void *c_linear_clone(coco_problem_t *problem, void *thing) {
+  linear_constraint_data_t *data = (linear_constraint_data_t *) thing;
+  linear_constraint_data_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (linear_constraint_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 /**
@@ -199,10 +215,12 @@ static coco_problem_t *c_linear_transform(coco_problem_t *inner_problem,
   data = coco_allocate_memory(sizeof(*data));
   data->gradient = coco_duplicate_vector(gradient, inner_problem->number_of_variables);
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->number_of_owners = NULL;
   data->x_shift_factor = shift_factor;
   data->gradient_norm = gradient_norm;
   self = coco_problem_transformed_allocate(inner_problem, data, 
       c_linear_gradient_free, "gradient_linear_constraint");
+  coco_problem_transformed_set_data_clone_function(self, c_linear_clone);
   self->evaluate_constraint = c_linear_single_evaluate;
 
   return self;
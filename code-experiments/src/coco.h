@@ -213,6 +213,15 @@ struct coco_archive_s;
  * See coco_archive_s for more information on its fields. */
 typedef struct coco_archive_s coco_archive_t;
 
+/** @brief Structure containing a COCO evaluation handle. */
+struct coco_evaluation_handle_s;
+
+/**
+ * @brief The COCO evaluation handle type.
+ *
+ * See coco_evaluation_handle_s for more information on its fields. */
+typedef struct coco_evaluation_handle_s coco_evaluation_handle_t;
+
 /** @brief Structure containing a COCO random state. */
 struct coco_random_state_s;
 
@@ -257,6 +266,15 @@ coco_problem_t *coco_suite_get_problem_by_function_dimension_instance(coco_suite
                                                                       const size_t dimension,
                                                                       const size_t instance);
 
+/**
+ * @brief Constructs the problem of the given suite defined by function, dimension and instance numbers
+ * without constructing the suite.
+ */
+coco_problem_t *coco_get_suite_problem(const char *suite_name,
+                                       const size_t function,
+                                       const size_t dimension,
+                                       const size_t instance);
+
 /**
  * @brief Returns the number of problems in the given suite.
  */
@@ -355,6 +373,16 @@ void coco_suite_decode_problem_index(const coco_suite_t *suite,
                                      size_t *function_idx,
                                      size_t *dimension_idx,
                                      size_t *instance_idx);
+
+/**
+ * @brief Returns the index of the problem at the given position in the order in which the suite is iterated.
+ */
+size_t coco_suite_get_ordered_problem_index(const coco_suite_t *suite, const size_t position);
+
+/**
+ * @brief Returns the estimated (relative) cost of running the problem with problem_index in the given suite.
+ */
+double coco_suite_get_problem_cost(const coco_suite_t *suite, const size_t problem_index);
 /**@}*/
 
 /***********************************************************************************************************/
@@ -393,6 +421,21 @@ const char *coco_observer_get_result_folder(const coco_observer_t *observer);
  */
 void coco_observer_signal_restart(coco_observer_t *observer, coco_problem_t *problem);
 
+/**
+ * @brief Returns the number of evaluations looked up in the evaluation caches of the observed problems.
+ */
+size_t coco_observer_get_evaluation_cache_lookups(const coco_observer_t *observer);
+
+/**
+ * @brief Returns the number of evaluations answered from the evaluation caches of the observed problems.
+ */
+size_t coco_observer_get_evaluation_cache_hits(const coco_observer_t *observer);
+
+/**
+ * @brief Merges the output of the workers that shared the given folder into a new result folder.
+ */
+size_t coco_observer_merge_workers(const char *work_queue_folder, const char *merged_folder);
+
 /**@}*/
 
 /***********************************************************************************************************/
@@ -406,6 +449,73 @@ void coco_observer_signal_restart(coco_observer_t *observer, coco_problem_t *pro
  */
 void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y);
 
+/**
+ * @brief Evaluates the problem function in number_of_points points stored row-wise in x and saves the
+ * results row-wise in y.
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem,
+                                  const double *x,
+                                  const size_t number_of_points,
+                                  double *y);
+
+/**
+ * @brief Evaluates the gradient of the single-objective problem function in point x and saves the result in
+ * y (which must have room for dimension values).
+ *
+ * If the problem has no gradient (see coco_problem_has_gradient), y is set to NAN values and a warning is
+ * output.
+ */
+void coco_evaluate_gradient(coco_problem_t *problem, const double *x, double *y);
+
+/**
+ * @brief Evaluates the gradient of the problem function in number_of_points points stored row-wise in x and
+ * saves the results row-wise in y.
+ */
+void coco_evaluate_gradient_batch(coco_problem_t *problem,
+                                  const double *x,
+                                  const size_t number_of_points,
+                                  double *y);
+
+/**
+ * @brief Evaluates the mixed-integer problem in the point given by the integer part x_int and the continuous
+ * part x_cont and saves the result in y.
+ */
+void coco_evaluate_function_mixint(coco_problem_t *problem, const int32_t *x_int, const double *x_cont,
+                                   double *y);
+
+/**
+ * @brief Same as coco_evaluate_function_mixint, but with a 64-bit integer part.
+ */
+void coco_evaluate_function_mixint64(coco_problem_t *problem, const int64_t *x_int, const double *x_cont,
+                                     double *y);
+
+/**
+ * @brief Evaluates the problem function in point x, saves the result in y and returns a handle that allows
+ * cheap re-evaluations after changing a few coordinates of x (see coco_evaluate_delta).
+ */
+coco_evaluation_handle_t *coco_evaluation_handle_allocate(coco_problem_t *problem, const double *x, double *y);
+
+/**
+ * @brief Sets the given coordinates of the point stored in the handle to new values, evaluates the problem
+ * function in the resulting point and saves the result in y.
+ */
+void coco_evaluate_delta(coco_problem_t *problem,
+                         coco_evaluation_handle_t *handle,
+                         const size_t number_of_changes,
+                         const size_t *indices,
+                         const double *values,
+                         double *y);
+
+/**
+ * @brief Returns the point currently stored in the handle.
+ */
+const double *coco_evaluation_handle_get_x(const coco_evaluation_handle_t *handle);
+
+/**
+ * @brief Frees the given evaluation handle.
+ */
+void coco_evaluation_handle_free(coco_evaluation_handle_t *handle);
+
 /**
  * @brief Evaluates the problem constraints in point x and save the result in y.
  */
@@ -421,6 +531,16 @@ void coco_recommend_solution(coco_problem_t *problem, const double *x);
  */
 void coco_problem_free(coco_problem_t *problem);
 
+/**
+ * @brief Returns an independent copy of the given problem.
+ *
+ * The read-only data of the problem (matrices, optima, peak tables, ...) is shared with the clone, while
+ * the clone has its own buffers and evaluation counters, so that the problem and its clones can be
+ * evaluated concurrently (e.g. one per thread). The clone must be freed with coco_problem_free and
+ * remains valid when the given problem is freed. Problems wrapped by an observer cannot be cloned.
+ */
+coco_problem_t *coco_problem_clone(coco_problem_t *problem);
+
 /**
  * @brief Returns the name of the problem.
  */
@@ -461,6 +581,17 @@ size_t coco_problem_get_evaluations(const coco_problem_t *problem);
  */
 size_t coco_problem_get_evaluations_constraints(const coco_problem_t *problem);
 
+/**
+ * @brief Returns the number of gradient evaluations done on the problem.
+ */
+size_t coco_problem_get_evaluations_gradient(const coco_problem_t *problem);
+
+/**
+ * @brief Returns 1 if the gradient of the problem can be evaluated with coco_evaluate_gradient, 0 otherwise
+ * (for example for the noisy, mixed-integer and multi-objective problems).
+ */
+int coco_problem_has_gradient(const coco_problem_t *problem);
+
 /**
  * @brief Returns 1 if the final target was hit, 0 otherwise.
  */
@@ -523,6 +654,17 @@ void coco_problem_get_initial_solution(const coco_problem_t *problem, double *in
  */
 coco_random_state_t *coco_random_new(uint32_t seed);
 
+/**
+ * @brief Creates and returns the random number state of the given stream of the given seed.
+ *
+ * Streams are meant for drawing independent random numbers in parallel (one stream per thread or process).
+ * Stream 0 is the same as coco_random_new(seed) and the other streams of one seed start from distinct states.
+ * The generator has no jump-ahead, so that the streams are not disjoint by construction; with a period in
+ * excess of 2^607, the probability that any two of k streams of length n overlap is however below
+ * k^2 n / 2^607. Streams of different seeds should not be mixed.
+ */
+coco_random_state_t *coco_random_new_stream(uint32_t seed, uint32_t stream);
+
 /**
  * @brief Frees all memory associated with the random state.
  */
@@ -534,10 +676,25 @@ void coco_random_free(coco_random_state_t *state);
  */
 double coco_random_uniform(coco_random_state_t *state);
 
+/**
+ * @brief Stores the given number of uniform [0, 1) random values in values.
+ *
+ * The values are the same as those returned by as many calls of coco_random_uniform.
+ */
+void coco_random_uniform_fill(coco_random_state_t *state, double *values, const size_t number);
+
 /**
  * @brief Generates an approximately normal random number.
  */
 double coco_random_normal(coco_random_state_t *state);
+
+/**
+ * @brief Stores the given number of approximately normal random numbers in values.
+ *
+ * Uses half as many uniform random values as the same number of calls of coco_random_normal, so that the
+ * values (and the state afterwards) are not the same as with coco_random_normal.
+ */
+void coco_random_normal_fill(coco_random_state_t *state, double *values, const size_t number);
 /**@}*/
 
 /***********************************************************************************************************/
@@ -625,6 +782,16 @@ const char *coco_set_log_level(const char *level);
  */
 /**@{*/
 
+/**
+ * @brief Computes the ideal and nadir points of the given bi-objective problem.
+ */
+void coco_archive_get_ideal_and_nadir(const char *suite_name,
+                                      const size_t function,
+                                      const size_t dimension,
+                                      const size_t instance,
+                                      double *ideal,
+                                      double *nadir);
+
 /**
  * @brief Constructs a COCO archive.
  */
@@ -639,6 +806,31 @@ coco_archive_t *coco_archive(const char *suite_name,
  */
 int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text);
 
+/**
+ * @brief Adds the solutions with objectives (y1[i], y2[i]) to the archive in bulk and returns the number of
+ * solutions that updated the archive.
+ *
+ * The archive stores references to the solution texts in text_buffer (at the given offsets) instead of
+ * copies, so the buffer must outlive the archive.
+ */
+size_t coco_archive_add_solutions(coco_archive_t *archive,
+                                  const size_t number_of_solutions,
+                                  const double *y1,
+                                  const double *y2,
+                                  const char *text_buffer,
+                                  const size_t *text_offsets);
+
+/**
+ * @brief Adds the solutions of the given instance stored in the archive file to the archive.
+ *
+ * Returns the number of solutions read from the file, -1 if the file (containing multiple instances)
+ * does not contain the given instance or -2 if the file cannot be read.
+ */
+long coco_archive_add_solutions_from_file(coco_archive_t *archive,
+                                          const char *file_name,
+                                          const size_t instance,
+                                          const int single_instance);
+
 /**
  * @brief Returns the number of (non-dominated) solutions in the archive (computed first, if needed).
  */
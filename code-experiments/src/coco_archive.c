@@ -10,6 +10,91 @@
 #include "coco_utilities.c"
 #include "mo_utilities.c"
 #include "mo_avl_tree.c"
+#include "suite_biobj.c"
+
+/**
+ * @brief The contents of a file that is read as a whole (memory-mapped where possible).
+ */
+typedef struct {
+  char *data;                    /**< @brief The file contents (not null-terminated). */
+  size_t size;                   /**< @brief The size of the file contents in bytes. */
+  int is_mapped;                 /**< @brief Whether data is memory-mapped or allocated. */
+} coco_archive_file_t;
+
+/**
+ * @brief Opens the file with the given name and makes its contents available (memory-mapped if supported).
+ *
+ * Returns 0 on success and -1 (after a warning) if the file cannot be read.
+ */
+static int coco_archive_file_open(coco_archive_file_t *file, const char *file_name) {
+
+#if defined(HAVE_MMAP)
+  struct stat file_stat;
+  int fd = open(file_name, O_RDONLY);
+  if (fd < 0) {
+    coco_warning("coco_archive_file_open(): failed to open file '%s'", file_name);
+    return -1;
+  }
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    coco_warning("coco_archive_file_open(): failed to get the size of file '%s'", file_name);
+    return -1;
+  }
+  file->size = (size_t) file_stat.st_size;
+  file->data = NULL;
+  file->is_mapped = 0;
+  if (file->size > 0) {
+    file->data = (char *) mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (file->data == (char *) MAP_FAILED) {
+      close(fd);
+      coco_warning("coco_archive_file_open(): failed to map file '%s'", file_name);
+      return -1;
+    }
+    file->is_mapped = 1;
+  }
+  close(fd);
+#else
+  long size;
+  FILE *f = fopen(file_name, "rb");
+  if (f == NULL) {
+    coco_warning("coco_archive_file_open(): failed to open file '%s'", file_name);
+    return -1;
+  }
+  fseek(f, 0, SEEK_END);
+  size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (size < 0) {
+    fclose(f);
+    coco_warning("coco_archive_file_open(): failed to get the size of file '%s'", file_name);
+    return -1;
+  }
+  file->size = (size_t) size;
+  file->data = (char *) coco_allocate_memory(file->size + 1);
+  file->is_mapped = 0;
+  if (fread(file->data, 1, file->size, f) != file->size) {
+    fclose(f);
+    coco_free_memory(file->data);
+    coco_warning("coco_archive_file_open(): failed to read file '%s'", file_name);
+    return -1;
+  }
+  fclose(f);
+#endif
+  return 0;
+}
+
+/**
+ * @brief Releases the contents of the file.
+ */
+static void coco_archive_file_close(coco_archive_file_t *file) {
+#if defined(HAVE_MMAP)
+  if (file->is_mapped)
+    munmap(file->data, file->size);
+#else
+  coco_free_memory(file->data);
+#endif
+  file->data = NULL;
+  file->size = 0;
+}
 
 /**
  * @brief The COCO archive structure.
@@ -32,17 +117,26 @@ struct coco_archive_s {
   avl_node_t *extreme1;          /**< @brief Pointer to the first extreme solution. */
   avl_node_t *extreme2;          /**< @brief Pointer to the second extreme solution. */
   int extremes_already_returned; /**< @brief Whether the extreme solutions have already been returned. */
+
+  coco_archive_file_t *files;    /**< @brief The files read by coco_archive_add_solutions_from_file. */
+  size_t number_of_files;        /**< @brief Number of files read by coco_archive_add_solutions_from_file. */
+  char *text;                    /**< @brief Buffer for the text of a solution that refers to a line. */
+  size_t text_size;              /**< @brief Size of the text buffer. */
 };
 
 /**
  * @brief The type for the node's item in the AVL tree used by the archive.
  *
  * Contains information on the rounded normalized objective values (normalized_y), which are used for
- * computing the indicators and the text, which is used for output.
+ * computing the indicators and the text, which is used for output. The text is either a copy owned by the
+ * item or refers to a line in a buffer owned by the caller (or a file read by the archive), in which case it
+ * is materialized only when it is returned.
  */
 typedef struct {
-  double *normalized_y;      /**< @brief The values of normalized objectives of this solution. */
-  char *text;                /**< @brief The text describing the solution (the whole line of the archive). */
+  double normalized_y[2];    /**< @brief The values of normalized objectives of this solution. */
+  const char *text;          /**< @brief The text describing the solution (the whole line of the archive). */
+  size_t text_length;        /**< @brief The length of the text (without the line ending if it is a reference). */
+  int owns_text;             /**< @brief Whether text is a null-terminated copy owned by the item. */
 } coco_archive_avl_item_t;
 
 /**
@@ -58,9 +152,12 @@ static coco_archive_avl_item_t* coco_archive_node_item_create(const double *y,
   coco_archive_avl_item_t *item = (coco_archive_avl_item_t*) coco_allocate_memory(sizeof(*item));
 
   /* Compute the normalized y */
-  item->normalized_y = mo_normalize(y, ideal, nadir, num_obj);
+  assert(num_obj == 2);
+  mo_normalize_into(y, ideal, nadir, num_obj, item->normalized_y);
 
   item->text = coco_strdup(text);
+  item->text_length = strlen(text);
+  item->owns_text = 1;
   return item;
 }
 
@@ -68,8 +165,8 @@ static coco_archive_avl_item_t* coco_archive_node_item_create(const double *y,
  * @brief Frees the data of the given coco_archive_avl_item_t.
  */
 static void coco_archive_node_item_free(coco_archive_avl_item_t *item, void *userdata) {
-  coco_free_memory(item->normalized_y);
-  coco_free_memory(item->text);
+  if (item->owns_text)
+    coco_free_memory((char *) item->text);
   coco_free_memory(item);
   (void) userdata; /* To silence the compiler */
 }
@@ -113,9 +210,71 @@ static coco_archive_t *coco_archive_allocate(void) {
   archive->extreme2 = NULL;             /* To be set in coco_archive() */
   archive->extremes_already_returned = 0;
 
+  archive->files = NULL;
+  archive->number_of_files = 0;
+  archive->text = NULL;
+  archive->text_size = 0;
+
   return archive;
 }
 
+/**
+ * For problems of the bbob-biobj and bbob-biobj-ext suites with known instances, the points are computed
+ * from the two underlying single-objective problems without constructing the suite. Otherwise, the problem
+ * is retrieved from the suite.
+ */
+void coco_archive_get_ideal_and_nadir(const char *suite_name,
+                                      const size_t function,
+                                      const size_t dimension,
+                                      const size_t instance,
+                                      double *ideal,
+                                      double *nadir) {
+
+  const size_t dimensions[] = { 2, 3, 5, 10, 20, 40 };
+  const size_t num_dimensions = sizeof(dimensions) / sizeof(dimensions[0]);
+  size_t number_of_functions = 0, i;
+  int dimension_found = 0;
+  coco_suite_t *suite;
+  char *suite_instance, *suite_options;
+  coco_problem_t *problem;
+
+  if (strcmp(suite_name, "bbob-biobj") == 0)
+    number_of_functions = 55;
+  else if (strcmp(suite_name, "bbob-biobj-ext") == 0)
+    number_of_functions = 55 + 37;
+  for (i = 0; i < num_dimensions; i++) {
+    if (dimensions[i] == dimension)
+      dimension_found = 1;
+  }
+  if ((function >= 1) && (function <= number_of_functions) && dimension_found
+      && suite_biobj_get_ideal_and_nadir(function, dimension, instance, coco_get_bbob_problem, ideal, nadir))
+    return;
+
+  suite_instance = coco_strdupf("instances: %lu", (unsigned long) instance);
+  suite_options = coco_strdupf("dimensions: %lu function_indices: %lu",
+      (unsigned long) dimension, (unsigned long) function);
+  suite = coco_suite(suite_name, suite_instance, suite_options);
+  if (suite == NULL) {
+    coco_error("coco_archive_get_ideal_and_nadir(): cannot create suite '%s'", suite_name);
+    return; /* Never reached */
+  }
+  problem = coco_suite_get_next_problem(suite, NULL);
+  if (problem == NULL) {
+    coco_error("coco_archive_get_ideal_and_nadir(): cannot create problem f%02lu_i%02lu_d%02lu in suite '%s'",
+        (unsigned long) function, (unsigned long) instance, (unsigned long) dimension, suite_name);
+    return; /* Never reached */
+  }
+
+  for (i = 0; i < 2; i++) {
+    ideal[i] = problem->best_value[i];
+    nadir[i] = problem->nadir_value[i];
+  }
+
+  coco_free_memory(suite_instance);
+  coco_free_memory(suite_options);
+  coco_suite_free(suite);
+}
+
 /**
  * The archive always contains the two extreme solutions
  */
@@ -126,29 +285,13 @@ coco_archive_t *coco_archive(const char *suite_name,
 
   coco_archive_t *archive = coco_archive_allocate();
   int output_precision = 15;
-  coco_suite_t *suite;
-  char *suite_instance = coco_strdupf("instances: %lu", (unsigned long) instance);
-  char *suite_options = coco_strdupf("dimensions: %lu function_indices: %lu",
-  		(unsigned long) dimension, (unsigned long) function);
-  coco_problem_t *problem;
   char *text;
   int update;
 
-  suite = coco_suite(suite_name, suite_instance, suite_options);
-  if (suite == NULL) {
-    coco_error("coco_archive(): cannot create suite '%s'", suite_name);
-    return NULL; /* Never reached */
-  }
-  problem = coco_suite_get_next_problem(suite, NULL);
-  if (problem == NULL) {
-    coco_error("coco_archive(): cannot create problem f%02lu_i%02lu_d%02lu in suite '%s'",
-    		(unsigned long) function, (unsigned long) instance, (unsigned long) dimension, suite_name);
-    return NULL; /* Never reached */
-  }
-
   /* Store the ideal and nadir points */
-  archive->ideal = coco_duplicate_vector(problem->best_value, 2);
-  archive->nadir = coco_duplicate_vector(problem->nadir_value, 2);
+  archive->ideal = coco_allocate_vector(2);
+  archive->nadir = coco_allocate_vector(2);
+  coco_archive_get_ideal_and_nadir(suite_name, function, dimension, instance, archive->ideal, archive->nadir);
 
   /* Add the extreme points to the archive */
   text = coco_strdupf("0\t%.*e\t%.*e\n", output_precision, archive->nadir[0], output_precision, archive->ideal[1]);
@@ -165,29 +308,21 @@ coco_archive_t *coco_archive(const char *suite_name,
   archive->extreme2 = archive->tree->tail;
   assert(archive->extreme1 != archive->extreme2);
 
-  coco_free_memory(suite_instance);
-  coco_free_memory(suite_options);
-  coco_suite_free(suite);
-
   (void) update; /* To silence compiler warnings */
 
   return archive;
 }
 
-int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text) {
+/**
+ * @brief Adds the given item to the archive if none of the existing solutions in the archive dominates it
+ * and returns 1 in this case. Otherwise, the item is freed and 0 is returned.
+ */
+static int coco_archive_add_item(coco_archive_t *archive, coco_archive_avl_item_t *insert_item) {
 
-  coco_archive_avl_item_t* insert_item;
   avl_node_t *node, *next_node;
   int update = 0;
   int dominance;
 
-  double *y = coco_allocate_vector(2);
-  y[0] = y1;
-  y[1] = y2;
-  insert_item = coco_archive_node_item_create(y, archive->ideal, archive->nadir,
-      archive->number_of_objectives, text);
-  coco_free_memory(y);
-
   /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
   node = avl_item_search_right(archive->tree, insert_item, NULL);
 
@@ -234,8 +369,8 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
     }
 
     if(avl_item_insert(archive->tree, insert_item) == NULL) {
+      coco_warning("Solution %.*s did not update the archive", (int) insert_item->text_length, insert_item->text);
       coco_archive_node_item_free(insert_item, NULL);
-      coco_warning("Solution %s did not update the archive", text);
       update = 0;
     }
 
@@ -245,6 +380,20 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
   return update;
 }
 
+int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text) {
+
+  coco_archive_avl_item_t* insert_item;
+
+  double *y = coco_allocate_vector(2);
+  y[0] = y1;
+  y[1] = y2;
+  insert_item = coco_archive_node_item_create(y, archive->ideal, archive->nadir,
+      archive->number_of_objectives, text);
+  coco_free_memory(y);
+
+  return coco_archive_add_item(archive, insert_item);
+}
+
 /**
  * @brief Updates the archive fields returned by the getters.
  */
@@ -288,9 +437,29 @@ static void coco_archive_update(coco_archive_t *archive) {
 
 }
 
+/**
+ * @brief Returns the text of the given item, materializing it in the archive's text buffer if the item
+ * refers to a line (the text is then valid until the next call).
+ */
+static const char *coco_archive_get_item_text(coco_archive_t *archive, const coco_archive_avl_item_t *item) {
+
+  if (item->owns_text)
+    return item->text;
+
+  if (archive->text_size < item->text_length + 2) {
+    coco_free_memory(archive->text);
+    archive->text_size = 2 * item->text_length + 2;
+    archive->text = (char *) coco_allocate_memory(archive->text_size);
+  }
+  memcpy(archive->text, item->text, item->text_length);
+  archive->text[item->text_length] = '\n';
+  archive->text[item->text_length + 1] = '\0';
+  return archive->text;
+}
+
 const char *coco_archive_get_next_solution_text(coco_archive_t *archive) {
 
-  char *text;
+  const char *text;
 
   coco_archive_update(archive);
 
@@ -298,14 +467,14 @@ const char *coco_archive_get_next_solution_text(coco_archive_t *archive) {
 
     if (archive->current_solution == NULL) {
       /* Return the first extreme */
-      text = ((coco_archive_avl_item_t *) archive->extreme1->item)->text;
+      text = coco_archive_get_item_text(archive, (coco_archive_avl_item_t *) archive->extreme1->item);
       archive->current_solution = archive->extreme2;
       return text;
     }
 
     if (archive->current_solution == archive->extreme2) {
       /* Return the second extreme */
-      text = ((coco_archive_avl_item_t *) archive->extreme2->item)->text;
+      text = coco_archive_get_item_text(archive, (coco_archive_avl_item_t *) archive->extreme2->item);
       archive->extremes_already_returned = 1;
       archive->current_solution = archive->tree->head;
       return text;
@@ -323,7 +492,7 @@ const char *coco_archive_get_next_solution_text(coco_archive_t *archive) {
     }
 
     /* Return the current solution and move to the next */
-    text = ((coco_archive_avl_item_t *) archive->current_solution->item)->text;
+    text = coco_archive_get_item_text(archive, (coco_archive_avl_item_t *) archive->current_solution->item);
     archive->current_solution = archive->current_solution->next;
     return text;
   }
@@ -343,11 +512,403 @@ double coco_archive_get_hypervolume(coco_archive_t *archive) {
 
 void coco_archive_free(coco_archive_t *archive) {
 
+  size_t i;
+
   assert(archive != NULL);
 
   avl_tree_destruct(archive->tree);
   coco_free_memory(archive->ideal);
   coco_free_memory(archive->nadir);
+  for (i = 0; i < archive->number_of_files; i++)
+    coco_archive_file_close(&archive->files[i]);
+  if (archive->files != NULL)
+    coco_free_memory(archive->files);
+  if (archive->text != NULL)
+    coco_free_memory(archive->text);
   coco_free_memory(archive);
 
 }
+
+/**
+ * @brief A solution given in bulk, referring to its line in a text buffer.
+ */
+typedef struct {
+  double normalized_y[2];        /**< @brief The normalized objective values of the solution. */
+  size_t index;                  /**< @brief The position of the solution in the order of addition. */
+  size_t text_offset;            /**< @brief The offset of the solution's line within the text buffer. */
+  size_t text_length;            /**< @brief The length of the line without the line ending (or unknown). */
+} coco_archive_solution_t;
+
+/**
+ * @brief Returns whether c is a whitespace character (as understood by Python's str.split()).
+ */
+static int coco_archive_is_space(const char c) {
+  return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r') || (c == '\v') || (c == '\f');
+}
+
+/**
+ * @brief Parses the number in [begin, end) into value and returns 1 if the whole token is a valid number
+ * and 0 otherwise.
+ *
+ * Numbers whose significant digits form an integer not larger than 2^53 and whose decimal exponent is
+ * within [-22, 22] (this covers the numbers written by COCO loggers) are converted by a single multiplication
+ * or division of two exactly representable values (the fast path of Clinger's algorithm). Other numbers are
+ * converted by strtod, so that the result is always the correctly rounded value.
+ */
+static int coco_archive_parse_double(const char *begin, const char *end, double *value) {
+
+  static const double powers_of_ten[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+  const char *p = begin;
+  int negative = 0;
+  int number_of_digits = 0;
+  int any_digits = 0;
+  long exponent = 0;
+  long explicit_exponent = 0;
+  int exponent_negative = 0;
+  double mantissa = 0;
+  char buffer[64];
+  char *copy, *copy_end;
+  int is_number;
+
+  if ((p < end) && ((*p == '-') || (*p == '+'))) {
+    negative = (*p == '-');
+    p++;
+  }
+  /* Integer part */
+  while ((p < end) && (*p >= '0') && (*p <= '9')) {
+    any_digits = 1;
+    if ((number_of_digits > 0) || (*p != '0')) {
+      mantissa = mantissa * 10 + (*p - '0');
+      number_of_digits++;
+    }
+    p++;
+  }
+  /* Fractional part */
+  if ((p < end) && (*p == '.')) {
+    p++;
+    while ((p < end) && (*p >= '0') && (*p <= '9')) {
+      any_digits = 1;
+      if ((number_of_digits > 0) || (*p != '0')) {
+        mantissa = mantissa * 10 + (*p - '0');
+        number_of_digits++;
+      }
+      exponent--;
+      p++;
+    }
+  }
+  /* Exponent */
+  if (any_digits && (p < end) && ((*p == 'e') || (*p == 'E'))) {
+    p++;
+    if ((p < end) && ((*p == '-') || (*p == '+'))) {
+      exponent_negative = (*p == '-');
+      p++;
+    }
+    if ((p == end) || (*p < '0') || (*p > '9'))
+      any_digits = 0;
+    while ((p < end) && (*p >= '0') && (*p <= '9')) {
+      if (explicit_exponent < 10000)
+        explicit_exponent = explicit_exponent * 10 + (*p - '0');
+      p++;
+    }
+    exponent += exponent_negative ? -explicit_exponent : explicit_exponent;
+  }
+
+  if (any_digits && (p == end) && (number_of_digits <= 16) && (mantissa <= 9007199254740992.0)
+      && (exponent >= -22) && (exponent <= 22)) {
+    /* The mantissa is exact, so is the power of ten, and the result is rounded only once */
+    if (exponent >= 0)
+      *value = mantissa * powers_of_ten[exponent];
+    else
+      *value = mantissa / powers_of_ten[-exponent];
+    if (negative)
+      *value = -*value;
+    return 1;
+  }
+
+  /* Fall back to strtod on a null-terminated copy of the token (allocated only for long tokens) */
+  copy = ((size_t) (end - begin) < sizeof(buffer)) ? buffer : coco_allocate_string((size_t) (end - begin) + 1);
+  memcpy(copy, begin, (size_t) (end - begin));
+  copy[end - begin] = '\0';
+  *value = strtod(copy, &copy_end);
+  is_number = (copy_end != copy) && (*copy_end == '\0');
+  if (copy != buffer)
+    coco_free_memory(copy);
+  return is_number;
+}
+
+/**
+ * @brief Reads the value of the instance from the given comment line in the form "% ... instance = value, ..."
+ * and returns 1 if it was found and 0 otherwise.
+ */
+static int coco_archive_parse_instance(const char *begin, const char *end, size_t *instance) {
+
+  const char *key_begin, *key_end, *p = begin + 1;
+  unsigned long value;
+
+  while (p < end) {
+    /* Read the key */
+    while ((p < end) && (*p == ' '))
+      p++;
+    key_begin = p;
+    while ((p < end) && (*p != '=') && (*p != ','))
+      p++;
+    key_end = p;
+    while ((key_end > key_begin) && coco_archive_is_space(*(key_end - 1)))
+      key_end--;
+    if ((p < end) && (*p == '=')) {
+      p++;
+      if ((key_end - key_begin == 8) && (strncmp(key_begin, "instance", 8) == 0)) {
+        while ((p < end) && coco_archive_is_space(*p))
+          p++;
+        if ((p == end) || (*p < '0') || (*p > '9'))
+          return 0;
+        value = 0;
+        while ((p < end) && (*p >= '0') && (*p <= '9')) {
+          value = value * 10 + (unsigned long) (*p - '0');
+          p++;
+        }
+        *instance = (size_t) value;
+        return 1;
+      }
+    }
+    /* Skip the value */
+    while ((p < end) && (*p != ','))
+      p++;
+    if (p < end)
+      p++;
+  }
+  return 0;
+}
+
+/**
+ * @brief Returns whether the string in [begin, end) contains the given null-terminated string.
+ */
+static int coco_archive_contains(const char *begin, const char *end, const char *string) {
+  size_t length = strlen(string);
+  const char *p;
+  for (p = begin; (size_t) (end - p) >= length; p++) {
+    if ((*p == *string) && (strncmp(p, string, length) == 0))
+      return 1;
+  }
+  return 0;
+}
+
+
+/**
+ * @brief Defines the ordering of solutions given in bulk: by the last objective, then by the first objective
+ * and finally by the order of addition (values closer than mo_precision are treated as equal).
+ */
+static int coco_archive_solution_compare(const void *a, const void *b) {
+
+  const coco_archive_solution_t *solution1 = (const coco_archive_solution_t *) a;
+  const coco_archive_solution_t *solution2 = (const coco_archive_solution_t *) b;
+  int i;
+
+  for (i = 1; i >= 0; i--) {
+    if (!coco_double_almost_equal(solution1->normalized_y[i], solution2->normalized_y[i], mo_precision)) {
+      if (solution1->normalized_y[i] < solution2->normalized_y[i])
+        return -1;
+      else
+        return 1;
+    }
+  }
+  if (solution1->index < solution2->index)
+    return -1;
+  else if (solution1->index > solution2->index)
+    return 1;
+  return 0;
+}
+
+/**
+ * @brief Adds the given solutions, whose texts refer to lines in text_buffer, to the archive and returns the
+ * number of solutions that updated the archive.
+ *
+ * The solutions are first reduced to their nondominated subset by sorting them and sweeping over them once,
+ * so that only the nondominated solutions need to be inserted into the AVL tree. The resulting archive is the
+ * same as if all solutions were added one by one with coco_archive_add_solution in the order of their indices.
+ */
+static size_t coco_archive_add_solution_references(coco_archive_t *archive,
+                                                   coco_archive_solution_t *solutions,
+                                                   const size_t number_of_solutions,
+                                                   const char *text_buffer) {
+
+  coco_archive_solution_t *solution;
+  coco_archive_avl_item_t *item;
+  const char *text;
+  double best_normalized_y0 = 0;
+  size_t i, number_of_updates = 0;
+
+  /* Sort the solutions and keep only those that improve the first objective of all the preceding ones */
+  qsort(solutions, number_of_solutions, sizeof(*solutions), coco_archive_solution_compare);
+  for (i = 0; i < number_of_solutions; i++) {
+    solution = &solutions[i];
+    if ((i > 0) && ((solution->normalized_y[0] > best_normalized_y0)
+        || coco_double_almost_equal(solution->normalized_y[0], best_normalized_y0, mo_precision)))
+      continue;
+    best_normalized_y0 = solution->normalized_y[0];
+
+    item = (coco_archive_avl_item_t *) coco_allocate_memory(sizeof(*item));
+    item->normalized_y[0] = solution->normalized_y[0];
+    item->normalized_y[1] = solution->normalized_y[1];
+    item->text = text = text_buffer + solution->text_offset;
+    if (solution->text_length == (size_t) -1) {
+      /* Find the end of the line */
+      while ((*text != '\n') && (*text != '\0'))
+        text++;
+      if ((text > item->text) && (*(text - 1) == '\r'))
+        text--;
+      item->text_length = (size_t) (text - item->text);
+    } else {
+      item->text_length = solution->text_length;
+    }
+    item->owns_text = 0;
+    number_of_updates += (size_t) coco_archive_add_item(archive, item);
+  }
+
+  return number_of_updates;
+}
+
+/**
+ * The text of the i-th solution is the line starting at text_buffer + text_offsets[i] (it ends with '\n' or
+ * '\0'). The texts are not copied, so the buffer must stay unchanged until the archive is freed.
+ */
+size_t coco_archive_add_solutions(coco_archive_t *archive,
+                                  const size_t number_of_solutions,
+                                  const double *y1,
+                                  const double *y2,
+                                  const char *text_buffer,
+                                  const size_t *text_offsets) {
+
+  coco_archive_solution_t *solutions;
+  double y[2];
+  size_t i, number_of_updates;
+
+  if (number_of_solutions == 0)
+    return 0;
+
+  solutions = (coco_archive_solution_t *) coco_allocate_memory(number_of_solutions * sizeof(*solutions));
+  for (i = 0; i < number_of_solutions; i++) {
+    y[0] = y1[i];
+    y[1] = y2[i];
+    mo_normalize_into(y, archive->ideal, archive->nadir, archive->number_of_objectives,
+        solutions[i].normalized_y);
+    solutions[i].index = i;
+    solutions[i].text_offset = text_offsets[i];
+    solutions[i].text_length = (size_t) -1;
+  }
+  number_of_updates = coco_archive_add_solution_references(archive, solutions, number_of_solutions, text_buffer);
+
+  coco_free_memory(solutions);
+  return number_of_updates;
+}
+
+/**
+ * Solutions are read from all lines (except comments and empty lines) of the file if single_instance is
+ * true. Otherwise, only the solutions between the comment "% instance = <instance>" and the next comment
+ * containing an instance are read. The second and third column of each line hold the objective values; the
+ * whole line is the solution text.
+ *
+ * The file stays open (memory-mapped where possible) until the archive is freed, so that the texts of the
+ * solutions are not copied.
+ */
+long coco_archive_add_solutions_from_file(coco_archive_t *archive,
+                                          const char *file_name,
+                                          const size_t instance,
+                                          const int single_instance) {
+
+  coco_archive_file_t file, *files;
+  coco_archive_solution_t *solutions, *solution;
+  size_t number_of_solutions = 0, max_number_of_solutions = 1024;
+  size_t line_instance;
+  const char *line_begin, *line_end, *content_end, *file_end, *p;
+  const char *token_begin[3], *token_end[3];
+  int number_of_tokens, instance_found = single_instance;
+  double y[2];
+
+  if (coco_archive_file_open(&file, file_name) != 0)
+    return -2;
+  solutions = (coco_archive_solution_t *) coco_allocate_memory(max_number_of_solutions * sizeof(*solutions));
+
+  file_end = file.data + file.size;
+  for (line_begin = file.data; line_begin < file_end; line_begin = line_end + 1) {
+
+    line_end = (const char *) memchr(line_begin, '\n', (size_t) (file_end - line_begin));
+    if (line_end == NULL)
+      line_end = file_end;
+    content_end = line_end;
+    if ((content_end > line_begin) && (*(content_end - 1) == '\r'))
+      content_end--;
+
+    /* Ignore empty lines */
+    for (p = line_begin; (p < content_end) && coco_archive_is_space(*p); p++)
+      ;
+    if (p == content_end)
+      continue;
+
+    if (*line_begin == '%') {
+      /* Ignore comments, but stop at the next instance if the file contains multiple instances */
+      if (single_instance || !coco_archive_contains(line_begin, content_end, "instance"))
+        continue;
+      if (instance_found)
+        break;
+      if (coco_archive_parse_instance(line_begin, content_end, &line_instance) && (line_instance == instance))
+        instance_found = 1;
+      continue;
+    }
+
+    if (!instance_found)
+      continue;
+
+    /* Split the first three tokens */
+    number_of_tokens = 0;
+    p = line_begin;
+    while (number_of_tokens < 3) {
+      while ((p < content_end) && coco_archive_is_space(*p))
+        p++;
+      if (p == content_end)
+        break;
+      token_begin[number_of_tokens] = p;
+      while ((p < content_end) && !coco_archive_is_space(*p))
+        p++;
+      token_end[number_of_tokens] = p;
+      number_of_tokens++;
+    }
+    if ((number_of_tokens < 3) || !coco_archive_parse_double(token_begin[1], token_end[1], &y[0])
+        || !coco_archive_parse_double(token_begin[2], token_end[2], &y[1])) {
+      coco_warning("coco_archive_add_solutions_from_file(): problem in file %s, line %.*s, skipping line",
+          file_name, (int) (content_end - line_begin), line_begin);
+      continue;
+    }
+
+    if (number_of_solutions == max_number_of_solutions) {
+      max_number_of_solutions *= 2;
+      solution = (coco_archive_solution_t *) coco_allocate_memory(max_number_of_solutions * sizeof(*solutions));
+      memcpy(solution, solutions, number_of_solutions * sizeof(*solutions));
+      coco_free_memory(solutions);
+      solutions = solution;
+    }
+    solution = &solutions[number_of_solutions];
+    mo_normalize_into(y, archive->ideal, archive->nadir, archive->number_of_objectives, solution->normalized_y);
+    solution->index = number_of_solutions;
+    solution->text_offset = (size_t) (line_begin - file.data);
+    solution->text_length = (size_t) (content_end - line_begin);
+    number_of_solutions++;
+  }
+
+  coco_archive_add_solution_references(archive, solutions, number_of_solutions, file.data);
+  coco_free_memory(solutions);
+
+  /* Keep the file, since the solution texts refer to it */
+  files = (coco_archive_file_t *) coco_allocate_memory((archive->number_of_files + 1) * sizeof(*files));
+  if (archive->number_of_files > 0) {
+    memcpy(files, archive->files, archive->number_of_files * sizeof(*files));
+    coco_free_memory(archive->files);
+  }
+  files[archive->number_of_files++] = file;
+  archive->files = files;
+
+  if (!instance_found)
+    return -1;
+  return (long) number_of_solutions;
+}
@@ -28,6 +28,23 @@ typedef void (*coco_data_free_function_t)(void *data);
  */
 typedef void (*coco_problem_free_function_t)(coco_problem_t *problem);
 
+/**
+ * @brief The problem clone function type.
+ *
+ * This is a template for functions that set the data of the clone of a problem, which is a duplicate of
+ * the problem apart from the data (used by coco_problem_clone).
+ */
+typedef void (*coco_problem_clone_function_t)(coco_problem_t *clone, coco_problem_t *problem);
+
+/**
+ * @brief The data clone function type.
+ *
+ * This is a template for functions that return a clone of the data of the given transformed problem (used
+ * by coco_problem_clone). Read-only contents can be shared with the clone (see
+ * coco_shared_references_increase), while buffers written in evaluations must be allocated anew.
+ */
+typedef void *(*coco_data_clone_function_t)(coco_problem_t *problem, void *data);
+
 /**
  * @brief The evaluate function type.
  *
@@ -43,6 +60,28 @@ typedef void (*coco_evaluate_function_t)(coco_problem_t *problem, const double *
  */
 typedef void (*coco_evaluate_c_function_t)(coco_problem_t *problem, const double *x, double *y, int update_counter);
 
+/**
+ * @brief The evaluate term function type.
+ *
+ * This is a template for functions that return the contribution of the variable with index i and value x_i
+ * to the objective value of a separable single-objective problem. The objective value of such a problem
+ * equals a constant plus the sum of the contributions of all its variables.
+ */
+typedef double (*coco_evaluate_term_function_t)(coco_problem_t *problem, const size_t i, const double x_i);
+
+/**
+ * @brief The prepare integers function type.
+ *
+ * This is a template for functions that prepare the discretizations of a mixed-integer problem for its
+ * evaluation in the point given by its integer part (either x_int32 or x_int64, the other one is NULL) and its
+ * continuous part x_cont. They return the (preallocated) decision vector in which the problem is then to be
+ * evaluated. If both integer parts are NULL, the preparation is cancelled and NULL is returned.
+ */
+typedef double *(*coco_prepare_integers_function_t)(void *discretization,
+                                                    const int32_t *x_int32,
+                                                    const int64_t *x_int64,
+                                                    const double *x_cont);
+
 /**
  * @brief The recommend solutions function type.
  *
@@ -99,6 +138,9 @@ typedef struct {
   void *data;                                     /**< @brief Pointer to data, which enables further
                                                   wrapping of the problem */
   coco_data_free_function_t data_free_function;   /**< @brief Function to free the contents of data */
+  coco_data_clone_function_t data_clone_function; /**< @brief Function to clone data (NULL if the
+                                                  transformation cannot be cloned) */
+  char *name;                                     /**< @brief Name of the transformation */
 } coco_problem_transformed_data_t;
 
 /**
@@ -122,6 +164,36 @@ typedef struct {
   char **keys;   /**< @brief Pointer to option keys */
 } coco_option_keys_t;
 
+/**
+ * @brief The evaluation cache statistics data type.
+ *
+ * This is a type of a structure used to count the lookups and hits of evaluation caches. It can be shared
+ * by several caches (and their observer) and is freed when its last reference is released.
+ */
+typedef struct {
+  size_t number_of_lookups;     /**< @brief Number of cache lookups */
+  size_t number_of_hits;        /**< @brief Number of lookups that were answered from the cache */
+  size_t number_of_references;  /**< @brief Number of owners of this structure */
+} coco_evaluation_cache_statistics_t;
+
+/**
+ * @brief The checkpoint data type.
+ *
+ * This is a type of a structure holding the journal of an experiment that can be resumed (see
+ * coco_observer_checkpoint.c). It is shared by the observer and the logger of the problem that is being
+ * written and is freed when its last reference is released.
+ */
+typedef struct {
+  char *result_folder;             /**< @brief The result folder of the experiment */
+  char *file_name;                 /**< @brief The name of the checkpoint file */
+  size_t *completed;               /**< @brief The function, dimension and instance of the completed problems */
+  size_t number_of_completed;      /**< @brief Number of problems completed in earlier runs */
+  size_t max_number_of_completed;  /**< @brief Number of problems that fit into the completed array */
+  char *observer_state;            /**< @brief The observer state restored on resume (NULL if none) */
+  char *pending_record;            /**< @brief The record written when the started problem is done (or NULL) */
+  size_t number_of_references;     /**< @brief Number of owners of this structure */
+} coco_observer_checkpoint_t;
+
 
 /***********************************************************************************************************/
 
@@ -138,8 +210,12 @@ struct coco_problem_s {
   coco_evaluate_function_t evaluate_function;         /**< @brief  The function for evaluating the problem. */
   coco_evaluate_c_function_t evaluate_constraint;     /**< @brief  The function for evaluating the constraints. */
   coco_evaluate_function_t evaluate_gradient;         /**< @brief  The function for evaluating the gradient of the function. */
+  coco_evaluate_term_function_t evaluate_term;        /**< @brief  The function for evaluating the contribution of a
+                                                      single variable (only set for separable problems). */
   coco_recommend_function_t recommend_solution;       /**< @brief  The function for recommending a solution. */
   coco_problem_free_function_t problem_free_function; /**< @brief  The function for freeing this problem. */
+  coco_problem_clone_function_t problem_clone_function; /**< @brief  The function for cloning the data of this
+                                                       problem (NULL if it has none). */
   
   size_t number_of_variables;          /**< @brief Number of variables expected by the function, i.e.
                                        problem dimension */
@@ -168,6 +244,7 @@ struct coco_problem_s {
 
   size_t evaluations;                  /**< @brief Number of objective function evaluations performed on the problem. */
   size_t evaluations_constraints;      /**< @brief Number of constraint function evaluations performed on the problem. */
+  size_t evaluations_gradient;         /**< @brief Number of gradient evaluations performed on the problem. */
 
   /* Convenience fields for output generation */
   /* If at some point in time these arrays are changed to pointers, checks need to be added in the code to make sure
@@ -187,6 +264,16 @@ struct coco_problem_s {
   void *data;                          /**< @brief Pointer to a data instance @see coco_problem_transformed_data_t */
   
   void *versatile_data;                /* Wassim: *< @brief pointer to eventual additional data that need to be accessed all along the transformations*/
+
+  coco_evaluation_handle_t *evaluation_handle; /**< @brief Handle whose value the next evaluation returns
+                                               instead of evaluating (NULL otherwise) @see coco_evaluate_delta */
+  coco_prepare_integers_function_t prepare_integers; /**< @brief Prepares the discretizations for an evaluation
+                                               in integers (NULL if there are none) @see coco_evaluate_function_mixint */
+  void *discretization;                /**< @brief The data of prepare_integers (shared by the problems wrapping it) */
+#if defined(COCO_PROFILE)
+  double profile_ticks;                /**< @brief Ticks spent in evaluate_function (including inner problems) */
+  size_t profile_evaluations;          /**< @brief Number of evaluations when profile_ticks was last reset */
+#endif
 };
 
 /**
@@ -215,6 +302,13 @@ struct coco_observer_s {
   int precision_f;              /**< @brief Output precision for function values. */
   int precision_g;              /**< @brief Output precision for constraint values. */
   int log_discrete_as_int;      /**< @brief Whether to output discrete variables in int or double format. */
+  size_t evaluation_cache_size; /**< @brief Number of solutions cached per observed problem (0 means no cache). */
+  coco_evaluation_cache_statistics_t *evaluation_cache_statistics;
+                                /**< @brief Statistics of the evaluation caches of all observed problems. */
+  int profile;                  /**< @brief Whether the evaluations of the observed problems are profiled. */
+  coco_observer_checkpoint_t *checkpoint;
+                                /**< @brief The checkpoint of the experiment (NULL if it is not checkpointed). */
+  char *work_queue_folder;      /**< @brief The result folder shared with other workers (NULL if not shared). */
   void *data;                   /**< @brief Void pointer that can be used to point to data specific to an observer. */
 
   coco_data_free_function_t data_free_function;             /**< @brief  The function for freeing this observer. */
@@ -252,6 +346,11 @@ struct coco_suite_s {
   long current_function_idx;       /**< @brief The function index of the currently tackled problem. */
   long current_instance_idx;       /**< @brief The instance index of the currently tackled problem. */
 
+  double *costs;                   /**< @brief The estimated costs of the problems of each function and dimension. */
+  size_t *order;                   /**< @brief The problem indices in the order of iteration (NULL for the default order). */
+  size_t number_of_ordered_problems; /**< @brief Number of problem indices in the order. */
+  long current_order_position;     /**< @brief The position of the currently tackled problem in the order. */
+
   void *data;                      /**< @brief Void pointer that can be used to point to data specific to a suite. */
 
   coco_data_free_function_t data_free_function; /**< @brief The function for freeing this suite. */
@@ -489,6 +489,11 @@ static coco_observer_t *coco_observer_allocate(
   observer->precision_f = precision_f;
   observer->precision_g = precision_g;
   observer->log_discrete_as_int = log_discrete_as_int;
+  observer->evaluation_cache_size = 0;
+  observer->evaluation_cache_statistics = NULL;
+  observer->profile = 0;
+  observer->checkpoint = NULL;
+  observer->work_queue_folder = NULL;
   observer->data = NULL;
   observer->data_free_function = NULL;
   observer->logger_allocate_function = NULL;
@@ -498,6 +503,8 @@ static coco_observer_t *coco_observer_allocate(
   return observer;
 }
 
+static void transform_obj_cache_statistics_release(coco_evaluation_cache_statistics_t *statistics);
+
 void coco_observer_free(coco_observer_t *observer) {
 
   if (observer != NULL) {
@@ -514,6 +521,14 @@ void coco_observer_free(coco_observer_t *observer) {
     if (observer->base_evaluation_triggers != NULL)
       coco_free_memory(observer->base_evaluation_triggers);
 
+    transform_obj_cache_statistics_release(observer->evaluation_cache_statistics);
+    observer->evaluation_cache_statistics = NULL;
+
+    coco_observer_checkpoint_release(observer->checkpoint);
+    observer->checkpoint = NULL;
+    if (observer->work_queue_folder != NULL)
+      coco_free_memory(observer->work_queue_folder);
+
     if (observer->data != NULL) {
       if (observer->data_free_function != NULL) {
         observer->data_free_function(observer->data);
@@ -531,6 +546,10 @@ void coco_observer_free(coco_observer_t *observer) {
   }
 }
 
+#include "coco_observer_checkpoint.c"
+#include "coco_work_queue.c"
+#include "transform_obj_cache.c"
+#include "transform_obj_profile.c"
 #include "logger_bbob.c"
 #include "logger_bbob_old.c"
 #include "logger_biobj.c"
@@ -598,6 +617,38 @@ void coco_observer_free(coco_observer_t *observer) {
  * - "log_discrete_as_int: VALUE" determines whether the values of integer
  * variables (in mixed-integer problems) are logged as integers (1) or not (0 -
  * in this case they are logged as doubles). The default value is 0.
+ * - "evaluation_cache_size: VALUE" defines the number of most recently evaluated
+ * solutions whose objective and constraint values are cached for each observed
+ * (noiseless) problem. Re-evaluations of cached solutions are counted and logged
+ * as usual, but the function is not computed again. The default value is 0 (no
+ * cache). See coco_observer_get_evaluation_cache_hits for the hit statistics.
+ * - "profile: VALUE" determines whether the evaluation cost of each stage of
+ * the observed problems (transformations, raw function and logger) is profiled
+ * (1) or not (0). The profiles are appended to the file profile.jsonl in the
+ * result folder. Requires COCO to be compiled with -DCOCO_PROFILE. The default
+ * value is 0.
+ * - "checkpoint: VALUE" determines whether the experiment keeps a journal of the
+ * started and completed problems in the file checkpoint.txt in the result
+ * folder (1) or not (0), so that it can be resumed after an interruption. The
+ * default value is 0.
+ * - "resume: VALUE" determines whether an interrupted experiment is resumed
+ * (1) or not (0). If set, the results are output to the given result folder
+ * even if it already exists (no suffix is added), the output of the problem
+ * that was interrupted is removed and coco_suite_get_next_problem skips the
+ * problems that were completed according to the checkpoint file (the option
+ * "checkpoint" is implied). The default value is 0.
+ * - "work_queue: VALUE" determines whether the problems are distributed among
+ * several workers (processes on the same or on different machines) that share
+ * the result folder (1) or not (0). If set, no suffix is added to the given
+ * result folder, each worker writes its results to a new sub-folder worker-NNNN
+ * and coco_suite_get_next_problem skips the problems that were claimed by other
+ * workers (the option "checkpoint" is implied). The output of the workers is
+ * merged with coco_observer_merge_workers. The default value is 0.
+ * - "worker: VALUE" defines the number NNNN of the worker whose sub-folder
+ * worker-NNNN is used when an interrupted worker is resumed (together with the
+ * options "work_queue" and "resume"). The default value is 0 (a new worker).
+ * Checkpoints and work queues are supported by the "bbob" and "bbob-biobj"
+ * observers (and the observers of the other suites that use their loggers).
  *
  * @return The constructed observer object or NULL if observer_name equals NULL,
  * "" or "no_observer".
@@ -607,7 +658,11 @@ coco_observer_t *coco_observer(const char *observer_name,
 
   coco_observer_t *observer;
   char *path, *outer_folder, *result_folder, *algorithm_name, *algorithm_info;
-  int precision_x, precision_f, precision_g, log_discrete_as_int;
+  int precision_x, precision_f, precision_g, log_discrete_as_int, profile;
+  int checkpoint, resume, work_queue;
+  size_t worker;
+  char *work_queue_folder = NULL;
+  size_t evaluation_cache_size;
 
   size_t number_target_triggers;
   size_t number_evaluation_triggers;
@@ -632,7 +687,13 @@ coco_observer_t *coco_observer(const char *observer_name,
                               "precision_x",
                               "precision_f",
                               "precision_g",
-                              "log_discrete_as_int"};
+                              "log_discrete_as_int",
+                              "evaluation_cache_size",
+                              "profile",
+                              "checkpoint",
+                              "resume",
+                              "work_queue",
+                              "worker"};
   additional_option_keys = NULL; /* To be set by the chosen observer */
 
   if (0 == strcmp(observer_name, "no_observer")) {
@@ -657,11 +718,68 @@ coco_observer_t *coco_observer(const char *observer_name,
     strcpy(result_folder, "default");
   }
 
-  /* Create the result_folder inside the outer folder */
+  resume = 0;
+  if (coco_options_read_int(observer_options, "resume", &resume) != 0) {
+    if ((resume < 0) || (resume > 1)) {
+      coco_warning("coco_observer(): Unsuitable observer option value "
+                   "(resume: %d) ignored",
+                   resume);
+      resume = 0;
+    }
+  }
+
+  work_queue = 0;
+  if (coco_options_read_int(observer_options, "work_queue", &work_queue) != 0) {
+    if ((work_queue < 0) || (work_queue > 1)) {
+      coco_warning("coco_observer(): Unsuitable observer option value "
+                   "(work_queue: %d) ignored",
+                   work_queue);
+      work_queue = 0;
+    }
+  }
+
+  worker = 0;
+  if (coco_options_read_size_t(observer_options, "worker", &worker) != 0) {
+    if (!work_queue || !resume || (worker < 1) || (worker > 9999)) {
+      coco_warning("coco_observer(): Unsuitable observer option value "
+                   "(worker: %lu) ignored",
+                   (unsigned long)worker);
+      worker = 0;
+    }
+  }
+
+  checkpoint = resume || work_queue;
+  if (coco_options_read_int(observer_options, "checkpoint", &checkpoint) != 0) {
+    if ((checkpoint < 0) || (checkpoint > 1) ||
+        ((resume || work_queue) && !checkpoint)) {
+      coco_warning("coco_observer(): Unsuitable observer option value "
+                   "(checkpoint: %d) ignored",
+                   checkpoint);
+      checkpoint = resume || work_queue;
+    }
+  }
+
+  /* Create the result_folder inside the outer folder (a resumed experiment
+   * continues in the existing folder and the workers of a work queue write
+   * to their own sub-folders of the shared folder) */
   path = coco_allocate_string(COCO_PATH_MAX + 1);
   memcpy(path, outer_folder, strlen(outer_folder) + 1);
   coco_join_path(path, COCO_PATH_MAX, result_folder, NULL);
-  coco_create_unique_directory(&path);
+  if (work_queue) {
+    work_queue_folder = path;
+    if (worker > 0) {
+      sprintf(result_folder, "worker-%04lu", (unsigned long)worker);
+      path = coco_work_queue_get_path(work_queue_folder, result_folder);
+      if (!coco_directory_exists(path))
+        coco_error("coco_observer(): worker folder %s does not exist", path);
+    } else {
+      path = coco_work_queue_create_worker_folder(work_queue_folder);
+    }
+  } else if (resume) {
+    coco_create_directory(path);
+  } else {
+    coco_create_unique_directory(&path);
+  }
   coco_info("Results will be output to folder %s", path);
   coco_free_memory(outer_folder);
   coco_free_memory(result_folder);
@@ -770,12 +888,51 @@ coco_observer_t *coco_observer(const char *observer_name,
     }
   }
 
+  evaluation_cache_size = 0;
+  coco_options_read_size_t(observer_options, "evaluation_cache_size",
+                           &evaluation_cache_size);
+
+  profile = 0;
+  if (coco_options_read_int(observer_options, "profile", &profile) != 0) {
+#if !defined(COCO_PROFILE)
+    if (profile != 0) {
+      coco_warning("coco_observer(): Observer option (profile: %d) ignored, "
+                   "COCO needs to be compiled with -DCOCO_PROFILE",
+                   profile);
+      profile = 0;
+    }
+#endif
+    if ((profile < 0) || (profile > 1)) {
+      coco_warning("coco_observer(): Unsuitable observer option value "
+                   "(profile: %d) ignored",
+                   profile);
+      profile = 0;
+    }
+  }
+
   observer = coco_observer_allocate(
       path, observer_name, algorithm_name, algorithm_info,
       number_target_triggers, log_target_precision, lin_target_precision,
       number_evaluation_triggers, base_evaluation_triggers, precision_x,
       precision_f, precision_g, log_discrete_as_int);
 
+  if (evaluation_cache_size > 0) {
+    observer->evaluation_cache_size = evaluation_cache_size;
+    observer->evaluation_cache_statistics =
+        (coco_evaluation_cache_statistics_t *)coco_allocate_memory(
+            sizeof(*observer->evaluation_cache_statistics));
+    observer->evaluation_cache_statistics->number_of_lookups = 0;
+    observer->evaluation_cache_statistics->number_of_hits = 0;
+    observer->evaluation_cache_statistics->number_of_references = 1;
+  }
+  observer->profile = profile;
+
+  /* The checkpoint is read before the specific observer is initialized,
+   * because it restores the observer state */
+  if (checkpoint)
+    observer->checkpoint = coco_observer_checkpoint(path, resume);
+  observer->work_queue_folder = work_queue_folder;
+
   coco_free_memory(path);
   coco_free_memory(algorithm_name);
   coco_free_memory(algorithm_info);
@@ -816,6 +973,19 @@ coco_observer_t *coco_observer(const char *observer_name,
     return NULL;
   }
 
+  if ((observer->checkpoint != NULL)
+      && (observer->logger_allocate_function != logger_bbob)
+      && (observer->logger_allocate_function != logger_biobj)) {
+    coco_warning("coco_observer(): Observer options checkpoint, resume and "
+                 "work_queue are not supported by observer %s and are ignored",
+                 observer_name);
+    coco_observer_checkpoint_release(observer->checkpoint);
+    observer->checkpoint = NULL;
+    if (observer->work_queue_folder != NULL)
+      coco_free_memory(observer->work_queue_folder);
+    observer->work_queue_folder = NULL;
+  }
+
   /* Check for redundant option keys */
   known_option_keys = coco_option_keys_allocate(
       sizeof(known_keys) / sizeof(char *), known_keys);
@@ -850,7 +1020,10 @@ coco_observer_t *coco_observer(const char *observer_name,
 
 /**
  * Wraps the observer's logger around the problem if the observer is not NULL
- * and invokes the initialization of this logger.
+ * and invokes the initialization of this logger. If the observer was
+ * constructed with a positive evaluation_cache_size, an evaluation cache is
+ * wrapped around noiseless problems first (inside the logger). If the observer
+ * profiles the problems, a profile is wrapped directly inside the logger.
  *
  * @param problem The given COCO problem.
  * @param observer The COCO observer, whose logger will wrap the problem.
@@ -861,6 +1034,9 @@ coco_observer_t *coco_observer(const char *observer_name,
 coco_problem_t *coco_problem_add_observer(coco_problem_t *problem,
                                           coco_observer_t *observer) {
 
+  coco_problem_t *profiled_problem = NULL;
+  char file_name[COCO_PATH_MAX + 1];
+
   if (problem == NULL)
     return NULL;
 
@@ -871,8 +1047,21 @@ coco_problem_t *coco_problem_add_observer(coco_problem_t *problem,
     return problem;
   }
 
+  if ((observer->evaluation_cache_size > 0) && !problem->is_noisy)
+    problem = transform_obj_cache(problem, observer->evaluation_cache_size,
+                                  observer->evaluation_cache_statistics);
+
+  if (observer->profile) {
+    file_name[0] = '\0';
+    coco_join_path(file_name, sizeof(file_name), observer->result_folder, "profile.jsonl", NULL);
+    problem = profiled_problem = transform_obj_profile(problem, file_name);
+  }
+
   assert(observer->logger_allocate_function);
-  return observer->logger_allocate_function(observer, problem);
+  problem = observer->logger_allocate_function(observer, problem);
+  if (profiled_problem != NULL)
+    transform_obj_profile_set_outer_problem(profiled_problem, problem);
+  return problem;
 }
 
 /**
@@ -911,10 +1100,13 @@ coco_problem_t *coco_problem_remove_observer(coco_problem_t *problem,
   }
   coco_free_memory(prefix);
 
-  /* Keep the inner problem and remove the logger data */
+  /* Keep the inner problem and remove the logger data (and the profile and
+   * evaluation cache, if any) */
   problem_unobserved = coco_problem_transformed_get_inner_problem(problem);
+  problem_unobserved = transform_obj_profile_remove(problem_unobserved);
   coco_problem_transformed_free_data(problem);
   problem = NULL;
+  problem_unobserved = transform_obj_cache_remove(problem_unobserved);
 
   return problem_unobserved;
 }
@@ -964,3 +1156,30 @@ void coco_observer_signal_restart(coco_observer_t *observer,
   else
     observer->restart_function(problem);
 }
+
+/**
+ * @param observer The COCO observer.
+ *
+ * @return The number of evaluations (of objectives or constraints) of the
+ * problems observed by the observer that were looked up in the evaluation
+ * cache. Zero if the observer has no evaluation cache.
+ */
+size_t coco_observer_get_evaluation_cache_lookups(const coco_observer_t *observer) {
+  if ((observer == NULL) || (observer->evaluation_cache_statistics == NULL))
+    return 0;
+  return observer->evaluation_cache_statistics->number_of_lookups;
+}
+
+/**
+ * @param observer The COCO observer.
+ *
+ * @return The number of evaluations (of objectives or constraints) of the
+ * problems observed by the observer that were answered from the evaluation
+ * cache without computing the function. Zero if the observer has no evaluation
+ * cache.
+ */
+size_t coco_observer_get_evaluation_cache_hits(const coco_observer_t *observer) {
+  if ((observer == NULL) || (observer->evaluation_cache_statistics == NULL))
+    return 0;
+  return observer->evaluation_cache_statistics->number_of_hits;
+}
@@ -0,0 +1,480 @@
+/**
+ * @file coco_observer_checkpoint.c
+ * @brief Checkpointing of experiments so that interrupted runs can be resumed.
+ *
+ * If the observer option "checkpoint" (or "resume") is set, the observer keeps a journal in the file
+ * checkpoint.txt in the result folder. Each problem that the logger starts to write is recorded in three
+ * steps, every one of which reaches the file before the logger writes any output that depends on it:
+ * - "start F D I STATE" records the function, dimension and instance of the problem together with the
+ * state of the observer before the problem,
+ * - "file SIZE PATH" records the size of a file (-1 if it does not exist yet) before it is first opened by
+ * the logger of this problem (PATH is relative to the result folder),
+ * - "done F D I STATE" records that the problem is completed (its logger has been freed) together with
+ * the state of the observer after the problem.
+ *
+ * When an experiment is resumed (observer option "resume"), the journal is read and the problems that are
+ * done are skipped by coco_suite_get_next_problem. If the last problem was started but not done, all files
+ * it wrote to are truncated to their recorded sizes (or removed if they did not exist), so that this problem
+ * is run again from scratch and the output is the same as that of an uninterrupted run. The observer state
+ * (the last function, dimension and data file, for example) is restored from the last record that is kept.
+ *
+ * The state of a problem itself (the triggers, best found values and archives of the loggers) is not
+ * checkpointed, because the state of the optimization algorithm cannot be restored either, which is why
+ * the granularity of a checkpoint is one problem.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+
+/**
+ * @brief Returns the size of the file with the given path or -1 if the file does not exist.
+ */
+static long coco_observer_checkpoint_get_file_size(const char *path) {
+  FILE *file;
+  long size = -1;
+
+  file = fopen(path, "rb");
+  if (file == NULL)
+    return -1;
+  if (fseek(file, 0, SEEK_END) == 0)
+    size = ftell(file);
+  fclose(file);
+  return size;
+}
+
+/**
+ * @brief Truncates the file with the given path to the given size (or removes it if the size is negative).
+ *
+ * The first size bytes are copied to a temporary file, which then replaces the original file.
+ */
+static void coco_observer_checkpoint_truncate_file(const char *path, const long size) {
+  char buffer[8192];
+  char *temporary_path;
+  FILE *file, *temporary_file;
+  long remaining = size;
+  size_t count;
+  int is_written = 1;
+
+  if (size < 0) {
+    if (coco_file_exists(path) && (remove(path) != 0))
+      coco_error("coco_observer_checkpoint_truncate_file(): failed to remove file '%s'", path);
+    return;
+  }
+  if (coco_observer_checkpoint_get_file_size(path) == size)
+    return;
+
+  file = fopen(path, "rb");
+  if (file == NULL) {
+    coco_error("coco_observer_checkpoint_truncate_file(): failed to open file '%s'", path);
+    return; /* Never reached */
+  }
+  temporary_path = coco_strdupf("%s.tmp", path);
+  temporary_file = fopen(temporary_path, "wb");
+  if (temporary_file == NULL) {
+    coco_error("coco_observer_checkpoint_truncate_file(): failed to open file '%s'", temporary_path);
+    return; /* Never reached */
+  }
+  while (remaining > 0) {
+    count = fread(buffer, 1, remaining < (long) sizeof(buffer) ? (size_t) remaining : sizeof(buffer), file);
+    if ((count == 0) || (fwrite(buffer, 1, count, temporary_file) != count)) {
+      is_written = 0;
+      break;
+    }
+    remaining -= (long) count;
+  }
+  fclose(file);
+  is_written = (fclose(temporary_file) == 0) && is_written;
+  if (!is_written || (remove(path) != 0) || (rename(temporary_path, path) != 0)) {
+    coco_error("coco_observer_checkpoint_truncate_file(): failed to truncate file '%s' to %ld bytes",
+        path, size);
+  }
+  coco_free_memory(temporary_path);
+}
+
+/**
+ * @brief Appends the line to the checkpoint file and flushes it.
+ */
+static void coco_observer_checkpoint_append(const coco_observer_checkpoint_t *checkpoint, const char *line) {
+  FILE *file;
+
+  file = fopen(checkpoint->file_name, "ab");
+  if ((file == NULL) || (fputs(line, file) < 0) || (fclose(file) != 0)) {
+    coco_error("coco_observer_checkpoint_append(): failed to write to file '%s'", checkpoint->file_name);
+  }
+}
+
+/**
+ * @brief Adds the problem with the given function, dimension and instance to the completed problems.
+ */
+static void coco_observer_checkpoint_add_completed(coco_observer_checkpoint_t *checkpoint,
+                                                   const size_t function,
+                                                   const size_t dimension,
+                                                   const size_t instance) {
+  size_t *completed;
+
+  if (checkpoint->number_of_completed == checkpoint->max_number_of_completed) {
+    checkpoint->max_number_of_completed = 2 * checkpoint->max_number_of_completed + 16;
+    completed = coco_allocate_vector_size_t(3 * checkpoint->max_number_of_completed);
+    if (checkpoint->number_of_completed > 0)
+      memcpy(completed, checkpoint->completed, 3 * checkpoint->number_of_completed * sizeof(size_t));
+    if (checkpoint->completed != NULL)
+      coco_free_memory(checkpoint->completed);
+    checkpoint->completed = completed;
+  }
+  completed = checkpoint->completed + 3 * checkpoint->number_of_completed;
+  completed[0] = function;
+  completed[1] = dimension;
+  completed[2] = instance;
+  checkpoint->number_of_completed++;
+}
+
+/**
+ * @brief Parses a "start" or "done" record and returns the position of its state in the line (NULL if the
+ * record is malformed).
+ */
+static const char *coco_observer_checkpoint_parse_problem(const char *record,
+                                                          size_t *function,
+                                                          size_t *dimension,
+                                                          size_t *instance) {
+  unsigned long f, d, i;
+  int length = 0;
+
+  if ((sscanf(record, "%lu %lu %lu%n", &f, &d, &i, &length) != 3) || (record[length] != ' '))
+    return NULL;
+  *function = (size_t) f;
+  *dimension = (size_t) d;
+  *instance = (size_t) i;
+  return record + length + 1;
+}
+
+/**
+ * @brief A list of files (paths relative to the result folder) with their sizes.
+ */
+typedef struct {
+  char **paths;      /**< @brief The paths of the files */
+  long *sizes;       /**< @brief The sizes of the files (-1 for files that do not exist) */
+  size_t count;      /**< @brief Number of files in the list */
+  size_t max_count;  /**< @brief Number of files that fit into the list */
+} coco_observer_checkpoint_files_t;
+
+/**
+ * @brief Allocates an empty list of files.
+ */
+static coco_observer_checkpoint_files_t *coco_observer_checkpoint_files(void) {
+  coco_observer_checkpoint_files_t *files;
+
+  files = (coco_observer_checkpoint_files_t *) coco_allocate_memory(sizeof(*files));
+  files->paths = NULL;
+  files->sizes = NULL;
+  files->count = 0;
+  files->max_count = 0;
+  return files;
+}
+
+/**
+ * @brief Removes all files from the list.
+ */
+static void coco_observer_checkpoint_files_clear(coco_observer_checkpoint_files_t *files) {
+  size_t i;
+
+  for (i = 0; i < files->count; i++)
+    coco_free_memory(files->paths[i]);
+  files->count = 0;
+}
+
+/**
+ * @brief Frees the list of files.
+ */
+static void coco_observer_checkpoint_files_free(coco_observer_checkpoint_files_t *files) {
+  coco_observer_checkpoint_files_clear(files);
+  if (files->paths != NULL)
+    coco_free_memory(files->paths);
+  if (files->sizes != NULL)
+    coco_free_memory(files->sizes);
+  coco_free_memory(files);
+}
+
+/**
+ * @brief Returns the position of the file with the given path in the list or files->count if it is not
+ * in the list.
+ */
+static size_t coco_observer_checkpoint_files_find(const coco_observer_checkpoint_files_t *files,
+                                                  const char *path) {
+  size_t i;
+
+  for (i = 0; i < files->count; i++) {
+    if (strcmp(files->paths[i], path) == 0)
+      return i;
+  }
+  return files->count;
+}
+
+/**
+ * @brief Adds the file with the given path and size to the end of the list.
+ */
+static void coco_observer_checkpoint_files_add(coco_observer_checkpoint_files_t *files,
+                                               const char *path,
+                                               const long size) {
+  char **paths;
+  long *sizes;
+
+  if (files->count == files->max_count) {
+    files->max_count = 2 * files->max_count + 16;
+    paths = (char **) coco_allocate_memory(files->max_count * sizeof(char *));
+    sizes = (long *) coco_allocate_memory(files->max_count * sizeof(long));
+    if (files->count > 0) {
+      memcpy(paths, files->paths, files->count * sizeof(char *));
+      memcpy(sizes, files->sizes, files->count * sizeof(long));
+      coco_free_memory(files->paths);
+      coco_free_memory(files->sizes);
+    }
+    files->paths = paths;
+    files->sizes = sizes;
+  }
+  files->paths[files->count] = coco_strdup(path);
+  files->sizes[files->count] = size;
+  files->count++;
+}
+
+/**
+ * @brief Reads the checkpoint file and restores the completed problems and the observer state.
+ *
+ * The files of the problem that was started but not done (if any) are added to pending_files together with
+ * their sizes before this problem. If all_files is not NULL, the files written by any problem are added to it
+ * (each one once). Returns the position in the checkpoint file from which on the records need to be removed
+ * (those of the pending problem and an incomplete last line) or -1 if there is nothing to remove.
+ */
+static long coco_observer_checkpoint_read(coco_observer_checkpoint_t *checkpoint,
+                                          coco_observer_checkpoint_files_t *pending_files,
+                                          coco_observer_checkpoint_files_t *all_files) {
+  const size_t line_size = 2 * COCO_PATH_MAX + 128;
+  char *line, *path;
+  const char *state;
+  long line_start = 0, started_line_start = -1, size;
+  size_t length;
+  size_t function, dimension, instance;
+  int is_complete = 1;
+  FILE *file;
+
+  file = fopen(checkpoint->file_name, "rb");
+  if (file == NULL)
+    return -1;
+
+  line = coco_allocate_string(line_size);
+  while (fgets(line, (int) line_size, file) != NULL) {
+    length = strlen(line);
+    if ((length == 0) || (line[length - 1] != '\n')) {
+      is_complete = 0; /* The last line was not written completely */
+      break;
+    }
+    while ((length > 0) && ((line[length - 1] == '\n') || (line[length - 1] == '\r')))
+      line[--length] = '\0';
+
+    if (strncmp(line, "start ", 6) == 0) {
+      state = coco_observer_checkpoint_parse_problem(line + 6, &function, &dimension, &instance);
+      if (state == NULL)
+        coco_error("coco_observer_checkpoint_read(): malformed record '%s' in '%s'", line, checkpoint->file_name);
+      started_line_start = line_start;
+      coco_observer_checkpoint_files_clear(pending_files);
+      if (checkpoint->observer_state != NULL)
+        coco_free_memory(checkpoint->observer_state);
+      checkpoint->observer_state = coco_strdup(state);
+    } else if (strncmp(line, "file ", 5) == 0) {
+      if ((sscanf(line + 5, "%ld", &size) != 1) || ((path = strchr(line + 5, ' ')) == NULL))
+        coco_error("coco_observer_checkpoint_read(): malformed record '%s' in '%s'", line, checkpoint->file_name);
+      if (started_line_start >= 0) {
+        coco_observer_checkpoint_files_add(pending_files, path + 1, size);
+        if ((all_files != NULL) && (coco_observer_checkpoint_files_find(all_files, path + 1) == all_files->count))
+          coco_observer_checkpoint_files_add(all_files, path + 1, size);
+      }
+    } else if (strncmp(line, "done ", 5) == 0) {
+      state = coco_observer_checkpoint_parse_problem(line + 5, &function, &dimension, &instance);
+      if (state == NULL)
+        coco_error("coco_observer_checkpoint_read(): malformed record '%s' in '%s'", line, checkpoint->file_name);
+      coco_observer_checkpoint_add_completed(checkpoint, function, dimension, instance);
+      started_line_start = -1;
+      coco_observer_checkpoint_files_clear(pending_files);
+      if (checkpoint->observer_state != NULL)
+        coco_free_memory(checkpoint->observer_state);
+      checkpoint->observer_state = coco_strdup(state);
+    } else {
+      coco_error("coco_observer_checkpoint_read(): malformed record '%s' in '%s'", line, checkpoint->file_name);
+    }
+    line_start = ftell(file);
+  }
+  fclose(file);
+  coco_free_memory(line);
+
+  if (started_line_start >= 0)
+    return started_line_start;
+  return is_complete ? -1 : line_start;
+}
+
+/**
+ * @brief Reads the checkpoint file, rolls back the problem that was started but not done (if any) and
+ * restores the completed problems and the observer state.
+ */
+static void coco_observer_checkpoint_resume(coco_observer_checkpoint_t *checkpoint) {
+  coco_observer_checkpoint_files_t *pending_files;
+  char *path;
+  long position;
+  size_t i;
+
+  pending_files = coco_observer_checkpoint_files();
+  position = coco_observer_checkpoint_read(checkpoint, pending_files, NULL);
+
+  /* Roll back the files of the interrupted problem (in reverse order, so that the size recorded first wins)
+   * and remove its records together with any incomplete line */
+  if (pending_files->count > 0)
+    coco_info("Rolling back the output of the interrupted problem in %s", checkpoint->result_folder);
+  path = coco_allocate_string(COCO_PATH_MAX + 1);
+  for (i = pending_files->count; i > 0; i--) {
+    memcpy(path, checkpoint->result_folder, strlen(checkpoint->result_folder) + 1);
+    coco_join_path(path, COCO_PATH_MAX, pending_files->paths[i - 1], NULL);
+    coco_observer_checkpoint_truncate_file(path, pending_files->sizes[i - 1]);
+  }
+  coco_free_memory(path);
+  if (position >= 0)
+    coco_observer_checkpoint_truncate_file(checkpoint->file_name, position);
+
+  coco_observer_checkpoint_files_free(pending_files);
+  coco_info("Resuming the experiment in %s (%lu problems done)", checkpoint->result_folder,
+      (unsigned long) checkpoint->number_of_completed);
+}
+
+/**
+ * @brief Allocates the checkpoint of the experiment with the given result folder and resumes it if needed.
+ */
+static coco_observer_checkpoint_t *coco_observer_checkpoint(const char *result_folder, const int resume) {
+  coco_observer_checkpoint_t *checkpoint;
+
+  checkpoint = (coco_observer_checkpoint_t *) coco_allocate_memory(sizeof(*checkpoint));
+  checkpoint->result_folder = coco_strdup(result_folder);
+  checkpoint->file_name = coco_allocate_string(COCO_PATH_MAX + 1);
+  memcpy(checkpoint->file_name, result_folder, strlen(result_folder) + 1);
+  coco_join_path(checkpoint->file_name, COCO_PATH_MAX, "checkpoint.txt", NULL);
+  checkpoint->completed = NULL;
+  checkpoint->number_of_completed = 0;
+  checkpoint->max_number_of_completed = 0;
+  checkpoint->observer_state = NULL;
+  checkpoint->pending_record = NULL;
+  checkpoint->number_of_references = 1;
+
+  if (resume)
+    coco_observer_checkpoint_resume(checkpoint);
+  return checkpoint;
+}
+
+/**
+ * @brief Releases a reference to the checkpoint and frees it when it was the last one.
+ */
+static void coco_observer_checkpoint_release(coco_observer_checkpoint_t *checkpoint) {
+  if (checkpoint == NULL)
+    return;
+  assert(checkpoint->number_of_references > 0);
+  if (--checkpoint->number_of_references > 0)
+    return;
+  coco_free_memory(checkpoint->result_folder);
+  coco_free_memory(checkpoint->file_name);
+  if (checkpoint->completed != NULL)
+    coco_free_memory(checkpoint->completed);
+  if (checkpoint->observer_state != NULL)
+    coco_free_memory(checkpoint->observer_state);
+  if (checkpoint->pending_record != NULL)
+    coco_free_memory(checkpoint->pending_record);
+  coco_free_memory(checkpoint);
+}
+
+/**
+ * @brief Returns 1 if the problem with the given function, dimension and instance was completed in an
+ * earlier run of the experiment and 0 otherwise (or if the checkpoint is NULL).
+ */
+static int coco_observer_checkpoint_is_completed(const coco_observer_checkpoint_t *checkpoint,
+                                                 const size_t function,
+                                                 const size_t dimension,
+                                                 const size_t instance) {
+  size_t i;
+
+  if (checkpoint == NULL)
+    return 0;
+  for (i = 0; i < checkpoint->number_of_completed; i++) {
+    if ((checkpoint->completed[3 * i] == function) && (checkpoint->completed[3 * i + 1] == dimension)
+        && (checkpoint->completed[3 * i + 2] == instance))
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Records that the logger starts to write the output of the given problem.
+ *
+ * Must be called before the logger writes anything. The state_before and state_after strings (without new
+ * lines) hold the state of the observer before and after the problem. Returns a new reference to the
+ * checkpoint, which is passed to coco_observer_checkpoint_add_file and released by
+ * coco_observer_checkpoint_done (or NULL if the checkpoint is NULL).
+ */
+static coco_observer_checkpoint_t *coco_observer_checkpoint_start(coco_observer_checkpoint_t *checkpoint,
+                                                                  const size_t function,
+                                                                  const size_t dimension,
+                                                                  const size_t instance,
+                                                                  const char *state_before,
+                                                                  const char *state_after) {
+  char *record;
+
+  if (checkpoint == NULL)
+    return NULL;
+  if (checkpoint->pending_record != NULL)
+    coco_error("coco_observer_checkpoint_start(): the previous problem is not done yet");
+
+  record = coco_strdupf("start %lu %lu %lu %s\n", (unsigned long) function, (unsigned long) dimension,
+      (unsigned long) instance, state_before);
+  coco_observer_checkpoint_append(checkpoint, record);
+  coco_free_memory(record);
+  checkpoint->pending_record = coco_strdupf("done %lu %lu %lu %s\n", (unsigned long) function,
+      (unsigned long) dimension, (unsigned long) instance, state_after);
+  checkpoint->number_of_references++;
+  return checkpoint;
+}
+
+/**
+ * @brief Records the size of the file with the given path before the logger of the started problem opens
+ * it (does nothing if the checkpoint is NULL).
+ */
+static void coco_observer_checkpoint_add_file(const coco_observer_checkpoint_t *checkpoint, const char *path) {
+  size_t length;
+  long size;
+  char *record;
+
+  if (checkpoint == NULL)
+    return;
+  assert(checkpoint->pending_record != NULL);
+
+  /* Paths inside the result folder are recorded relative to it, so that the folder can be moved */
+  size = coco_observer_checkpoint_get_file_size(path);
+  length = strlen(checkpoint->result_folder);
+  if ((strncmp(path, checkpoint->result_folder, length) == 0) && (path[length] == coco_path_separator[0]))
+    path += length + 1;
+  record = coco_strdupf("file %ld %s\n", size, path);
+  coco_observer_checkpoint_append(checkpoint, record);
+  coco_free_memory(record);
+}
+
+/**
+ * @brief Records that the logger has finished writing the output of the started problem and releases the
+ * reference to the checkpoint (does nothing if the checkpoint is NULL).
+ */
+static void coco_observer_checkpoint_done(coco_observer_checkpoint_t *checkpoint) {
+  if (checkpoint == NULL)
+    return;
+  assert(checkpoint->pending_record != NULL);
+  coco_observer_checkpoint_append(checkpoint, checkpoint->pending_record);
+  coco_free_memory(checkpoint->pending_record);
+  checkpoint->pending_record = NULL;
+  coco_observer_checkpoint_release(checkpoint);
+}
@@ -58,6 +58,39 @@ static const char *coco_path_separator = "/";
 #error COCO_PATH_MAX undefined
 #endif
 
+/* Definitions needed for memory-mapping files (used when reading archive files) */
+#if defined(HAVE_STAT)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
+/* Definitions needed for running tasks in parallel threads (only when compiled with -DCOCO_USE_THREADS,
+ * which might require linking with -pthread) */
+#if defined(COCO_USE_THREADS) && defined(HAVE_STAT)
+#include <pthread.h>
+#define HAVE_PTHREAD 1
+#endif
+
+/* Definitions needed for profiling the evaluations of the problems (only when compiled with -DCOCO_PROFILE).
+ * The cycle counter is used where available and the processor time elsewhere. */
+#if defined(COCO_PROFILE)
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define coco_profile_ticks() ((double) __rdtsc())
+#define COCO_PROFILE_TICK_UNIT "cycles"
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define coco_profile_ticks() ((double) __rdtsc())
+#define COCO_PROFILE_TICK_UNIT "cycles"
+#else
+#include <time.h>
+#define coco_profile_ticks() ((double) clock())
+#define COCO_PROFILE_TICK_UNIT "clock"
+#endif
+#endif
+
 /* Definitions needed for creating and removing directories */
 /* Separately handle the special case of Microsoft Visual Studio 2008 with x86_64-w64-mingw32-gcc */
 #if _MSC_VER
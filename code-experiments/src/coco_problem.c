@@ -9,6 +9,7 @@
 
 #include "coco_utilities.c"
 
+static double coco_evaluation_handle_get_value(const coco_evaluation_handle_t *handle);
 
 /***********************************************************************************************************/
 
@@ -52,7 +53,19 @@ void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
     return;
   }
 
-  problem->evaluate_function(problem, x, y);
+  if (problem->evaluation_handle != NULL) {
+    /* The value was computed incrementally by coco_evaluate_delta (which is used only once) */
+    y[0] = coco_evaluation_handle_get_value(problem->evaluation_handle);
+    problem->evaluation_handle = NULL;
+  } else {
+#if defined(COCO_PROFILE)
+    double start = coco_profile_ticks();
+    problem->evaluate_function(problem, x, y);
+    problem->profile_ticks += coco_profile_ticks() - start;
+#else
+    problem->evaluate_function(problem, x, y);
+#endif
+  }
   problem->evaluations++; /* each derived class has its own counter, only the most outer will be visible */
 
   /* A little bit of bookkeeping */
@@ -70,9 +83,104 @@ void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
   }
 }
 
+/**
+ * Evaluates the problem function in each of the given points. The evaluations are counted and logged exactly
+ * as the corresponding sequence of calls to coco_evaluate_function.
+ *
+ * @note x must hold number_of_points * dimension values (one point per row) and y must have room for
+ * number_of_points * number_of_objectives values (one objective vector per row).
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vectors stored row-wise.
+ * @param number_of_points The number of decision vectors.
+ * @param y The objective vectors that are the result of the evaluations (stored row-wise).
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem,
+                                  const double *x,
+                                  const size_t number_of_points,
+                                  double *y) {
+  size_t i;
+  size_t dimension, number_of_objectives;
+
+  assert(problem != NULL);
+  dimension = coco_problem_get_dimension(problem);
+  number_of_objectives = coco_problem_get_number_of_objectives(problem);
+  for (i = 0; i < number_of_points; i++) {
+    coco_evaluate_function(problem, x + i * dimension, y + i * number_of_objectives);
+  }
+}
+
+/**
+ * @brief Evaluates the problem in the point given by its integer and continuous parts (either x_int32 or
+ * x_int64 holds the integer part, the other one is NULL).
+ *
+ * The discretizations of the problem (see transform_vars_discretize.c) map the integers straight to their
+ * tabulated inner values, while the problem (with its observer) is evaluated in the decision vector they
+ * return, so that the evaluation is counted and logged as usual. Problems without a discretization are
+ * evaluated in an allocated decision vector.
+ */
+static void coco_evaluate_function_integers(coco_problem_t *problem,
+                                            const int32_t *x_int32,
+                                            const int64_t *x_int64,
+                                            const double *x_cont,
+                                            double *y) {
+  const size_t number_of_integer_variables = coco_problem_get_number_of_integer_variables(problem);
+  const size_t dimension = coco_problem_get_dimension(problem);
+  double *x;
+  size_t i;
+
+  assert(number_of_integer_variables == 0 || x_int32 != NULL || x_int64 != NULL);
+  assert(number_of_integer_variables == dimension || x_cont != NULL);
+
+  if (problem->prepare_integers != NULL) {
+    x = problem->prepare_integers(problem->discretization, x_int32, x_int64, x_cont);
+    coco_evaluate_function(problem, x, y);
+    /* Discretizations that were not evaluated (for example, because of an evaluation cache) are reset */
+    problem->prepare_integers(problem->discretization, NULL, NULL, NULL);
+    return;
+  }
+
+  x = coco_allocate_vector(dimension);
+  for (i = 0; i < number_of_integer_variables; i++) {
+    x[i] = (x_int32 != NULL) ? (double) x_int32[i] : (double) x_int64[i];
+  }
+  for (i = number_of_integer_variables; i < dimension; i++) {
+    x[i] = x_cont[i - number_of_integer_variables];
+  }
+  coco_evaluate_function(problem, x, y);
+  coco_free_memory(x);
+}
+
+/**
+ * Evaluates a mixed-integer problem in the point given by its integer and continuous parts. The evaluation
+ * is counted and logged exactly as the corresponding call to coco_evaluate_function.
+ *
+ * @note x_int must hold coco_problem_get_number_of_integer_variables(problem) values and x_cont the
+ * remaining ones (x_cont is ignored if all variables are integer).
+ *
+ * @param problem The given COCO problem.
+ * @param x_int The integer part of the decision vector.
+ * @param x_cont The continuous part of the decision vector.
+ * @param y The objective vector that is the result of the evaluation.
+ */
+void coco_evaluate_function_mixint(coco_problem_t *problem, const int32_t *x_int, const double *x_cont,
+                                   double *y) {
+  assert(problem != NULL);
+  coco_evaluate_function_integers(problem, x_int, NULL, x_cont, y);
+}
+
+/**
+ * Same as coco_evaluate_function_mixint, but with a 64-bit integer part.
+ */
+void coco_evaluate_function_mixint64(coco_problem_t *problem, const int64_t *x_int, const double *x_cont,
+                                     double *y) {
+  assert(problem != NULL);
+  coco_evaluate_function_integers(problem, NULL, x_int, x_cont, y);
+}
+
 /**
  * Evaluates the problem constraint.
- * 
+ *
  * @note Both x and y must point to correctly sized allocated memory regions.
  *
  * @param problem The given COCO problem.
@@ -117,6 +225,76 @@ void coco_evaluate_constraint(coco_problem_t *problem, const double *x, double *
   coco_evaluate_constraint_optional_update(problem, x, y, 1);
 }
 
+/**
+ * Evaluates the gradient of the problem function through the whole chain of transformations. The gradient is
+ * available for all problems of the bbob suite and all problems built from the same functions and
+ * transformations. At the points where the function is not differentiable (a set of measure zero), the
+ * gradient of one of the adjacent pieces is returned. For problems without a gradient (such as the noisy,
+ * mixed-integer and large-scale Gallagher, Lunacek and step ellipsoid problems), which can be recognized
+ * with coco_problem_has_gradient, y is set to NAN values and a warning is output.
+ *
+ * Gradient evaluations are neither logged nor counted as function evaluations, they have their own counter
+ * (see coco_problem_get_evaluations_gradient).
+ *
+ * @note Both x and y must point to correctly sized allocated memory regions (y must have room for
+ * dimension values).
+ *
+ * @param problem The given COCO problem (with a single objective).
+ * @param x The decision vector.
+ * @param y The gradient of the function evaluated at the point x.
+ */
+void coco_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  assert(problem != NULL);
+  if (problem->number_of_objectives != 1) {
+    coco_error("coco_evaluate_gradient(): The gradient is only defined for single-objective problems, "
+        "not for problem %s", problem->problem_id);
+  }
+
+  if (problem->evaluate_gradient == NULL) {
+    coco_warning("coco_evaluate_gradient(): No gradient function implemented for problem %s",
+        problem->problem_id);
+    coco_vector_set_to_nan(y, coco_problem_get_dimension(problem));
+    return;
+  }
+
+  /* Set the gradient to NAN if the decision vector contains any NAN or INFINITY values */
+  for (i = 0; i < coco_problem_get_dimension(problem); i++) {
+    if (coco_is_nan(x[i]) || coco_is_inf(x[i])) {
+      coco_vector_set_to_nan(y, coco_problem_get_dimension(problem));
+      return;
+    }
+  }
+
+  bbob_evaluate_gradient(problem, x, y);
+  problem->evaluations_gradient++;
+}
+
+/**
+ * Evaluates the gradient of the problem function in each of the given points. The evaluations are counted
+ * exactly as the corresponding sequence of calls to coco_evaluate_gradient.
+ *
+ * @note x must hold number_of_points * dimension values (one point per row) and so must y.
+ *
+ * @param problem The given COCO problem (with a single objective).
+ * @param x The decision vectors stored row-wise.
+ * @param number_of_points The number of decision vectors.
+ * @param y The gradients evaluated at the decision vectors (stored row-wise).
+ */
+void coco_evaluate_gradient_batch(coco_problem_t *problem,
+                                  const double *x,
+                                  const size_t number_of_points,
+                                  double *y) {
+  size_t i;
+  size_t dimension;
+
+  assert(problem != NULL);
+  dimension = coco_problem_get_dimension(problem);
+  for (i = 0; i < number_of_points; i++) {
+    coco_evaluate_gradient(problem, x + i * dimension, y + i * dimension);
+  }
+}
+
 /**
  * @note Both x and y must point to correctly sized allocated memory regions.
  *
@@ -168,8 +346,10 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   problem->evaluate_function = NULL;
   problem->evaluate_constraint = NULL;
   problem->evaluate_gradient = NULL;
+  problem->evaluate_term = NULL;
   problem->recommend_solution = NULL;
   problem->problem_free_function = NULL;
+  problem->problem_clone_function = NULL;
 
   problem->number_of_variables = number_of_variables;
   problem->number_of_objectives = number_of_objectives;
@@ -199,6 +379,7 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   problem->problem_type = NULL;
   problem->evaluations = 0;
   problem->evaluations_constraints = 0;
+  problem->evaluations_gradient = 0;
   problem->final_target_delta[0] = 1e-8; /* in case to be modified by the benchmark */
   problem->best_observed_fvalue[0] = DBL_MAX;
   problem->best_observed_evaluation[0] = 0;
@@ -208,6 +389,13 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   problem->suite_dep_instance = 0;
   problem->data = NULL;
   problem->versatile_data = NULL; /* Wassim: added to be able to pass data from one transformation to another*/
+  problem->evaluation_handle = NULL;
+  problem->prepare_integers = NULL;
+  problem->discretization = NULL;
+#if defined(COCO_PROFILE)
+  problem->profile_ticks = 0;
+  problem->profile_evaluations = 0;
+#endif
   return problem;
 }
 
@@ -224,8 +412,11 @@ static coco_problem_t *coco_problem_duplicate(const coco_problem_t *other) {
   problem->evaluate_constraint = other->evaluate_constraint;
   problem->recommend_solution = other->recommend_solution;
   problem->problem_free_function = other->problem_free_function;
+  problem->problem_clone_function = other->problem_clone_function;
   
   problem->versatile_data = other->versatile_data; /* Wassim: make the pointers the same*/
+  problem->prepare_integers = other->prepare_integers;
+  problem->discretization = other->discretization;
 
   for (i = 0; i < problem->number_of_variables; ++i) {
     problem->smallest_values_of_interest[i] = other->smallest_values_of_interest[i];
@@ -255,6 +446,7 @@ static coco_problem_t *coco_problem_duplicate(const coco_problem_t *other) {
 
   problem->evaluations = other->evaluations;
   problem->evaluations_constraints = other->evaluations_constraints;
+  problem->evaluations_gradient = other->evaluations_gradient;
   problem->final_target_delta[0] = other->final_target_delta[0];
   problem->best_observed_fvalue[0] = other->best_observed_fvalue[0];
   problem->best_observed_evaluation[0] = other->best_observed_evaluation[0];
@@ -269,6 +461,41 @@ static coco_problem_t *coco_problem_duplicate(const coco_problem_t *other) {
   return problem;
 }
 
+/**
+ * @brief Returns an independent copy of the problem (see coco_problem_clone in coco.h).
+ *
+ * The clone starts as a duplicate of the problem with fresh evaluation counters, whose data is then set by
+ * the problem_clone_function of the problem (transformed and stacked problems clone their inner problems
+ * recursively).
+ */
+coco_problem_t *coco_problem_clone(coco_problem_t *problem) {
+  coco_problem_t *clone;
+
+  assert(problem != NULL);
+  if (problem->problem_clone_function == NULL && (problem->data != NULL || problem->versatile_data != NULL)) {
+    coco_error("coco_problem_clone(): problem %s cannot be cloned", problem->problem_id);
+    return NULL; /* Never reached */
+  }
+
+  clone = coco_problem_duplicate(problem);
+  clone->evaluate_gradient = problem->evaluate_gradient;
+  clone->evaluate_term = problem->evaluate_term;
+  clone->is_noisy = problem->is_noisy;
+  if (problem->best_parameter == NULL && clone->best_parameter != NULL) {
+    coco_free_memory(clone->best_parameter);
+    clone->best_parameter = NULL;
+  }
+  clone->evaluations = 0;
+  clone->evaluations_constraints = 0;
+  clone->evaluations_gradient = 0;
+  clone->best_observed_fvalue[0] = DBL_MAX;
+  clone->best_observed_evaluation[0] = 0;
+
+  if (problem->problem_clone_function != NULL)
+    problem->problem_clone_function(clone, problem);
+  return clone;
+}
+
 /**
  * @brief Allocates a problem using scalar values for smallest_value_of_interest, largest_value_of_interest
  * and best_parameter. Assumes all variables are continuous.
@@ -430,6 +657,16 @@ size_t coco_problem_get_evaluations_constraints(const coco_problem_t *problem) {
   return problem->evaluations_constraints;
 }
 
+size_t coco_problem_get_evaluations_gradient(const coco_problem_t *problem) {
+  assert(problem != NULL);
+  return problem->evaluations_gradient;
+}
+
+int coco_problem_has_gradient(const coco_problem_t *problem) {
+  assert(problem != NULL);
+  return (problem->number_of_objectives == 1) && (problem->evaluate_gradient != NULL);
+}
+
 /**
  * @brief Returns 1 if the best parameter is not (close to) zero and 0 otherwise.
  */
@@ -747,6 +984,18 @@ static void bbob_problem_transformed_evaluate_gradient(coco_problem_t *problem,
   bbob_evaluate_gradient(data->inner_problem, x, y);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the value of the inner problem.
+ *
+ * @note Only to be used by layers that leave the function value unchanged (such as loggers), see
+ * coco_evaluate_delta.
+ */
+static double coco_problem_transformed_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  return inner_problem->evaluate_term(inner_problem, i, x_i);
+}
+
 /**
  * @brief Calls the coco_recommend_solution function on the inner problem.
  */
@@ -780,6 +1029,10 @@ static void coco_problem_transformed_free_data(coco_problem_t *problem) {
     coco_free_memory(data->data);
     data->data = NULL;
   }
+  if (data->name != NULL) {
+    coco_free_memory(data->name);
+    data->name = NULL;
+  }
   /* Let the generic free problem code deal with the rest of the fields. For this we clear the free_problem
    * function pointer and recall the generic function. */
   problem->problem_free_function = NULL;
@@ -803,11 +1056,60 @@ static void coco_problem_transformed_free(coco_problem_t *problem) {
   coco_problem_transformed_free_data(problem);
 }
 
+/**
+ * @brief Clones the transformed problem by cloning its inner problem and its data.
+ */
+static void coco_problem_transformed_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  coco_problem_transformed_data_t *data, *clone_data;
+
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  data = (coco_problem_transformed_data_t *) problem->data;
+  if (data->data != NULL && data->data_clone_function == NULL) {
+    coco_error("coco_problem_clone(): transformation %s of problem %s cannot be cloned", data->name,
+        problem->problem_id);
+    return; /* Never reached */
+  }
+
+  clone_data = (coco_problem_transformed_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  clone_data->inner_problem = coco_problem_clone(data->inner_problem);
+  clone_data->data = (data->data != NULL) ? data->data_clone_function(problem, data->data) : NULL;
+  clone_data->data_free_function = data->data_free_function;
+  clone_data->data_clone_function = data->data_clone_function;
+  clone_data->name = coco_strdup(data->name);
+  clone->data = clone_data;
+
+  /* The versatile data is owned by the innermost problem and shared by the problems wrapping it */
+  if (problem->versatile_data == data->inner_problem->versatile_data)
+    clone->versatile_data = clone_data->inner_problem->versatile_data;
+
+  /* The discretization is either the data of this transformation or shared with the inner problem */
+  if (problem->discretization == data->data)
+    clone->discretization = clone_data->data;
+  else if (problem->discretization == data->inner_problem->discretization)
+    clone->discretization = clone_data->inner_problem->discretization;
+}
+
+/**
+ * @brief Sets the function that clones the data of the transformed problem (the transformation cannot be
+ * cloned otherwise).
+ */
+static void coco_problem_transformed_set_data_clone_function(coco_problem_t *problem,
+                                                             coco_data_clone_function_t data_clone_function) {
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  ((coco_problem_transformed_data_t *) problem->data)->data_clone_function = data_clone_function;
+}
+
 /**
  * @brief Allocates a transformed problem that wraps the inner_problem.
  *
  * By default all methods will dispatch to the inner_problem. A prefix is prepended to the problem name
  * in order to reflect the transformation somewhere.
+ *
+ * @note The gradient is only dispatched if the inner problem has one. Transformations that change the
+ * function value (or the decision vector) must set evaluate_gradient to their own gradient function or to
+ * NULL.
  */
 static coco_problem_t *coco_problem_transformed_allocate(coco_problem_t *inner_problem,
                                                          void *user_data,
@@ -821,13 +1123,17 @@ static coco_problem_t *coco_problem_transformed_allocate(coco_problem_t *inner_p
   problem->inner_problem = inner_problem;
   problem->data = user_data;
   problem->data_free_function = data_free_function;
+  problem->data_clone_function = NULL;
+  problem->name = coco_strdup(name_prefix);
 
   inner_copy = coco_problem_duplicate(inner_problem);
   inner_copy->evaluate_function = coco_problem_transformed_evaluate_function;
   inner_copy->evaluate_constraint = coco_problem_transformed_evaluate_constraint;
-  inner_copy->evaluate_gradient = bbob_problem_transformed_evaluate_gradient;
+  if (inner_problem->evaluate_gradient != NULL)
+    inner_copy->evaluate_gradient = bbob_problem_transformed_evaluate_gradient;
   inner_copy->recommend_solution = coco_problem_transformed_recommend_solution;
   inner_copy->problem_free_function = coco_problem_transformed_free;
+  inner_copy->problem_clone_function = coco_problem_transformed_clone;
   inner_copy->data = problem;
 
   coco_problem_set_name(inner_copy, "%s(%s)", name_prefix, old_name);
@@ -893,6 +1199,19 @@ static void coco_problem_stacked_evaluate_constraint(coco_problem_t *problem, co
   
 }
 
+/**
+ * @brief Evaluates the gradient of the single objective of the underlying problems (the other problem only
+ * contributes constraints).
+ */
+static void coco_problem_stacked_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  coco_problem_stacked_data_t* data = (coco_problem_stacked_data_t *) problem->data;
+
+  if (coco_problem_get_number_of_objectives(data->problem1) > 0)
+    bbob_evaluate_gradient(data->problem1, x, y);
+  else
+    bbob_evaluate_gradient(data->problem2, x, y);
+}
+
 /* TODO: Missing coco_problem_stacked_recommend_solution function! */
 
 /**
@@ -919,6 +1238,42 @@ static void coco_problem_stacked_free(coco_problem_t *problem) {
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the stacked problem by cloning the two underlying problems.
+ */
+static void coco_problem_stacked_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  coco_problem_stacked_data_t *data, *clone_data;
+
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  data = (coco_problem_stacked_data_t *) problem->data;
+
+  clone_data = (coco_problem_stacked_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  clone_data->problem1 = coco_problem_clone(data->problem1);
+  clone_data->problem2 = coco_problem_clone(data->problem2);
+  clone->data = clone_data;
+  if (problem->discretization == data)
+    clone->discretization = clone_data;
+}
+
+/**
+ * @brief Prepares the discretizations of the two underlying problems and returns the decision vector of the
+ * first one that has any.
+ */
+static double *coco_problem_stacked_prepare_integers(void *discretization,
+                                                     const int32_t *x_int32,
+                                                     const int64_t *x_int64,
+                                                     const double *x_cont) {
+  coco_problem_stacked_data_t *data = (coco_problem_stacked_data_t *) discretization;
+  double *x1 = NULL, *x2 = NULL;
+
+  if (data->problem1->prepare_integers != NULL)
+    x1 = data->problem1->prepare_integers(data->problem1->discretization, x_int32, x_int64, x_cont);
+  if (data->problem2->prepare_integers != NULL)
+    x2 = data->problem2->prepare_integers(data->problem2->discretization, x_int32, x_int64, x_cont);
+  return (x1 != NULL) ? x1 : x2;
+}
+
 /**
  * @brief Allocates a problem constructed by stacking two COCO problems.
  * 
@@ -962,6 +1317,11 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
   problem->evaluate_function = coco_problem_stacked_evaluate_function;
   if (number_of_constraints > 0)
     problem->evaluate_constraint = coco_problem_stacked_evaluate_constraint;
+  if (number_of_objectives == 1) {
+    if ((coco_problem_get_number_of_objectives(problem1) == 1 && problem1->evaluate_gradient != NULL)
+        || (coco_problem_get_number_of_objectives(problem2) == 1 && problem2->evaluate_gradient != NULL))
+      problem->evaluate_gradient = coco_problem_stacked_evaluate_gradient;
+  }
 
   assert(smallest_values_of_interest);
   assert(largest_values_of_interest);
@@ -1004,9 +1364,237 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
 
   problem->data = data;
   problem->problem_free_function = coco_problem_stacked_free;
+  problem->problem_clone_function = coco_problem_stacked_clone;
+  if ((problem1->prepare_integers != NULL) || (problem2->prepare_integers != NULL)) {
+    problem->prepare_integers = coco_problem_stacked_prepare_integers;
+    problem->discretization = data;
+  }
 
   return problem;
 }
 /**@}*/
 
 /***********************************************************************************************************/
+
+/**
+ * @name Methods regarding incremental evaluation
+ *
+ * The objective value of a separable single-objective problem (every layer of which implements
+ * evaluate_term) equals a constant plus the sum of the contributions of its variables. The evaluation
+ * handle keeps these contributions in a binary tree of partial sums, so that changing k coordinates costs
+ * O(k log(n)) evaluations of the (univariate) transformations instead of a full evaluation. As the sum is
+ * always recomputed from the current contributions, no rounding errors accumulate over many changes.
+ * Problems that are not separable are evaluated in full.
+ */
+/**@{*/
+
+/**
+ * @brief The COCO evaluation handle structure.
+ */
+struct coco_evaluation_handle_s {
+
+  coco_problem_t *problem;      /**< @brief The evaluated problem. */
+  coco_problem_t *core_problem; /**< @brief The outermost layer of the problem that is not a logger. */
+  double *x;                    /**< @brief The current point. */
+  double value;                 /**< @brief The function value of the current point. */
+
+  int is_incremental;           /**< @brief Whether the problem can be evaluated incrementally. */
+  int is_synchronized;          /**< @brief Whether partial_sums hold the contributions of the current point. */
+  int has_constant;             /**< @brief Whether the constant is already known. */
+  double constant;              /**< @brief The function value minus the sum of all contributions. */
+  size_t number_of_leaves;      /**< @brief The number of leaves of the tree (a power of two). */
+  double *partial_sums;         /**< @brief The tree of partial sums with the root at index 1 and the
+                                contribution of the i-th variable at index number_of_leaves + i. */
+};
+
+/**
+ * @brief Returns the function value of the handle, which coco_evaluate_function returns instead of
+ * evaluating the core problem while the handle is set in it, so that the evaluation passes through (and is
+ * counted and logged by) all outer layers.
+ */
+static double coco_evaluation_handle_get_value(const coco_evaluation_handle_t *handle) {
+  return handle->value;
+}
+
+/**
+ * @brief Returns whether the given value is neither NAN nor infinite.
+ */
+static int coco_evaluation_handle_is_finite(const double value) {
+  return !coco_is_nan(value) && !coco_is_inf(value);
+}
+
+/**
+ * @brief Recomputes the contributions of all variables of the current point and the tree of partial sums.
+ */
+static void coco_evaluation_handle_synchronize(coco_evaluation_handle_t *handle) {
+  coco_problem_t *problem = handle->problem;
+  const size_t number_of_leaves = handle->number_of_leaves;
+  size_t i;
+
+  for (i = 0; i < problem->number_of_variables; ++i)
+    handle->partial_sums[number_of_leaves + i] = problem->evaluate_term(problem, i, handle->x[i]);
+  for (i = number_of_leaves - 1; i > 0; --i)
+    handle->partial_sums[i] = handle->partial_sums[2 * i] + handle->partial_sums[2 * i + 1];
+
+  handle->is_synchronized = coco_evaluation_handle_is_finite(handle->partial_sums[1])
+      && coco_evaluation_handle_is_finite(handle->value);
+  if (handle->is_synchronized && !handle->has_constant) {
+    handle->constant = handle->value - handle->partial_sums[1];
+    handle->has_constant = 1;
+  }
+}
+
+/**
+ * @brief Computes the constant in the optimum (if known), where the contributions are small, so that the
+ * constant is not affected by large rounding errors.
+ */
+static void coco_evaluation_handle_compute_constant(coco_evaluation_handle_t *handle) {
+  coco_problem_t *core_problem = handle->core_problem;
+  const double *best_parameter = core_problem->best_parameter;
+  double best_value, sum = 0;
+  size_t i;
+
+  if (best_parameter == NULL || coco_vector_contains_nan(best_parameter, core_problem->number_of_variables))
+    return;
+
+  /* Evaluates the core problem directly, so that the evaluation is neither counted nor logged */
+  core_problem->evaluate_function(core_problem, best_parameter, &best_value);
+  for (i = 0; i < core_problem->number_of_variables; ++i)
+    sum += core_problem->evaluate_term(core_problem, i, best_parameter[i]);
+  if (coco_evaluation_handle_is_finite(best_value) && coco_evaluation_handle_is_finite(sum)) {
+    handle->constant = best_value - sum;
+    handle->has_constant = 1;
+  }
+}
+
+/**
+ * The evaluation is counted and logged exactly as the corresponding call to coco_evaluate_function.
+ *
+ * @note The handle needs to be freed with coco_evaluation_handle_free before the problem is freed.
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vector (copied to the handle).
+ * @param y The objective vector that is the result of the evaluation.
+ */
+coco_evaluation_handle_t *coco_evaluation_handle_allocate(coco_problem_t *problem, const double *x, double *y) {
+  coco_evaluation_handle_t *handle;
+  size_t i;
+
+  assert(problem != NULL);
+  handle = (coco_evaluation_handle_t *) coco_allocate_memory(sizeof(*handle));
+  handle->problem = problem;
+  handle->x = coco_duplicate_vector(x, problem->number_of_variables);
+  handle->is_incremental = (problem->evaluate_term != NULL) && (problem->number_of_objectives == 1)
+      && (problem->number_of_constraints == 0) && !problem->is_noisy;
+  handle->is_synchronized = 0;
+  handle->has_constant = 0;
+  handle->constant = 0;
+  handle->number_of_leaves = 0;
+  handle->partial_sums = NULL;
+
+  /* The core problem is found below the layers that leave the function value unchanged */
+  handle->core_problem = problem;
+  while (handle->core_problem->evaluate_term == coco_problem_transformed_evaluate_term)
+    handle->core_problem = coco_problem_transformed_get_inner_problem(handle->core_problem);
+
+  coco_evaluate_function(problem, handle->x, y);
+  handle->value = y[0];
+
+  if (handle->is_incremental) {
+    handle->number_of_leaves = 1;
+    while (handle->number_of_leaves < problem->number_of_variables)
+      handle->number_of_leaves *= 2;
+    handle->partial_sums = coco_allocate_vector(2 * handle->number_of_leaves);
+    for (i = 0; i < 2 * handle->number_of_leaves; ++i)
+      handle->partial_sums[i] = 0; /* The leaves beyond the number of variables remain zero */
+    coco_evaluation_handle_compute_constant(handle);
+    coco_evaluation_handle_synchronize(handle);
+  }
+  return handle;
+}
+
+/**
+ * If the problem is separable, only the contributions of the changed variables are recomputed, otherwise
+ * (or if the new point contains NAN or infinite values) the problem is evaluated in full. In both cases the
+ * evaluation is counted and logged exactly as the corresponding call to coco_evaluate_function. The
+ * incremental result can differ from the one of a full evaluation by rounding errors only.
+ *
+ * @note The changes are kept, to undo a change, call coco_evaluate_delta with the old values.
+ *
+ * @param problem The given COCO problem (the same as the one used to allocate the handle).
+ * @param handle The evaluation handle.
+ * @param number_of_changes The number of changed coordinates.
+ * @param indices The indices of the changed coordinates.
+ * @param values The new values of the changed coordinates.
+ * @param y The objective vector that is the result of the evaluation.
+ */
+void coco_evaluate_delta(coco_problem_t *problem,
+                         coco_evaluation_handle_t *handle,
+                         const size_t number_of_changes,
+                         const size_t *indices,
+                         const double *values,
+                         double *y) {
+  size_t i, j;
+
+  assert(problem != NULL);
+  assert(handle != NULL);
+  if (handle->problem != problem) {
+    coco_error("coco_evaluate_delta(): the handle was allocated for a different problem than %s",
+        problem->problem_id);
+    return; /* Never reached */
+  }
+
+  for (j = 0; j < number_of_changes; ++j) {
+    if (indices[j] >= problem->number_of_variables) {
+      coco_error("coco_evaluate_delta(): index %lu out of range for problem %s",
+          (unsigned long) indices[j], problem->problem_id);
+      return; /* Never reached */
+    }
+    handle->x[indices[j]] = values[j];
+    if (!coco_evaluation_handle_is_finite(values[j]))
+      handle->is_synchronized = 0;
+  }
+
+  if (handle->is_incremental && handle->is_synchronized) {
+    for (j = 0; j < number_of_changes; ++j) {
+      i = handle->number_of_leaves + indices[j];
+      handle->partial_sums[i] = problem->evaluate_term(problem, indices[j], handle->x[indices[j]]);
+      for (i /= 2; i > 0; i /= 2)
+        handle->partial_sums[i] = handle->partial_sums[2 * i] + handle->partial_sums[2 * i + 1];
+    }
+    handle->is_synchronized = coco_evaluation_handle_is_finite(handle->partial_sums[1]);
+  }
+
+  if (handle->is_incremental && handle->is_synchronized) {
+    handle->value = handle->constant + handle->partial_sums[1];
+    handle->core_problem->evaluation_handle = handle;
+    coco_evaluate_function(problem, handle->x, y);
+    /* The core problem is not evaluated if an outer layer (for example, an evaluation cache) answers */
+    handle->core_problem->evaluation_handle = NULL;
+  } else {
+    coco_evaluate_function(problem, handle->x, y);
+    handle->value = y[0];
+    if (handle->is_incremental)
+      coco_evaluation_handle_synchronize(handle);
+  }
+}
+
+/**
+ * @brief Returns the point currently stored in the handle.
+ */
+const double *coco_evaluation_handle_get_x(const coco_evaluation_handle_t *handle) {
+  assert(handle != NULL);
+  return handle->x;
+}
+
+/**
+ * @brief Frees the given evaluation handle.
+ */
+void coco_evaluation_handle_free(coco_evaluation_handle_t *handle) {
+  assert(handle != NULL);
+  coco_free_memory(handle->x);
+  if (handle->partial_sums != NULL)
+    coco_free_memory(handle->partial_sums);
+  coco_free_memory(handle);
+}
+/**@}*/
@@ -7,6 +7,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "coco.h"
 #include <stdio.h>
@@ -24,25 +25,36 @@ struct coco_random_state_s {
   size_t index;
 };
 
+/**
+ * @brief Adds the lagged values to the values and wraps the sums to [0, 1).
+ *
+ * The values and the lagged values do not overlap, so that the loop has no dependencies. The sums lie in
+ * [0, 2), so that subtracting their integer part is the same (and exact) as subtracting 1.0 from the sums
+ * that are at least 1.0, but without a branch, which lets the compiler vectorize the loop.
+ */
+static void coco_random_generate_block(double *values, const double *lagged_values, const size_t number) {
+  size_t i;
+  for (i = 0; i < number; ++i) {
+    const double t = values[i] + lagged_values[i];
+    values[i] = t - (double) (int) t;
+  }
+}
+
 /**
  * @brief A lagged Fibonacci random number generator.
  *
  * This generator is nice because it is reasonably small and directly generates double values. The chosen
  * lags (607 and 273) lead to a generator with a period in excess of 2^607-1.
+ *
+ * The state is updated in blocks of at most COCO_SHORT_LAG values, each of which only depends on values that
+ * are not in the block.
  */
 static void coco_random_generate(coco_random_state_t *state) {
   size_t i;
-  for (i = 0; i < COCO_SHORT_LAG; ++i) {
-    double t = state->x[i] + state->x[i + (COCO_LONG_LAG - COCO_SHORT_LAG)];
-    if (t >= 1.0)
-      t -= 1.0;
-    state->x[i] = t;
-  }
-  for (i = COCO_SHORT_LAG; i < COCO_LONG_LAG; ++i) {
-    double t = state->x[i] + state->x[i - COCO_SHORT_LAG];
-    if (t >= 1.0)
-      t -= 1.0;
-    state->x[i] = t;
+  coco_random_generate_block(state->x, state->x + (COCO_LONG_LAG - COCO_SHORT_LAG), COCO_SHORT_LAG);
+  for (i = COCO_SHORT_LAG; i < COCO_LONG_LAG; i += COCO_SHORT_LAG) {
+    const size_t number = (COCO_LONG_LAG - i < COCO_SHORT_LAG) ? COCO_LONG_LAG - i : COCO_SHORT_LAG;
+    coco_random_generate_block(state->x + i, state->x + i - COCO_SHORT_LAG, number);
   }
   state->index = 0;
 }
@@ -63,6 +75,30 @@ coco_random_state_t *coco_random_new(uint32_t seed) {
   return state;
 }
 
+/**
+ * Mixes the seed and the stream number with the finalizer of MurmurHash3, which is a bijection of the stream
+ * number for a given seed. The generator is then run for a few iterations, so that the streams do not start
+ * with the correlated values of the seed expansion.
+ */
+coco_random_state_t *coco_random_new_stream(uint32_t seed, uint32_t stream) {
+  coco_random_state_t *state;
+  uint32_t stream_seed;
+  size_t i;
+
+  if (stream == 0)
+    return coco_random_new(seed);
+  stream_seed = seed ^ (stream * (uint32_t) 0x9E3779B9UL);
+  stream_seed ^= stream_seed >> 16;
+  stream_seed *= (uint32_t) 0x85EBCA6BUL;
+  stream_seed ^= stream_seed >> 13;
+  stream_seed *= (uint32_t) 0xC2B2AE35UL;
+  stream_seed ^= stream_seed >> 16;
+  state = coco_random_new(stream_seed);
+  for (i = 0; i < 10; ++i)
+    coco_random_generate(state);
+  return state;
+}
+
 void coco_random_free(coco_random_state_t *state) {
   coco_free_memory(state);
 }
@@ -75,6 +111,20 @@ double coco_random_uniform(coco_random_state_t *state) {
   return state->x[state->index++];
 }
 
+void coco_random_uniform_fill(coco_random_state_t *state, double *values, const size_t number) {
+  size_t copied = 0, available;
+  while (copied < number) {
+    if (state->index >= COCO_LONG_LAG)
+      coco_random_generate(state);
+    available = COCO_LONG_LAG - state->index;
+    if (available > number - copied)
+      available = number - copied;
+    memcpy(values + copied, state->x + state->index, available * sizeof(double));
+    state->index += available;
+    copied += available;
+  }
+}
+
 /**
  * Instead of using the (expensive) polar method, we may cheat and abuse the central limit theorem. The sum
  * of 12 uniform random values has mean 6, variance 1 and is approximately normal. Subtract 6 and you get
@@ -97,6 +147,33 @@ double coco_random_normal(coco_random_state_t *state) {
   return normal;
 }
 
+/**
+ * Uses both outputs of the Box-Muller transformation, so that one pair of uniform values yields two normal
+ * values. The cosine outputs are the values returned by coco_random_normal for the same uniform values.
+ */
+void coco_random_normal_fill(coco_random_state_t *state, double *values, const size_t number) {
+  size_t i;
+#ifdef COCO_NORMAL_POLAR
+  double radius, angle;
+
+  /* The pairs of uniform values are drawn in place of the normal values */
+  coco_random_uniform_fill(state, values, number - number % 2);
+  for (i = 0; i + 1 < number; i += 2) {
+    radius = sqrt(-2 * log(values[i]));
+    angle = 2 * coco_pi * values[i + 1];
+    values[i] = radius * cos(angle);
+    values[i + 1] = radius * sin(angle);
+  }
+  if (number % 2 == 1) {
+    values[number - 1] = coco_random_normal(state);
+  }
+#else
+  for (i = 0; i < number; ++i) {
+    values[i] = coco_random_normal(state);
+  }
+#endif
+}
+
 /* Be hygienic (for amalgamation) and undef lags. */
 #undef COCO_SHORT_LAG
 #undef COCO_LONG_LAG
@@ -0,0 +1,300 @@
+/**
+ * @file coco_shared_data.c
+ * @brief Sharing of read-only instance data between processes through memory-mapped files.
+ *
+ * If the environment variable COCO_SHARED_DATA_FOLDER is set (for example to /dev/shm/coco), the large
+ * read-only arrays of the problems (transformation matrices, packed block matrices and the Gallagher peaks)
+ * are stored in files in this folder and mapped read-only by all processes that construct the same problems,
+ * instead of being kept in the heap of each process. Block rotations are also read from there instead of
+ * being computed anew.
+ *
+ * The file names contain the COCO version and a key, which is either given (for data that is looked up
+ * before it is computed) or derived from the contents (for data that is shared after it is computed). A file
+ * is written under a temporary name and then renamed, so that other processes never see it half-written.
+ * Files that are missing, truncated, written by another version or that do not hold the expected contents
+ * are ignored (and replaced), in which case the data is simply kept in the heap as if the folder were not
+ * set. Without memory-mapping (e.g., under Windows), the data is never shared.
+ *
+ * @note The data must not be changed once it is shared. When compiled with COCO_USE_THREADS (see
+ * coco_run_tasks), the list of mappings is guarded by a mutex, so that problems using shared data can be
+ * constructed and freed by several threads at a time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+/**
+ * @brief The header of a shared data file, which is followed by the data itself.
+ */
+typedef struct {
+  char magic[8];              /**< @brief Identifies the file format (COCO_SHARED_DATA_MAGIC). */
+  char version[40];           /**< @brief The COCO version that wrote the file. */
+  unsigned long size;         /**< @brief The size of the data in bytes. */
+  unsigned long checksum;     /**< @brief The checksum of the data (see coco_shared_data_checksum). */
+} coco_shared_data_header_t;
+
+/**
+ * @brief The mappings of shared data files made by this process (so that they can be told apart from data
+ * allocated in the heap when they are freed).
+ */
+typedef struct coco_shared_data_mapping_s {
+  void *data;                                /**< @brief The data following the header. */
+  size_t length;                             /**< @brief The length of the mapping (header included). */
+  struct coco_shared_data_mapping_s *next;   /**< @brief The next mapping. */
+} coco_shared_data_mapping_t;
+
+#define COCO_SHARED_DATA_MAGIC "COCOSHD"
+
+static coco_shared_data_mapping_t *coco_shared_data_mappings = NULL;
+
+/**
+ * @brief Returns the FNV-1a hash of the given bytes.
+ */
+static unsigned long coco_shared_data_checksum(const void *data, const size_t size) {
+  const unsigned char *bytes = (const unsigned char *) data;
+  unsigned long hash = 2166136261UL;
+  size_t i;
+
+  for (i = 0; i < size; i++) {
+    hash ^= (unsigned long) bytes[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Returns the folder given by the environment variable COCO_SHARED_DATA_FOLDER (NULL if it is not
+ * set or if data cannot be shared on this platform).
+ */
+static const char *coco_shared_data_get_folder(void) {
+#if defined(HAVE_MMAP)
+  const char *folder = getenv("COCO_SHARED_DATA_FOLDER");
+  if ((folder == NULL) || (strlen(folder) == 0))
+    return NULL;
+  return folder;
+#else
+  return NULL;
+#endif
+}
+
+#if defined(HAVE_MMAP)
+
+#if defined(HAVE_PTHREAD)
+static pthread_mutex_t coco_shared_data_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+/**
+ * @brief Locks the list of mappings (does nothing without COCO_USE_THREADS).
+ */
+static void coco_shared_data_lock(void) {
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_lock(&coco_shared_data_mutex);
+#endif
+}
+
+/**
+ * @brief Unlocks the list of mappings (does nothing without COCO_USE_THREADS).
+ */
+static void coco_shared_data_unlock(void) {
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_unlock(&coco_shared_data_mutex);
+#endif
+}
+
+/**
+ * @brief Returns the (allocated) name of the file holding the data with the given key.
+ */
+static char *coco_shared_data_get_file_name(const char *folder, const char *key) {
+  return coco_strdupf("%s%scoco-%s-%s", folder, coco_path_separator, coco_version, key);
+}
+
+/**
+ * @brief Maps the file with the given name and returns its data if it holds size bytes written by this
+ * version of COCO (NULL otherwise). The checksum is verified if check_contents is set.
+ */
+static void *coco_shared_data_map(const char *file_name, const size_t size, const int check_contents) {
+  coco_shared_data_header_t *header;
+  coco_shared_data_mapping_t *mapping;
+  struct stat file_stat;
+  size_t length = sizeof(*header) + size;
+  void *address;
+  int fd;
+
+  fd = open(file_name, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  if ((fstat(fd, &file_stat) != 0) || ((size_t) file_stat.st_size != length)) {
+    close(fd);
+    return NULL;
+  }
+  address = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (address == MAP_FAILED)
+    return NULL;
+
+  header = (coco_shared_data_header_t *) address;
+  if ((strncmp(header->magic, COCO_SHARED_DATA_MAGIC, sizeof(header->magic)) != 0)
+      || (strncmp(header->version, coco_version, sizeof(header->version)) != 0)
+      || (header->size != (unsigned long) size)
+      || (check_contents && (header->checksum != coco_shared_data_checksum(header + 1, size)))) {
+    coco_debug("coco_shared_data_map(): ignoring stale file '%s'", file_name);
+    munmap(address, length);
+    return NULL;
+  }
+
+  mapping = (coco_shared_data_mapping_t *) coco_allocate_memory(sizeof(*mapping));
+  mapping->data = header + 1;
+  mapping->length = length;
+  coco_shared_data_lock();
+  mapping->next = coco_shared_data_mappings;
+  coco_shared_data_mappings = mapping;
+  coco_shared_data_unlock();
+  return mapping->data;
+}
+
+/**
+ * @brief Writes the data to the file with the given name (replacing any existing file at once).
+ */
+static void coco_shared_data_write(const char *folder, const char *file_name, const void *data, const size_t size) {
+  coco_shared_data_header_t header;
+  char *temporary_name;
+  FILE *file;
+  int is_written;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, COCO_SHARED_DATA_MAGIC, strlen(COCO_SHARED_DATA_MAGIC));
+  strncpy(header.version, coco_version, sizeof(header.version) - 1);
+  header.size = (unsigned long) size;
+  header.checksum = coco_shared_data_checksum(data, size);
+
+  coco_create_directory(folder);
+  /* The temporary name is unique to the process and (through the address of the data) to the thread */
+  temporary_name = coco_strdupf("%s.%ld.%lx.tmp", file_name, (long) getpid(), (unsigned long) (size_t) data);
+  file = fopen(temporary_name, "wb");
+  if (file == NULL) {
+    coco_warning("coco_shared_data_write(): failed to open file '%s'", temporary_name);
+    coco_free_memory(temporary_name);
+    return;
+  }
+  is_written = (fwrite(&header, sizeof(header), 1, file) == 1) && (fwrite(data, 1, size, file) == size);
+  is_written = (fclose(file) == 0) && is_written;
+  if (!is_written || (rename(temporary_name, file_name) != 0)) {
+    coco_warning("coco_shared_data_write(): failed to write file '%s'", file_name);
+    remove(temporary_name);
+  }
+  coco_free_memory(temporary_name);
+}
+
+#endif
+
+/**
+ * @brief Frees data returned by coco_shared_data_share (whether it is shared or not).
+ */
+static void coco_shared_data_free(void *data) {
+#if defined(HAVE_MMAP)
+  coco_shared_data_mapping_t **mapping, *found = NULL;
+
+  coco_shared_data_lock();
+  for (mapping = &coco_shared_data_mappings; *mapping != NULL; mapping = &(*mapping)->next) {
+    if ((*mapping)->data == data) {
+      found = *mapping;
+      *mapping = found->next;
+      break;
+    }
+  }
+  coco_shared_data_unlock();
+  if (found != NULL) {
+    munmap((coco_shared_data_header_t *) data - 1, found->length);
+    coco_free_memory(found);
+    return;
+  }
+#endif
+  coco_free_memory(data);
+}
+
+/**
+ * @brief Copies the data with the given key and size from the shared data folder and returns 1 if it is
+ * found there (0 otherwise).
+ */
+static int coco_shared_data_read(const char *key, void *data, const size_t size) {
+  const char *folder = coco_shared_data_get_folder();
+  int is_found = 0;
+#if defined(HAVE_MMAP)
+  char *file_name;
+  void *shared_data;
+
+  if (folder == NULL)
+    return 0;
+  file_name = coco_shared_data_get_file_name(folder, key);
+  shared_data = coco_shared_data_map(file_name, size, 1);
+  if (shared_data != NULL) {
+    memcpy(data, shared_data, size);
+    coco_shared_data_free(shared_data);
+    is_found = 1;
+  }
+  coco_free_memory(file_name);
+#else
+  (void) folder; (void) key; (void) data; (void) size; /* To silence the compiler */
+#endif
+  return is_found;
+}
+
+/**
+ * @brief Stores the data with the given key and size in the shared data folder (if it is set).
+ */
+static void coco_shared_data_store(const char *key, const void *data, const size_t size) {
+  const char *folder = coco_shared_data_get_folder();
+#if defined(HAVE_MMAP)
+  char *file_name;
+
+  if (folder == NULL)
+    return;
+  file_name = coco_shared_data_get_file_name(folder, key);
+  coco_shared_data_write(folder, file_name, data, size);
+  coco_free_memory(file_name);
+#else
+  (void) folder; (void) key; (void) data; (void) size; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Returns a read-only copy of the (allocated) data that is shared with other processes, in which case
+ * the data is freed, or the data itself if it cannot be shared.
+ *
+ * The data is looked up by its checksum and compared in full to the shared copy. The result must be freed
+ * with coco_shared_data_free.
+ */
+static void *coco_shared_data_share(void *data, const size_t size) {
+  const char *folder = coco_shared_data_get_folder();
+#if defined(HAVE_MMAP)
+  char *file_name, *key;
+  void *shared_data;
+
+  if ((folder == NULL) || (size == 0))
+    return data;
+  key = coco_strdupf("%lx-%lu", coco_shared_data_checksum(data, size), (unsigned long) size);
+  file_name = coco_shared_data_get_file_name(folder, key);
+  shared_data = coco_shared_data_map(file_name, size, 0);
+  if ((shared_data != NULL) && (memcmp(shared_data, data, size) != 0)) {
+    coco_shared_data_free(shared_data);
+    shared_data = NULL;
+  }
+  if (shared_data == NULL) {
+    coco_shared_data_write(folder, file_name, data, size);
+    shared_data = coco_shared_data_map(file_name, size, 0);
+  }
+  coco_free_memory(file_name);
+  coco_free_memory(key);
+  if (shared_data == NULL)
+    return data;
+  coco_free_memory(data);
+  return shared_data;
+#else
+  (void) folder; (void) size; /* To silence the compiler */
+  return data;
+#endif
+}
@@ -14,6 +14,9 @@
 #include "coco.h"
 #include "coco_internal.h"
 #include "coco_utilities.c"
+#include "coco_observer_checkpoint.c"
+#include "coco_work_queue.c"
+#include "coco_suite_order.c"
 
 #include "suite_bbob_noisy.c"
 #include "suite_bbob.c"
@@ -204,6 +207,90 @@ coco_problem_t *coco_suite_get_problem_by_function_dimension_instance(coco_suite
   return coco_suite_get_problem_from_indices(suite, (size_t) function_idx, (size_t) dimension_idx, (size_t) instance_idx);
 }
 
+/**
+ * Constructs the problem directly by the constructor of the given suite (e.g. coco_get_bbob_problem), without
+ * setting up the suite instances or any observer. The problem is not part of a suite, so its suite-dependent
+ * index is 0. The instances of the bi-objective suites that are not fixed in suite_biobj_instances are
+ * determined from the default dimensions of the suite.
+ *
+ * @note The dimension is not checked against the dimensions of the suite, but some suites support only
+ * some dimensions (e.g. multiples of 5 for the mixed-integer suites).
+ *
+ * @param suite_name The name of the suite (see coco_suite for the supported names, "toy" is not supported).
+ * @param function The function number as used in the suite (e.g. 101-130 for the "bbob-noisy" suite).
+ * @param dimension The dimension.
+ * @param instance The instance number.
+ *
+ * @return The constructed problem or NULL if the suite is not known or does not contain the function.
+ */
+coco_problem_t *coco_get_suite_problem(const char *suite_name,
+                                       const size_t function,
+                                       const size_t dimension,
+                                       const size_t instance) {
+
+  const char *suite_names[] = { "bbob", "bbob-biobj", "bbob-biobj-ext", "bbob-largescale", "bbob-constrained",
+      "bbob-constrained-active-only", "bbob-constrained-no-disguise", "bbob-mixint", "bbob-biobj-mixint",
+      "bbob-noisy" };
+  const size_t dim_large_scale = 50; /* Mixed-integer suites use large-scale functions from this dimension on */
+  coco_suite_t *suite;
+  coco_problem_t *problem = NULL;
+  suite_biobj_new_inst_t *new_inst_data = NULL;
+  size_t i;
+  int found = 0;
+
+  for (i = 0; i < sizeof(suite_names) / sizeof(suite_names[0]); i++) {
+    if (strcmp(suite_name, suite_names[i]) == 0)
+      found = 1;
+  }
+  if (!found)
+    return NULL;
+
+  suite = coco_suite_intialize(suite_name);
+  found = 0;
+  for (i = 0; i < suite->number_of_functions; i++) {
+    if (suite->functions[i] == function)
+      found = 1;
+  }
+
+  if (!found) {
+    problem = NULL;
+  } else if (strcmp(suite_name, "bbob") == 0) {
+    problem = coco_get_bbob_problem(function, dimension, instance);
+  } else if ((strcmp(suite_name, "bbob-biobj") == 0) || (strcmp(suite_name, "bbob-biobj-ext") == 0)) {
+    problem = coco_get_biobj_problem(function, dimension, instance, coco_get_bbob_problem, &new_inst_data, 1,
+        suite->dimensions, suite->number_of_dimensions);
+  } else if (strncmp(suite_name, "bbob-constrained", 16) == 0) {
+    problem = coco_get_cons_bbob_problem(suite_name, function, dimension, instance);
+    /* Use the same problem_id and problem_name as suite_cons_bbob_get_problem */
+    coco_problem_set_id(problem, "%s_f%03lu_i%02lu_d%02lu",
+      suite_name, (unsigned long)function, (unsigned long)instance, (unsigned long)dimension);
+    coco_problem_set_name(problem, "%s suite problem f%lu instance %lu in %luD",
+      suite_name, (unsigned long)function, (unsigned long)instance, (unsigned long)dimension);
+  } else if (strcmp(suite_name, "bbob-largescale") == 0) {
+    problem = coco_get_largescale_problem(function, dimension, instance);
+  } else if (strcmp(suite_name, "bbob-mixint") == 0) {
+    problem = coco_get_bbob_mixint_problem(function, dimension, instance,
+        (dimension < dim_large_scale) ? coco_get_bbob_problem : coco_get_largescale_problem);
+  } else if (strcmp(suite_name, "bbob-biobj-mixint") == 0) {
+    problem = coco_get_biobj_mixint_problem(function, dimension, instance,
+        (dimension < dim_large_scale) ? coco_get_bbob_problem : coco_get_largescale_problem,
+        &new_inst_data, 1, suite->dimensions, suite->number_of_dimensions);
+  } else if (strcmp(suite_name, "bbob-noisy") == 0) {
+    problem = coco_get_bbob_noisy_problem(function, dimension, instance);
+  }
+
+  if (problem != NULL) {
+    problem->suite_dep_function = function;
+    problem->suite_dep_instance = instance;
+    problem->suite_dep_index = 0;
+  }
+
+  /* The new instance data (if any) is freed together with the suite */
+  suite->data = new_inst_data;
+  coco_suite_free(suite);
+  return problem;
+}
+
 
 /**
  * @brief Allocates the space for a coco_suite_t instance.
@@ -252,6 +339,12 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name,
   suite->current_instance_idx = -1;
   suite->current_problem = NULL;
 
+  /* To be set in coco_suite() */
+  suite->costs = NULL;
+  suite->order = NULL;
+  suite->number_of_ordered_problems = 0;
+  suite->current_order_position = -1;
+
   /* To be set in coco_suite_set_instance() */
   suite->number_of_instances = 0;
   suite->instances = NULL;
@@ -408,6 +501,14 @@ void coco_suite_free(coco_suite_t *suite) {
       coco_free_memory(suite->default_instances);
       suite->default_instances = NULL;
     }
+    if (suite->costs) {
+      coco_free_memory(suite->costs);
+      suite->costs = NULL;
+    }
+    if (suite->order) {
+      coco_free_memory(suite->order);
+      suite->order = NULL;
+    }
 
     if (suite->current_problem) {
       coco_problem_free(suite->current_problem);
@@ -635,6 +736,12 @@ static int coco_suite_is_next_dimension_found(coco_suite_t *suite) {
  * in the suite, and
  * - "instance_indices: VALUES", where VALUES is a list or a range of instance indices (starting from 1) to keep
  * in the suite.
+ * Further supported options define the order in which coco_suite_get_next_problem iterates the suite:
+ * - "order: VALUE", where VALUE is either "default" (by instances, then by functions and finally by
+ * dimensions) or "cost-desc" (by decreasing estimated cost, see coco_suite_get_problem_cost, so that the most
+ * expensive problems come first when the experiment is run in parallel), and
+ * - "cost_profile: FILE", where FILE is the profile.jsonl file of an earlier run (see the observer option
+ * "profile") from which the evaluation times of the problems are taken to estimate their cost.
  *
  * @return The constructed suite object.
  */
@@ -648,11 +755,14 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
   size_t *dimensions = NULL;
   long dim_found, dim_idx_found;
   int parce_dim = 1, parce_dim_idx = 1;
+  int order_by_cost = 0;
+  char *cost_profile = NULL;
 
   coco_option_keys_t *known_option_keys, *given_option_keys, *redundant_option_keys;
 
   /* Sets the valid keys for suite options and suite instance */
-  const char *known_keys_o[] = { "dimensions", "dimension_indices", "function_indices", "instance_indices" };
+  const char *known_keys_o[] = { "dimensions", "dimension_indices", "function_indices", "instance_indices",
+      "order", "cost_profile" };
   const char *known_keys_i[] = { "year", "instances" };
 
   /* Initialize the suite */
@@ -764,6 +874,17 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
     }
     coco_free_memory(option_string);
 
+    option_string = coco_allocate_string(COCO_PATH_MAX + 1);
+    if (coco_options_read_string(suite_options, "order", option_string) > 0) {
+      if (strcmp(option_string, "cost-desc") == 0)
+        order_by_cost = 1;
+      else if (strcmp(option_string, "default") != 0)
+        coco_warning("coco_suite(): unknown 'order' suite option value %s ignored", option_string);
+    }
+    if (coco_options_read_string(suite_options, "cost_profile", option_string) > 0)
+      cost_profile = coco_strdup(option_string);
+    coco_free_memory(option_string);
+
     /* Check for redundant option keys for suite options */
     known_option_keys = coco_option_keys_allocate(sizeof(known_keys_o) / sizeof(char *), known_keys_o);
     given_option_keys = coco_option_keys(suite_options);
@@ -800,6 +921,8 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
       || (suite->number_of_functions < 1)
       || (suite->number_of_instances < 1)) {
     coco_warning("coco_suite(): the suite does not contain at least one dimension, function and instance");
+    if (cost_profile != NULL)
+      coco_free_memory(cost_profile);
     return NULL;
   }
 
@@ -808,14 +931,23 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
   coco_suite_is_next_function_found(suite);
   coco_suite_is_next_dimension_found(suite);
 
+  suite->costs = coco_suite_order_get_costs(suite, cost_profile);
+  if (order_by_cost)
+    coco_suite_order_by_cost(suite);
+  if (cost_profile != NULL)
+    coco_free_memory(cost_profile);
+
   return suite;
 }
 
 /**
- * Iterates through the suite first by instances, then by functions and finally by dimensions.
- * The instances/functions/dimensions that have been filtered out using the suite_options of the coco_suite
- * function are skipped. Outputs some information regarding the current place in the iteration. The returned
- * problem is wrapped with the observer. If the observer is NULL, the returned problem is unobserved.
+ * Iterates through the suite first by instances, then by functions and finally by dimensions (or by the
+ * decreasing estimated cost of the problems if the suite option "order: cost-desc" is given). The
+ * instances/functions/dimensions that have been filtered out using the suite_options of the coco_suite
+ * function are skipped, as are the problems completed in an earlier run if the observer resumes an experiment
+ * (see the observer option "resume"). Outputs some information regarding the current place in the iteration.
+ * The returned problem is wrapped with the observer. If the observer is NULL, the returned problem is
+ * unobserved.
  *
  * @param suite The given suite.
  * @param observer The observer used to wrap the problem. If NULL, the problem is returned unobserved.
@@ -841,13 +973,22 @@ coco_problem_t *coco_suite_get_next_problem(coco_suite_t *suite, coco_observer_t
 
   /* Iterate through the suite by instances, then functions and lastly dimensions in search for the next
    * problem. Note that these functions set the values of suite fields current_instance_idx,
-   * current_function_idx and current_dimension_idx. */
-  if (!coco_suite_is_next_instance_found(suite)
-      && !coco_suite_is_next_function_found(suite)
-      && !coco_suite_is_next_dimension_found(suite)) {
-    coco_info_partial("done\n");
-    return NULL;
-  }
+   * current_function_idx and current_dimension_idx. The problems completed in an earlier run of a resumed
+   * experiment and the problems claimed by other workers of a work queue are skipped. */
+  do {
+    if ((suite->order != NULL) ? !coco_suite_is_next_ordered_problem_found(suite)
+        : (!coco_suite_is_next_instance_found(suite)
+        && !coco_suite_is_next_function_found(suite)
+        && !coco_suite_is_next_dimension_found(suite))) {
+      coco_info_partial("done\n");
+      return NULL;
+    }
+  } while ((observer != NULL) && (coco_observer_checkpoint_is_completed(observer->checkpoint,
+      suite->functions[suite->current_function_idx], suite->dimensions[suite->current_dimension_idx],
+      suite->instances[suite->current_instance_idx])
+      || !coco_work_queue_claim(observer->work_queue_folder, observer->result_folder,
+      suite->functions[suite->current_function_idx], suite->dimensions[suite->current_dimension_idx],
+      suite->instances[suite->current_instance_idx])));
 
   if (suite->current_problem) {
     coco_problem_free(suite->current_problem);
@@ -935,3 +1076,54 @@ void coco_suite_decode_problem_index(const coco_suite_t *suite,
   *dimension_idx = problem_index / (suite->number_of_instances * suite->number_of_functions);
 
 }
+
+/**
+ * The cost of a problem is estimated from its dimension, its function and the measured evaluation times given
+ * by the suite option "cost_profile" (see coco_suite_order.c for the model). Only the relative costs of the
+ * problems are meaningful, for example to distribute them among workers by longest processing time first.
+ *
+ * @param suite The suite.
+ * @param problem_index Index of the problem in the suite (starting with 0).
+ *
+ * @return The estimated cost of the problem with problem_index (0 if problem_index is too large).
+ */
+double coco_suite_get_problem_cost(const coco_suite_t *suite, const size_t problem_index) {
+
+  size_t function_idx = 0, dimension_idx = 0, instance_idx = 0;
+
+  if (problem_index >= coco_suite_get_number_of_problems(suite))
+    return 0;
+  coco_suite_decode_problem_index(suite, problem_index, &function_idx, &dimension_idx, &instance_idx);
+  return suite->costs[dimension_idx * suite->number_of_functions + function_idx];
+}
+
+/**
+ * The order is the one in which coco_suite_get_next_problem iterates the suite (see the suite option "order"),
+ * so that the problem_index can be passed to coco_suite_get_problem or coco_suite_decode_problem_index.
+ * Problems that have been filtered out are not part of the order.
+ *
+ * @param suite The suite.
+ * @param position The position of the problem in the order (starting with 0).
+ *
+ * @return The index of the problem at the given position or coco_suite_get_number_of_problems(suite) if the
+ * suite has no more problems.
+ */
+size_t coco_suite_get_ordered_problem_index(const coco_suite_t *suite, const size_t position) {
+
+  size_t function_idx = 0, dimension_idx = 0, instance_idx = 0, problem_index, count = 0;
+
+  if (suite->order != NULL)
+    return (position < suite->number_of_ordered_problems) ? suite->order[position]
+        : coco_suite_get_number_of_problems(suite);
+
+  /* The default order is the order of the problem indices */
+  for (problem_index = 0; problem_index < coco_suite_get_number_of_problems(suite); problem_index++) {
+    coco_suite_decode_problem_index(suite, problem_index, &function_idx, &dimension_idx, &instance_idx);
+    if ((suite->functions[function_idx] == 0) || (suite->dimensions[dimension_idx] == 0)
+        || (suite->instances[instance_idx] == 0))
+      continue;
+    if (count++ == position)
+      return problem_index;
+  }
+  return coco_suite_get_number_of_problems(suite);
+}
@@ -0,0 +1,207 @@
+/**
+ * @file coco_suite_order.c
+ * @brief Estimation of the cost of the problems of a suite and the order of iteration by cost.
+ *
+ * The cost of running a problem of function f in dimension d is estimated as d * t(f, d), that is, the
+ * budget (which is proportional to the dimension) times the time of one evaluation. The time t(f, d) is
+ * taken from the profile of an earlier run (the file profile.jsonl written by the observer option
+ * "profile: 1" with COCO compiled with -DCOCO_PROFILE) as the mean time per evaluation of the problems of
+ * f in dimension d. Otherwise it is estimated as s(f) * d * d, which is the cost of a full rotation, where
+ * s(f) is the mean of t(f, d) / (d * d) over the measured dimensions of f (over all measured problems if f
+ * was not measured and 1 if there is no profile).
+ *
+ * The problem index given by coco_suite_encode_problem_index does not depend on the order, so that the
+ * problems (and their output) stay the same however the suite is iterated.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+#include "transform_vars_permutation_helpers.c"
+
+/**
+ * @brief Reads the mean time per evaluation of the problems of each function and dimension of the suite from
+ * the given profile file into times (the sums of the times and their number in counts).
+ *
+ * Returns the number of problems whose time was read.
+ */
+static size_t coco_suite_order_read_profile(const coco_suite_t *suite,
+                                            const char *file_name,
+                                            double *times,
+                                            size_t *counts) {
+  char line[4096], *id, *position;
+  unsigned long function, instance, dimension, evaluations;
+  double ticks;
+  size_t function_idx, dimension_idx, number_of_problems = 0;
+  FILE *file;
+  int c;
+
+  file = fopen(file_name, "r");
+  if (file == NULL) {
+    coco_warning("coco_suite_order_read_profile(): failed to open file '%s'", file_name);
+    return 0;
+  }
+
+  while (fgets(line, sizeof(line), file) != NULL) {
+    /* Only the start of a line with the problem id and the outermost stage is needed */
+    if (strchr(line, '\n') == NULL) {
+      do {
+        c = fgetc(file);
+      } while ((c != '\n') && (c != EOF));
+    }
+
+    id = strstr(line, "\"problem_id\": \"");
+    if (id == NULL)
+      continue;
+    for (position = strstr(id, "_f"); position != NULL; position = strstr(position + 2, "_f")) {
+      if (sscanf(position, "_f%lu_i%lu_d%lu", &function, &instance, &dimension) == 3)
+        break;
+    }
+    if ((position == NULL) || ((position = strstr(line, "\"evaluations\": ")) == NULL)
+        || (sscanf(position, "\"evaluations\": %lu, \"ticks\": %lf", &evaluations, &ticks) != 2)
+        || (evaluations == 0) || (ticks <= 0))
+      continue;
+
+    for (function_idx = 0; function_idx < suite->number_of_functions; function_idx++) {
+      if (suite->functions[function_idx] == function)
+        break;
+    }
+    for (dimension_idx = 0; dimension_idx < suite->number_of_dimensions; dimension_idx++) {
+      if (suite->dimensions[dimension_idx] == dimension)
+        break;
+    }
+    if ((function_idx == suite->number_of_functions) || (dimension_idx == suite->number_of_dimensions))
+      continue;
+
+    times[dimension_idx * suite->number_of_functions + function_idx] += ticks / (double) evaluations;
+    counts[dimension_idx * suite->number_of_functions + function_idx]++;
+    number_of_problems++;
+  }
+  fclose(file);
+
+  if (number_of_problems == 0)
+    coco_warning("coco_suite_order_read_profile(): no evaluation times found in '%s' (was COCO compiled with "
+        "-DCOCO_PROFILE?)", file_name);
+  return number_of_problems;
+}
+
+/**
+ * @brief Returns the estimated costs of the problems of each function and dimension of the suite (the cost
+ * of function_idx in dimension_idx is at dimension_idx * number_of_functions + function_idx).
+ *
+ * The times are read from the given profile file if it is not NULL.
+ */
+static double *coco_suite_order_get_costs(const coco_suite_t *suite, const char *profile_file_name) {
+  const size_t number_of_costs = suite->number_of_dimensions * suite->number_of_functions;
+  double *costs, *times, scale, all_scale = 0, function_scale, dimension;
+  size_t *counts, function_idx, dimension_idx, i, count, all_count = 0;
+
+  costs = coco_allocate_vector(number_of_costs);
+  times = coco_allocate_vector(number_of_costs);
+  counts = coco_allocate_vector_size_t(number_of_costs);
+  for (i = 0; i < number_of_costs; i++) {
+    times[i] = 0;
+    counts[i] = 0;
+  }
+  if (profile_file_name != NULL)
+    coco_suite_order_read_profile(suite, profile_file_name, times, counts);
+
+  /* The scale of the times of all measured problems */
+  for (i = 0; i < number_of_costs; i++) {
+    if (counts[i] > 0) {
+      dimension = (double) suite->dimensions[i / suite->number_of_functions];
+      all_scale += times[i] / (double) counts[i] / (dimension * dimension);
+      all_count++;
+    }
+  }
+  all_scale = (all_count > 0) ? all_scale / (double) all_count : 1;
+
+  for (function_idx = 0; function_idx < suite->number_of_functions; function_idx++) {
+    /* The scale of the times of the measured problems of this function */
+    function_scale = 0;
+    count = 0;
+    for (dimension_idx = 0; dimension_idx < suite->number_of_dimensions; dimension_idx++) {
+      i = dimension_idx * suite->number_of_functions + function_idx;
+      if (counts[i] > 0) {
+        dimension = (double) suite->dimensions[dimension_idx];
+        function_scale += times[i] / (double) counts[i] / (dimension * dimension);
+        count++;
+      }
+    }
+    scale = (count > 0) ? function_scale / (double) count : all_scale;
+
+    for (dimension_idx = 0; dimension_idx < suite->number_of_dimensions; dimension_idx++) {
+      i = dimension_idx * suite->number_of_functions + function_idx;
+      dimension = (double) suite->dimensions[dimension_idx];
+      if (counts[i] > 0)
+        costs[i] = dimension * times[i] / (double) counts[i];
+      else
+        costs[i] = dimension * scale * dimension * dimension;
+    }
+  }
+
+  coco_free_memory(times);
+  coco_free_memory(counts);
+  return costs;
+}
+
+/**
+ * @brief Sets the order of iteration of the suite to the decreasing estimated cost of its problems.
+ *
+ * Problems of equal cost are ordered by their problem index, so that the order is deterministic.
+ */
+static void coco_suite_order_by_cost(coco_suite_t *suite) {
+  size_t function_idx = 0, dimension_idx = 0, instance_idx = 0, problem_index, i;
+  size_t *problem_indices, *permutation;
+  double *keys;
+
+  problem_indices = coco_allocate_vector_size_t(coco_suite_get_number_of_problems(suite));
+  keys = coco_allocate_vector(coco_suite_get_number_of_problems(suite));
+  suite->number_of_ordered_problems = 0;
+  for (problem_index = 0; problem_index < coco_suite_get_number_of_problems(suite); problem_index++) {
+    coco_suite_decode_problem_index(suite, problem_index, &function_idx, &dimension_idx, &instance_idx);
+    if ((suite->functions[function_idx] == 0) || (suite->dimensions[dimension_idx] == 0)
+        || (suite->instances[instance_idx] == 0))
+      continue;
+    problem_indices[suite->number_of_ordered_problems] = problem_index;
+    keys[suite->number_of_ordered_problems] = -coco_suite_get_problem_cost(suite, problem_index);
+    suite->number_of_ordered_problems++;
+  }
+
+  permutation = coco_allocate_vector_size_t(suite->number_of_ordered_problems);
+  coco_compute_permutation_from_keys(permutation, keys, suite->number_of_ordered_problems);
+  suite->order = coco_allocate_vector_size_t(suite->number_of_ordered_problems);
+  for (i = 0; i < suite->number_of_ordered_problems; i++)
+    suite->order[i] = problem_indices[permutation[i]];
+  suite->current_order_position = -1;
+
+  coco_free_memory(problem_indices);
+  coco_free_memory(keys);
+  coco_free_memory(permutation);
+}
+
+/**
+ * @brief Moves to the next problem in the order of the suite and sets the current indices accordingly.
+ *
+ * Returns 1 if such a problem is found and 0 if the end of the order is reached (in which case the next
+ * call starts again at the first problem).
+ */
+static int coco_suite_is_next_ordered_problem_found(coco_suite_t *suite) {
+  size_t function_idx = 0, dimension_idx = 0, instance_idx = 0;
+
+  suite->current_order_position++;
+  if (suite->current_order_position >= (long) suite->number_of_ordered_problems) {
+    suite->current_order_position = -1;
+    return 0;
+  }
+  coco_suite_decode_problem_index(suite, suite->order[suite->current_order_position], &function_idx,
+      &dimension_idx, &instance_idx);
+  suite->current_function_idx = (long) function_idx;
+  suite->current_dimension_idx = (long) dimension_idx;
+  suite->current_instance_idx = (long) instance_idx;
+  return 1;
+}
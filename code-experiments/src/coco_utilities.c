@@ -512,6 +512,40 @@ static double *coco_duplicate_vector(const double *src, const size_t number_of_e
   }
   return dst;
 }
+
+/**
+ * @brief Registers one more owner of read-only data shared between a problem and its clones.
+ *
+ * The number of owners is only allocated when the data is shared for the first time (NULL stands for a
+ * single owner), so that problems that are never cloned are not affected. All owners point to the same
+ * number of owners.
+ *
+ * @note The number of owners is not updated atomically, so clones must be created and freed by one thread
+ * at a time.
+ */
+static void coco_shared_references_increase(size_t **number_of_owners) {
+  if (*number_of_owners == NULL) {
+    *number_of_owners = coco_allocate_vector_size_t(1);
+    **number_of_owners = 1;
+  }
+  (**number_of_owners)++;
+}
+
+/**
+ * @brief Unregisters one owner of read-only data shared between a problem and its clones. Returns 1 if it
+ * was the last owner (that must free the data) and 0 otherwise.
+ */
+static int coco_shared_references_decrease(size_t **number_of_owners) {
+  if (*number_of_owners == NULL)
+    return 1;
+  assert(**number_of_owners > 0);
+  (**number_of_owners)--;
+  if (**number_of_owners > 0)
+    return 0;
+  coco_free_memory(*number_of_owners);
+  *number_of_owners = NULL;
+  return 1;
+}
 /**@}*/
 
 /***********************************************************************************************************/
@@ -1266,3 +1300,88 @@ static int coco_vector_is_zero(const double *x, const size_t dim) {
 /**@}*/
 
 /***********************************************************************************************************/
+
+/**
+ * @name Methods regarding parallel execution
+ */
+/**@{*/
+
+/**
+ * @brief The signature of a task run by coco_run_tasks(). The tasks must be independent of each other.
+ */
+typedef void (*coco_task_function_t)(void *data, const size_t task);
+
+#if defined(HAVE_PTHREAD)
+/**
+ * @brief The data shared by the threads of coco_run_tasks().
+ */
+typedef struct {
+  coco_task_function_t task_function; /**< @brief The function run for each task. */
+  void *data;                         /**< @brief The data passed to the task function. */
+  size_t number_of_tasks;             /**< @brief The number of tasks. */
+  size_t next_task;                   /**< @brief The next task that has not been started yet. */
+  pthread_mutex_t mutex;              /**< @brief The mutex guarding next_task. */
+} coco_tasks_t;
+
+/**
+ * @brief Runs tasks until none are left (executed by each thread of coco_run_tasks()).
+ */
+static void *coco_run_tasks_thread(void *stuff) {
+
+  coco_tasks_t *tasks = (coco_tasks_t *) stuff;
+  size_t task;
+
+  while (1) {
+    pthread_mutex_lock(&tasks->mutex);
+    task = tasks->next_task++;
+    pthread_mutex_unlock(&tasks->mutex);
+    if (task >= tasks->number_of_tasks)
+      break;
+    tasks->task_function(tasks->data, task);
+  }
+  return NULL;
+}
+#endif
+
+/**
+ * @brief Runs task_function(data, task) for task = 0, ..., number_of_tasks - 1.
+ *
+ * When compiled with COCO_USE_THREADS, the tasks are distributed among as many threads as there are online
+ * processors (the calling thread included). Otherwise, or if the threads cannot be created, they are run
+ * sequentially in the given order.
+ */
+static void coco_run_tasks(coco_task_function_t task_function, void *data, const size_t number_of_tasks) {
+
+  size_t i;
+#if defined(HAVE_PTHREAD)
+  coco_tasks_t tasks;
+  pthread_t *threads;
+  size_t number_of_threads = 0;
+  long number_of_processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+  if ((number_of_processors > 1) && (number_of_tasks > 1)) {
+    tasks.task_function = task_function;
+    tasks.data = data;
+    tasks.number_of_tasks = number_of_tasks;
+    tasks.next_task = 0;
+    pthread_mutex_init(&tasks.mutex, NULL);
+    threads = (pthread_t *) coco_allocate_memory((size_t) number_of_processors * sizeof(pthread_t));
+    for (i = 0; (i < (size_t) number_of_processors - 1) && (i < number_of_tasks - 1); i++) {
+      if (pthread_create(&threads[i], NULL, coco_run_tasks_thread, &tasks) != 0)
+        break;
+      number_of_threads++;
+    }
+    coco_run_tasks_thread(&tasks);
+    for (i = 0; i < number_of_threads; i++)
+      pthread_join(threads[i], NULL);
+    coco_free_memory(threads);
+    pthread_mutex_destroy(&tasks.mutex);
+    return;
+  }
+#endif
+  for (i = 0; i < number_of_tasks; i++)
+    task_function(data, i);
+}
+/**@}*/
+
+/***********************************************************************************************************/
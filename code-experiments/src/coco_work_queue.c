@@ -0,0 +1,784 @@
+/**
+ * @file coco_work_queue.c
+ * @brief Distribution of the problems of a suite among several workers through a shared folder.
+ *
+ * If the observer option "work_queue" is set, the result folder is shared by all workers (processes on the
+ * same or on different machines that run the same experiment). Each worker writes its output into its own
+ * sub-folder worker-NNNN of the shared folder and claims each problem before running it by creating the
+ * folder queue/fF_dD_iI in the shared folder. Creating a folder either succeeds or fails at once on all
+ * common file systems, so that no locks are needed and each problem is claimed by exactly one worker.
+ * The claiming worker leaves an empty file with its name in the claimed folder, so that it can resume its
+ * problems after an interruption.
+ *
+ * Once all workers are finished, coco_observer_merge_workers merges the output of the workers into a single
+ * result folder that looks as if the experiment had been run by one process (see there).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+#include "coco_observer_checkpoint.c"
+
+/**
+ * @brief Returns the (allocated) path of the given name in the given folder.
+ */
+static char *coco_work_queue_get_path(const char *folder, const char *name) {
+  char *path;
+
+  path = coco_allocate_string(COCO_PATH_MAX + 1);
+  memcpy(path, folder, strlen(folder) + 1);
+  coco_join_path(path, COCO_PATH_MAX, name, NULL);
+  return path;
+}
+
+/**
+ * @brief Creates the first worker folder worker-NNNN in the shared folder that does not exist yet and returns
+ * its (allocated) path (the queue folder is created as well).
+ */
+static char *coco_work_queue_create_worker_folder(const char *folder) {
+  char *name, *path;
+  unsigned long worker;
+
+  path = coco_work_queue_get_path(folder, "queue");
+  coco_create_directory(path);
+  coco_free_memory(path);
+  for (worker = 1; worker <= 9999; worker++) {
+    name = coco_strdupf("worker-%04lu", worker);
+    path = coco_work_queue_get_path(folder, name);
+    coco_free_memory(name);
+    if (coco_mkdir(path) == 0)
+      return path;
+    coco_free_memory(path);
+  }
+  coco_error("coco_work_queue_create_worker_folder(): too many workers in %s", folder);
+  return NULL; /* Never reached */
+}
+
+/**
+ * @brief Claims the problem with the given function, dimension and instance for the worker that writes into
+ * worker_folder and returns 1 if it succeeds or if the worker claimed the problem before (0 if another worker
+ * claimed it). Always returns 1 if work_queue_folder is NULL.
+ */
+static int coco_work_queue_claim(const char *work_queue_folder,
+                                 const char *worker_folder,
+                                 const size_t function,
+                                 const size_t dimension,
+                                 const size_t instance) {
+  char *name, *claim_path, *owner_path;
+  const char *worker_name;
+  int is_claimed;
+  FILE *file;
+
+  if (work_queue_folder == NULL)
+    return 1;
+
+  name = coco_strdupf("f%lu_d%lu_i%lu", (unsigned long) function, (unsigned long) dimension,
+      (unsigned long) instance);
+  claim_path = coco_work_queue_get_path(work_queue_folder, "queue");
+  coco_join_path(claim_path, COCO_PATH_MAX, name, NULL);
+  worker_name = worker_folder + strlen(work_queue_folder) + 1;
+  owner_path = coco_work_queue_get_path(claim_path, worker_name);
+
+  if (coco_mkdir(claim_path) == 0) {
+    file = fopen(owner_path, "w");
+    if ((file == NULL) || (fclose(file) != 0))
+      coco_error("coco_work_queue_claim(): failed to create file '%s'", owner_path);
+    is_claimed = 1;
+  } else {
+    is_claimed = coco_file_exists(owner_path);
+  }
+
+  coco_free_memory(name);
+  coco_free_memory(claim_path);
+  coco_free_memory(owner_path);
+  return is_claimed;
+}
+
+/***********************************************************************************************************/
+
+/**
+ * @name Methods for merging the output of the workers
+ */
+/**@{*/
+
+/**
+ * @brief A group of problems of one function and dimension in a merged info file.
+ *
+ * The info files of the bbob logger have one block per line of problems, consisting of a header line,
+ * comment lines and a line with the data file and the entries of the problems. The info files of the
+ * bbob-biobj logger have one header and comment lines followed by one line per function and dimension with
+ * the data file and the entries of the problems.
+ */
+typedef struct {
+  char *info_file;          /**< @brief The info file (relative to the result folder) */
+  char *header;             /**< @brief The header line */
+  char *comments;           /**< @brief The comment lines (each one preceded by a new line) */
+  char *key;                /**< @brief The start of the line of problems (up to their entries) */
+  size_t function;          /**< @brief The function of the problems */
+  size_t dimension;         /**< @brief The dimension of the problems */
+  char **entries;           /**< @brief The entries of the problems, each one preceded by ", " */
+  size_t *instances;        /**< @brief The instances of the entries */
+  size_t number_of_entries; /**< @brief Number of entries */
+  size_t max_number_of_entries; /**< @brief Number of entries that fit into the arrays */
+  int is_bbob;              /**< @brief Whether the group is written in the format of the bbob logger */
+} coco_work_queue_group_t;
+
+/**
+ * @brief The part of a worker file that was written by one problem.
+ */
+typedef struct {
+  size_t function;          /**< @brief The function of the problem */
+  size_t dimension;         /**< @brief The dimension of the problem */
+  size_t instance;          /**< @brief The instance of the problem */
+  char *source;             /**< @brief The path of the worker file */
+  char *destination;        /**< @brief The path of the merged file (relative to the merged folder) */
+  long start;               /**< @brief The position of the part in the worker file */
+  long end;                 /**< @brief The position after the part in the worker file */
+} coco_work_queue_chunk_t;
+
+/**
+ * @brief The position of a problem (or of a group of problems) in the order of the merged output.
+ */
+typedef struct {
+  size_t dimension;         /**< @brief The dimension */
+  size_t function;          /**< @brief The function */
+  size_t instance;          /**< @brief The instance */
+  size_t index;             /**< @brief The position before sorting (keeps the order of equal problems) */
+} coco_work_queue_order_t;
+
+/**
+ * @brief The output of the workers while it is merged.
+ */
+typedef struct {
+  const char *merged_folder;          /**< @brief The merged result folder */
+  coco_work_queue_group_t *groups;    /**< @brief The groups of problems in the merged info files */
+  size_t number_of_groups;            /**< @brief Number of groups */
+  size_t max_number_of_groups;        /**< @brief Number of groups that fit into the array */
+  coco_work_queue_chunk_t *chunks;    /**< @brief The parts of the worker files that are merged */
+  size_t number_of_chunks;            /**< @brief Number of chunks */
+  size_t max_number_of_chunks;        /**< @brief Number of chunks that fit into the array */
+  size_t *problems;                   /**< @brief The function, dimension and instance of the merged problems */
+  size_t number_of_problems;          /**< @brief Number of merged problems */
+  size_t max_number_of_problems;      /**< @brief Number of problems that fit into the array */
+} coco_work_queue_merge_t;
+
+/**
+ * @brief Returns 1 if the file with the given path is an info file and 0 otherwise.
+ */
+static int coco_work_queue_is_info_file(const char *path) {
+  size_t length = strlen(path);
+  return (length >= 5) && (strcmp(path + length - 5, ".info") == 0);
+}
+
+/**
+ * @brief Orders by dimension, function, instance and then by the position before sorting.
+ */
+static int coco_work_queue_compare_order(const void *a, const void *b) {
+  const coco_work_queue_order_t *order_a = (const coco_work_queue_order_t *) a;
+  const coco_work_queue_order_t *order_b = (const coco_work_queue_order_t *) b;
+
+  if (order_a->dimension != order_b->dimension)
+    return (order_a->dimension < order_b->dimension) ? -1 : 1;
+  if (order_a->function != order_b->function)
+    return (order_a->function < order_b->function) ? -1 : 1;
+  if (order_a->instance != order_b->instance)
+    return (order_a->instance < order_b->instance) ? -1 : 1;
+  if (order_a->index != order_b->index)
+    return (order_a->index < order_b->index) ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Returns the size of the worker file with the given path that is merged (the whole file if it is not
+ * written by an interrupted problem) or -1 if nothing is merged.
+ */
+static long coco_work_queue_get_merged_size(const char *worker_folder,
+                                            const char *relative_path,
+                                            const coco_observer_checkpoint_files_t *pending_files) {
+  char *path;
+  size_t i;
+  long size;
+
+  path = coco_work_queue_get_path(worker_folder, relative_path);
+  size = coco_observer_checkpoint_get_file_size(path);
+  coco_free_memory(path);
+  /* The first recorded size is the one before the interrupted problem */
+  i = coco_observer_checkpoint_files_find(pending_files, relative_path);
+  if ((i < pending_files->count) && (pending_files->sizes[i] < size))
+    size = pending_files->sizes[i];
+  return size;
+}
+
+/**
+ * @brief Appends the bytes from start to end of the file with the given source path to the file with the
+ * given destination path (creating its folder if needed).
+ */
+static void coco_work_queue_append_file(const char *destination_path,
+                                        const char *source_path,
+                                        const long start,
+                                        const long end) {
+  char buffer[8192];
+  char *folder, *separator;
+  FILE *source, *destination;
+  long remaining = end - start;
+  size_t count;
+
+  folder = coco_strdup(destination_path);
+  separator = strrchr(folder, coco_path_separator[0]);
+  if ((separator == NULL) || ((strrchr(folder, '/') != NULL) && (strrchr(folder, '/') > separator)))
+    separator = strrchr(folder, '/');
+  if (separator != NULL) {
+    *separator = '\0';
+    coco_create_directory(folder);
+  }
+  coco_free_memory(folder);
+
+  destination = fopen(destination_path, "ab");
+  if (destination == NULL)
+    coco_error("coco_work_queue_append_file(): failed to open file '%s'", destination_path);
+  if (remaining > 0) {
+    source = fopen(source_path, "rb");
+    if ((source == NULL) || (fseek(source, start, SEEK_SET) != 0))
+      coco_error("coco_work_queue_append_file(): failed to open file '%s'", source_path);
+    while (remaining > 0) {
+      count = fread(buffer, 1, remaining < (long) sizeof(buffer) ? (size_t) remaining : sizeof(buffer), source);
+      if ((count == 0) || (fwrite(buffer, 1, count, destination) != count))
+        coco_error("coco_work_queue_append_file(): failed to append '%s' to '%s'", source_path, destination_path);
+      remaining -= (long) count;
+    }
+    fclose(source);
+  }
+  if (fclose(destination) != 0)
+    coco_error("coco_work_queue_append_file(): failed to write file '%s'", destination_path);
+}
+
+/**
+ * @brief Reads the first size bytes of the file with the given path into an (allocated) string.
+ */
+static char *coco_work_queue_read_file(const char *path, const long size) {
+  char *content;
+  FILE *file;
+
+  content = coco_allocate_string((size_t) size + 1);
+  file = fopen(path, "rb");
+  if ((file == NULL) || (fread(content, 1, (size_t) size, file) != (size_t) size))
+    coco_error("coco_work_queue_read_file(): failed to read file '%s'", path);
+  fclose(file);
+  content[size] = '\0';
+  return content;
+}
+
+/**
+ * @brief Adds the parts of the worker files (except for the info files) that were written by the completed
+ * problems of the worker to the chunks of the merge.
+ *
+ * The journal of the worker records the size of each file before a problem writes to it, so that the part
+ * of a problem ends where the next problem starts to write to the same file (or at the merged size).
+ */
+static void coco_work_queue_merge_read_chunks(coco_work_queue_merge_t *merge,
+                                              const char *worker_folder,
+                                              const coco_observer_checkpoint_t *checkpoint,
+                                              const coco_observer_checkpoint_files_t *pending_files) {
+  const size_t line_size = 2 * COCO_PATH_MAX + 128;
+  coco_observer_checkpoint_files_t *next_starts;
+  coco_work_queue_chunk_t *chunk, *chunks;
+  char *line, *path;
+  size_t length, function = 0, dimension = 0, instance = 0, first_chunk, problem_chunk = 0, i, j;
+  long size;
+  int is_started = 0;
+  FILE *file;
+
+  first_chunk = merge->number_of_chunks;
+  file = fopen(checkpoint->file_name, "rb");
+  if (file == NULL)
+    return;
+  line = coco_allocate_string(line_size);
+  while (fgets(line, (int) line_size, file) != NULL) {
+    length = strlen(line);
+    if ((length == 0) || (line[length - 1] != '\n'))
+      break; /* The last line was not written completely */
+    while ((length > 0) && ((line[length - 1] == '\n') || (line[length - 1] == '\r')))
+      line[--length] = '\0';
+
+    if (strncmp(line, "start ", 6) == 0) {
+      coco_observer_checkpoint_parse_problem(line + 6, &function, &dimension, &instance);
+      problem_chunk = merge->number_of_chunks;
+      is_started = 1;
+    } else if ((strncmp(line, "file ", 5) == 0) && is_started) {
+      if ((sscanf(line + 5, "%ld", &size) != 1) || ((path = strchr(line + 5, ' ')) == NULL))
+        continue;
+      path++;
+      if (coco_work_queue_is_info_file(path))
+        continue; /* The info files are merged by their groups */
+      if (merge->number_of_chunks == merge->max_number_of_chunks) {
+        merge->max_number_of_chunks = 2 * merge->max_number_of_chunks + 16;
+        chunks = (coco_work_queue_chunk_t *) coco_allocate_memory(merge->max_number_of_chunks * sizeof(*chunks));
+        if (merge->number_of_chunks > 0) {
+          memcpy(chunks, merge->chunks, merge->number_of_chunks * sizeof(*chunks));
+          coco_free_memory(merge->chunks);
+        }
+        merge->chunks = chunks;
+      }
+      chunk = &merge->chunks[merge->number_of_chunks++];
+      chunk->function = function;
+      chunk->dimension = dimension;
+      chunk->instance = instance;
+      chunk->source = coco_work_queue_get_path(worker_folder, path);
+      chunk->destination = coco_strdup(path);
+      chunk->start = (size > 0) ? size : 0;
+    } else if (strncmp(line, "done ", 5) == 0) {
+      is_started = 0;
+    }
+  }
+  fclose(file);
+  coco_free_memory(line);
+
+  /* The parts written by an interrupted problem are left out */
+  if (is_started) {
+    for (i = problem_chunk; i < merge->number_of_chunks; i++) {
+      coco_free_memory(merge->chunks[i].source);
+      coco_free_memory(merge->chunks[i].destination);
+    }
+    merge->number_of_chunks = problem_chunk;
+  }
+
+  /* Going backwards, next_starts holds the start of the next part of each file */
+  next_starts = coco_observer_checkpoint_files();
+  for (i = merge->number_of_chunks; i > first_chunk; i--) {
+    chunk = &merge->chunks[i - 1];
+    j = coco_observer_checkpoint_files_find(next_starts, chunk->destination);
+    if (j < next_starts->count) {
+      chunk->end = next_starts->sizes[j];
+      next_starts->sizes[j] = chunk->start;
+    } else {
+      chunk->end = coco_work_queue_get_merged_size(worker_folder, chunk->destination, pending_files);
+      coco_observer_checkpoint_files_add(next_starts, chunk->destination, chunk->start);
+    }
+    if (chunk->end < chunk->start)
+      chunk->end = chunk->start;
+  }
+  coco_observer_checkpoint_files_free(next_starts);
+}
+
+/**
+ * @brief Returns the group of the merged info file with the given header and key, which is added if it does
+ * not exist yet (the key is ignored for info files of the bbob logger, whose groups are told apart by their
+ * header).
+ */
+static coco_work_queue_group_t *coco_work_queue_merge_get_group(coco_work_queue_merge_t *merge,
+                                                                const char *info_file,
+                                                                const char *header,
+                                                                const char *comments,
+                                                                const char *key,
+                                                                const int is_bbob) {
+  coco_work_queue_group_t *group, *groups;
+  const char *position;
+  char *name, *path;
+  unsigned long function = 0, dimension = 0;
+  size_t i;
+
+  for (i = 0; i < merge->number_of_groups; i++) {
+    group = &merge->groups[i];
+    if ((strcmp(group->info_file, info_file) == 0) && (strcmp(group->header, header) == 0)
+        && (is_bbob || (strcmp(group->key, key) == 0)))
+      return group;
+  }
+
+  if (merge->number_of_groups == merge->max_number_of_groups) {
+    merge->max_number_of_groups = 2 * merge->max_number_of_groups + 16;
+    groups = (coco_work_queue_group_t *) coco_allocate_memory(merge->max_number_of_groups * sizeof(*groups));
+    if (merge->number_of_groups > 0) {
+      memcpy(groups, merge->groups, merge->number_of_groups * sizeof(*groups));
+      coco_free_memory(merge->groups);
+    }
+    merge->groups = groups;
+  }
+  group = &merge->groups[merge->number_of_groups++];
+  group->info_file = coco_strdup(info_file);
+  group->header = coco_strdup(header);
+  group->comments = coco_strdup(comments);
+  group->key = coco_strdup(key);
+  group->entries = NULL;
+  group->instances = NULL;
+  group->number_of_entries = 0;
+  group->max_number_of_entries = 0;
+  group->is_bbob = is_bbob;
+
+  /* The function and dimension are given in the header (bbob) or in the key (bbob-biobj) */
+  if (is_bbob) {
+    if ((position = strstr(header, "funcId = ")) != NULL)
+      sscanf(position, "funcId = %lu", &function);
+    if ((position = strstr(header, "DIM = ")) != NULL)
+      sscanf(position, "DIM = %lu", &dimension);
+  } else {
+    if ((position = strstr(key, "function = ")) != NULL)
+      sscanf(position, "function = %lu, dim = %lu", &function, &dimension);
+  }
+  group->function = (size_t) function;
+  group->dimension = (size_t) dimension;
+
+  /* The data files of a bbob group are merged under a name that is not used by another group */
+  if (is_bbob) {
+    coco_free_memory(group->key);
+    group->key = coco_remove_from_string(key, ".dat", "");
+    coco_create_unique_filename(merge->merged_folder, &group->key, ".dat");
+    /* The name is taken by creating the (empty) data file, to which the chunks are appended later */
+    name = coco_strdupf("%s.dat", group->key);
+    path = coco_work_queue_get_path(merge->merged_folder, name);
+    coco_work_queue_append_file(path, path, 0, 0);
+    coco_free_memory(name);
+    coco_free_memory(path);
+  }
+  return group;
+}
+
+/**
+ * @brief Adds the given entries of problems (each one preceded by ", ") to the group.
+ */
+static void coco_work_queue_group_add_entries(coco_work_queue_group_t *group, char *entries) {
+  char *entry, *next_entry, **new_entries;
+  size_t *new_instances;
+
+  for (entry = entries; (entry != NULL) && (*entry != '\0'); entry = next_entry) {
+    /* An entry ends at the next ", " followed by a digit */
+    for (next_entry = strstr(entry + 2, ", "); next_entry != NULL; next_entry = strstr(next_entry + 2, ", ")) {
+      if ((next_entry[2] >= '0') && (next_entry[2] <= '9'))
+        break;
+    }
+    if (group->number_of_entries == group->max_number_of_entries) {
+      group->max_number_of_entries = 2 * group->max_number_of_entries + 16;
+      new_entries = (char **) coco_allocate_memory(group->max_number_of_entries * sizeof(char *));
+      new_instances = coco_allocate_vector_size_t(group->max_number_of_entries);
+      if (group->number_of_entries > 0) {
+        memcpy(new_entries, group->entries, group->number_of_entries * sizeof(char *));
+        memcpy(new_instances, group->instances, group->number_of_entries * sizeof(size_t));
+        coco_free_memory(group->entries);
+        coco_free_memory(group->instances);
+      }
+      group->entries = new_entries;
+      group->instances = new_instances;
+    }
+    if (next_entry == NULL) {
+      group->entries[group->number_of_entries] = coco_strdup(entry);
+    } else {
+      group->entries[group->number_of_entries] = coco_allocate_string((size_t) (next_entry - entry) + 1);
+      memcpy(group->entries[group->number_of_entries], entry, (size_t) (next_entry - entry));
+      group->entries[group->number_of_entries][next_entry - entry] = '\0';
+    }
+    group->instances[group->number_of_entries] = (size_t) strtoul(entry + 2, NULL, 10);
+    group->number_of_entries++;
+  }
+}
+
+/**
+ * @brief Merges the info file of a worker (of which size bytes are merged) into the groups of the merged info
+ * files. The chunks of the data files of the bbob logger (from first_chunk on) are given the data files of
+ * their groups as destinations.
+ */
+static void coco_work_queue_merge_info_file(coco_work_queue_merge_t *merge,
+                                            const char *worker_folder,
+                                            const char *info_file,
+                                            const long size,
+                                            const size_t first_chunk) {
+  const char *extensions[] = { ".dat", ".tdat", ".rdat", ".mdat" };
+  coco_work_queue_group_t *group;
+  char *path, *content, *line, *next_line, *entries, *header = NULL, *comments, *comment, *key;
+  char *data_file, *source_path;
+  size_t i, j;
+  int is_bbob = 0;
+
+  path = coco_work_queue_get_path(worker_folder, info_file);
+  content = coco_work_queue_read_file(path, size);
+  coco_free_memory(path);
+  comments = coco_strdup("");
+
+  for (line = content; line != NULL; line = next_line) {
+    next_line = strchr(line, '\n');
+    if (next_line != NULL)
+      *(next_line++) = '\0';
+    if ((strlen(line) > 0) && (line[strlen(line) - 1] == '\r'))
+      line[strlen(line) - 1] = '\0';
+    if (strlen(line) == 0)
+      continue;
+
+    if (strncmp(line, "suite = ", 8) == 0) {
+      /* A header (bbob headers hold the function, bbob-biobj headers the indicator) */
+      header = line;
+      is_bbob = (strstr(line, "funcId = ") != NULL);
+      coco_free_memory(comments);
+      comments = coco_strdup("");
+    } else if (line[0] == '%') {
+      comment = coco_strdupf("%s\n%s", comments, line);
+      coco_free_memory(comments);
+      comments = comment;
+    } else if (header != NULL) {
+      /* A line of problems, whose entries start with the first ", " followed by a digit */
+      for (entries = strstr(line, ", "); entries != NULL; entries = strstr(entries + 2, ", ")) {
+        if ((entries[2] >= '0') && (entries[2] <= '9'))
+          break;
+      }
+      if (entries == NULL)
+        entries = line + strlen(line);
+      key = coco_allocate_string((size_t) (entries - line) + 1);
+      memcpy(key, line, (size_t) (entries - line));
+      key[entries - line] = '\0';
+
+      group = coco_work_queue_merge_get_group(merge, info_file, header, comments, key, is_bbob);
+      coco_work_queue_group_add_entries(group, entries);
+
+      /* The data files of the bbob logger are merged into the data files of the group */
+      if (is_bbob) {
+        data_file = coco_remove_from_string(key, ".dat", "");
+        for (i = 0; i < sizeof(extensions) / sizeof(extensions[0]); i++) {
+          path = coco_strdupf("%s%s", data_file, extensions[i]);
+          source_path = coco_work_queue_get_path(worker_folder, path);
+          coco_free_memory(path);
+          for (j = first_chunk; j < merge->number_of_chunks; j++) {
+            if (strcmp(merge->chunks[j].source, source_path) == 0) {
+              coco_free_memory(merge->chunks[j].destination);
+              merge->chunks[j].destination = coco_strdupf("%s%s", group->key, extensions[i]);
+            }
+          }
+          coco_free_memory(source_path);
+        }
+        coco_free_memory(data_file);
+      }
+      coco_free_memory(key);
+    }
+  }
+  coco_free_memory(comments);
+  coco_free_memory(content);
+}
+
+/**
+ * @brief Writes the merged info files with the groups ordered by dimension and function and their entries
+ * ordered by instance.
+ */
+static void coco_work_queue_merge_write_info_files(const coco_work_queue_merge_t *merge) {
+  coco_work_queue_group_t *group;
+  coco_work_queue_order_t *order, *entry_order;
+  char *path;
+  size_t i, j, k;
+  int is_first;
+  FILE *file;
+
+  order = (coco_work_queue_order_t *) coco_allocate_memory((merge->number_of_groups + 1) * sizeof(*order));
+  for (i = 0; i < merge->number_of_groups; i++) {
+    order[i].dimension = merge->groups[i].dimension;
+    order[i].function = merge->groups[i].function;
+    order[i].instance = 0;
+    order[i].index = i;
+  }
+  qsort(order, merge->number_of_groups, sizeof(*order), coco_work_queue_compare_order);
+
+  for (i = 0; i < merge->number_of_groups; i++) {
+    group = &merge->groups[order[i].index];
+    for (j = 0; j < i; j++) {
+      if (strcmp(merge->groups[order[j].index].info_file, group->info_file) == 0)
+        break;
+    }
+    if (j < i)
+      continue; /* The info file was written already */
+
+    path = coco_work_queue_get_path(merge->merged_folder, group->info_file);
+    file = fopen(path, "w");
+    if (file == NULL)
+      coco_error("coco_work_queue_merge_write_info_files(): failed to open file '%s'", path);
+    is_first = 1;
+    for (j = i; j < merge->number_of_groups; j++) {
+      group = &merge->groups[order[j].index];
+      if (strcmp(group->info_file, merge->groups[order[i].index].info_file) != 0)
+        continue;
+      if (group->is_bbob) {
+        fprintf(file, "%s%s%s\n%s.dat", is_first ? "" : "\n", group->header, group->comments, group->key);
+      } else {
+        if (is_first)
+          fprintf(file, "%s%s", group->header, group->comments);
+        fprintf(file, "\n%s", group->key);
+      }
+      entry_order = (coco_work_queue_order_t *) coco_allocate_memory((group->number_of_entries + 1)
+          * sizeof(*entry_order));
+      for (k = 0; k < group->number_of_entries; k++) {
+        entry_order[k].dimension = group->dimension;
+        entry_order[k].function = group->function;
+        entry_order[k].instance = group->instances[k];
+        entry_order[k].index = k;
+      }
+      qsort(entry_order, group->number_of_entries, sizeof(*entry_order), coco_work_queue_compare_order);
+      for (k = 0; k < group->number_of_entries; k++)
+        fputs(group->entries[entry_order[k].index], file);
+      coco_free_memory(entry_order);
+      is_first = 0;
+    }
+    fclose(file);
+    coco_free_memory(path);
+  }
+  coco_free_memory(order);
+}
+
+/**
+ * @brief Appends the chunks of the worker files to the merged files in the order of dimension, function and
+ * instance of their problems.
+ */
+static void coco_work_queue_merge_write_chunks(const coco_work_queue_merge_t *merge) {
+  coco_work_queue_order_t *order;
+  coco_work_queue_chunk_t *chunk;
+  char *destination_path;
+  size_t i;
+
+  order = (coco_work_queue_order_t *) coco_allocate_memory((merge->number_of_chunks + 1) * sizeof(*order));
+  for (i = 0; i < merge->number_of_chunks; i++) {
+    order[i].dimension = merge->chunks[i].dimension;
+    order[i].function = merge->chunks[i].function;
+    order[i].instance = merge->chunks[i].instance;
+    order[i].index = i;
+  }
+  qsort(order, merge->number_of_chunks, sizeof(*order), coco_work_queue_compare_order);
+
+  for (i = 0; i < merge->number_of_chunks; i++) {
+    chunk = &merge->chunks[order[i].index];
+    destination_path = coco_work_queue_get_path(merge->merged_folder, chunk->destination);
+    coco_work_queue_append_file(destination_path, chunk->source, chunk->start, chunk->end);
+    coco_free_memory(destination_path);
+  }
+  coco_free_memory(order);
+}
+
+/**
+ * @brief Merges the output of one worker.
+ */
+static void coco_work_queue_merge_worker(coco_work_queue_merge_t *merge, const char *worker_folder) {
+  coco_observer_checkpoint_t *checkpoint;
+  coco_observer_checkpoint_files_t *pending_files, *all_files;
+  size_t i, j, *problem, *problems, first_chunk;
+  long size;
+
+  checkpoint = coco_observer_checkpoint(worker_folder, 0);
+  pending_files = coco_observer_checkpoint_files();
+  all_files = coco_observer_checkpoint_files();
+  coco_observer_checkpoint_read(checkpoint, pending_files, all_files);
+  if (pending_files->count > 0) {
+    coco_warning("coco_observer_merge_workers(): the output of the interrupted problem in %s is not merged "
+        "(resume this worker to complete it)", worker_folder);
+  }
+
+  /* The completed problems */
+  for (i = 0; i < checkpoint->number_of_completed; i++) {
+    problem = checkpoint->completed + 3 * i;
+    for (j = 0; j < merge->number_of_problems; j++) {
+      if (memcmp(merge->problems + 3 * j, problem, 3 * sizeof(size_t)) == 0)
+        coco_warning("coco_observer_merge_workers(): problem f%lu_d%lu_i%lu was run by several workers",
+            (unsigned long) problem[0], (unsigned long) problem[1], (unsigned long) problem[2]);
+    }
+    if (merge->number_of_problems == merge->max_number_of_problems) {
+      merge->max_number_of_problems = 2 * merge->max_number_of_problems + 16;
+      problems = coco_allocate_vector_size_t(3 * merge->max_number_of_problems);
+      if (merge->number_of_problems > 0) {
+        memcpy(problems, merge->problems, 3 * merge->number_of_problems * sizeof(size_t));
+        coco_free_memory(merge->problems);
+      }
+      merge->problems = problems;
+    }
+    memcpy(merge->problems + 3 * merge->number_of_problems, problem, 3 * sizeof(size_t));
+    merge->number_of_problems++;
+  }
+
+  /* The parts of the files written by the completed problems */
+  first_chunk = merge->number_of_chunks;
+  coco_work_queue_merge_read_chunks(merge, worker_folder, checkpoint, pending_files);
+
+  /* The info files (and the data files they refer to in the format of the bbob logger) */
+  for (i = 0; i < all_files->count; i++) {
+    if (!coco_work_queue_is_info_file(all_files->paths[i]))
+      continue;
+    size = coco_work_queue_get_merged_size(worker_folder, all_files->paths[i], pending_files);
+    if (size > 0)
+      coco_work_queue_merge_info_file(merge, worker_folder, all_files->paths[i], size, first_chunk);
+  }
+
+  coco_observer_checkpoint_files_free(pending_files);
+  coco_observer_checkpoint_files_free(all_files);
+  coco_observer_checkpoint_release(checkpoint);
+}
+
+/**@}*/
+
+/**
+ * Merges the output of the workers that shared the given work queue folder (see the observer option
+ * "work_queue") into a new result folder that can be read by the post-processing as if the experiment had
+ * been run by one process: the lines of the info files of the same function and dimension are joined and
+ * their data files are concatenated. The output is written in the default order of the suite (by dimension,
+ * function and instance), so that it is the same as that of a single process that runs the suite in this
+ * order, however the problems were distributed among the workers. The output of a problem that was
+ * interrupted is left out (such a worker should be resumed before merging).
+ *
+ * @param work_queue_folder The shared result folder of the workers.
+ * @param merged_folder The result folder to be created for the merged output.
+ *
+ * @return The number of merged problems.
+ */
+size_t coco_observer_merge_workers(const char *work_queue_folder, const char *merged_folder) {
+  coco_work_queue_merge_t merge;
+  char *name, *worker_folder;
+  unsigned long worker;
+  size_t i, j;
+
+  if (coco_create_directory(merged_folder) != 0)
+    coco_error("coco_observer_merge_workers(): the folder %s exists already", merged_folder);
+
+  merge.merged_folder = merged_folder;
+  merge.groups = NULL;
+  merge.number_of_groups = 0;
+  merge.max_number_of_groups = 0;
+  merge.chunks = NULL;
+  merge.number_of_chunks = 0;
+  merge.max_number_of_chunks = 0;
+  merge.problems = NULL;
+  merge.number_of_problems = 0;
+  merge.max_number_of_problems = 0;
+
+  /* The workers are numbered consecutively (see coco_work_queue_create_worker_folder) */
+  for (worker = 1; worker <= 9999; worker++) {
+    name = coco_strdupf("worker-%04lu", worker);
+    worker_folder = coco_work_queue_get_path(work_queue_folder, name);
+    coco_free_memory(name);
+    if (!coco_directory_exists(worker_folder)) {
+      coco_free_memory(worker_folder);
+      break;
+    }
+    coco_work_queue_merge_worker(&merge, worker_folder);
+    coco_free_memory(worker_folder);
+  }
+  coco_work_queue_merge_write_info_files(&merge);
+  coco_work_queue_merge_write_chunks(&merge);
+  coco_info("Merged %lu problems of %lu workers into %s", (unsigned long) merge.number_of_problems,
+      worker - 1, merged_folder);
+
+  for (i = 0; i < merge.number_of_groups; i++) {
+    coco_free_memory(merge.groups[i].info_file);
+    coco_free_memory(merge.groups[i].header);
+    coco_free_memory(merge.groups[i].comments);
+    coco_free_memory(merge.groups[i].key);
+    for (j = 0; j < merge.groups[i].number_of_entries; j++)
+      coco_free_memory(merge.groups[i].entries[j]);
+    if (merge.groups[i].entries != NULL) {
+      coco_free_memory(merge.groups[i].entries);
+      coco_free_memory(merge.groups[i].instances);
+    }
+  }
+  if (merge.groups != NULL)
+    coco_free_memory(merge.groups);
+  for (i = 0; i < merge.number_of_chunks; i++) {
+    coco_free_memory(merge.chunks[i].source);
+    coco_free_memory(merge.chunks[i].destination);
+  }
+  if (merge.chunks != NULL)
+    coco_free_memory(merge.chunks);
+  if (merge.problems != NULL)
+    coco_free_memory(merge.problems);
+  return merge.number_of_problems;
+}
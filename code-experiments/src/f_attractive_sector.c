@@ -14,8 +14,7 @@
 #include "transform_obj_shift.c"
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_vars_conditioning.c"
 #include "transform_obj_norm_by_dim.c"
 
@@ -24,6 +23,7 @@
  */
 typedef struct {
   double *xopt;
+  size_t *number_of_owners; /**< @brief Number of clones sharing xopt (NULL if not shared) */
 } f_attractive_sector_data_t;
 
 /**
@@ -58,17 +58,46 @@ static void f_attractive_sector_evaluate(coco_problem_t *problem, const double *
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw attractive sector function.
+ */
+static void f_attractive_sector_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_attractive_sector_data_t *data = (f_attractive_sector_data_t *) problem->data;
+  size_t i;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    if (data->xopt[i] * x[i] > 0.0) {
+      y[i] = 2.0 * 100.0 * 100.0 * x[i];
+    } else {
+      y[i] = 2.0 * x[i];
+    }
+  }
+}
+
 /**
  * @brief Frees the attractive sector data object.
  */
 static void f_attractive_sector_free(coco_problem_t *problem) {
   f_attractive_sector_data_t *data;
   data = (f_attractive_sector_data_t *) problem->data;
-  coco_free_memory(data->xopt);
+  if (coco_shared_references_decrease(&data->number_of_owners))
+    coco_free_memory(data->xopt);
   problem->problem_free_function = NULL;
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the attractive sector data object, sharing xopt.
+ */
+static void f_attractive_sector_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_attractive_sector_data_t *data, *clone_data;
+  data = (f_attractive_sector_data_t *) problem->data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (f_attractive_sector_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone->data = clone_data;
+}
+
 /**
  * @brief Allocates the basic attractive sector problem.
  */
@@ -77,11 +106,14 @@ static coco_problem_t *f_attractive_sector_allocate(const size_t number_of_varia
   f_attractive_sector_data_t *data;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("attractive sector function",
       f_attractive_sector_evaluate, f_attractive_sector_free, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_gradient = f_attractive_sector_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "attractive_sector", number_of_variables);
 
   data = (f_attractive_sector_data_t *) coco_allocate_memory(sizeof(*data));
   data->xopt = coco_duplicate_vector(xopt, number_of_variables);
+  data->number_of_owners = NULL;
   problem->data = data;
+  problem->problem_clone_function = f_attractive_sector_clone;
 
   /* Compute best solution */
   f_attractive_sector_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -186,10 +218,10 @@ static coco_problem_t *f_attractive_sector_permblockdiag_bbob_problem_allocate(c
   P12 = coco_allocate_vector_size_t(dimension);
   P21 = coco_allocate_vector_size_t(dimension);
   P22 = coco_allocate_vector_size_t(dimension);
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 2000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 5000000, dimension, nb_swaps2, swap_range2);
+  coco_compute_swap_permutation(P11, rseed + 2000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P12, rseed + 3000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
+  coco_compute_swap_permutation(P22, rseed + 5000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
 
   problem = f_attractive_sector_allocate(dimension, xopt);
   problem = transform_obj_norm_by_dim(problem);
@@ -197,13 +229,9 @@ static coco_problem_t *f_attractive_sector_permblockdiag_bbob_problem_allocate(c
   problem = transform_obj_power(problem, 0.9);
   problem = transform_obj_shift(problem, fopt);
 
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_conditioning(problem, condition);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_shift(problem, xopt, 0);
   
   coco_problem_set_id(problem, problem_id_template, function, instance, dimension);
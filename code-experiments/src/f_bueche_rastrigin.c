@@ -45,6 +45,26 @@ static void f_bueche_rastrigin_evaluate(coco_problem_t *problem, const double *x
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw Bueche-Rastrigin function.
+ */
+static void f_bueche_rastrigin_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 20.0 * coco_pi * sin(2 * coco_pi * x[i]) + 2.0 * x[i];
+  }
+}
+
+/**
+ * @brief Returns the contribution of the i-th variable to the raw Bueche-Rastrigin function.
+ */
+static double f_bueche_rastrigin_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  (void) problem; /* silence (C89) compilers */
+  (void) i;
+  return 10.0 * (1.0 - cos(2 * coco_pi * x_i)) + x_i * x_i;
+}
+
 /**
  * @brief Allocates the basic Bueche-Rastrigin problem.
  */
@@ -52,6 +72,8 @@ static coco_problem_t *f_bueche_rastrigin_allocate(const size_t number_of_variab
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Bueche-Rastrigin function",
       f_bueche_rastrigin_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_gradient = f_bueche_rastrigin_evaluate_gradient;
+  problem->evaluate_term = f_bueche_rastrigin_evaluate_term;
   coco_problem_set_id(problem, "%s_d%02lu", "bueche-rastrigin", number_of_variables);
 
   /* Compute best solution */
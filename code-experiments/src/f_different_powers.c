@@ -12,8 +12,7 @@
 #include "transform_obj_shift.c"
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -72,13 +71,39 @@ static void f_different_powers_evaluate_gradient(coco_problem_t *problem, const
   
   for (i = 0; i < problem->number_of_variables; ++i) {
     aux = 2.0 + (4.0 * (double) (long) i) / ((double) (long) problem->number_of_variables - 1.0);
-	 y[i] = 0.5 * (aux)/(sum);
+    y[i] = 0.5 * (aux) / sqrt(sum);
     aux -= 1.0;
     y[i] *= pow(fabs(x[i]), aux) * sign(x[i]);
   }
   
 }
 
+/**
+ * @brief Evaluates the gradient of the function "different powers" divided by its square root (the sum),
+ * which is how its gradient used to be computed.
+ *
+ * Only used to construct the constraints of the bbob-constrained suite, which must not change (see
+ * f_different_powers_bbob_constrained_evaluate_legacy_gradient).
+ */
+static void f_different_powers_evaluate_legacy_gradient(coco_problem_t *problem, const double *x, double *y) {
+
+  size_t i;
+  double sum = 0.0;
+  double aux;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    aux = 2.0 + (4.0 * (double) (long) i) / ((double) (long) problem->number_of_variables - 1.0);
+    sum += pow(fabs(x[i]), aux);
+  }
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    aux = 2.0 + (4.0 * (double) (long) i) / ((double) (long) problem->number_of_variables - 1.0);
+    y[i] = 0.5 * (aux)/(sum);
+    aux -= 1.0;
+    y[i] *= pow(fabs(x[i]), aux) * sign(x[i]);
+  }
+}
+
 /**
  * @brief Allocates the basic different powers problem.
  */
@@ -196,6 +221,25 @@ static coco_problem_t *f_different_powers_bbob_constrained_problem_allocate(cons
   return problem;
 }
 
+/**
+ * @brief Evaluates the gradient of the bbob-constrained different powers problem in the way it was
+ * evaluated before the gradient of the raw function was corrected (with the same direction but a different
+ * length), so that the constraints constructed from it are the same to the last bit.
+ */
+static void f_different_powers_bbob_constrained_evaluate_legacy_gradient(coco_problem_t *problem,
+                                                                         const double *x,
+                                                                         double *y) {
+  coco_problem_t *raw_problem = problem;
+
+  while (raw_problem->problem_free_function == coco_problem_transformed_free)
+    raw_problem = coco_problem_transformed_get_inner_problem(raw_problem);
+  assert(raw_problem->evaluate_gradient == f_different_powers_evaluate_gradient);
+
+  raw_problem->evaluate_gradient = f_different_powers_evaluate_legacy_gradient;
+  bbob_evaluate_gradient(problem, x, y);
+  raw_problem->evaluate_gradient = f_different_powers_evaluate_gradient;
+}
+
 /**
  * @brief Creates the BBOB generalized permuted block-rotated sum of different powers problem.
  */
@@ -231,13 +275,11 @@ static coco_problem_t *f_different_powers_permblockdiag_bbob_problem_allocate(co
   B_copy = (const double *const *)B;
   coco_compute_blockrotation(B, rseed + 1000000, dimension, block_sizes, nb_blocks);
 
-  coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  coco_compute_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
 
   problem = f_different_powers_allocate(dimension);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
@@ -11,8 +11,7 @@
 #include "transform_vars_oscillate.c"
 #include "transform_vars_shift.c"
 #include "transform_obj_shift.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -70,6 +69,34 @@ static void f_discus_generalized_evaluate(coco_problem_t *problem, const double
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the generalized discus function.
+ */
+static void f_discus_generalized_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  static const double condition = 1.0e6;
+  f_discus_generalized_versatile_data_t *versatile_data =
+      (f_discus_generalized_versatile_data_t *) problem->versatile_data;
+  size_t i, nb_short_axes;
+
+  nb_short_axes = problem->number_of_variables / versatile_data->proportion_short_axes_denom;
+  if (problem->number_of_variables % versatile_data->proportion_short_axes_denom != 0) {
+    nb_short_axes += 1;
+  }
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = (i < nb_short_axes) ? 2.0 * condition * x[i] : 2.0 * x[i];
+  }
+}
+
+/**
+ * @brief Clones the versatile data of the generalized discus problem.
+ */
+static void f_discus_generalized_versatile_data_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_discus_generalized_versatile_data_t *versatile_data;
+  versatile_data = (f_discus_generalized_versatile_data_t *) coco_allocate_memory(sizeof(*versatile_data));
+  *versatile_data = *(f_discus_generalized_versatile_data_t *) problem->versatile_data;
+  clone->versatile_data = versatile_data;
+}
+
 /**
  * @brief Allocates the basic generalized discus problem.
  */
@@ -77,9 +104,11 @@ static coco_problem_t *f_discus_generalized_allocate(const size_t number_of_vari
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("generalized discus function",
                                                                f_discus_generalized_evaluate, f_discus_generalized_versatile_data_free, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_gradient = f_discus_generalized_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%04lu", "discus_generalized", number_of_variables);
   problem->versatile_data = (f_discus_generalized_versatile_data_t *) coco_allocate_memory(sizeof(f_discus_generalized_versatile_data_t));
   ((f_discus_generalized_versatile_data_t *) problem->versatile_data)->proportion_short_axes_denom = proportion_short_axes_denom;
+  problem->problem_clone_function = f_discus_generalized_versatile_data_clone;
 
 
   /* Compute best solution */
@@ -123,14 +152,12 @@ static coco_problem_t *f_discus_generalized_permblockdiag_bbob_problem_allocate(
   B_copy = (const double *const *)B;
 
   coco_compute_blockrotation(B, rseed + 1000000, dimension, block_sizes, nb_blocks);
-  coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  coco_compute_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
 
   problem = f_discus_generalized_allocate(dimension, proportion_short_axes_denom);
   problem = transform_vars_oscillate(problem);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
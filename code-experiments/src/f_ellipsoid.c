@@ -13,8 +13,7 @@
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
 #include "transform_obj_shift.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -53,6 +52,19 @@ static void f_ellipsoid_evaluate(coco_problem_t *problem, const double *x, doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the ellipsoid function.
+ */
+static double f_ellipsoid_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  f_ellipsoid_data_t *data = (f_ellipsoid_data_t *) problem->data;
+  double exponent;
+
+  if (i == 0)
+    return x_i * x_i;
+  exponent = 1.0 * (double) (long) i / ((double) (long) problem->number_of_variables - 1.0);
+  return pow(data->conditioning, exponent) * x_i * x_i;
+}
+
 /**
  * @brief Evaluates the gradient of the ellipsoid function.
  */
@@ -69,6 +81,16 @@ static void f_ellipsoid_evaluate_gradient(coco_problem_t *problem,
  
 }
 
+/**
+ * @brief Clones the data of the ellipsoid problem.
+ */
+static void f_ellipsoid_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_ellipsoid_data_t *data;
+  data = (f_ellipsoid_data_t *) coco_allocate_memory(sizeof(*data));
+  *data = *(f_ellipsoid_data_t *) problem->data;
+  clone->data = data;
+}
+
 /**
  * @brief Allocates the basic ellipsoid problem.
  */
@@ -77,11 +99,13 @@ static coco_problem_t *f_ellipsoid_allocate(const size_t number_of_variables, co
   coco_problem_t *problem = coco_problem_allocate_from_scalars("ellipsoid function",
       f_ellipsoid_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
   problem->evaluate_gradient = f_ellipsoid_evaluate_gradient;
+  problem->evaluate_term = f_ellipsoid_evaluate_term;
   coco_problem_set_id(problem, "%s_d%02lu", "ellipsoid", number_of_variables);
   f_ellipsoid_data_t *data;
   data = (f_ellipsoid_data_t *) coco_allocate_memory(sizeof(*data));
   data->conditioning = conditioning;
   problem->data = data;
+  problem->problem_clone_function = f_ellipsoid_clone;
   /* Compute best solution */
   f_ellipsoid_evaluate(problem, problem->best_parameter, problem->best_value);
   return problem;
@@ -198,14 +222,12 @@ static coco_problem_t *f_ellipsoid_permblockdiag_bbob_problem_allocate(const siz
   coco_compute_blockrotation(B, rseed + 1000000, dimension, block_sizes, nb_blocks);
   B_copy = (const double *const *)B;/*TODO: silences the warning, not sure if it prevents the modification of B at all levels. Check everywhere*/
   
-  coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  coco_compute_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
 
   problem = f_ellipsoid_allocate(dimension, 1.0e6);
   problem = transform_vars_oscillate(problem);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
   problem = transform_vars_shift(problem, xopt, 0);
 
 
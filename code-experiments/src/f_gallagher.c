@@ -9,6 +9,7 @@
 #include "coco.h"
 #include "coco_problem.c"
 #include "coco_utilities.c"
+#include "coco_shared_data.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_shift.c"
 #include "transform_vars_permutation.c"
@@ -40,13 +41,29 @@ typedef struct {
 typedef struct {
   long rseed;
   double *xopt;
-  double **rotation, **x_local, **arr_scales;
+  double **rotation;
+  double *x_local;     /**< @brief the peak centers in the rotated space, stored contiguously per peak */
+  double *arr_scales;  /**< @brief the peak scales, stored contiguously per peak */
   size_t number_of_peaks;
   double penalty_scale;
-  double *peak_values;
+  double *peak_values; /**< @brief the peak values, non-increasing (see f_gallagher_get_peak_position) */
+  double *log_peak_values; /**< @brief the logarithms of the peak values */
+  double *tmx;         /**< @brief the rotated decision vector */
+  size_t *number_of_owners; /**< @brief Number of clones sharing the read-only fields (NULL if not shared) */
   coco_problem_free_function_t old_free_problem;
 } f_gallagher_data_t;
 
+/**
+ * @brief Number of peaks whose distances are computed together (as independent sums, so that they can be
+ * computed in parallel by the processor). The kernel in f_gallagher_raw is unrolled accordingly.
+ */
+#define F_GALLAGHER_PEAK_BLOCK_SIZE 4
+
+/**
+ * @brief Number of variables between two checks whether the peaks can still exceed the current maximum.
+ */
+#define F_GALLAGHER_VARIABLE_BLOCK_SIZE 8
+
 /**
  * Comparison function used for sorting.
  */
@@ -60,15 +77,33 @@ static int f_gallagher_compare_doubles(const void *a, const void *b) {
     return 0;
 }
 
+/**
+ * @brief Returns the position at which the data of the i-th peak (in the order of the old code) is stored.
+ *
+ * The global peak comes first, followed by the local peaks in order of decreasing peak values, so that
+ * the maximum over the peaks grows as fast as possible when they are evaluated in the stored order.
+ */
+static size_t f_gallagher_get_peak_position(const size_t i, const size_t number_of_peaks) {
+  return (i == 0) ? 0 : number_of_peaks - i;
+}
+
 /**
  * @brief Implements the Gallagher function without connections to any COCO structures.
+ *
+ * The peaks are evaluated in blocks, in order of decreasing peak values. As the weighted distance to a
+ * peak only grows with each added variable, the evaluation of a block stops as soon as none of its peaks
+ * can exceed the current maximum anymore (with a margin that is large compared to the rounding errors, so
+ * the result is the same as when evaluating all peaks completely), and no more blocks are evaluated once
+ * their peak values cannot exceed it.
  */
 static double f_gallagher_raw(const double *x, const size_t number_of_variables, f_gallagher_data_t *data) {
-  size_t i, j; /* Loop over dim */
-  double *tmx;
+  size_t i, j, k, block_end, peaks_in_block; /* Loop over dim */
+  const double *x_local[F_GALLAGHER_PEAK_BLOCK_SIZE], *arr_scales[F_GALLAGHER_PEAK_BLOCK_SIZE];
+  double *tmx = data->tmx;
   double a = 0.1;
-  double tmp2, f = 0., f_add, tmp, f_pen = 0., f_true = 0.;
-  double fac;
+  double tmp2[F_GALLAGHER_PEAK_BLOCK_SIZE], f = 0., f_add, tmp, f_pen = 0., f_true = 0.;
+  double fac, log_f = 0., max_tmp2[F_GALLAGHER_PEAK_BLOCK_SIZE], peak_value;
+  int can_exceed;
   double result;
 
   if (coco_vector_contains_nan(x, number_of_variables))
@@ -87,7 +122,6 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   f_add = f_pen;
   /* Transformation in search space */
   /* TODO: this should rather be done in f_gallagher */
-  tmx = coco_allocate_vector(number_of_variables);
   for (i = 0; i < number_of_variables; i++) {
     tmx[i] = 0;
     for (j = 0; j < number_of_variables; ++j) {
@@ -95,14 +129,52 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
     }
   }
   /* Computation core*/
-  for (i = 0; i < data->number_of_peaks; ++i) {
-    tmp2 = 0.;
-    for (j = 0; j < number_of_variables; ++j) {
-      tmp = (tmx[j] - data->x_local[j][i]);
-      tmp2 += data->arr_scales[i][j] * tmp * tmp;
+  for (i = 0; i < data->number_of_peaks; i += peaks_in_block) {
+    if (data->peak_values[i] <= f)
+      break; /* Neither these nor any of the following peaks can exceed f */
+    peaks_in_block = data->number_of_peaks - i;
+    if (peaks_in_block > F_GALLAGHER_PEAK_BLOCK_SIZE)
+      peaks_in_block = F_GALLAGHER_PEAK_BLOCK_SIZE;
+    for (k = 0; k < F_GALLAGHER_PEAK_BLOCK_SIZE; ++k) {
+      if (k < peaks_in_block) {
+        /* The value of the peak is smaller than f if its tmp2 exceeds max_tmp2 */
+        max_tmp2[k] = (f > 0) ? (log_f - data->log_peak_values[i + k] - 1e-12) / fac : HUGE_VAL;
+        x_local[k] = data->x_local + (i + k) * number_of_variables;
+        arr_scales[k] = data->arr_scales + (i + k) * number_of_variables;
+      } else {
+        /* Fill up the last block with the first peak of the block, whose copies are then ignored */
+        max_tmp2[k] = -1.;
+        x_local[k] = x_local[0];
+        arr_scales[k] = arr_scales[0];
+      }
+      tmp2[k] = 0.;
+    }
+    can_exceed = 1;
+    for (j = 0; j < number_of_variables && can_exceed; j = block_end) {
+      block_end = j + F_GALLAGHER_VARIABLE_BLOCK_SIZE;
+      if (block_end > number_of_variables)
+        block_end = number_of_variables;
+      for (; j < block_end; ++j) {
+        tmp = (tmx[j] - x_local[0][j]);
+        tmp2[0] += arr_scales[0][j] * tmp * tmp;
+        tmp = (tmx[j] - x_local[1][j]);
+        tmp2[1] += arr_scales[1][j] * tmp * tmp;
+        tmp = (tmx[j] - x_local[2][j]);
+        tmp2[2] += arr_scales[2][j] * tmp * tmp;
+        tmp = (tmx[j] - x_local[3][j]);
+        tmp2[3] += arr_scales[3][j] * tmp * tmp;
+      }
+      can_exceed = !(tmp2[0] > max_tmp2[0]) || !(tmp2[1] > max_tmp2[1])
+          || !(tmp2[2] > max_tmp2[2]) || !(tmp2[3] > max_tmp2[3]);
+    }
+    for (k = 0; k < peaks_in_block; ++k) {
+      if (tmp2[k] > max_tmp2[k])
+        continue;
+      peak_value = data->peak_values[i + k] * exp(fac * tmp2[k]);
+      if (peak_value > f)
+        log_f = log(peak_value);
+      f = coco_double_max(f, peak_value);
     }
-    tmp2 = data->peak_values[i] * exp(fac * tmp2);
-    f = coco_double_max(f, tmp2);
   }
 
   f = 10. - f;
@@ -118,7 +190,6 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   f_true *= f_true;
   f_true += f_add;
   result = f_true;
-  coco_free_memory(tmx);
   return result;
 }
 
@@ -131,21 +202,93 @@ static void f_gallagher_evaluate(coco_problem_t *problem, const double *x, doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Gallagher function.
+ *
+ * The gradient is that of the highest peak (the maximum is not differentiable where several peaks are
+ * equally high).
+ */
+static void f_gallagher_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_gallagher_data_t *data = (f_gallagher_data_t *) problem->data;
+  const size_t number_of_variables = problem->number_of_variables;
+  const double fac = -0.5 / (double) number_of_variables;
+  const double *x_local, *arr_scales;
+  size_t i, j, best_peak = 0;
+  double f = 0., peak_value, tmp, tmp2, factor;
+  tosz_data d;
+
+  for (i = 0; i < number_of_variables; i++) {
+    data->tmx[i] = 0;
+    for (j = 0; j < number_of_variables; ++j) {
+      data->tmx[i] += data->rotation[i][j] * x[j];
+    }
+  }
+  for (i = 0; i < data->number_of_peaks; ++i) {
+    x_local = data->x_local + i * number_of_variables;
+    arr_scales = data->arr_scales + i * number_of_variables;
+    tmp2 = 0.;
+    for (j = 0; j < number_of_variables; ++j) {
+      tmp = (data->tmx[j] - x_local[j]);
+      tmp2 += arr_scales[j] * tmp * tmp;
+    }
+    peak_value = data->peak_values[i] * exp(fac * tmp2);
+    if (peak_value > f) {
+      f = peak_value;
+      best_peak = i;
+    }
+  }
+
+  /* The result is tosz(10 - f)^2 + penalty */
+  d.alpha = 0.1;
+  factor = -2. * tosz_uv(10. - f, &d) * tosz_uv_derivative(10. - f, &d) * f * fac * 2.;
+  x_local = data->x_local + best_peak * number_of_variables;
+  arr_scales = data->arr_scales + best_peak * number_of_variables;
+  for (j = 0; j < number_of_variables; ++j) {
+    data->tmx[j] = factor * arr_scales[j] * (data->tmx[j] - x_local[j]);
+  }
+  for (j = 0; j < number_of_variables; ++j) {
+    tmp = fabs(x[j]) - 5.;
+    y[j] = 0.;
+    for (i = 0; i < number_of_variables; ++i) {
+      y[j] += data->rotation[i][j] * data->tmx[i];
+    }
+    if (tmp > 0.)
+      y[j] += data->penalty_scale * 2. * tmp * (x[j] > 0. ? 1. : -1.);
+  }
+}
+
 /**
  * @brief Frees the Gallagher data object.
  */
 static void f_gallagher_free(coco_problem_t *problem) {
   f_gallagher_data_t *data;
   data = (f_gallagher_data_t *) problem->data;
-  coco_free_memory(data->xopt);
-  coco_free_memory(data->peak_values);
-  bbob2009_free_matrix(data->rotation, problem->number_of_variables);
-  bbob2009_free_matrix(data->x_local, problem->number_of_variables);
-  bbob2009_free_matrix(data->arr_scales, data->number_of_peaks);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->xopt);
+    coco_free_memory(data->peak_values);
+    coco_free_memory(data->log_peak_values);
+    bbob2009_free_matrix(data->rotation, problem->number_of_variables);
+    coco_shared_data_free(data->x_local);
+    coco_shared_data_free(data->arr_scales);
+  }
+  coco_free_memory(data->tmx);
   problem->problem_free_function = NULL;
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the Gallagher data object, sharing the rotation and the peaks.
+ */
+static void f_gallagher_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_gallagher_data_t *data, *clone_data;
+  data = (f_gallagher_data_t *) problem->data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (f_gallagher_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->tmx = coco_allocate_vector(problem->number_of_variables);
+  clone->data = clone_data;
+}
+
 /**
  * @brief Creates the BBOB Gallagher problem.
  *
@@ -193,8 +336,10 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   data->penalty_scale = penalty_scale;
   data->xopt = coco_allocate_vector(dimension);
   data->rotation = bbob2009_allocate_matrix(dimension, dimension);
-  data->x_local = bbob2009_allocate_matrix(dimension, data->number_of_peaks);
-  data->arr_scales = bbob2009_allocate_matrix(data->number_of_peaks, dimension);
+  data->x_local = coco_allocate_vector(data->number_of_peaks * dimension);
+  data->arr_scales = coco_allocate_vector(data->number_of_peaks * dimension);
+  data->tmx = coco_allocate_vector(dimension);
+  data->number_of_owners = NULL;
 
   if (data->number_of_peaks == peaks_101) {
     maxcondition1 = sqrt(maxcondition1);
@@ -227,10 +372,14 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   data->peak_values[0] = 10;
   for (i = 1; i < data->number_of_peaks; ++i) {
     arrCondition[i] = pow(maxcondition, (double) (rperm[i - 1].index) / ((double) (data->number_of_peaks - 2)));
-    data->peak_values[i] = (double) (i - 1) / (double) (data->number_of_peaks - 2) * (fitvalues[1] - fitvalues[0])
+    data->peak_values[f_gallagher_get_peak_position(i, data->number_of_peaks)] = (double) (i - 1) / (double) (data->number_of_peaks - 2) * (fitvalues[1] - fitvalues[0])
         + fitvalues[0];
   }
   coco_free_memory(rperm);
+  data->log_peak_values = coco_allocate_vector(data->number_of_peaks);
+  for (i = 0; i < data->number_of_peaks; ++i) {
+    data->log_peak_values[i] = log(data->peak_values[i]);
+  }
 
   rperm = (f_gallagher_permutation_t *) coco_allocate_memory(sizeof(*rperm) * dimension);
   for (i = 0; i < data->number_of_peaks; ++i) {
@@ -241,7 +390,7 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
     }
     qsort(rperm, dimension, sizeof(*rperm), f_gallagher_compare_doubles);
     for (j = 0; j < dimension; ++j) {
-      data->arr_scales[i][j] = pow(arrCondition[i],                             /* Lambda^alpha_i from the doc */
+      data->arr_scales[f_gallagher_get_peak_position(i, data->number_of_peaks) * dimension + j] = pow(arrCondition[i],                             /* Lambda^alpha_i from the doc */
           ((double) rperm[j].index) / ((double) (dimension - 1)) - 0.5);
     }
   }
@@ -252,19 +401,24 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
     data->xopt[i] = 0.8 * (b * random_numbers[i] - c);
     problem->best_parameter[i] = 0.8 * (b * random_numbers[i] - c);
     for (j = 0; j < data->number_of_peaks; ++j) {
-      data->x_local[i][j] = 0.;
+      double *current_x_local = data->x_local + f_gallagher_get_peak_position(j, data->number_of_peaks) * dimension + i;
+      *current_x_local = 0.;
       for (k = 0; k < dimension; ++k) {
-        data->x_local[i][j] += data->rotation[i][k] * (b * random_numbers[j * dimension + k] - c);
+        *current_x_local += data->rotation[i][k] * (b * random_numbers[j * dimension + k] - c);
       }
       if (j == 0) {
-        data->x_local[i][j] *= 0.8;
+        *current_x_local *= 0.8;
       }
     }
   }
   coco_free_memory(arrCondition);
   coco_free_memory(random_numbers);
+  data->x_local = (double *) coco_shared_data_share(data->x_local, data->number_of_peaks * dimension * sizeof(double));
+  data->arr_scales = (double *) coco_shared_data_share(data->arr_scales, data->number_of_peaks * dimension * sizeof(double));
 
   problem->data = data;
+  problem->problem_clone_function = f_gallagher_clone;
+  problem->evaluate_gradient = f_gallagher_evaluate_gradient;
 
   /* Compute best solution */
   f_gallagher_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -314,6 +468,8 @@ static coco_problem_t *f_gallagher_sub_problem_allocate(const size_t number_of_v
   versatile_data_tmp->first_non_zero_map = NULL;
   versatile_data_tmp->block_sizes = NULL;
   versatile_data_tmp->B = NULL;
+  versatile_data_tmp->number_of_owners = NULL;
+  problem_i->problem_clone_function = f_gallagher_versatile_data_clone;
 
   coco_problem_set_id(problem_i, "%s_d%04lu", "gallagher_sub", number_of_variables);
 
@@ -393,6 +549,9 @@ static coco_problem_t *f_gallagher_problem_allocate(const size_t number_of_varia
   versatile_data->block_size_map = coco_allocate_vector_size_t(number_of_variables);
   versatile_data->first_non_zero_map = coco_allocate_vector_size_t(number_of_variables);
   versatile_data->block_sizes = coco_allocate_vector_size_t(number_of_variables);
+  versatile_data->B = NULL;
+  versatile_data->number_of_owners = NULL;
+  problem->problem_clone_function = f_gallagher_versatile_data_clone;
 
   coco_problem_set_id(problem, "%s_d%04lu", "gallagher", number_of_variables);
   problem->best_value[0] = 0;
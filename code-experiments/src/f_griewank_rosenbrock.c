@@ -14,8 +14,7 @@
 #include "transform_vars_shift.c"
 #include "transform_obj_shift.c"
 #include "transform_vars_scale.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -59,6 +58,40 @@ static void f_griewank_rosenbrock_evaluate(coco_problem_t *problem, const double
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw Griewank-Rosenbrock function.
+ */
+static void f_griewank_rosenbrock_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_griewank_rosenbrock_data_t *data = (f_griewank_rosenbrock_data_t *) problem->data;
+  size_t i;
+  double derivative;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 0.0;
+  }
+  for (i = 0; i < problem->number_of_variables - 1; ++i) {
+    const double c1 = x[i] * x[i] - x[i + 1];
+    const double c2 = 1.0 - x[i];
+    const double tmp = 100.0 * c1 * c1 + c2 * c2;
+    derivative = 1. / 4000. + sin(tmp);
+    y[i] += derivative * (400.0 * c1 * x[i] - 2.0 * c2);
+    y[i + 1] -= derivative * 200.0 * c1;
+  }
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= data->facftrue / (double) (problem->number_of_variables - 1);
+  }
+}
+
+/**
+ * @brief Clones the data of the Griewank-Rosenbrock problem.
+ */
+static void f_griewank_rosenbrock_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_griewank_rosenbrock_data_t *data;
+  data = (f_griewank_rosenbrock_data_t *) coco_allocate_memory(sizeof(*data));
+  *data = *(f_griewank_rosenbrock_data_t *) problem->data;
+  clone->data = data;
+}
+
 /**
  * @brief Allocates the basic Griewank-Rosenbrock problem.
  */
@@ -66,6 +99,7 @@ static coco_problem_t *f_griewank_rosenbrock_allocate(const size_t number_of_var
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Griewank Rosenbrock function",
       f_griewank_rosenbrock_evaluate, NULL, number_of_variables, -5.0, 5.0, 1);
+  problem->evaluate_gradient = f_griewank_rosenbrock_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "griewank_rosenbrock", number_of_variables);
 
 
@@ -73,6 +107,7 @@ static coco_problem_t *f_griewank_rosenbrock_allocate(const size_t number_of_var
   data = (f_griewank_rosenbrock_data_t *) coco_allocate_memory(sizeof(*data));
   data->facftrue = facftrue;
   problem->data = data;
+  problem->problem_clone_function = f_griewank_rosenbrock_clone;
   /* Compute best solution */
   f_griewank_rosenbrock_evaluate(problem, problem->best_parameter, problem->best_value);
   return problem;
@@ -187,8 +222,8 @@ static coco_problem_t *f_griewank_rosenbrock_permblockdiag_bbob_bbob_problem_all
   B_copy = (const double *const *)B;
   
   coco_compute_blockrotation(B, rseed, dimension, block_sizes, nb_blocks);
-  coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  coco_compute_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
   
   f_griewank_rosenbrock_args_t *f_griewank_rosenbrock_args;
   f_griewank_rosenbrock_args = ((f_griewank_rosenbrock_args_t *) args);
@@ -196,9 +231,7 @@ static coco_problem_t *f_griewank_rosenbrock_permblockdiag_bbob_bbob_problem_all
   problem = f_griewank_rosenbrock_allocate(dimension, f_griewank_rosenbrock_args->facftrue);
   problem = transform_vars_shift(problem, shift, 0);
   problem = transform_vars_scale(problem, scales);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
   
   /*problem = transform_obj_norm_by_dim(problem);*/ /* Wassim: there is already a normalization by dimension*/
   problem = transform_obj_shift(problem, fopt);
@@ -14,6 +14,7 @@
 #include "transform_obj_shift.c"
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_penalize.c"
 #include "transform_obj_norm_by_dim.c"
 
@@ -58,6 +59,39 @@ static void f_katsuura_evaluate(coco_problem_t *problem, const double *x, double
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw Katsuura function.
+ *
+ * The function is piecewise differentiable with (as many as 2^32 per unit) kinks in each variable, so the
+ * gradient is only meaningful locally.
+ */
+static void f_katsuura_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  const size_t number_of_variables = problem->number_of_variables;
+  const double exponent = 10. / pow((double) number_of_variables, 1.2);
+  size_t i, j;
+  double tmp, tmp2, derivative, product = 1.0;
+
+  for (i = 0; i < number_of_variables; ++i) {
+    tmp = 0;
+    derivative = 0;
+    for (j = 1; j < 33; ++j) {
+      tmp2 = pow(2., (double) j);
+      tmp += fabs(tmp2 * x[i] - coco_double_round(tmp2 * x[i])) / tmp2;
+      if (tmp2 * x[i] > coco_double_round(tmp2 * x[i]))
+        derivative += 1.0;
+      else if (tmp2 * x[i] < coco_double_round(tmp2 * x[i]))
+        derivative -= 1.0;
+    }
+    tmp = 1.0 + ((double) (long) i + 1) * tmp;
+    product *= pow(tmp, exponent);
+    /* the derivative of log(tmp^exponent), multiplied by the product below */
+    y[i] = exponent * ((double) (long) i + 1) * derivative / tmp;
+  }
+  for (i = 0; i < number_of_variables; ++i) {
+    y[i] *= 10. / ((double) number_of_variables) / ((double) number_of_variables) * product;
+  }
+}
+
 /**
  * @brief Allocates the basic Katsuura problem.
  */
@@ -65,6 +99,7 @@ static coco_problem_t *f_katsuura_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Katsuura function",
       f_katsuura_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_gradient = f_katsuura_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "katsuura", number_of_variables);
 
   /* Compute best solution */
@@ -178,19 +213,15 @@ static coco_problem_t *f_katsuura_permblockdiag_bbob_problem_allocate(const size
   coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
   coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
 
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 4000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 5000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
+  coco_compute_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P12, rseed + 4000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P21, rseed + 5000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
+  coco_compute_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
 
   problem = f_katsuura_allocate(dimension);
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_conditioning(problem, 100.0);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_shift(problem, xopt, 0);
 
   /*problem = transform_obj_norm_by_dim(problem);*/ /* Wassim: does not seem to be needed*/
@@ -57,6 +57,29 @@ static void f_linear_slope_evaluate(coco_problem_t *problem, const double *x, do
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the linear slope function.
+ */
+static double f_linear_slope_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+
+  static const double alpha = 100.0;
+  double base, exponent, si;
+
+  base = sqrt(alpha);
+  exponent = (double) (long) i / ((double) (long) problem->number_of_variables - 1);
+  if (problem->best_parameter[i] > 0.0) {
+    si = pow(base, exponent);
+  } else {
+    si = -pow(base, exponent);
+  }
+  /* boundary handling */
+  if (x_i * problem->best_parameter[i] < 25.0) {
+    return 5.0 * fabs(si) - si * x_i;
+  } else {
+    return 5.0 * fabs(si) - si * problem->best_parameter[i];
+  }
+}
+
 /**
  * @brief Evaluates the gradient of the linear slope function.
  */
@@ -68,7 +91,6 @@ static void f_linear_slope_evaluate_gradient(coco_problem_t *problem,
   double base, exponent, si;
   size_t i;
 
-  (void)x; /* silence (C89) compiliers */
   for (i = 0; i < problem->number_of_variables; ++i) {
     base = sqrt(alpha);
     exponent = (double) (long) i / ((double) (long) problem->number_of_variables - 1);
@@ -77,7 +99,12 @@ static void f_linear_slope_evaluate_gradient(coco_problem_t *problem,
     } else {
       si = -pow(base, exponent);
     }
-    y[i] = -si;
+    /* the function is constant beyond the boundary (see f_linear_slope_raw) */
+    if (x[i] * problem->best_parameter[i] < 25.0) {
+      y[i] = -si;
+    } else {
+      y[i] = 0.0;
+    }
   }
 }
 
@@ -91,6 +118,7 @@ static coco_problem_t *f_linear_slope_allocate(const size_t number_of_variables,
   coco_problem_t *problem = coco_problem_allocate_from_scalars("linear slope function",
       f_linear_slope_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
   problem->evaluate_gradient = f_linear_slope_evaluate_gradient;
+  problem->evaluate_term = f_linear_slope_evaluate_term;
   coco_problem_set_id(problem, "%s_d%02lu", "linear_slope", number_of_variables);
 
   /* Compute best solution */
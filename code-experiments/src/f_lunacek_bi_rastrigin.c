@@ -8,12 +8,14 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_shared_data.c"
 #include "suite_bbob_legacy_code.c"
 #include "transform_obj_shift.c"
 #include "f_sphere.c"
 #include "transform_vars_x_hat_generic.c"
 #include "transform_obj_norm_by_dim.c"
 #include "transform_obj_scale.c"
+#include "transform_vars_permblockdiag.c"
 
 /**
  * @brief Data type for the Lunacek bi-Rastrigin problem.
@@ -21,8 +23,9 @@
 typedef struct {
   double *x_hat, *z;
   double *xopt, fopt;
-  double **rot1, **rot2;
+  double *M; /**< @brief rot1 * diag(conditioning) * rot2 in row-major format, composed at construction */
   long rseed;
+  size_t *number_of_owners; /**< @brief Number of clones sharing xopt and M (NULL if not shared) */
   coco_problem_free_function_t old_free_problem;
 } f_lunacek_bi_rastrigin_data_t;
 
@@ -33,14 +36,13 @@ static double f_lunacek_bi_rastrigin_raw(const double *x,
                                          const size_t number_of_variables,
                                          f_lunacek_bi_rastrigin_data_t *data) {
   double result;
-  static const double condition = 100.;
   size_t i, j;
   double penalty = 0.0;
   static const double mu0 = 2.5;
   static const double d = 1.;
   const double s = 1. - 0.5 / (sqrt((double) (number_of_variables + 20)) - 4.1);
   const double mu1 = -sqrt((mu0 * mu0 - d) / s);
-  double *tmpvect, sum1 = 0., sum2 = 0., sum3 = 0.;
+  double sum1 = 0., sum2 = 0., sum3 = 0.;
 
   assert(number_of_variables > 1);
 
@@ -62,20 +64,12 @@ static double f_lunacek_bi_rastrigin_raw(const double *x,
     }
   }
 
-  tmpvect = coco_allocate_vector(number_of_variables);
-  /* affine transformation */
-  for (i = 0; i < number_of_variables; ++i) {
-    double c1;
-    tmpvect[i] = 0.0;
-    c1 = pow(sqrt(condition), ((double) i) / (double) (number_of_variables - 1));
-    for (j = 0; j < number_of_variables; ++j) {
-      tmpvect[i] += c1 * data->rot2[i][j] * (data->x_hat[j] - mu0);
-    }
-  }
+  /* affine transformation (the rotations and the conditioning are composed into M) */
   for (i = 0; i < number_of_variables; ++i) {
+    const double *current_row = data->M + i * number_of_variables;
     data->z[i] = 0;
     for (j = 0; j < number_of_variables; ++j) {
-      data->z[i] += data->rot1[i][j] * tmpvect[j];
+      data->z[i] += current_row[j] * (data->x_hat[j] - mu0);
     }
   }
   /* Computation core */
@@ -86,7 +80,6 @@ static double f_lunacek_bi_rastrigin_raw(const double *x,
   }
   result = coco_double_min(sum1, d * (double) number_of_variables + s * sum2)
       + 10. * ((double) number_of_variables - sum3) + 1e4 * penalty;
-  coco_free_memory(tmpvect);
 
   return result;
 }
@@ -100,6 +93,50 @@ static void f_lunacek_bi_rastrigin_evaluate(coco_problem_t *problem, const doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the Lunacek bi-Rastrigin function.
+ */
+static void f_lunacek_bi_rastrigin_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_lunacek_bi_rastrigin_data_t *data = (f_lunacek_bi_rastrigin_data_t *) problem->data;
+  const size_t number_of_variables = problem->number_of_variables;
+  size_t i, j;
+  static const double mu0 = 2.5;
+  static const double d = 1.;
+  const double s = 1. - 0.5 / (sqrt((double) (number_of_variables + 20)) - 4.1);
+  const double mu1 = -sqrt((mu0 * mu0 - d) / s);
+  double sum1 = 0., sum2 = 0.;
+
+  /* the raw function leaves x_hat and z in the data */
+  f_lunacek_bi_rastrigin_raw(x, number_of_variables, data);
+  for (i = 0; i < number_of_variables; ++i) {
+    sum1 += (data->x_hat[i] - mu0) * (data->x_hat[i] - mu0);
+    sum2 += (data->x_hat[i] - mu1) * (data->x_hat[i] - mu1);
+  }
+
+  /* gradient with respect to x_hat */
+  for (i = 0; i < number_of_variables; ++i) {
+    if (sum1 < d * (double) number_of_variables + s * sum2)
+      y[i] = 2. * (data->x_hat[i] - mu0);
+    else
+      y[i] = 2. * s * (data->x_hat[i] - mu1);
+  }
+  for (i = 0; i < number_of_variables; ++i) {
+    const double *current_row = data->M + i * number_of_variables;
+    const double factor = 20. * coco_pi * sin(2 * coco_pi * data->z[i]);
+    for (j = 0; j < number_of_variables; ++j) {
+      y[j] += factor * current_row[j];
+    }
+  }
+
+  /* chain rule through x_hat and the penalty */
+  for (i = 0; i < number_of_variables; ++i) {
+    const double tmp = fabs(x[i]) - 5.0;
+    y[i] *= (data->xopt[i] < 0.) ? -2. : 2.;
+    if (tmp > 0.0)
+      y[i] += 1e4 * 2. * tmp * (x[i] > 0.0 ? 1.0 : -1.0);
+  }
+}
+
 /**
  * @brief Frees the Lunacek bi-Rastrigin data object.
  */
@@ -108,9 +145,10 @@ static void f_lunacek_bi_rastrigin_free(coco_problem_t *problem) {
   data = (f_lunacek_bi_rastrigin_data_t *) problem->data;
   coco_free_memory(data->x_hat);
   coco_free_memory(data->z);
-  coco_free_memory(data->xopt);
-  bbob2009_free_matrix(data->rot1, problem->number_of_variables);
-  bbob2009_free_matrix(data->rot2, problem->number_of_variables);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->xopt);
+    coco_shared_data_free(data->M);
+  }
 
   /* Let the generic free problem code deal with all of the
    * coco_problem_t fields.
@@ -119,6 +157,20 @@ static void f_lunacek_bi_rastrigin_free(coco_problem_t *problem) {
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the Lunacek bi-Rastrigin data object, sharing xopt and M.
+ */
+static void f_lunacek_bi_rastrigin_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_lunacek_bi_rastrigin_data_t *data, *clone_data;
+  data = (f_lunacek_bi_rastrigin_data_t *) problem->data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (f_lunacek_bi_rastrigin_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->x_hat = coco_allocate_vector(problem->number_of_variables);
+  clone_data->z = coco_allocate_vector(problem->number_of_variables);
+  clone->data = clone_data;
+}
+
 /**
  * @brief Creates the BBOB Lunacek bi-Rastrigin problem.
  *
@@ -136,25 +188,50 @@ static coco_problem_t *f_lunacek_bi_rastrigin_bbob_problem_allocate(const size_t
       f_lunacek_bi_rastrigin_evaluate, f_lunacek_bi_rastrigin_free, dimension, -5.0, 5.0, 0.0);
 
   const double mu0 = 2.5;
+  const double condition = 100.;
 
-  double fopt, *tmpvect;
-  size_t i;
+  double fopt, *tmpvect, *conditioning, **rot1, **rot2;
+  size_t i, j, k;
 
   data = (f_lunacek_bi_rastrigin_data_t *) coco_allocate_memory(sizeof(*data));
   /* Allocate temporary storage and space for the rotation matrices */
   data->x_hat = coco_allocate_vector(dimension);
   data->z = coco_allocate_vector(dimension);
   data->xopt = coco_allocate_vector(dimension);
-  data->rot1 = bbob2009_allocate_matrix(dimension, dimension);
-  data->rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  data->M = coco_allocate_vector(dimension * dimension);
   data->rseed = rseed;
+  data->number_of_owners = NULL;
 
   data->fopt = bbob2009_compute_fopt(24, instance);
   bbob2009_compute_xopt(data->xopt, rseed, dimension);
-  bbob2009_compute_rotation(data->rot1, rseed + 1000000, dimension);
-  bbob2009_compute_rotation(data->rot2, rseed, dimension);
+
+  /* Compose M = rot1 * diag(conditioning) * rot2, so that only one matrix-vector product is needed per
+   * evaluation */
+  rot1 = bbob2009_allocate_matrix(dimension, dimension);
+  rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  bbob2009_compute_rotation(rot1, rseed + 1000000, dimension);
+  bbob2009_compute_rotation(rot2, rseed, dimension);
+  conditioning = coco_allocate_vector(dimension);
+  for (k = 0; k < dimension; ++k) {
+    conditioning[k] = pow(sqrt(condition), ((double) k) / (double) (dimension - 1));
+  }
+  for (i = 0; i < dimension; ++i) {
+    for (j = 0; j < dimension; ++j) {
+      double *current_element = data->M + i * dimension + j;
+      *current_element = 0.0;
+      for (k = 0; k < dimension; ++k) {
+        *current_element += rot1[i][k] * conditioning[k] * rot2[k][j];
+      }
+    }
+  }
+  coco_free_memory(conditioning);
+  bbob2009_free_matrix(rot1, dimension);
+  bbob2009_free_matrix(rot2, dimension);
+  data->M = (double *) coco_shared_data_share(data->M, dimension * dimension * sizeof(double));
 
   problem->data = data;
+  problem->problem_clone_function = f_lunacek_bi_rastrigin_clone;
+  problem->evaluate_gradient = f_lunacek_bi_rastrigin_evaluate_gradient;
 
   /* Compute best solution */
   tmpvect = coco_allocate_vector(dimension);
@@ -206,6 +283,22 @@ static void f_lunacek_bi_rastrigin_versatile_data_free(coco_problem_t *problem)
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the versatile_data part of the problem, including the two sub-problems.
+ */
+static void f_lunacek_bi_rastrigin_versatile_data_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_lunacek_bi_rastrigin_versatile_data_t *versatile_data, *clone_versatile_data;
+  versatile_data = (f_lunacek_bi_rastrigin_versatile_data_t *) problem->versatile_data;
+  clone_versatile_data = (f_lunacek_bi_rastrigin_versatile_data_t *) coco_allocate_memory(sizeof(*clone_versatile_data));
+  clone_versatile_data->sub_problem_mu0 = NULL;
+  clone_versatile_data->sub_problem_mu1 = NULL;
+  if (versatile_data->sub_problem_mu0 != NULL)
+    clone_versatile_data->sub_problem_mu0 = coco_problem_clone(versatile_data->sub_problem_mu0);
+  if (versatile_data->sub_problem_mu1 != NULL)
+    clone_versatile_data->sub_problem_mu1 = coco_problem_clone(versatile_data->sub_problem_mu1);
+  clone_versatile_data->x_hat = coco_allocate_vector(problem->number_of_variables);
+  clone->versatile_data = clone_versatile_data;
+}
 
 /**
  * @brief Uses the core function to evaluate the sub problem.
@@ -282,6 +375,7 @@ static coco_problem_t *f_lunacek_bi_rastrigin_problem_allocate(const size_t numb
 
   problem->versatile_data = (f_lunacek_bi_rastrigin_versatile_data_t *) coco_allocate_memory(sizeof(f_lunacek_bi_rastrigin_versatile_data_t));
   ((f_lunacek_bi_rastrigin_versatile_data_t *) problem->versatile_data)->x_hat = coco_allocate_vector(number_of_variables); /* Manh: Allocate x_hat in versatile_data */
+  problem->problem_clone_function = f_lunacek_bi_rastrigin_versatile_data_clone;
   coco_problem_set_id(problem, "%s_d%04lu", "lunacek_bi_rastrigin", number_of_variables);
   /* Compute the best solution later once the sub-problems are well defined */
   *(problem->best_value) = 0;  /* Manh: set default value to avoid assert() in transformation later*/
@@ -339,10 +433,10 @@ static coco_problem_t *f_lunacek_bi_rastrigin_permblockdiag_bbob_problem_allocat
   P12 = coco_allocate_vector_size_t(dimension);
   P21 = coco_allocate_vector_size_t(dimension);
   P22 = coco_allocate_vector_size_t(dimension);
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 4000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 5000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
+  coco_compute_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P12, rseed + 4000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P21, rseed + 5000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
+  coco_compute_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
 
   problem = f_lunacek_bi_rastrigin_problem_allocate(dimension);
 
@@ -379,14 +473,10 @@ static coco_problem_t *f_lunacek_bi_rastrigin_permblockdiag_bbob_problem_allocat
   *sub_problem_tmp = transform_obj_shift(*sub_problem_tmp, d * (double) dimension);
 
   /* transformations on main problem */
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_conditioning(problem, condition);
 
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_shift(problem, mu0_vector, 0);
   problem = transform_vars_x_hat_generic(problem, sign_vector);
 
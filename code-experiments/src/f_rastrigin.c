@@ -17,8 +17,7 @@
 #include "transform_vars_shift.c"
 #include "transform_obj_shift.c"
 #include "transform_vars_affine.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -53,6 +52,15 @@ static void f_rastrigin_evaluate(coco_problem_t *problem, const double *x, doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the raw Rastrigin function.
+ */
+static double f_rastrigin_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  (void) problem; /* silence (C89) compilers */
+  (void) i;
+  return 10.0 * (1.0 - cos(coco_two_pi * x_i)) + x_i * x_i;
+}
+
 /**
  * @brief Evaluates the gradient of the raw Rastrigin function.
  */
@@ -72,8 +80,8 @@ static coco_problem_t *f_rastrigin_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Rastrigin function",
       f_rastrigin_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
-  /* TODO: make sure the gradient is computed correctly for the rotated Rastrigin */
   problem->evaluate_gradient = f_rastrigin_evaluate_gradient;
+  problem->evaluate_term = f_rastrigin_evaluate_term;
   coco_problem_set_id(problem, "%s_d%02lu", "rastrigin", number_of_variables);
 
   /* Compute best solution */
@@ -219,24 +227,18 @@ static coco_problem_t *f_rastrigin_permblockdiag_bbob_problem_allocate(const siz
   coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
   coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
 
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 4000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 5000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
+  coco_compute_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P12, rseed + 4000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P21, rseed + 5000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
+  coco_compute_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
   
   problem = f_rastrigin_allocate(dimension);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P11, P12, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_conditioning(problem, 10.0);
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P21, P22, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_asymmetric(problem, 0.2);
   problem = transform_vars_oscillate(problem);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P11, P12, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
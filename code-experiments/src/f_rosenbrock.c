@@ -12,8 +12,7 @@
 #include "transform_vars_scale.c"
 #include "transform_vars_affine.c"
 #include "transform_obj_shift.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -50,6 +49,23 @@ static void f_rosenbrock_evaluate(coco_problem_t *problem, const double *x, doub
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw Rosenbrock function.
+ */
+static void f_rosenbrock_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  double tmp;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 0.0;
+  }
+  for (i = 0; i < problem->number_of_variables - 1; ++i) {
+    tmp = (x[i] * x[i] - x[i + 1]);
+    y[i] += 400.0 * tmp * x[i] + 2.0 * (x[i] - 1.0);
+    y[i + 1] -= 200.0 * tmp;
+  }
+}
+
 /**
  * @brief Allocates the basic Rosenbrock problem.
  */
@@ -57,6 +73,7 @@ static coco_problem_t *f_rosenbrock_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Rosenbrock function",
       f_rosenbrock_evaluate, NULL, number_of_variables, -5.0, 5.0, 1.0);
+  problem->evaluate_gradient = f_rosenbrock_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "rosenbrock", number_of_variables);
 
   /* Compute best solution */
@@ -217,15 +234,13 @@ static coco_problem_t *f_rosenbrock_permblockdiag_bbob_problem_allocate(const si
   B_copy = (const double *const *)B;
 
   coco_compute_blockrotation(B, rseed, dimension, block_sizes, nb_blocks);
-  coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
+  coco_compute_swap_permutation(P1, rseed + 2000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
 
   problem = f_rosenbrock_allocate(dimension);
   problem = transform_vars_shift(problem, minus_one, 0);
   problem = transform_vars_scale(problem, factor);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
 
   problem = transform_vars_shift(problem, xopt, 0);
   problem = transform_obj_norm_by_dim(problem);
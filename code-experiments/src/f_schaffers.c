@@ -16,8 +16,7 @@
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
 #include "transform_obj_penalize.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -64,6 +63,33 @@ static void f_schaffers_evaluate(coco_problem_t *problem, const double *x, doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw Schaffer's F7 function.
+ */
+static void f_schaffers_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  const double n1 = (double) (long) problem->number_of_variables - 1.0;
+  size_t i;
+  double sum = 0.0, derivative;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 0.0;
+  }
+  for (i = 0; i < problem->number_of_variables - 1; ++i) {
+    const double tmp = x[i] * x[i] + x[i + 1] * x[i + 1];
+    const double tmp_01 = pow(tmp, 0.1);
+    sum += pow(tmp, 0.25) * (1.0 + pow(sin(50.0 * tmp_01), 2.0));
+    if (tmp > 0.0) {
+      derivative = 0.25 * pow(tmp, -0.75) * (1.0 + pow(sin(50.0 * tmp_01), 2.0))
+          + 5.0 * pow(tmp, -0.65) * sin(100.0 * tmp_01);
+      y[i] += derivative * 2.0 * x[i];
+      y[i + 1] += derivative * 2.0 * x[i + 1];
+    }
+  }
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= 2.0 * sum / (n1 * n1);
+  }
+}
+
 /**
  * @brief Allocates the basic Schaffer's F7 problem.
  */
@@ -71,6 +97,7 @@ static coco_problem_t *f_schaffers_allocate(const size_t number_of_variables) {
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Schaffer's function",
       f_schaffers_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_gradient = f_schaffers_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "schaffers", number_of_variables);
 
   /* Compute best solution */
@@ -189,21 +216,17 @@ static coco_problem_t *f_schaffers_permblockdiag_bbob_problem_allocate(const siz
     coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
     coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
     
-    coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range);
-    coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range);
-    coco_compute_truncated_uniform_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range);
-    coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range);
+    coco_compute_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+    coco_compute_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+    coco_compute_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+    coco_compute_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range, "bbob-largescale");
     
     problem = f_schaffers_allocate(dimension);
     problem = transform_vars_conditioning(problem, conditioning);
-    problem = transform_vars_permutation(problem, P21, dimension);
-    problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-    problem = transform_vars_permutation(problem, P11, dimension);
+    problem = transform_vars_permblockdiag(problem, B2_copy, P11, P21, dimension, block_sizes2, nb_blocks2);
     
     problem = transform_vars_asymmetric(problem, 0.5);
-    problem = transform_vars_permutation(problem, P22, dimension);
-    problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-    problem = transform_vars_permutation(problem, P12, dimension);
+    problem = transform_vars_permblockdiag(problem, B1_copy, P12, P22, dimension, block_sizes1, nb_blocks1);
     
     problem = transform_vars_shift(problem, xopt, 0);
     /*problem = transform_obj_norm_by_dim(problem);*/ /* Wassim: there is already a normalization by dimension*/
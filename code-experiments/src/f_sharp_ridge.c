@@ -49,6 +49,27 @@ static void f_sharp_ridge_evaluate(coco_problem_t *problem, const double *x, dou
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw sharp ridge function.
+ *
+ * The gradient does not exist on the ridge, where the derivatives of its (non-differentiable) part are set
+ * to 0.
+ */
+static void f_sharp_ridge_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  static const double alpha = 100.0;
+  size_t i;
+  double norm = 0.0;
+
+  for (i = 1; i < problem->number_of_variables; ++i) {
+    norm += x[i] * x[i];
+  }
+  norm = sqrt(norm);
+  y[0] = 2.0 * x[0];
+  for (i = 1; i < problem->number_of_variables; ++i) {
+    y[i] = (norm > 0.0) ? alpha * x[i] / norm : 0.0;
+  }
+}
+
 /**
  * @brief Allocates the basic sharp ridge problem.
  */
@@ -56,6 +77,7 @@ static coco_problem_t *f_sharp_ridge_allocate(const size_t number_of_variables)
 
   coco_problem_t *problem = coco_problem_allocate_from_scalars("sharp ridge function",
       f_sharp_ridge_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->evaluate_gradient = f_sharp_ridge_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "sharp_ridge", number_of_variables);
 
   /* Compute best solution */
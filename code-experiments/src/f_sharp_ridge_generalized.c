@@ -13,8 +13,7 @@
 #include "transform_vars_affine.c"
 #include "transform_vars_shift.c"
 #include "transform_vars_conditioning.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -77,6 +76,44 @@ static void f_sharp_ridge_generalized_evaluate(coco_problem_t *problem, const do
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the generalized sharp ridge function.
+ *
+ * The derivatives of the (non-differentiable) ridge part are set to 0 on the ridge.
+ */
+static void f_sharp_ridge_generalized_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  static const double alpha = 100.0;
+  f_sharp_ridge_generalized_versatile_data_t *versatile_data =
+      (f_sharp_ridge_generalized_versatile_data_t *) problem->versatile_data;
+  size_t i, number_linear_dimensions;
+  double norm = 0.0;
+
+  number_linear_dimensions = problem->number_of_variables / versatile_data->proportion_of_linear_dims;
+  if (problem->number_of_variables % versatile_data->proportion_of_linear_dims != 0) {
+    number_linear_dimensions += 1;
+  }
+  for (i = number_linear_dimensions; i < problem->number_of_variables; ++i) {
+    norm += x[i] * x[i];
+  }
+  norm = sqrt(norm);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    if (i < number_linear_dimensions)
+      y[i] = 2.0 * x[i];
+    else
+      y[i] = (norm > 0.0) ? alpha * x[i] / norm : 0.0;
+  }
+}
+
+/**
+ * @brief Clones the versatile data of the generalized sharp ridge problem.
+ */
+static void f_sharp_ridge_generalized_versatile_data_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_sharp_ridge_generalized_versatile_data_t *versatile_data;
+  versatile_data = (f_sharp_ridge_generalized_versatile_data_t *) coco_allocate_memory(sizeof(*versatile_data));
+  *versatile_data = *(f_sharp_ridge_generalized_versatile_data_t *) problem->versatile_data;
+  clone->versatile_data = versatile_data;
+}
+
 /**
  * @brief Allocates the basic sharp ridge problem.
  */
@@ -85,9 +122,11 @@ static coco_problem_t *f_sharp_ridge_generalized_allocate(const size_t number_of
   coco_problem_t *problem = coco_problem_allocate_from_scalars("sharp ridge function",
       f_sharp_ridge_generalized_evaluate, f_sharp_ridge_generalized_versatile_data_free, number_of_variables, -5.0, 5.0, 0.0);
 
+  problem->evaluate_gradient = f_sharp_ridge_generalized_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "sharp_ridge_generalized", number_of_variables);
   problem->versatile_data = (f_sharp_ridge_generalized_versatile_data_t *) coco_allocate_memory(sizeof(f_sharp_ridge_generalized_versatile_data_t));
   ((f_sharp_ridge_generalized_versatile_data_t *) problem->versatile_data)->proportion_of_linear_dims = proportion_of_linear_dims;
+  problem->problem_clone_function = f_sharp_ridge_generalized_versatile_data_clone;
 
   /* Compute best solution */
   f_sharp_ridge_generalized_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -140,20 +179,16 @@ static coco_problem_t *f_sharp_ridge_generalized_permblockdiag_bbob_problem_allo
   coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
   coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
   
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range);
+  coco_compute_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+  coco_compute_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range, "bbob-largescale");
   
   
   problem = f_sharp_ridge_generalized_allocate(dimension, proportion_of_linear_dims);
-  problem = transform_vars_permutation(problem, P21, dimension);/* LIFO */
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P11, P21, dimension, block_sizes1, nb_blocks1); /* LIFO */
   problem = transform_vars_conditioning(problem, 10.0);
-  problem = transform_vars_permutation(problem, P22, dimension);/*Consider replacing P11 and 22 by a single permutation P3*/
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P12, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P12, P22, dimension, block_sizes2, nb_blocks2); /*Consider replacing P11 and 22 by a single permutation P3*/
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
@@ -41,6 +41,15 @@ static void f_sphere_evaluate(coco_problem_t *problem, const double *x, double *
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the sphere function.
+ */
+static double f_sphere_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  (void) problem; /* silence (C89) compilers */
+  (void) i;
+  return x_i * x_i;
+}
+
 /**
  * @brief Evaluates the gradient of the sphere function.
  */
@@ -61,6 +70,7 @@ static coco_problem_t *f_sphere_allocate(const size_t number_of_variables) {
   coco_problem_t *problem = coco_problem_allocate_from_scalars("sphere function",
      f_sphere_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
   problem->evaluate_gradient = f_sphere_evaluate_gradient;
+  problem->evaluate_term = f_sphere_evaluate_term;
   coco_problem_set_id(problem, "%s_d%02lu", "sphere", number_of_variables);
 
   /* Compute best solution */
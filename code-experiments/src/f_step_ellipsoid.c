@@ -20,8 +20,7 @@
 #include "transform_obj_penalize.c"
 #include "transform_obj_shift.c"
 #include "transform_vars_shift.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_vars_round_step.c"
 #include "transform_obj_norm_by_dim.c"
 
@@ -32,7 +31,9 @@
 typedef struct {
   double *x, *xx;
   double *xopt, fopt, penalty_scale;
-  double **rot1, **rot2;
+  double **rot1, **rot2; /**< @brief rot1 and rot2, where the rows of rot2 are already conditioned */
+  double *weights;       /**< @brief The weights of the ellipsoid */
+  size_t *number_of_owners; /**< @brief Number of clones sharing xopt, rot1, rot2 and weights (NULL if not shared) */
 } f_step_ellipsoid_data_t;
 
 /**
@@ -40,7 +41,6 @@ typedef struct {
  */
 static double f_step_ellipsoid_raw(const double *x, const size_t number_of_variables, const f_step_ellipsoid_data_t *data) {
   
-  static const double condition = 100;
   static const double alpha = 10.0;
   size_t i, j;
   double penalty = 0.0, x1;
@@ -59,11 +59,9 @@ static double f_step_ellipsoid_raw(const double *x, const size_t number_of_varia
   }
   penalty = penalty * (data -> penalty_scale);
   for (i = 0; i < number_of_variables; ++i) {
-    double c1;
     data->x[i] = 0.0;
-    c1 = sqrt(pow(condition / 10., (double) i / (double) (number_of_variables - 1)));
     for (j = 0; j < number_of_variables; ++j) {
-      data->x[i] += c1 * data->rot2[i][j] * (x[j] - data->xopt[j]);
+      data->x[i] += data->rot2[i][j] * (x[j] - data->xopt[j]);
     }
   }
   x1 = data->x[0];
@@ -85,9 +83,7 @@ static double f_step_ellipsoid_raw(const double *x, const size_t number_of_varia
   /* Computation core */
   result = 0.0;
   for (i = 0; i < number_of_variables; ++i) {
-    double exponent;
-    exponent = (double) (long) i / ((double) (long) number_of_variables - 1.0);
-    result += pow(condition, exponent) * data->xx[i] * data->xx[i];
+    result += data->weights[i] * data->xx[i] * data->xx[i];
   }
   result = 0.1 * coco_double_max(fabs(x1) * 1.0e-4, result) + penalty + data->fopt;
   
@@ -103,6 +99,39 @@ static void f_step_ellipsoid_evaluate(coco_problem_t *problem, const double *x,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the step ellipsoid function.
+ *
+ * The rounded ellipsoid is piecewise constant and only the term 1e-4 |x1| (where it is the larger one of
+ * the maximum) and the penalty contribute to the gradient.
+ */
+static void f_step_ellipsoid_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_step_ellipsoid_data_t *data = (f_step_ellipsoid_data_t *) problem->data;
+  const size_t number_of_variables = problem->number_of_variables;
+  size_t i, j;
+  double x1, result;
+
+  /* the raw function leaves the rotated rounded vector in data->xx */
+  f_step_ellipsoid_raw(x, number_of_variables, data);
+  result = 0.0;
+  for (i = 0; i < number_of_variables; ++i) {
+    result += data->weights[i] * data->xx[i] * data->xx[i];
+  }
+  x1 = 0.0;
+  for (j = 0; j < number_of_variables; ++j) {
+    x1 += data->rot2[0][j] * (x[j] - data->xopt[j]);
+  }
+
+  for (i = 0; i < number_of_variables; ++i) {
+    const double tmp = fabs(x[i]) - 5.0;
+    y[i] = 0.0;
+    if (fabs(x1) * 1.0e-4 > result && x1 != 0.0)
+      y[i] = 0.1 * 1.0e-4 * (x1 > 0.0 ? 1.0 : -1.0) * data->rot2[0][i];
+    if (tmp > 0.0)
+      y[i] += data->penalty_scale * 2.0 * tmp * (x[i] > 0.0 ? 1.0 : -1.0);
+  }
+}
+
 /**
  * @brief Frees the step ellipsoid data object.
  */
@@ -111,14 +140,31 @@ static void f_step_ellipsoid_free(coco_problem_t *problem) {
   data = (f_step_ellipsoid_data_t *) problem->data;
   coco_free_memory(data->x);
   coco_free_memory(data->xx);
-  coco_free_memory(data->xopt);
-  bbob2009_free_matrix(data->rot1, problem->number_of_variables);
-  bbob2009_free_matrix(data->rot2, problem->number_of_variables);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->xopt);
+    bbob2009_free_matrix(data->rot1, problem->number_of_variables);
+    bbob2009_free_matrix(data->rot2, problem->number_of_variables);
+    coco_free_memory(data->weights);
+  }
   /* Let the generic free problem code deal with all of the coco_problem_t fields */
   problem->problem_free_function = NULL;
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the step ellipsoid data object, sharing xopt, the rotations and the weights.
+ */
+static void f_step_ellipsoid_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_step_ellipsoid_data_t *data, *clone_data;
+  data = (f_step_ellipsoid_data_t *) problem->data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (f_step_ellipsoid_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  clone_data->xx = coco_allocate_vector(problem->number_of_variables);
+  clone->data = clone_data;
+}
+
 /**
  * @brief Creates the BBOB step ellipsoid problem.
  *
@@ -132,8 +178,9 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
                                                               const char *problem_id_template,
                                                               const char *problem_name_template) {
   
+  static const double condition = 100;
   f_step_ellipsoid_data_t *data;
-  size_t i;
+  size_t i, j;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("step ellipsoid function",
                                                                f_step_ellipsoid_evaluate, f_step_ellipsoid_free, dimension, -5.0, 5.0, 0);
   
@@ -144,6 +191,7 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
   data->xopt = coco_allocate_vector(dimension);
   data->rot1 = bbob2009_allocate_matrix(dimension, dimension);
   data->rot2 = bbob2009_allocate_matrix(dimension, dimension);
+  data->number_of_owners = NULL;
 
   f_step_ellipsoid_args_t *f_step_ellipsoid_args;
   f_step_ellipsoid_args = ((f_step_ellipsoid_args_t *) args);
@@ -154,8 +202,22 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
   bbob2009_compute_xopt(data->xopt, rseed, dimension);
   bbob2009_compute_rotation(data->rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(data->rot2, rseed, dimension);
+
+  /* Precompute the conditioning of the rows of rot2 and the weights, which do not depend on x (the
+   * products are evaluated in the same order as before, so the function values do not change) */
+  data->weights = coco_allocate_vector(dimension);
+  for (i = 0; i < dimension; ++i) {
+    double c1 = sqrt(pow(condition / 10., (double) i / (double) (dimension - 1)));
+    double exponent = (double) (long) i / ((double) (long) dimension - 1.0);
+    for (j = 0; j < dimension; ++j) {
+      data->rot2[i][j] = c1 * data->rot2[i][j];
+    }
+    data->weights[i] = pow(condition, exponent);
+  }
   
   problem->data = data;
+  problem->problem_clone_function = f_step_ellipsoid_clone;
+  problem->evaluate_gradient = f_step_ellipsoid_evaluate_gradient;
   
   /* Compute best solution
    *
@@ -211,6 +273,16 @@ static void f_step_ellipsoid_versatile_data_free(coco_problem_t *problem) {
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the versatile_data part of the problem.
+ */
+static void f_step_ellipsoid_versatile_data_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_step_ellipsoid_versatile_data_t *versatile_data;
+  versatile_data = (f_step_ellipsoid_versatile_data_t *) coco_allocate_memory(sizeof(*versatile_data));
+  *versatile_data = *(f_step_ellipsoid_versatile_data_t *) problem->versatile_data;
+  clone->versatile_data = versatile_data;
+}
+
 /**
  * @brief Allocates the basic step ellipsoid problem.
  * an additional coordinate is added that will contain the value of \hat{z}_1 but that is ignored by functions other that f_step_ellipsoid_core and transform_vars_round_step. The latter sets it.
@@ -223,6 +295,7 @@ static coco_problem_t *f_step_ellipsoid_allocate(const size_t number_of_variable
   ((f_step_ellipsoid_versatile_data_t *) problem->versatile_data)->zhat_1 = 0;/*needed for xopt evaluation*/
   /* add the free function of the allocated versatile_data*/
   problem->problem_free_function = f_step_ellipsoid_versatile_data_free;
+  problem->problem_clone_function = f_step_ellipsoid_versatile_data_clone;
   
   coco_problem_set_id(problem, "%s_d%02lu", "step_ellipsoid", number_of_variables);
   /* Compute best solution, here done outside after the zhat is set to the best_value */
@@ -274,22 +347,18 @@ static coco_problem_t *f_step_ellipsoid_permblockdiag_bbob_problem_allocate(cons
   P12 = coco_allocate_vector_size_t(dimension);
   P21 = coco_allocate_vector_size_t(dimension);
   P22 = coco_allocate_vector_size_t(dimension);
-  coco_compute_truncated_uniform_swap_permutation(P11, rseed + 2000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P12, rseed + 3000000, dimension, nb_swaps1, swap_range1);
-  coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps2, swap_range2);
-  coco_compute_truncated_uniform_swap_permutation(P22, rseed + 5000000, dimension, nb_swaps2, swap_range2);
+  coco_compute_swap_permutation(P11, rseed + 2000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P12, rseed + 3000000, dimension, nb_swaps1, swap_range1, "bbob-largescale");
+  coco_compute_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
+  coco_compute_swap_permutation(P22, rseed + 5000000, dimension, nb_swaps2, swap_range2, "bbob-largescale");
 
   problem = f_step_ellipsoid_allocate(dimension);
 
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_round_step(problem, alpha);
   
   problem = transform_vars_conditioning(problem, 10.0);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
@@ -15,8 +15,7 @@
 #include "transform_vars_affine.c"
 #include "transform_vars_oscillate.c"
 #include "transform_vars_shift.c"
-#include "transform_vars_permutation.c"
-#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /** @brief Number of summands in the Weierstrass problem. */
@@ -62,6 +61,39 @@ static void f_weierstrass_evaluate(coco_problem_t *problem, const double *x, dou
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the raw Weierstrass function.
+ */
+static void f_weierstrass_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  f_weierstrass_data_t *data = (f_weierstrass_data_t *) problem->data;
+  const double n = (double) (long) problem->number_of_variables;
+  size_t i, j;
+  double sum = 0.0, factor;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] = 0.0;
+    for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j) {
+      sum += cos(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * data->ak[j];
+      y[i] -= sin(2 * coco_pi * (x[i] + 0.5) * data->bk[j]) * 2 * coco_pi * data->bk[j] * data->ak[j];
+    }
+  }
+  factor = sum / n - data->f0;
+  factor = 30.0 * factor * factor / n;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= factor;
+  }
+}
+
+/**
+ * @brief Clones the data of the Weierstrass problem.
+ */
+static void f_weierstrass_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  f_weierstrass_data_t *data;
+  data = (f_weierstrass_data_t *) coco_allocate_memory(sizeof(*data));
+  *data = *(f_weierstrass_data_t *) problem->data;
+  clone->data = data;
+}
+
 /**
  * @brief Allocates the basic Weierstrass problem.
  */
@@ -72,6 +104,7 @@ static coco_problem_t *f_weierstrass_allocate(const size_t number_of_variables)
   double *non_unique_best_value;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("Weierstrass function",
       f_weierstrass_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.);
+  problem->evaluate_gradient = f_weierstrass_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "weierstrass", number_of_variables);
 
   data = (f_weierstrass_data_t *) coco_allocate_memory(sizeof(*data));
@@ -82,6 +115,7 @@ static coco_problem_t *f_weierstrass_allocate(const size_t number_of_variables)
     data->f0 += data->ak[i] * cos(2 * coco_pi * data->bk[i] * 0.5);
   }
   problem->data = data;
+  problem->problem_clone_function = f_weierstrass_clone;
 
   /* Compute best solution */
   non_unique_best_value = coco_allocate_vector(number_of_variables);
@@ -198,25 +232,19 @@ static coco_problem_t *f_weierstrass_permblockdiag_bbob_problem_allocate(const s
     coco_compute_blockrotation(B1, rseed + 1000000, dimension, block_sizes1, nb_blocks1);
     coco_compute_blockrotation(B2, rseed, dimension, block_sizes2, nb_blocks2);
     
-    coco_compute_truncated_uniform_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range);
-    coco_compute_truncated_uniform_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range);
-    coco_compute_truncated_uniform_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range);
-    coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range);
+    coco_compute_swap_permutation(P11, rseed + 3000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+    coco_compute_swap_permutation(P21, rseed + 4000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+    coco_compute_swap_permutation(P12, rseed + 5000000, dimension, nb_swaps, swap_range, "bbob-largescale");
+    coco_compute_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range, "bbob-largescale");
     
     problem = f_weierstrass_allocate(dimension);
-    problem = transform_vars_permutation(problem, P22, dimension);
-    problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-    problem = transform_vars_permutation(problem, P12, dimension);
+    problem = transform_vars_permblockdiag(problem, B1_copy, P12, P22, dimension, block_sizes1, nb_blocks1);
     
     problem = transform_vars_conditioning(problem, 1.0/condition);
-    problem = transform_vars_permutation(problem, P21, dimension);
-    problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-    problem = transform_vars_permutation(problem, P11, dimension);
+    problem = transform_vars_permblockdiag(problem, B2_copy, P11, P21, dimension, block_sizes2, nb_blocks2);
     
     problem = transform_vars_oscillate(problem);
-    problem = transform_vars_permutation(problem, P22, dimension);
-    problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-    problem = transform_vars_permutation(problem, P12, dimension);
+    problem = transform_vars_permblockdiag(problem, B1_copy, P12, P22, dimension, block_sizes1, nb_blocks1);
 
     problem = transform_vars_shift(problem, xopt, 0);
     /*problem = transform_obj_norm_by_dim(problem);*/ /* Wassim: there is already a normalization by dimension*/
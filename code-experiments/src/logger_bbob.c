@@ -34,6 +34,7 @@
 #include "coco_problem.c"
 #include "coco_string.c"
 #include "coco_observer.c"
+#include "coco_observer_checkpoint.c"
 #include "observer_bbob.c"
 
 /**
@@ -79,6 +80,7 @@ typedef struct {
 
   coco_observer_targets_t *targets;           /**< @brief Triggers based on target values. */
   coco_observer_evaluations_t *evaluations;   /**< @brief Triggers based on the number of evaluations. */
+  coco_observer_checkpoint_t *checkpoint;     /**< @brief Checkpoint of the experiment (NULL if not checkpointed) */
 
 } logger_bbob_data_t;
 
@@ -202,10 +204,11 @@ static void logger_bbob_output(FILE *data_file,
 }
 
 /**
- * @brief Opens the file in append mode
+ * @brief Opens the file in append mode (after recording its size in the checkpoint, if any)
  */
-static void logger_bbob_open_file(FILE **file, const char *file_path) {
+static void logger_bbob_open_file(FILE **file, const char *file_path, const coco_observer_checkpoint_t *checkpoint) {
   if (*file == NULL) {
+    coco_observer_checkpoint_add_file(checkpoint, file_path);
     *file = fopen(file_path, "a");
     if (*file == NULL) {
       coco_error("logger_bbob_open_file(): Error opening file: %s\nError: %d", file_path, errno);
@@ -219,13 +222,14 @@ static void logger_bbob_open_file(FILE **file, const char *file_path) {
 static void logger_bbob_open_data_file(FILE **data_file,
                                        const char *path,
                                        const char *file_name,
-                                       const char *file_extension) {
+                                       const char *file_extension,
+                                       const coco_observer_checkpoint_t *checkpoint) {
   char file_path[COCO_PATH_MAX + 2] = { 0 };
   char relative_file_path[COCO_PATH_MAX + 2] = { 0 };
   strncpy(relative_file_path, file_name, COCO_PATH_MAX - strlen(relative_file_path) - 1);
   strncat(relative_file_path, file_extension, COCO_PATH_MAX - strlen(relative_file_path) - 1);
   coco_join_path(file_path, sizeof(file_path), path, relative_file_path, NULL);
-  logger_bbob_open_file(data_file, file_path);
+  logger_bbob_open_file(data_file, file_path, checkpoint);
 }
 
 /**
@@ -270,7 +274,7 @@ static void logger_bbob_open_info_file(logger_bbob_data_t *logger,
       add_empty_line = 1;
       fclose(tmp_file);
     }
-    logger_bbob_open_file(info_file, file_path);
+    logger_bbob_open_file(info_file, file_path, logger->checkpoint);
     if (start_new_line) {
       if (add_empty_line)
         fprintf(*info_file, "\n");
@@ -303,6 +307,7 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, int is_opt_known)
   char *dimension_string;
   char *str_pointer;
   char *relative_path_pointer = NULL;
+  char *state_before, *state_after;
   int start_new_line;
   observer_bbob_data_t *observer_data;
 
@@ -331,6 +336,8 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, int is_opt_known)
   strncat(relative_path, dimension_string, COCO_PATH_MAX - strlen(relative_path) - 1);
   
   /* Find out whether a new line in the info file (and a new .?dat file) is needed */
+  state_before = coco_strdupf("%lu %lu %s", (unsigned long) observer_data->last_function,
+      (unsigned long) observer_data->last_dimension, observer_data->last_dat_file);
   start_new_line = logger_bbob_start_new_line(logger->observer, logger->number_of_variables, logger->function);
   if (start_new_line) {
     relative_path_pointer = coco_strdup(relative_path);
@@ -342,19 +349,31 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, int is_opt_known)
     relative_path_pointer = coco_strdup(observer_data->last_dat_file);
   }
 
+  /* Record the problem in the checkpoint before anything is written (the state is restored by observer_bbob) */
+  state_after = coco_strdupf("%lu %lu %s", (unsigned long) observer_data->last_function,
+      (unsigned long) observer_data->last_dimension, observer_data->last_dat_file);
+  logger->checkpoint = coco_observer_checkpoint_start(logger->observer->checkpoint, logger->function,
+      logger->number_of_variables, logger->instance, state_before, state_after);
+  coco_free_memory(state_before);
+  coco_free_memory(state_after);
+
   /* info file */
   logger_bbob_open_info_file(logger, logger->observer->result_folder, function_string, relative_path_pointer, 
     logger->suite_name, start_new_line);
   fprintf(logger->info_file, ", %lu", (unsigned long) logger->instance);
 
   /* data files */
-  logger_bbob_open_data_file(&(logger->dat_file), logger->observer->result_folder, relative_path_pointer, ".dat");
+  logger_bbob_open_data_file(&(logger->dat_file), logger->observer->result_folder, relative_path_pointer, ".dat",
+      logger->checkpoint);
   fprintf(logger->dat_file, logger_bbob_header, str_pointer, logger->optimal_value);
-  logger_bbob_open_data_file(&(logger->tdat_file), logger->observer->result_folder, relative_path_pointer, ".tdat");
+  logger_bbob_open_data_file(&(logger->tdat_file), logger->observer->result_folder, relative_path_pointer, ".tdat",
+      logger->checkpoint);
   fprintf(logger->tdat_file, logger_bbob_header, str_pointer, logger->optimal_value);
-  logger_bbob_open_data_file(&(logger->rdat_file), logger->observer->result_folder, relative_path_pointer, ".rdat");
+  logger_bbob_open_data_file(&(logger->rdat_file), logger->observer->result_folder, relative_path_pointer, ".rdat",
+      logger->checkpoint);
   fprintf(logger->rdat_file, logger_bbob_header, str_pointer, logger->optimal_value);
-  logger_bbob_open_data_file(&(logger->mdat_file), logger->observer->result_folder, relative_path_pointer, ".mdat");
+  logger_bbob_open_data_file(&(logger->mdat_file), logger->observer->result_folder, relative_path_pointer, ".mdat",
+      logger->checkpoint);
   fprintf(logger->mdat_file, logger_bbob_header, str_pointer, logger->optimal_value);
 
   logger->is_initialized = 1;
@@ -579,6 +598,10 @@ static void logger_bbob_free(void *stuff) {
     logger->evaluations = NULL;
   }
 
+  /* All output of this problem is written */
+  coco_observer_checkpoint_done(logger->checkpoint);
+  logger->checkpoint = NULL;
+
   observer = logger->observer;
   if ((observer != NULL) && (observer->is_active == 1)) {
     if (observer->data != NULL) {
@@ -647,6 +670,7 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
   logger_data->tdat_file = NULL;
   logger_data->rdat_file = NULL;
   logger_data->mdat_file = NULL;
+  logger_data->checkpoint = NULL;
 
   logger_data->num_func_evaluations = 0;
   logger_data->num_cons_evaluations = 0;
@@ -674,6 +698,8 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_bbob_free, observer->observer_name);
   problem->evaluate_function = logger_bbob_evaluate;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = coco_problem_transformed_evaluate_term;
   problem->recommend_solution = logger_bbob_recommend;
 
   observer_data->observed_problem = problem;
@@ -49,6 +49,7 @@
 #include "coco_problem.c"
 #include "coco_string.c"
 #include "mo_avl_tree.c"
+#include "coco_observer_checkpoint.c"
 #include "observer_biobj.c"
 
 #include "mo_utilities.c"
@@ -146,6 +147,8 @@ typedef struct {
   int compute_indicators;             /**< @brief Whether to compute the indicators. */
   logger_biobj_indicator_t *indicators[LOGGER_BIOBJ_NUMBER_OF_INDICATORS];
                                       /**< @brief The implemented indicators. */
+  coco_observer_checkpoint_t *checkpoint;
+                                      /**< @brief Checkpoint of the experiment (NULL if not checkpointed). */
 } logger_biobj_data_t;
 
 /**
@@ -197,7 +200,7 @@ static logger_biobj_avl_item_t* logger_biobj_node_create(const coco_problem_t *p
     item->y[i] = y[i];
 
   /* Compute the normalized y */
-  item->normalized_y = mo_normalize(item->y, problem->best_value, problem->nadir_value, num_obj);
+  item->normalized_y = mo_normalize(y, problem->best_value, problem->nadir_value, num_obj);
   item->within_ROI = mo_is_within_ROI(item->normalized_y, num_obj);
 
   item->evaluation_number = evaluation_number;
@@ -489,6 +492,7 @@ static void logger_biobj_indicator_initialize_file(const logger_biobj_data_t *lo
   prefix = coco_remove_from_string(problem->problem_id, "_i", "_d");
   file_name = coco_strdupf("%s_%s.%s", prefix, indicator->name, file_ending);
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
+  coco_observer_checkpoint_add_file(logger->checkpoint, path_name);
   *f = fopen(path_name, "a");
   if (*f == NULL) {
     coco_error("logger_biobj_indicator_initialize_file() failed to open file '%s'.", path_name);
@@ -554,6 +558,7 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
   file_name = coco_strdupf("%s_%s.info", problem->problem_type, indicator_name);
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
   info_file_exists = coco_file_exists(path_name);
+  coco_observer_checkpoint_add_file(logger->checkpoint, path_name);
   indicator->info_file = fopen(path_name, "a");
   if (indicator->info_file == NULL) {
     coco_error("logger_biobj_indicator() failed to open file '%s'.", path_name);
@@ -991,6 +996,10 @@ static void logger_biobj_free(void *stuff) {
   avl_tree_destruct(logger->archive_tree);
   avl_tree_destruct(logger->buffer_tree);
 
+  /* All output of this problem is written */
+  coco_observer_checkpoint_done(logger->checkpoint);
+  logger->checkpoint = NULL;
+
   observer = logger->observer;
   if ((observer != NULL) && (observer->is_active == 1)) {
     if (observer->data != NULL) {
@@ -1039,6 +1048,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
   observer_biobj_data_t *observer_data;
   const char nondom_folder_name[] = "archive";
   char *path_name, *prefix, *file_name = NULL;
+  char *state_before, *state_after;
   size_t i;
 
   coco_debug("Started logger_biobj()");
@@ -1082,6 +1092,22 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
   else
     logger_data->log_vars = 1;
 
+  /* Record the problem in the checkpoint before anything is written (the state holds the previous function
+   * and dimension and is restored by observer_biobj) */
+  if (logger_data->compute_indicators) {
+    state_before = coco_strdupf("%ld %ld", observer_data->previous_function, observer_data->previous_dimension);
+    state_after = coco_strdupf("%lu %lu", (unsigned long) inner_problem->suite_dep_function,
+        (unsigned long) inner_problem->number_of_variables);
+  } else {
+    state_before = coco_strdup("-1 -1");
+    state_after = coco_strdup("-1 -1");
+  }
+  logger_data->checkpoint = coco_observer_checkpoint_start(observer->checkpoint,
+      inner_problem->suite_dep_function, inner_problem->number_of_variables, inner_problem->suite_dep_instance,
+      state_before, state_after);
+  coco_free_memory(state_before);
+  coco_free_memory(state_after);
+
   /* Initialize logging of nondominated solutions into the archive file */
   if ((logger_data->log_nondom_mode == LOG_NONDOM_ALL) ||
       (logger_data->log_nondom_mode == LOG_NONDOM_FINAL)) {
@@ -1101,6 +1127,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
     coco_free_memory(file_name);
 
     /* Open and initialize the archive file */
+    coco_observer_checkpoint_add_file(logger_data->checkpoint, path_name);
     logger_data->adat_file = fopen(path_name, "a");
     if (logger_data->adat_file == NULL) {
       coco_error("logger_biobj() failed to open file '%s'.", path_name);
@@ -1155,6 +1182,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
   coco_free_memory(prefix);
 
   /* Open and initialize the recommendation file */
+  coco_observer_checkpoint_add_file(logger_data->checkpoint, path_name);
   logger_data->mdat_file = fopen(path_name, "a");
   if (logger_data->mdat_file == NULL) {
     coco_error("logger_biobj() failed to open file '%s'.", path_name);
@@ -226,6 +226,8 @@ static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *inne
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_rw_free, observer->observer_name);
   problem->evaluate_function = logger_rw_evaluate;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = coco_problem_transformed_evaluate_term;
 
   return problem;
 }
@@ -93,6 +93,8 @@ static coco_problem_t *logger_toy(coco_observer_t *observer, coco_problem_t *inn
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_toy_free, observer->observer_name);
   problem->evaluate_function = logger_toy_evaluate;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = coco_problem_transformed_evaluate_term;
 
   /* Output initial information */
   assert(coco_problem_get_suite(inner_problem));
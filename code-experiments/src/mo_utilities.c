@@ -40,15 +40,18 @@ static double mo_get_norm(const double *first, const double *second, const size_
 }
 
 /**
- * @brief Creates a rounded normalized version of the given solution w.r.t. the given ROI.
+ * @brief Computes a rounded normalized version of the given solution w.r.t. the given ROI and stores it
+ * into normalized_y.
  *
  * If the solution seems to be better than the extremes it is corrected (2 objectives are assumed).
- * The caller is responsible for freeing the allocated memory using coco_free_memory().
  */
-static double *mo_normalize(const double *y, const double *ideal, const double *nadir, const size_t num_obj) {
+static void mo_normalize_into(const double *y,
+                              const double *ideal,
+                              const double *nadir,
+                              const size_t num_obj,
+                              double *normalized_y) {
 
   size_t i;
-  double *normalized_y = coco_allocate_vector(num_obj);
 
   for (i = 0; i < num_obj; i++) {
     assert((nadir[i] - ideal[i]) > mo_discretization);
@@ -67,7 +70,18 @@ static double *mo_normalize(const double *y, const double *ideal, const double *
       normalized_y[1-i] = 1;
     }
   }
+}
 
+/**
+ * @brief Creates a rounded normalized version of the given solution w.r.t. the given ROI.
+ *
+ * See mo_normalize_into() for details. The caller is responsible for freeing the allocated memory using
+ * coco_free_memory().
+ */
+static double *mo_normalize(const double *y, const double *ideal, const double *nadir, const size_t num_obj) {
+
+  double *normalized_y = coco_allocate_vector(num_obj);
+  mo_normalize_into(y, ideal, nadir, num_obj, normalized_y);
   return normalized_y;
 }
 
@@ -89,6 +89,18 @@ static void observer_bbob(coco_observer_t *observer, const char *options, coco_o
     strcpy(observer_data->prefix, "bbobexp");
   }
 
+  /* Restore the state of a resumed experiment (see logger_bbob_initialize for its format) */
+  if ((observer->checkpoint != NULL) && (observer->checkpoint->observer_state != NULL)) {
+    unsigned long last_function, last_dimension;
+    int length = 0;
+    const char *state = observer->checkpoint->observer_state;
+    if ((sscanf(state, "%lu %lu %n", &last_function, &last_dimension, &length) != 2) || (length == 0))
+      coco_error("observer_bbob(): malformed observer state '%s' in the checkpoint", state);
+    observer_data->last_function = (size_t) last_function;
+    observer_data->last_dimension = (size_t) last_dimension;
+    strncpy(observer_data->last_dat_file, state + length, COCO_PATH_MAX);
+  }
+
   observer->logger_allocate_function = logger_bbob;
   observer->logger_free_function = logger_bbob_free;
   observer->restart_function = logger_bbob_signal_restart;
@@ -141,6 +141,14 @@ static void observer_biobj(coco_observer_t *observer, const char *options, coco_
   if (observer_data->compute_indicators) {
     observer_data->previous_function = -1;
     observer_data->previous_dimension = -1;
+
+    /* Restore the state of a resumed experiment (see logger_biobj for its format) */
+    if ((observer->checkpoint != NULL) && (observer->checkpoint->observer_state != NULL)) {
+      if (sscanf(observer->checkpoint->observer_state, "%ld %ld", &observer_data->previous_function,
+          &observer_data->previous_dimension) != 2)
+        coco_error("observer_biobj(): malformed observer state '%s' in the checkpoint",
+            observer->checkpoint->observer_state);
+    }
   }
 
   observer_data->observed_problem = NULL;
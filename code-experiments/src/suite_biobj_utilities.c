@@ -7,7 +7,8 @@
  * suite_biobj_instances. If a new instance of the problem is called, a check ensures that the two underlying
  * single-objective instances create a true bi-objective problem. However, these new instances need to be
  * manually added to suite_biobj_instances, otherwise they will be computed each time the suite constructor
- * is invoked with these instances.
+ * is invoked with these instances (unless they are cached in the file given by the environment variable
+ * COCO_BIOBJ_INSTANCE_CACHE).
  */
 
 #include "coco.h"
@@ -74,66 +75,222 @@ static void suite_biobj_new_inst_free(void *stuff) {
 }
 
 /**
- * @brief  Performs a few checks and returns whether the two given problem instances should break the search
- * for new instances in suite_biobj_get_new_instance().
+ * @brief The single-objective problems of one dimension needed to check the candidate instances in
+ * suite_biobj_get_new_instance().
+ *
+ * The problems of instance1 are constructed once per search, the problems of instance2 once per candidate.
+ * The values of each problem in the optima of the other instance's problems (needed for the nadir points)
+ * are stored in matrices of size num_functions x num_functions, so that the checks can be performed in any
+ * order and the problems can be constructed and evaluated in parallel.
  */
-static int suite_biobj_check_inst_consistency(const size_t dimension,
-                                              size_t function1,
-                                              size_t instance1,
-                                              size_t function2,
-                                              size_t instance2) {
-  coco_problem_t *problem = NULL;
-  coco_problem_t *problem1, *problem2;
+typedef struct {
+  size_t dimension;               /**< @brief The dimension (0 if it is filtered out and thus skipped). */
+  const size_t *functions;        /**< @brief The bbob functions combined in pairs. */
+  size_t num_functions;           /**< @brief The number of bbob functions. */
+  const int *is_selected;         /**< @brief Whether the pair (f, f) is checked for the given function. */
+  size_t instance1;               /**< @brief The instance of the first problem. */
+  size_t instance2;               /**< @brief The (candidate) instance of the second problem. */
+  coco_problem_t **problems1;     /**< @brief The problems of instance1. */
+  coco_problem_t **problems2;     /**< @brief The problems of instance2. */
+  double *values1;                /**< @brief values1[f1 * num_functions + f2] = problem1 f1 at optimum of
+                                       problem2 f2 */
+  double *values2;                /**< @brief values2[f2 * num_functions + f1] = problem2 f2 at optimum of
+                                       problem1 f1 */
+} suite_biobj_inst_check_t;
+
+/**
+ * @brief Returns whether the pair (f1, f2) with f1 <= f2 is considered when checking a candidate instance.
+ */
+static int suite_biobj_inst_check_pair(const suite_biobj_inst_check_t *check, const size_t f1, const size_t f2) {
+  return (f1 < f2) || ((f1 == f2) && check->is_selected[f1]);
+}
+
+/**
+ * @brief Constructs the problems of the given function (task % num_functions) and dimension
+ * (task / num_functions) needed to check a candidate instance.
+ */
+static void suite_biobj_inst_check_construct(void *stuff, const size_t task) {
+
+  suite_biobj_inst_check_t *checks = (suite_biobj_inst_check_t *) stuff;
+  suite_biobj_inst_check_t *check = &checks[task / checks->num_functions];
+  const size_t f = task % check->num_functions;
+
+  if (check->dimension == 0)
+    return;
+  if (check->problems1[f] == NULL)
+    check->problems1[f] = coco_get_bbob_problem(check->functions[f], check->dimension, check->instance1);
+  if (check->problems2[f] != NULL)
+    coco_problem_free(check->problems2[f]);
+  check->problems2[f] = coco_get_bbob_problem(check->functions[f], check->dimension, check->instance2);
+}
+
+/**
+ * @brief Evaluates the problems of the given function (task % num_functions) and dimension
+ * (task / num_functions) in the optima of the problems they are paired with.
+ *
+ * Each task evaluates only its own two problems and can therefore run in parallel with the others.
+ */
+static void suite_biobj_inst_check_evaluate(void *stuff, const size_t task) {
+
+  suite_biobj_inst_check_t *checks = (suite_biobj_inst_check_t *) stuff;
+  suite_biobj_inst_check_t *check = &checks[task / checks->num_functions];
+  const size_t f = task % check->num_functions;
+  const size_t n = check->num_functions;
+  size_t g;
+
+  if (check->dimension == 0)
+    return;
+  for (g = 0; g < n; g++) {
+    if (suite_biobj_inst_check_pair(check, f, g))
+      coco_evaluate_function(check->problems1[f], check->problems2[g]->best_parameter, &check->values1[f * n + g]);
+    if (suite_biobj_inst_check_pair(check, g, f))
+      coco_evaluate_function(check->problems2[f], check->problems1[g]->best_parameter, &check->values2[f * n + g]);
+  }
+}
+
+/**
+ * @brief  Performs a few checks and returns whether the combination of problem f1 of instance1 and problem f2
+ * of instance2 should break the search for new instances in suite_biobj_get_new_instance().
+ *
+ * The checks are the same as those that would be performed on the problem stacked from the two problems.
+ */
+static int suite_biobj_check_inst_consistency(const suite_biobj_inst_check_t *check,
+                                              const size_t f1,
+                                              const size_t f2) {
+  const coco_problem_t *problem1 = check->problems1[f1];
+  const coco_problem_t *problem2 = check->problems2[f2];
   int break_search = 0;
   double norm;
-  double *smallest_values_of_interest, *largest_values_of_interest;
+  double ideal[2], nadir[2];
   const double apart_enough = 1e-4;
 
-  problem1 = coco_get_bbob_problem(function1, dimension, instance1);
-  problem2 = coco_get_bbob_problem(function2, dimension, instance2);
-
-  /* Set smallest and largest values of interest to some value (not important which, it just needs to be a
-   * vector of doubles of the right dimension) */
-  smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
-  largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
-  problem = coco_problem_stacked_allocate(problem1, problem2, smallest_values_of_interest,
-          largest_values_of_interest);
-  coco_free_memory(smallest_values_of_interest);
-  coco_free_memory(largest_values_of_interest);
+  ideal[0] = problem1->best_value[0];
+  ideal[1] = problem2->best_value[0];
+  nadir[0] = check->values1[f1 * check->num_functions + f2];
+  nadir[1] = check->values2[f2 * check->num_functions + f1];
 
   /* Check whether the ideal and nadir points are too close in the objective space */
-  norm = mo_get_norm(problem->best_value, problem->nadir_value, 2);
+  norm = mo_get_norm(ideal, nadir, 2);
   if (norm < 1e-1) { /* TODO How to set this value in a sensible manner? */
     coco_debug(
-        "suite_biobj_check_inst_consistency(): The ideal and nadir points of %s are too close in the objective space",
-        problem->problem_id);
-    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, problem->best_value[0],
-        problem->best_value[1], problem->nadir_value[0], problem->nadir_value[1]);
+        "suite_biobj_check_inst_consistency(): The ideal and nadir points of %s__%s are too close in the objective space",
+        problem1->problem_id, problem2->problem_id);
+    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, ideal[0], ideal[1], nadir[0], nadir[1]);
     break_search = 1;
   }
 
   /* Check whether the extreme optimal points are too close in the decision space */
-  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, problem->number_of_variables);
+  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, check->dimension);
   if (norm < apart_enough) {
     coco_debug(
-        "suite_biobj_check_inst_consistency(): The extreme points of %s are too close in the decision space",
-        problem->problem_id);
+        "suite_biobj_check_inst_consistency(): The extreme points of %s__%s are too close in the decision space",
+        problem1->problem_id, problem2->problem_id);
     coco_debug("norm = %e", norm);
     break_search = 1;
   }
 
-  /* Clean up */
-  if (problem) {
-    coco_problem_stacked_free(problem);
-    problem = NULL;
+  return break_search;
+}
+
+/**
+ * @brief Returns the name of the file caching the new instances, which is given by the environment variable
+ * COCO_BIOBJ_INSTANCE_CACHE (NULL if it is not set).
+ *
+ * The file contains lines "instance instance1 instance2 dimensions", where dimensions is a comma-separated
+ * list of the dimensions the instance was checked in. The file can be shared by concurrent processes, as they
+ * only append whole lines to it.
+ */
+static const char *suite_biobj_get_instance_cache_name(void) {
+  const char *file_name = getenv("COCO_BIOBJ_INSTANCE_CACHE");
+  if ((file_name == NULL) || (strlen(file_name) == 0))
+    return NULL;
+  return file_name;
+}
+
+/**
+ * @brief Returns the comma-separated list of (non-zero) dimensions used to identify cached instances.
+ */
+static char *suite_biobj_get_instance_cache_dimensions(const size_t *dimensions, const size_t num_dimensions) {
+
+  char *string = coco_allocate_string(num_dimensions * 21);
+  size_t d, length = 0;
+
+  for (d = 0; d < num_dimensions; d++) {
+    if (dimensions[d] == 0)
+      continue;
+    length += (size_t) sprintf(string + length, "%s%lu", length > 0 ? "," : "", (unsigned long) dimensions[d]);
   }
+  return string;
+}
 
-  return break_search;
+/**
+ * @brief Looks up the given instance in the instance cache file and returns the second instance (or 0 if
+ * it is not found).
+ */
+static size_t suite_biobj_read_instance_cache(const size_t instance,
+                                              const size_t instance1,
+                                              const size_t *dimensions,
+                                              const size_t num_dimensions) {
 
+  const char *file_name = suite_biobj_get_instance_cache_name();
+  char *dimension_string, line[COCO_PATH_MAX + 1], line_dimensions[COCO_PATH_MAX + 1];
+  unsigned long line_instance, line_instance1, line_instance2;
+  size_t instance2 = 0;
+  FILE *file;
+
+  if (file_name == NULL)
+    return 0;
+  file = fopen(file_name, "r");
+  if (file == NULL)
+    return 0;
+
+  dimension_string = suite_biobj_get_instance_cache_dimensions(dimensions, num_dimensions);
+  while (fgets(line, COCO_PATH_MAX, file) != NULL) {
+    if ((sscanf(line, "%lu %lu %lu %s", &line_instance, &line_instance1, &line_instance2, line_dimensions) == 4)
+        && (line_instance == instance) && (line_instance1 == instance1)
+        && (strcmp(line_dimensions, dimension_string) == 0)) {
+      instance2 = (size_t) line_instance2;
+      break;
+    }
+  }
+  coco_free_memory(dimension_string);
+  fclose(file);
+  return instance2;
+}
+
+/**
+ * @brief Appends the given instance to the instance cache file (if it is used).
+ */
+static void suite_biobj_write_instance_cache(const size_t instance,
+                                             const size_t instance1,
+                                             const size_t instance2,
+                                             const size_t *dimensions,
+                                             const size_t num_dimensions) {
+
+  const char *file_name = suite_biobj_get_instance_cache_name();
+  char *line, *dimension_string;
+  FILE *file;
+
+  if (file_name == NULL)
+    return;
+  file = fopen(file_name, "a");
+  if (file == NULL) {
+    coco_warning("suite_biobj_write_instance_cache(): failed to open file '%s'", file_name);
+    return;
+  }
+
+  /* Write the whole line at once, so that lines of concurrent processes are not interleaved */
+  dimension_string = suite_biobj_get_instance_cache_dimensions(dimensions, num_dimensions);
+  line = coco_strdupf("%lu %lu %lu %s\n", (unsigned long) instance, (unsigned long) instance1,
+      (unsigned long) instance2, dimension_string);
+  fputs(line, file);
+  coco_free_memory(line);
+  coco_free_memory(dimension_string);
+  fclose(file);
 }
 
 /**
- * @brief Computes the instance number of the second problem/objective so that the resulting bi-objective
+ * @brief Searches for the instance number of the second problem/objective so that the resulting bi-objective
  * problem has more than a single optimal solution.
  *
  * Starts by setting instance2 = instance1 + 1 and increases this number until an appropriate instance has
@@ -141,24 +298,60 @@ static int suite_biobj_check_inst_consistency(const size_t dimension,
  * An appropriate instance is the one for which the resulting bi-objective problem (in any considered
  * dimension) has the ideal and nadir points apart enough in the objective space and the extreme optimal
  * points apart enough in the decision space. When the instance has been found, it is output through
- * coco_warning, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ * coco_info, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ *
+ * The single-objective problems of instance1 are constructed only once and those of each candidate
+ * instance2 only once per dimension (instead of once per pair of functions). Their construction and
+ * evaluation is distributed among threads by coco_run_tasks().
  */
-static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data,
-                                           const size_t instance,
-                                           const size_t instance1,
-                                           const size_t *bbob_functions,
-                                           const size_t num_bbob_functions,
-                                           const size_t *sel_bbob_functions,
-                                           const size_t num_sel_bbob_functions,
-                                           const size_t *dimensions,
-                                           const size_t num_dimensions) {
+static size_t suite_biobj_search_new_instance(const size_t instance,
+                                              const size_t instance1,
+                                              const size_t *bbob_functions,
+                                              const size_t num_bbob_functions,
+                                              const size_t *sel_bbob_functions,
+                                              const size_t num_sel_bbob_functions,
+                                              const size_t *dimensions,
+                                              const size_t num_dimensions) {
 
   size_t instance2 = 0;
   size_t num_tries = 0;
   const size_t max_tries = 1000;
   int appropriate_instance_found = 0, break_search, warning_produced = 0;
   size_t d, f1, f2, i;
-  size_t function1, function2, dimension;
+  suite_biobj_inst_check_t *checks;
+  int *is_selected;
+
+  is_selected = (int *) coco_allocate_memory(num_bbob_functions * sizeof(int));
+  for (f1 = 0; f1 < num_bbob_functions; f1++) {
+    is_selected[f1] = 0;
+    for (i = 0; i < num_sel_bbob_functions; i++) {
+      if (sel_bbob_functions[i] == bbob_functions[f1])
+        is_selected[f1] = 1;
+    }
+  }
+
+  checks = (suite_biobj_inst_check_t *) coco_allocate_memory(num_dimensions * sizeof(*checks));
+  for (d = 0; d < num_dimensions; d++) {
+    checks[d].dimension = dimensions[d];
+    checks[d].functions = bbob_functions;
+    checks[d].num_functions = num_bbob_functions;
+    checks[d].is_selected = is_selected;
+    checks[d].instance1 = instance1;
+    checks[d].problems1 = (coco_problem_t **) coco_allocate_memory(num_bbob_functions * sizeof(coco_problem_t *));
+    checks[d].problems2 = (coco_problem_t **) coco_allocate_memory(num_bbob_functions * sizeof(coco_problem_t *));
+    for (f1 = 0; f1 < num_bbob_functions; f1++) {
+      checks[d].problems1[f1] = NULL;
+      checks[d].problems2[f1] = NULL;
+    }
+    checks[d].values1 = coco_allocate_vector(num_bbob_functions * num_bbob_functions);
+    checks[d].values2 = coco_allocate_vector(num_bbob_functions * num_bbob_functions);
+
+    if (dimensions[d] == 0) {
+      if (!warning_produced)
+        coco_warning("suite_biobj_search_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
+      warning_produced = 1;
+    }
+  }
 
   while ((!appropriate_instance_found) && (num_tries < max_tries)) {
     num_tries++;
@@ -168,125 +361,120 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
     /* An instance is "appropriate" if the ideal and nadir points in the objective space and the two
      * extreme optimal points in the decisions space are apart enough for all problems (all dimensions
      * and function combinations); therefore iterate over all dimensions and function combinations */
-
-    for (f1 = 0; (f1 < num_bbob_functions-1) && !break_search; f1++) {
-      function1 = bbob_functions[f1];
-      for (f2 = f1+1; (f2 < num_bbob_functions) && !break_search; f2++) {
-        function2 = bbob_functions[f2];
+    for (d = 0; d < num_dimensions; d++)
+      checks[d].instance2 = instance2;
+    coco_run_tasks(suite_biobj_inst_check_construct, checks, num_dimensions * num_bbob_functions);
+    coco_run_tasks(suite_biobj_inst_check_evaluate, checks, num_dimensions * num_bbob_functions);
+
+    /* Check all functions (f1, f2) with f1 < f2 and all functions (f, f) with f in {f1, f2, f6, f8, f13,
+     * f14, f15, f17, f20, f21} */
+    for (f1 = 0; (f1 < num_bbob_functions) && !break_search; f1++) {
+      for (f2 = f1; (f2 < num_bbob_functions) && !break_search; f2++) {
+        if (!suite_biobj_inst_check_pair(&checks[0], f1, f2))
+          continue;
         for (d = 0; (d < num_dimensions) && !break_search; d++) {
-          dimension = dimensions[d];
-
-          if (dimension == 0) {
-            if (!warning_produced)
-              coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
-            warning_produced = 1;
+          if (checks[d].dimension == 0)
             continue;
-          }
-
-          break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
+          break_search = suite_biobj_check_inst_consistency(&checks[d], f1, f2);
         }
       }
     }
 
-    /* Finally, check all functions (f,f) with f in {f1, f2, f6, f8, f13, f14, f15, f17, f20, f21}: */
-    for (f1 = 0; (f1 < num_sel_bbob_functions) && !break_search; f1++) {
-      function1 = sel_bbob_functions[f1];
-      function2 = sel_bbob_functions[f1];
-      for (d = 0; (d < num_dimensions) && !break_search; d++) {
-        dimension = dimensions[d];
-
-        if (dimension == 0) {
-            if (!warning_produced)
-              coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
-            warning_produced = 1;
-            continue;
-          }
-
-        break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
-      }
-    }
-
     if (break_search) {
       /* The search was broken, continue with next instance2 */
       continue;
     } else {
       /* An appropriate instance was found */
       appropriate_instance_found = 1;
-      coco_info("suite_biobj_get_new_instance(): Instance %lu created from instances %lu and %lu",
+      coco_info("suite_biobj_search_new_instance(): Instance %lu created from instances %lu and %lu",
           (unsigned long) instance, (unsigned long) instance1, (unsigned long) instance2);
+    }
+  }
 
-      /* Save the instance to new_instances */
-      for (i = 0; i < new_inst_data->max_new_instances; i++) {
-        if (new_inst_data->new_instances[i][0] == 0) {
-          new_inst_data->new_instances[i][0] = instance;
-          new_inst_data->new_instances[i][1] = instance1;
-          new_inst_data->new_instances[i][2] = instance2;
-          break;
-        };
-      }
+  for (d = 0; d < num_dimensions; d++) {
+    for (f1 = 0; f1 < num_bbob_functions; f1++) {
+      if (checks[d].problems1[f1] != NULL)
+        coco_problem_free(checks[d].problems1[f1]);
+      if (checks[d].problems2[f1] != NULL)
+        coco_problem_free(checks[d].problems2[f1]);
     }
+    coco_free_memory(checks[d].problems1);
+    coco_free_memory(checks[d].problems2);
+    coco_free_memory(checks[d].values1);
+    coco_free_memory(checks[d].values2);
   }
+  coco_free_memory(checks);
+  coco_free_memory(is_selected);
 
   if (!appropriate_instance_found) {
-    coco_error("suite_biobj_get_new_instance(): Could not find suitable instance %lu in %lu tries",
+    coco_error("suite_biobj_search_new_instance(): Could not find suitable instance %lu in %lu tries",
         (unsigned long) instance, (unsigned long) num_tries);
     return 0; /* Never reached */
   }
-
   return instance2;
 }
 
 /**
- * @brief Creates and returns a bi-objective problem without needing a suite.
+ * @brief Returns the instance number of the second problem/objective so that the resulting bi-objective
+ * problem has more than a single optimal solution and saves it to new_inst_data.
  *
- * Useful for creating suites based on the bi-objective problems.
- *
- * Creates the bi-objective problem by constructing it from two single-objective problems. If the
- * invoked instance number is not in suite_biobj_instances, the function uses the following formula
- * to construct a new appropriate instance:
- *   problem1_instance = 2 * biobj_instance + 1
- *   problem2_instance = problem1_instance + 1
- *
- * If needed, problem2_instance is increased (see also the explanation in suite_biobj_get_new_instance).
- *
- * @param function Function
- * @param dimension Dimension
- * @param instance Instance
- * @param coco_get_problem_function The function that is used to access the single-objective problem.
- * @param new_inst_data Structure containing information on new instance data.
- * @param num_new_instances The number of new instances.
- * @param dimensions An array of dimensions to take into account when creating new instances.
- * @param num_dimensions The number of dimensions to take into account when creating new instances.
- * @return The problem that corresponds to the given parameters.
+ * The instance is read from the instance cache file (see suite_biobj_get_instance_cache_name()) if it is
+ * there, otherwise it is searched for (see suite_biobj_search_new_instance()) and appended to the file, so
+ * that later processes do not need to search for it again. The cached instances are identified by instance,
+ * instance1 and the dimensions only (and not by the suite), because the search always checks the same bbob
+ * functions and does not depend on anything else.
  */
-static coco_problem_t *coco_get_biobj_problem(const size_t function,
-                                              const size_t dimension,
-                                              const size_t instance,
-                                              const coco_get_problem_function_t coco_get_problem_function,
-                                              suite_biobj_new_inst_t **new_inst_data,
-                                              const size_t num_new_instances,
-                                              const size_t *dimensions,
-                                              const size_t num_dimensions) {
-  
+static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data,
+                                           const size_t instance,
+                                           const size_t instance1,
+                                           const size_t *bbob_functions,
+                                           const size_t num_bbob_functions,
+                                           const size_t *sel_bbob_functions,
+                                           const size_t num_sel_bbob_functions,
+                                           const size_t *dimensions,
+                                           const size_t num_dimensions) {
+
+  size_t instance2;
+  size_t i;
+
+  instance2 = suite_biobj_read_instance_cache(instance, instance1, dimensions, num_dimensions);
+  if (instance2 > 0) {
+    coco_debug("suite_biobj_get_new_instance(): Instance %lu read from the instance cache",
+        (unsigned long) instance);
+  } else {
+    instance2 = suite_biobj_search_new_instance(instance, instance1, bbob_functions, num_bbob_functions,
+        sel_bbob_functions, num_sel_bbob_functions, dimensions, num_dimensions);
+    suite_biobj_write_instance_cache(instance, instance1, instance2, dimensions, num_dimensions);
+  }
+
+  /* Save the instance to new_instances */
+  for (i = 0; i < new_inst_data->max_new_instances; i++) {
+    if (new_inst_data->new_instances[i][0] == 0) {
+      new_inst_data->new_instances[i][0] = instance;
+      new_inst_data->new_instances[i][1] = instance1;
+      new_inst_data->new_instances[i][2] = instance2;
+      break;
+    };
+  }
+
+  return instance2;
+}
+
+/**
+ * @brief Computes the numbers of the two bbob functions that are combined into the given bi-objective
+ * function (of the bbob-biobj or bbob-biobj-ext suites).
+ */
+static void suite_biobj_get_bbob_functions(const size_t function, size_t *function1, size_t *function2) {
+
   /* Selected functions from the bbob suite that are used to construct the original bbob-biobj suite. */
   const size_t sel_bbob_functions[] = { 1, 2, 6, 8, 13, 14, 15, 17, 20, 21 };
   const size_t num_sel_bbob_functions = 10;
-  /* All functions from the bbob suite for later use during instance generation. */
+  /* All functions from the bbob suite that are used to construct the functions of bbob-biobj-ext. */
   const size_t all_bbob_functions[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24 };
-  const size_t num_all_bbob_functions = 24;
-  
-  coco_problem_t *problem1 = NULL, *problem2 = NULL, *problem = NULL;
-  size_t instance1 = 0, instance2 = 0;
-  size_t function1_idx, function2_idx;
-  const size_t function_idx = function - 1;
 
-  size_t i, j;
-  const size_t num_existing_instances = sizeof(suite_biobj_instances) / sizeof(suite_biobj_instances[0]);
-  int instance_found = 0;
+  size_t function1_idx = 0, function2_idx = 0;
+  const size_t function_idx = function - 1;
 
-  double *smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
-  double *largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
-  
   /* Determine the corresponding single-objective function indices */
   if (function_idx < 55) {
     /* A "magic" formula to compute the BBOB function index from the bi-objective function index */
@@ -407,9 +595,71 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
     function1_idx = 22;
     function2_idx = 23;
   } else {
-    coco_error("coco_get_biobj_problem(): Invalid function index %i.", function_idx);
+    coco_error("suite_biobj_get_bbob_functions(): Invalid function index %i.", function_idx);
+  }
+
+  if (function_idx < 55) {
+    *function1 = sel_bbob_functions[function1_idx];
+    *function2 = sel_bbob_functions[function2_idx];
+  } else {
+    *function1 = all_bbob_functions[function1_idx];
+    *function2 = all_bbob_functions[function2_idx];
   }
-      
+}
+
+/**
+ * @brief Creates and returns a bi-objective problem without needing a suite.
+ *
+ * Useful for creating suites based on the bi-objective problems.
+ *
+ * Creates the bi-objective problem by constructing it from two single-objective problems. If the
+ * invoked instance number is not in suite_biobj_instances, the function uses the following formula
+ * to construct a new appropriate instance:
+ *   problem1_instance = 2 * biobj_instance + 1
+ *   problem2_instance = problem1_instance + 1
+ *
+ * If needed, problem2_instance is increased (see also the explanation in suite_biobj_get_new_instance).
+ *
+ * @param function Function
+ * @param dimension Dimension
+ * @param instance Instance
+ * @param coco_get_problem_function The function that is used to access the single-objective problem.
+ * @param new_inst_data Structure containing information on new instance data.
+ * @param num_new_instances The number of new instances.
+ * @param dimensions An array of dimensions to take into account when creating new instances.
+ * @param num_dimensions The number of dimensions to take into account when creating new instances.
+ * @return The problem that corresponds to the given parameters.
+ */
+static coco_problem_t *coco_get_biobj_problem(const size_t function,
+                                              const size_t dimension,
+                                              const size_t instance,
+                                              const coco_get_problem_function_t coco_get_problem_function,
+                                              suite_biobj_new_inst_t **new_inst_data,
+                                              const size_t num_new_instances,
+                                              const size_t *dimensions,
+                                              const size_t num_dimensions) {
+  
+  /* Selected functions from the bbob suite that are used to construct the original bbob-biobj suite. */
+  const size_t sel_bbob_functions[] = { 1, 2, 6, 8, 13, 14, 15, 17, 20, 21 };
+  const size_t num_sel_bbob_functions = 10;
+  /* All functions from the bbob suite for later use during instance generation. */
+  const size_t all_bbob_functions[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24 };
+  const size_t num_all_bbob_functions = 24;
+  
+  coco_problem_t *problem1 = NULL, *problem2 = NULL, *problem = NULL;
+  size_t instance1 = 0, instance2 = 0;
+  size_t function1, function2;
+
+  size_t i, j;
+  const size_t num_existing_instances = sizeof(suite_biobj_instances) / sizeof(suite_biobj_instances[0]);
+  int instance_found = 0;
+
+  double *smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
+  double *largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
+
+  /* Determine the corresponding single-objective functions */
+  suite_biobj_get_bbob_functions(function, &function1, &function2);
+  
   /* Determine the instances */
 
   /* First search for the instance in suite_biobj_instances */
@@ -466,19 +716,11 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
   }
   
   /* Construct the problem based on the function index and dimension */
-  if (function_idx < 55) {
-    problem1 = coco_get_problem_function(sel_bbob_functions[function1_idx], dimension, instance1);
-    problem2 = coco_get_problem_function(sel_bbob_functions[function2_idx], dimension, instance2);
-    /* Store function numbers of the underlying problems */
-    problem1->suite_dep_function = sel_bbob_functions[function1_idx];
-    problem2->suite_dep_function = sel_bbob_functions[function2_idx];
-
-  } else {
-    problem1 = coco_get_problem_function(all_bbob_functions[function1_idx], dimension, instance1);
-    problem2 = coco_get_problem_function(all_bbob_functions[function2_idx], dimension, instance2);
-    problem1->suite_dep_function = all_bbob_functions[function1_idx];
-    problem2->suite_dep_function = all_bbob_functions[function2_idx];
-  }
+  problem1 = coco_get_problem_function(function1, dimension, instance1);
+  problem2 = coco_get_problem_function(function2, dimension, instance2);
+  /* Store function numbers of the underlying problems */
+  problem1->suite_dep_function = function1;
+  problem2->suite_dep_function = function2;
 
   problem = coco_problem_stacked_allocate(problem1, problem2, smallest_values_of_interest, largest_values_of_interest);
 
@@ -497,6 +739,54 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
   return problem;
 }
 
+/**
+ * @brief Computes the ideal and nadir points of the given problem from the bbob-biobj or bbob-biobj-ext
+ * suite without constructing the suite or the bi-objective problem.
+ *
+ * Only the two single-objective problems are constructed: the ideal point consists of their optimal values
+ * and the nadir point of their values in each other's optimum (exactly as in coco_problem_stacked_allocate).
+ * Returns 1 on success and 0 if the instance is not in suite_biobj_instances (new instances can only be
+ * determined by the suite).
+ */
+static int suite_biobj_get_ideal_and_nadir(const size_t function,
+                                           const size_t dimension,
+                                           const size_t instance,
+                                           const coco_get_problem_function_t coco_get_problem_function,
+                                           double *ideal,
+                                           double *nadir) {
+
+  coco_problem_t *problem1, *problem2;
+  size_t function1, function2;
+  size_t instance1 = 0, instance2 = 0;
+  size_t i;
+  const size_t num_existing_instances = sizeof(suite_biobj_instances) / sizeof(suite_biobj_instances[0]);
+  int instance_found = 0;
+
+  for (i = 0; i < num_existing_instances; i++) {
+    if (suite_biobj_instances[i][0] == instance) {
+      instance1 = suite_biobj_instances[i][1];
+      instance2 = suite_biobj_instances[i][2];
+      instance_found = 1;
+      break;
+    }
+  }
+  if (!instance_found)
+    return 0;
+
+  suite_biobj_get_bbob_functions(function, &function1, &function2);
+  problem1 = coco_get_problem_function(function1, dimension, instance1);
+  problem2 = coco_get_problem_function(function2, dimension, instance2);
+
+  ideal[0] = problem1->best_value[0];
+  ideal[1] = problem2->best_value[0];
+  coco_evaluate_function(problem1, problem2->best_parameter, &nadir[0]);
+  coco_evaluate_function(problem2, problem1->best_parameter, &nadir[1]);
+
+  coco_problem_free(problem1);
+  coco_problem_free(problem2);
+  return 1;
+}
+
 /**
  * @brief Saves the best known value for the hypervolume indicator matching the given key.
  *
@@ -676,7 +676,7 @@ static coco_problem_t *f_different_powers_c_linear_cons_bbob_problem_allocate(co
   problem = f_different_powers_bbob_constrained_problem_allocate(function, dimension,
       instance, rseed, problem_id_template, problem_name_template);
       
-  bbob_evaluate_gradient(problem, all_zeros, feasible_direction);
+  f_different_powers_bbob_constrained_evaluate_legacy_gradient(problem, all_zeros, feasible_direction);
   feasible_direction_set_length(feasible_direction, xopt, dimension, rseed);
   
   /* Create the constraints. Use the gradient of the objective
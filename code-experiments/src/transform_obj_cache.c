@@ -0,0 +1,331 @@
+/**
+ * @file transform_obj_cache.c
+ * @brief Implementation of a cache of objective and constraint values of already evaluated solutions.
+ *
+ * The cache holds the objective and constraint values of the most recently evaluated solutions (least
+ * recently used solutions are evicted first). Solutions are identified by the bit patterns of their
+ * decision vectors, so that only exact matches are considered as hits. On a hit, the cached values are
+ * returned without evaluating the inner problem.
+ *
+ * The cache is meant to be wrapped directly inside the logger. This way, cache hits are still counted and
+ * logged as evaluations, only the computation is skipped.
+ *
+ * @note The cache must not be used on noisy problems.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_problem.c"
+
+/** @brief Marks the end of a list of cache entries. */
+#define TRANSFORM_OBJ_CACHE_NONE ((size_t) -1)
+
+/**
+ * @brief Data type for transform_obj_cache.
+ *
+ * The cache entries are stored in preallocated arrays. Each entry belongs to a chain of entries with the
+ * same hash bucket and to a doubly-linked list ordered by recency of use.
+ */
+typedef struct {
+  size_t capacity;              /**< @brief Maximal number of cached solutions */
+  size_t number_of_entries;     /**< @brief Current number of cached solutions */
+  size_t entry_size;            /**< @brief Number of doubles stored per entry (x, y and constraints) */
+  double *values;               /**< @brief The stored x, y and constraint values of all entries */
+  uint64_t *hashes;             /**< @brief The hash of x of each entry */
+  int *has_objectives;          /**< @brief Whether the objective values of the entry are known */
+  int *has_constraints;         /**< @brief Whether the constraint values of the entry are known */
+
+  size_t number_of_buckets;     /**< @brief Number of hash buckets (a power of two) */
+  size_t *buckets;              /**< @brief The first entry of each bucket */
+  size_t *next_in_bucket;       /**< @brief The next entry in the same bucket */
+  size_t *newer;                /**< @brief The more recently used neighbor */
+  size_t *older;                /**< @brief The less recently used neighbor */
+  size_t newest;                /**< @brief The most recently used entry */
+  size_t oldest;                /**< @brief The least recently used entry */
+
+  coco_evaluation_cache_statistics_t *statistics; /**< @brief Shared hit statistics (can be NULL) */
+} transform_obj_cache_data_t;
+
+/**
+ * @brief Computes the hash of the bit pattern of x.
+ */
+static uint64_t transform_obj_cache_hash(const double *x, const size_t dimension) {
+  size_t i;
+  uint64_t bits, hash = 14695981039346656037ULL;
+
+  for (i = 0; i < dimension; i++) {
+    memcpy(&bits, &x[i], sizeof(bits));
+    hash ^= bits;
+    hash *= 1099511628211ULL;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+/**
+ * @brief Removes the entry from the list ordered by recency of use.
+ */
+static void transform_obj_cache_unlink(transform_obj_cache_data_t *data, const size_t entry) {
+  if (data->newer[entry] != TRANSFORM_OBJ_CACHE_NONE)
+    data->older[data->newer[entry]] = data->older[entry];
+  else
+    data->newest = data->older[entry];
+  if (data->older[entry] != TRANSFORM_OBJ_CACHE_NONE)
+    data->newer[data->older[entry]] = data->newer[entry];
+  else
+    data->oldest = data->newer[entry];
+}
+
+/**
+ * @brief Adds the entry (which must not be in the list ordered by recency of use) as the most recently used
+ * one.
+ */
+static void transform_obj_cache_link_newest(transform_obj_cache_data_t *data, const size_t entry) {
+  data->older[entry] = data->newest;
+  data->newer[entry] = TRANSFORM_OBJ_CACHE_NONE;
+  if (data->newest != TRANSFORM_OBJ_CACHE_NONE)
+    data->newer[data->newest] = entry;
+  data->newest = entry;
+  if (data->oldest == TRANSFORM_OBJ_CACHE_NONE)
+    data->oldest = entry;
+}
+
+/**
+ * @brief Marks the entry as the most recently used one.
+ */
+static void transform_obj_cache_touch(transform_obj_cache_data_t *data, const size_t entry) {
+  if (data->newest == entry)
+    return;
+  transform_obj_cache_unlink(data, entry);
+  transform_obj_cache_link_newest(data, entry);
+}
+
+/**
+ * @brief Returns the entry that holds x or TRANSFORM_OBJ_CACHE_NONE if there is none.
+ */
+static size_t transform_obj_cache_find(const transform_obj_cache_data_t *data,
+                                       const double *x,
+                                       const size_t dimension,
+                                       const uint64_t hash) {
+  size_t entry = data->buckets[hash & (data->number_of_buckets - 1)];
+
+  while (entry != TRANSFORM_OBJ_CACHE_NONE) {
+    if ((data->hashes[entry] == hash)
+        && (memcmp(&data->values[entry * data->entry_size], x, dimension * sizeof(double)) == 0))
+      return entry;
+    entry = data->next_in_bucket[entry];
+  }
+  return TRANSFORM_OBJ_CACHE_NONE;
+}
+
+/**
+ * @brief Stores x in the cache (evicting the least recently used entry if the cache is full) and returns
+ * the entry that holds it.
+ */
+static size_t transform_obj_cache_insert(transform_obj_cache_data_t *data,
+                                         const double *x,
+                                         const size_t dimension,
+                                         const uint64_t hash) {
+  size_t entry, *link;
+
+  if (data->number_of_entries < data->capacity) {
+    entry = data->number_of_entries++;
+  } else {
+    /* Evict the least recently used entry and remove it from its bucket and from the list */
+    entry = data->oldest;
+    link = &data->buckets[data->hashes[entry] & (data->number_of_buckets - 1)];
+    while (*link != entry)
+      link = &data->next_in_bucket[*link];
+    *link = data->next_in_bucket[entry];
+    transform_obj_cache_unlink(data, entry);
+  }
+
+  memcpy(&data->values[entry * data->entry_size], x, dimension * sizeof(double));
+  data->hashes[entry] = hash;
+  data->has_objectives[entry] = 0;
+  data->has_constraints[entry] = 0;
+  data->next_in_bucket[entry] = data->buckets[hash & (data->number_of_buckets - 1)];
+  data->buckets[hash & (data->number_of_buckets - 1)] = entry;
+  transform_obj_cache_link_newest(data, entry);
+  return entry;
+}
+
+/**
+ * @brief Returns the objective values of x from the cache or evaluates the inner problem.
+ */
+static void transform_obj_cache_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+  transform_obj_cache_data_t *data;
+  size_t entry;
+  uint64_t hash;
+  double *cached_y;
+  const size_t dimension = problem->number_of_variables;
+
+  data = (transform_obj_cache_data_t *) coco_problem_transformed_get_data(problem);
+  hash = transform_obj_cache_hash(x, dimension);
+  entry = transform_obj_cache_find(data, x, dimension, hash);
+  if (data->statistics != NULL)
+    data->statistics->number_of_lookups++;
+
+  if ((entry != TRANSFORM_OBJ_CACHE_NONE) && data->has_objectives[entry]) {
+    cached_y = &data->values[entry * data->entry_size + dimension];
+    memcpy(y, cached_y, problem->number_of_objectives * sizeof(double));
+    transform_obj_cache_touch(data, entry);
+    if (data->statistics != NULL)
+      data->statistics->number_of_hits++;
+    return;
+  }
+
+  coco_evaluate_function(coco_problem_transformed_get_inner_problem(problem), x, y);
+  if (entry == TRANSFORM_OBJ_CACHE_NONE)
+    entry = transform_obj_cache_insert(data, x, dimension, hash);
+  else
+    transform_obj_cache_touch(data, entry);
+  cached_y = &data->values[entry * data->entry_size + dimension];
+  memcpy(cached_y, y, problem->number_of_objectives * sizeof(double));
+  data->has_objectives[entry] = 1;
+}
+
+/**
+ * @brief Returns the constraint values of x from the cache or evaluates the inner problem.
+ */
+static void transform_obj_cache_evaluate_constraint(coco_problem_t *problem,
+                                                    const double *x,
+                                                    double *y,
+                                                    int update_counter) {
+  transform_obj_cache_data_t *data;
+  size_t entry;
+  uint64_t hash;
+  double *cached_y;
+  const size_t dimension = problem->number_of_variables;
+  const size_t offset = dimension + problem->number_of_objectives;
+
+  data = (transform_obj_cache_data_t *) coco_problem_transformed_get_data(problem);
+  hash = transform_obj_cache_hash(x, dimension);
+  entry = transform_obj_cache_find(data, x, dimension, hash);
+  if (data->statistics != NULL)
+    data->statistics->number_of_lookups++;
+
+  if ((entry != TRANSFORM_OBJ_CACHE_NONE) && data->has_constraints[entry]) {
+    cached_y = &data->values[entry * data->entry_size + offset];
+    memcpy(y, cached_y, problem->number_of_constraints * sizeof(double));
+    transform_obj_cache_touch(data, entry);
+    if (data->statistics != NULL)
+      data->statistics->number_of_hits++;
+    return;
+  }
+
+  coco_evaluate_constraint_optional_update(coco_problem_transformed_get_inner_problem(problem), x, y,
+      update_counter);
+  if (entry == TRANSFORM_OBJ_CACHE_NONE)
+    entry = transform_obj_cache_insert(data, x, dimension, hash);
+  else
+    transform_obj_cache_touch(data, entry);
+  cached_y = &data->values[entry * data->entry_size + offset];
+  memcpy(cached_y, y, problem->number_of_constraints * sizeof(double));
+  data->has_constraints[entry] = 1;
+}
+
+/**
+ * @brief Releases a reference to the shared cache statistics and frees them if no references are left.
+ */
+static void transform_obj_cache_statistics_release(coco_evaluation_cache_statistics_t *statistics) {
+  if (statistics == NULL)
+    return;
+  assert(statistics->number_of_references > 0);
+  statistics->number_of_references--;
+  if (statistics->number_of_references == 0)
+    coco_free_memory(statistics);
+}
+
+/**
+ * @brief Frees the data object.
+ */
+static void transform_obj_cache_free(void *thing) {
+  transform_obj_cache_data_t *data = (transform_obj_cache_data_t *) thing;
+  coco_free_memory(data->values);
+  coco_free_memory(data->hashes);
+  coco_free_memory(data->has_objectives);
+  coco_free_memory(data->has_constraints);
+  coco_free_memory(data->buckets);
+  coco_free_memory(data->next_in_bucket);
+  coco_free_memory(data->newer);
+  coco_free_memory(data->older);
+  transform_obj_cache_statistics_release(data->statistics);
+}
+
+/**
+ * @brief Creates the transformation.
+ *
+ * @param inner_problem The problem to be cached.
+ * @param capacity The maximal number of cached solutions.
+ * @param statistics Hit statistics shared with other caches (e.g. owned by the observer) or NULL.
+ */
+static coco_problem_t *transform_obj_cache(coco_problem_t *inner_problem,
+                                           const size_t capacity,
+                                           coco_evaluation_cache_statistics_t *statistics) {
+  coco_problem_t *problem;
+  transform_obj_cache_data_t *data;
+  char *problem_name;
+  size_t i;
+
+  assert(capacity > 0);
+  if (inner_problem->is_noisy)
+    coco_error("transform_obj_cache(): Caching noisy problem %s is not allowed", inner_problem->problem_id);
+
+  data = (transform_obj_cache_data_t *) coco_allocate_memory(sizeof(*data));
+  data->capacity = capacity;
+  data->number_of_entries = 0;
+  data->entry_size = inner_problem->number_of_variables + inner_problem->number_of_objectives
+      + inner_problem->number_of_constraints;
+  data->values = coco_allocate_vector(capacity * data->entry_size);
+  data->hashes = (uint64_t *) coco_allocate_memory(capacity * sizeof(uint64_t));
+  data->has_objectives = (int *) coco_allocate_memory(capacity * sizeof(int));
+  data->has_constraints = (int *) coco_allocate_memory(capacity * sizeof(int));
+  data->number_of_buckets = 1;
+  while (data->number_of_buckets < 2 * capacity)
+    data->number_of_buckets *= 2;
+  data->buckets = coco_allocate_vector_size_t(data->number_of_buckets);
+  for (i = 0; i < data->number_of_buckets; i++)
+    data->buckets[i] = TRANSFORM_OBJ_CACHE_NONE;
+  data->next_in_bucket = coco_allocate_vector_size_t(capacity);
+  data->newer = coco_allocate_vector_size_t(capacity);
+  data->older = coco_allocate_vector_size_t(capacity);
+  data->newest = TRANSFORM_OBJ_CACHE_NONE;
+  data->oldest = TRANSFORM_OBJ_CACHE_NONE;
+  data->statistics = statistics;
+  if (statistics != NULL)
+    statistics->number_of_references++;
+
+  /* The cache is invisible in the output, so the name of the inner problem is kept */
+  problem_name = coco_strdup(inner_problem->problem_name);
+  problem = coco_problem_transformed_allocate(inner_problem, data, transform_obj_cache_free,
+      "transform_obj_cache");
+  coco_problem_set_name(problem, "%s", problem_name);
+  coco_free_memory(problem_name);
+
+  if (inner_problem->number_of_objectives > 0)
+    problem->evaluate_function = transform_obj_cache_evaluate_function;
+  if (inner_problem->number_of_constraints > 0)
+    problem->evaluate_constraint = transform_obj_cache_evaluate_constraint;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = coco_problem_transformed_evaluate_term;
+
+  return problem;
+}
+
+/**
+ * @brief Frees the cache wrapped around the problem (if there is one) and returns the inner problem.
+ */
+static coco_problem_t *transform_obj_cache_remove(coco_problem_t *problem) {
+  coco_problem_t *inner_problem;
+
+  if ((problem->problem_free_function != coco_problem_transformed_free)
+      || (((coco_problem_transformed_data_t *) problem->data)->data_free_function != transform_obj_cache_free))
+    return problem;
+
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  coco_problem_transformed_free_data(problem);
+  return inner_problem;
+}
@@ -43,6 +43,17 @@ static void transform_obj_cauchy_noise_evaluate_function(
     *(y) = *(y) + cauchy_noise + 1.01 * tol + coco_boundary_handling(problem, x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_obj_cauchy_noise_clone(coco_problem_t *problem, void *thing) {
+    transform_obj_cauchy_noise_data_t *data;
+    (void) problem; /* To silence the compiler */
+    data = (transform_obj_cauchy_noise_data_t *) coco_allocate_memory(sizeof(*data));
+    *data = *(transform_obj_cauchy_noise_data_t *) thing;
+    return data;
+}
+
 /**
  * @brief Allocates a noisy problem with cauchy noise.
  */
@@ -58,7 +69,10 @@ static coco_problem_t *transform_obj_cauchy_noise(
     data -> p = p;
     problem = coco_problem_transformed_allocate(inner_problem, data, 
         NULL, "cauchy_noise_model");
+    coco_problem_transformed_set_data_clone_function(problem, transform_obj_cauchy_noise_clone);
     problem->evaluate_function = transform_obj_cauchy_noise_evaluate_function;
     problem->is_noisy = 1;
+    /* The noise is not differentiable */
+    problem->evaluate_gradient = NULL;
     return problem;
 }
@@ -38,6 +38,17 @@ static void transform_obj_gaussian_noise_evaluate_function(
 }
 
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_obj_gaussian_noise_clone(coco_problem_t *problem, void *thing) {
+    transform_obj_gaussian_noise_data_t *data;
+    (void) problem; /* To silence the compiler */
+    data = (transform_obj_gaussian_noise_data_t *) coco_allocate_memory(sizeof(*data));
+    *data = *(transform_obj_gaussian_noise_data_t *) thing;
+    return data;
+}
+
 /**
  * @brief Allocates a noisy problem with gaussian noise.
  */
@@ -51,8 +62,11 @@ static coco_problem_t *transform_obj_gaussian_noise(
     data -> beta = beta;
     problem = coco_problem_transformed_allocate(inner_problem, data, 
         NULL, "gaussian_noise_model");
+    coco_problem_transformed_set_data_clone_function(problem, transform_obj_gaussian_noise_clone);
     problem->evaluate_function = transform_obj_gaussian_noise_evaluate_function;
     problem->is_noisy = 1;
+    /* The noise is not differentiable */
+    problem->evaluate_gradient = NULL;
     return problem;
 
 }
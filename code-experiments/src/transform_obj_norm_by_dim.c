@@ -21,6 +21,28 @@ static void transform_obj_norm_by_dim_evaluate(coco_problem_t *problem, const do
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function.
+ */
+static double transform_obj_norm_by_dim_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  return inner_problem->evaluate_term(inner_problem, i, x_i)
+      * bbob2009_fmin(1, 40. / ((double) problem->number_of_variables));
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_obj_norm_by_dim_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= bbob2009_fmin(1, 40. / ((double) problem->number_of_variables));
+  }
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -29,5 +51,9 @@ static coco_problem_t *transform_obj_norm_by_dim(coco_problem_t *inner_problem)
 
   problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_obj_norm_by_dim");
   problem->evaluate_function = transform_obj_norm_by_dim_evaluate;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_obj_norm_by_dim_evaluate_term;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_obj_norm_by_dim_evaluate_gradient;
   return problem;
 }
@@ -8,6 +8,7 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "transform_vars_oscillate.c"
 
 /**
  * @brief Evaluates the transformation.
@@ -36,6 +37,26 @@ static void transform_obj_oscillate_evaluate(coco_problem_t *problem, const doub
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_obj_oscillate_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  coco_problem_t *inner_problem;
+  tosz_data d;
+  double value;
+  size_t i;
+
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  d.alpha = 0.1;
+
+  coco_evaluate_function(inner_problem, x, &value);
+  bbob_evaluate_gradient(inner_problem, x, y);
+  value = tosz_uv_derivative(value, &d);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= value;
+  }
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -43,6 +64,8 @@ static coco_problem_t *transform_obj_oscillate(coco_problem_t *inner_problem) {
   coco_problem_t *problem;
   problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_obj_oscillate");
   problem->evaluate_function = transform_obj_oscillate_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_obj_oscillate_evaluate_gradient;
   /* Compute best value */
   /* Maybe not the most efficient solution */
   transform_obj_oscillate_evaluate(problem, problem->best_parameter, problem->best_value);
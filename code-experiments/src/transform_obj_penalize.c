@@ -50,6 +50,54 @@ static void transform_obj_penalize_evaluate(coco_problem_t *problem, const doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable (including its penalty) to the transformed function.
+ */
+static double transform_obj_penalize_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  transform_obj_penalize_data_t *data = (transform_obj_penalize_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  const double c1 = x_i - problem->largest_values_of_interest[i];
+  const double c2 = problem->smallest_values_of_interest[i] - x_i;
+  double penalty = 0.0;
+
+  if (c1 > 0.0) {
+    penalty = c1 * c1;
+  } else if (c2 > 0.0) {
+    penalty = c2 * c2;
+  }
+  return inner_problem->evaluate_term(inner_problem, i, x_i) + data->factor * penalty;
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_obj_penalize_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  transform_obj_penalize_data_t *data = (transform_obj_penalize_data_t *) coco_problem_transformed_get_data(problem);
+  size_t i;
+
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    const double c1 = x[i] - problem->largest_values_of_interest[i];
+    const double c2 = problem->smallest_values_of_interest[i] - x[i];
+    if (c1 > 0.0) {
+      y[i] += data->factor * 2.0 * c1;
+    } else if (c2 > 0.0) {
+      y[i] -= data->factor * 2.0 * c2;
+    }
+  }
+}
+
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_obj_penalize_clone(coco_problem_t *problem, void *thing) {
+  transform_obj_penalize_data_t *data;
+  (void) problem; /* To silence the compiler */
+  data = (transform_obj_penalize_data_t *) coco_allocate_memory(sizeof(*data));
+  *data = *(transform_obj_penalize_data_t *) thing;
+  return data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -61,7 +109,12 @@ static coco_problem_t *transform_obj_penalize(coco_problem_t *inner_problem, con
   data = (transform_obj_penalize_data_t *) coco_allocate_memory(sizeof(*data));
   data->factor = factor;
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_obj_penalize");
+  coco_problem_transformed_set_data_clone_function(problem, transform_obj_penalize_clone);
   problem->evaluate_function = transform_obj_penalize_evaluate;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_obj_penalize_evaluate_term;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_obj_penalize_evaluate_gradient;
   /* No need to update the best value as the best parameter is feasible */
   return problem;
 }
@@ -37,6 +37,37 @@ static void transform_obj_power_evaluate(coco_problem_t *problem, const double *
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_obj_power_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  transform_obj_power_data_t *data;
+  coco_problem_t *inner_problem;
+  double value;
+  size_t i;
+
+  data = (transform_obj_power_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  coco_evaluate_function(inner_problem, x, &value);
+  bbob_evaluate_gradient(inner_problem, x, y);
+  value = data->exponent * pow(value, data->exponent - 1.0);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= value;
+  }
+}
+
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_obj_power_clone(coco_problem_t *problem, void *thing) {
+  transform_obj_power_data_t *data;
+  (void) problem; /* To silence the compiler */
+  data = (transform_obj_power_data_t *) coco_allocate_memory(sizeof(*data));
+  *data = *(transform_obj_power_data_t *) thing;
+  return data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -48,7 +79,10 @@ static coco_problem_t *transform_obj_power(coco_problem_t *inner_problem, const
   data->exponent = exponent;
 
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_obj_power");
+  coco_problem_transformed_set_data_clone_function(problem, transform_obj_power_clone);
   problem->evaluate_function = transform_obj_power_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_obj_power_evaluate_gradient;
   /* Compute best value */
   transform_obj_power_evaluate(problem, problem->best_parameter, problem->best_value);
   return problem;
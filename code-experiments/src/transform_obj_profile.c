@@ -0,0 +1,225 @@
+/**
+ * @file transform_obj_profile.c
+ * @brief Implementation of profiling the evaluations of a problem stage by stage.
+ *
+ * The profile is wrapped directly inside the logger. When it is removed or freed, it appends a line of
+ * JSON with the breakdown of the evaluation cost to the file "profile.jsonl" in the result folder. For each
+ * stage of the problem (from the logger down to the raw function, keyed by the name of the transformation)
+ * the number of evaluations, the ticks spent in the stage including its inner stages and the ticks spent in
+ * the stage itself are given.
+ *
+ * The ticks are only counted when COCO is compiled with -DCOCO_PROFILE (@see coco_evaluate_function). The
+ * evaluations done before profiling (for example, when constructing the problem) are then left out of both
+ * the ticks and the evaluations, otherwise all evaluations are given.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "coco.h"
+#include "coco_problem.c"
+
+#if !defined(COCO_PROFILE)
+#define COCO_PROFILE_TICK_UNIT "none"
+#endif
+
+/**
+ * @brief Data type for transform_obj_profile.
+ */
+typedef struct {
+  char *file_name;                /**< @brief Name of the file the profile is appended to */
+  coco_problem_t *outer_problem;  /**< @brief The problem wrapped around the profile (the logger) */
+} transform_obj_profile_data_t;
+
+static void transform_obj_profile_free_problem(coco_problem_t *problem);
+
+/**
+ * @brief Returns the ticks spent in evaluating the problem (including its inner problems).
+ */
+static double transform_obj_profile_get_ticks(const coco_problem_t *problem) {
+#if defined(COCO_PROFILE)
+  return problem->profile_ticks;
+#else
+  (void) problem; /* To silence the compiler */
+  return 0;
+#endif
+}
+
+/**
+ * @brief Returns the number of evaluations of the problem counted together with its ticks.
+ */
+static size_t transform_obj_profile_get_evaluations(const coco_problem_t *problem) {
+#if defined(COCO_PROFILE)
+  return problem->evaluations - problem->profile_evaluations;
+#else
+  return problem->evaluations;
+#endif
+}
+
+/**
+ * @brief Returns the name of the stage of the given problem and sets its inner problems (NULL if there
+ * are none).
+ */
+static const char *transform_obj_profile_get_stage(const coco_problem_t *problem,
+                                                   coco_problem_t **inner_problems) {
+  inner_problems[0] = NULL;
+  inner_problems[1] = NULL;
+  if ((problem->problem_free_function == coco_problem_transformed_free)
+      || (problem->problem_free_function == transform_obj_profile_free_problem)) {
+    inner_problems[0] = ((coco_problem_transformed_data_t *) problem->data)->inner_problem;
+    return ((coco_problem_transformed_data_t *) problem->data)->name;
+  } else if (problem->problem_free_function == coco_problem_stacked_free) {
+    inner_problems[0] = ((coco_problem_stacked_data_t *) problem->data)->problem1;
+    inner_problems[1] = ((coco_problem_stacked_data_t *) problem->data)->problem2;
+    return "coco_problem_stacked";
+  }
+  return problem->problem_name;
+}
+
+/**
+ * @brief Resets the ticks and evaluations of the given problem and its inner problems, so that evaluations
+ * done before profiling (for example, when constructing the problem) are not included.
+ */
+static void transform_obj_profile_reset(coco_problem_t *problem) {
+#if defined(COCO_PROFILE)
+  coco_problem_t *inner_problems[2];
+  size_t i;
+
+  problem->profile_ticks = 0;
+  problem->profile_evaluations = problem->evaluations;
+  transform_obj_profile_get_stage(problem, inner_problems);
+  for (i = 0; i < 2; i++) {
+    if (inner_problems[i] != NULL)
+      transform_obj_profile_reset(inner_problems[i]);
+  }
+#else
+  (void) problem; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Writes the stage of the given problem and recursively the stages of its inner problems.
+ *
+ * The profile itself is skipped.
+ */
+static void transform_obj_profile_write_stage(FILE *file,
+                                              const coco_problem_t *problem,
+                                              const coco_problem_t *profile,
+                                              const size_t depth,
+                                              int *is_first) {
+  coco_problem_t *inner_problems[2];
+  const char *name;
+  double inner_ticks = 0;
+  size_t i;
+
+  name = transform_obj_profile_get_stage(problem, inner_problems);
+  if (problem == profile) {
+    transform_obj_profile_write_stage(file, inner_problems[0], profile, depth, is_first);
+    return;
+  }
+
+  for (i = 0; i < 2; i++) {
+    if (inner_problems[i] != NULL)
+      inner_ticks += transform_obj_profile_get_ticks(inner_problems[i]);
+  }
+  fprintf(file, "%s{\"name\": \"%s\", \"depth\": %lu, \"evaluations\": %lu, \"ticks\": %.0f, \"self_ticks\": %.0f}",
+      *is_first ? "" : ", ", name, (unsigned long) depth, (unsigned long) transform_obj_profile_get_evaluations(problem),
+      transform_obj_profile_get_ticks(problem), transform_obj_profile_get_ticks(problem) - inner_ticks);
+  *is_first = 0;
+
+  for (i = 0; i < 2; i++) {
+    if (inner_problems[i] != NULL)
+      transform_obj_profile_write_stage(file, inner_problems[i], profile, depth + 1, is_first);
+  }
+}
+
+/**
+ * @brief Appends the profile of the problem to the profile file.
+ */
+static void transform_obj_profile_write(coco_problem_t *problem) {
+  transform_obj_profile_data_t *data;
+  FILE *file;
+  int is_first = 1;
+
+  data = (transform_obj_profile_data_t *) coco_problem_transformed_get_data(problem);
+  file = fopen(data->file_name, "a");
+  if (file == NULL) {
+    coco_error("transform_obj_profile_write(): Error opening file: %s", data->file_name);
+    return; /* Never reached */
+  }
+  fprintf(file, "{\"problem_id\": \"%s\", \"tick_unit\": \"%s\", \"stages\": [",
+      problem->problem_id, COCO_PROFILE_TICK_UNIT);
+  transform_obj_profile_write_stage(file, data->outer_problem != NULL ? data->outer_problem : problem,
+      problem, 0, &is_first);
+  fprintf(file, "]}\n");
+  fclose(file);
+}
+
+/**
+ * @brief Frees the data object.
+ */
+static void transform_obj_profile_free(void *stuff) {
+  transform_obj_profile_data_t *data = (transform_obj_profile_data_t *) stuff;
+  coco_free_memory(data->file_name);
+}
+
+/**
+ * @brief Writes the profile and frees the problem (while the inner problems are still available).
+ */
+static void transform_obj_profile_free_problem(coco_problem_t *problem) {
+  transform_obj_profile_write(problem);
+  coco_problem_transformed_free(problem);
+}
+
+/**
+ * @brief Creates the transformation.
+ *
+ * The profile is appended to the file file_name. Use transform_obj_profile_set_outer_problem to include
+ * the stage that wraps the profile (the logger) in the output.
+ */
+static coco_problem_t *transform_obj_profile(coco_problem_t *inner_problem, const char *file_name) {
+  coco_problem_t *problem;
+  transform_obj_profile_data_t *data;
+
+  data = (transform_obj_profile_data_t *) coco_allocate_memory(sizeof(*data));
+  data->file_name = coco_strdup(file_name);
+  data->outer_problem = NULL;
+
+  transform_obj_profile_reset(inner_problem);
+  problem = coco_problem_transformed_allocate(inner_problem, data, transform_obj_profile_free,
+      "transform_obj_profile");
+  problem->problem_free_function = transform_obj_profile_free_problem;
+  return problem;
+}
+
+/**
+ * @brief Sets the problem that wraps the profile, so that its stage is included in the output.
+ *
+ * Evaluations done when constructing the outer problem are not profiled.
+ */
+static void transform_obj_profile_set_outer_problem(coco_problem_t *problem, coco_problem_t *outer_problem) {
+  transform_obj_profile_data_t *data;
+  assert(problem->problem_free_function == transform_obj_profile_free_problem);
+
+  data = (transform_obj_profile_data_t *) coco_problem_transformed_get_data(problem);
+  data->outer_problem = outer_problem;
+  transform_obj_profile_reset(outer_problem);
+}
+
+/**
+ * @brief Writes the profile and removes it, if the given problem is a profile. Returns the inner problem
+ * in this case and the given problem otherwise.
+ *
+ * Must be called while the outer problem (if any) is still available.
+ */
+static coco_problem_t *transform_obj_profile_remove(coco_problem_t *problem) {
+  coco_problem_t *inner_problem;
+
+  if (problem->problem_free_function != transform_obj_profile_free_problem)
+    return problem;
+
+  transform_obj_profile_write(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  coco_problem_transformed_free_data(problem);
+  return inner_problem;
+}
@@ -45,6 +45,15 @@ static void transform_obj_shift_evaluate_function(coco_problem_t *problem, const
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function (the offset is constant).
+ */
+static double transform_obj_shift_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  return inner_problem->evaluate_term(inner_problem, i, x_i);
+}
+
 /**
  * @brief Evaluates the gradient of the transformed function at x
  */
@@ -58,6 +67,17 @@ static void transform_obj_shift_evaluate_gradient(coco_problem_t *problem, const
   bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), x, y);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_obj_shift_clone(coco_problem_t *problem, void *thing) {
+  transform_obj_shift_data_t *data;
+  (void) problem; /* To silence the compiler */
+  data = (transform_obj_shift_data_t *) coco_allocate_memory(sizeof(*data));
+  *data = *(transform_obj_shift_data_t *) thing;
+  return data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -70,11 +90,16 @@ static coco_problem_t *transform_obj_shift(coco_problem_t *inner_problem, const
 
   problem = coco_problem_transformed_allocate(inner_problem, data, 
     NULL, "transform_obj_shift");
+  coco_problem_transformed_set_data_clone_function(problem, transform_obj_shift_clone);
     
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_obj_shift_evaluate_function;
     
-  problem->evaluate_gradient = transform_obj_shift_evaluate_gradient;  /* TODO (NH): why do we need a new function pointer here? */
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_obj_shift_evaluate_gradient;  /* TODO (NH): why do we need a new function pointer here? */
+
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_obj_shift_evaluate_term;
   
   for (i = 0; i < problem->number_of_objectives; i++)
     problem->best_value[i] += offset;
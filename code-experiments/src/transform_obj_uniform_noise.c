@@ -45,6 +45,17 @@ static void transform_obj_uniform_noise_evaluate_function(
     *(y) = *(y) + fopt + coco_boundary_handling(problem, x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_obj_uniform_noise_clone(coco_problem_t *problem, void *thing) {
+    transform_obj_uniform_noise_data_t *data;
+    (void) problem; /* To silence the compiler */
+    data = (transform_obj_uniform_noise_data_t *) coco_allocate_memory(sizeof(*data));
+    *data = *(transform_obj_uniform_noise_data_t *) thing;
+    return data;
+}
+
 /**
  * @brief Allocates a noisy problem with uniform noise.
  */
@@ -60,7 +71,10 @@ static coco_problem_t *transform_obj_uniform_noise(
     data -> beta = beta;
     problem = coco_problem_transformed_allocate(inner_problem, data, 
         NULL, "uniform_noise_model");
+    coco_problem_transformed_set_data_clone_function(problem, transform_obj_uniform_noise_clone);
     problem->evaluate_function = transform_obj_uniform_noise_evaluate_function;
     problem->is_noisy = 1;
+    /* The noise is not differentiable */
+    problem->evaluate_gradient = NULL;
     return problem;
 }
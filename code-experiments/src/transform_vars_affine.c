@@ -15,12 +15,14 @@
 
 #include "coco.h"
 #include "coco_problem.c"
+#include "coco_shared_data.c"
 
 /**
  * @brief Data type for transform_vars_affine.
  */
 typedef struct {
   double *M, *b, *x;
+  size_t *number_of_owners; /**< @brief Number of clones sharing M and b (NULL if not shared) */
 } transform_vars_affine_data_t;
 
 /**
@@ -145,9 +147,24 @@ static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, con
  */
 static void transform_vars_affine_free(void *thing) {
   transform_vars_affine_data_t *data = (transform_vars_affine_data_t *) thing;
-  coco_free_memory(data->M);
-  coco_free_memory(data->b);
   coco_free_memory(data->x);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_shared_data_free(data->M);
+    coco_free_memory(data->b);
+  }
+}
+
+/**
+ * @brief Clones the data object, sharing M and b.
+ */
+static void *transform_vars_affine_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_affine_data_t *data = (transform_vars_affine_data_t *) thing;
+  transform_vars_affine_data_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_affine_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 /**
@@ -170,12 +187,14 @@ static coco_problem_t *transform_vars_affine(coco_problem_t *inner_problem,
 
   entries_in_M = inner_problem->number_of_variables * number_of_variables;
   data = (transform_vars_affine_data_t *) coco_allocate_memory(sizeof(*data));
-  data->M = coco_duplicate_vector(M, entries_in_M);
+  data->M = (double *) coco_shared_data_share(coco_duplicate_vector(M, entries_in_M), entries_in_M * sizeof(double));
   data->b = coco_duplicate_vector(b, inner_problem->number_of_variables);
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->number_of_owners = NULL;
 
   problem = coco_problem_transformed_allocate(inner_problem, data, 
     transform_vars_affine_free, "transform_vars_affine");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_affine_clone);
     
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_affine_evaluate_function;
@@ -183,7 +202,8 @@ static coco_problem_t *transform_vars_affine(coco_problem_t *inner_problem,
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_affine_evaluate_constraint;
     
-  problem->evaluate_gradient = transform_vars_affine_evaluate_gradient;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_affine_evaluate_gradient;
 
   /* Update the best parameter by computing
      problem->best_parameter = M^T * (inner_problem->best_parameter - b).
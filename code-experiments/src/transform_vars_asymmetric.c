@@ -12,6 +12,7 @@
 #include "coco.h"
 #include "coco_problem.c"
 #include "brentq.c"
+#include "transform_vars_inverse_helpers.c"
 
 /**
  * @brief Data type for transform_vars_asymmetric.
@@ -47,12 +48,59 @@ static double tasy_uv(double xi, tasy_data *d) {
 }
 
 /**
- * @brief Inverse of asymmetric non-linear transformation tasy_uv obtained with brentq.
+ * @brief Derivative of the univariate asymmetric non-linear transformation tasy_uv.
+ */
+static double tasy_uv_derivative(double xi, tasy_data *d) {
+  double factor;
+  if (xi > 0.0) {
+    factor = (d->beta * (double) (long) d->i) / ((double) (long) d->n - 1.0);
+    return tasy_uv(xi, d) * ((1.0 + factor * sqrt(xi)) / xi + factor * log(xi) / (2.0 * sqrt(xi)));
+  }
+  return 1.0;
+}
+
+/**
+ * @brief Logarithm of tasy_uv as a function of u = log(xi) for xi > 0 (and its derivative).
+ */
+static double tasy_uv_log(double u, const void *data, double *derivative) {
+  const tasy_data *d = (const tasy_data *) data;
+  double factor, tmp;
+  factor = (d->beta * (double) (long) d->i) / ((double) (long) d->n - 1.0);
+  tmp = factor * exp(u / 2.0);
+  *derivative = 1.0 + tmp * (1.0 + u / 2.0);
+  return (1.0 + tmp) * u;
+}
+
+/**
+ * @brief Inverse of asymmetric non-linear transformation tasy_uv.
+ *
+ * For yi > 0, the exponent of tasy_uv is at least 1, so log(xi) lies between 0 and log(yi) and is found
+ * with a safeguarded Newton's method.
  */
 static double tasy_uv_inv(double yi, tasy_data *d) {
-  double xi;
-  xi = brentinv((callback_type) &tasy_uv, yi, d);
-  return xi;
+  double v;
+  if (yi > 0.0) {
+    v = log(yi);
+    return exp(transform_inv_newton(tasy_uv_log, v,
+        coco_double_min(v, 0.0), coco_double_max(v, 0.0), d));
+  }
+  return yi;
+}
+
+/**
+ * @brief Wraps tasy_uv to be used by transform_inv_initial_apply.
+ */
+static double tasy_uv_of_coordinate(double xi, size_t i, void *d) {
+  ((tasy_data *) d)->i = i;
+  return tasy_uv(xi, (tasy_data *) d);
+}
+
+/**
+ * @brief Wraps tasy_uv_inv to be used by transform_inv_initial_apply.
+ */
+static double tasy_uv_inv_of_coordinate(double yi, size_t i, void *d) {
+  ((tasy_data *) d)->i = i;
+  return tasy_uv_inv(yi, (tasy_data *) d);
 }
 
 
@@ -111,6 +159,42 @@ static void transform_vars_asymmetric_evaluate_function(coco_problem_t *problem,
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_asymmetric_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_asymmetric_data_t *data;
+  tasy_data d;
+
+  data = (transform_vars_asymmetric_data_t *) coco_problem_transformed_get_data(problem);
+  d.beta = data->beta;
+  d.n = problem->number_of_variables;
+
+  tasy(data, x, problem->number_of_variables);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    d.i = i;
+    y[i] *= tasy_uv_derivative(x[i], &d);
+  }
+}
+
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function.
+ */
+static double transform_vars_asymmetric_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  transform_vars_asymmetric_data_t *data;
+  coco_problem_t *inner_problem;
+  tasy_data d;
+
+  data = (transform_vars_asymmetric_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  d.beta = data->beta;
+  d.i = i;
+  d.n = problem->number_of_variables;
+  return inner_problem->evaluate_term(inner_problem, i, tasy_uv(x_i, &d));
+}
+
 /**
  * @brief Evaluates the transformed constraint.
  */
@@ -153,6 +237,17 @@ static void transform_vars_asymmetric_free(void *thing) {
   coco_free_memory(data->x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_asymmetric_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_asymmetric_data_t *clone_data;
+  clone_data = (transform_vars_asymmetric_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *(transform_vars_asymmetric_data_t *) thing;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -165,9 +260,16 @@ static coco_problem_t *transform_vars_asymmetric(coco_problem_t *inner_problem,
   data->beta = beta;
   problem = coco_problem_transformed_allocate(inner_problem, data, 
     transform_vars_asymmetric_free, "transform_vars_asymmetric");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_asymmetric_clone);
     
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_asymmetric_evaluate_function;
+
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_vars_asymmetric_evaluate_term;
+
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_asymmetric_evaluate_gradient;
     
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_asymmetric_evaluate_constraint;
@@ -183,60 +285,18 @@ static coco_problem_t *transform_vars_asymmetric(coco_problem_t *inner_problem,
  * @brief Applies the inverse of the asymmetric transformation tasy to the initial solution.
  * 
  *        Takes xopt as input to check the solution remains in the bounds
- *        If not, a curve search is performed
+ *        If not, the initial solution is halved until it does (see transform_inv_initial_apply)
  *        xopt is needed because transform_vars_shift is not yet called
  *        in f_{function}_rotated_c_linear_cons_bbob_problem_allocate
  */
 static void transform_inv_initial_asymmetric(coco_problem_t *problem, const double *xopt) {
-  size_t i;
-  size_t j;
-  int is_in_bounds;
-  double di;
-  double xi;
-  double *sol = NULL;
-  double halving_factor = .5;
-
   transform_vars_asymmetric_data_t *data;
-  tasy_data *d;
-
-  sol = coco_allocate_vector(problem->number_of_variables);
-  d = coco_allocate_memory(sizeof(*d));
+  tasy_data d;
 
   data = (transform_vars_asymmetric_data_t *) coco_problem_transformed_get_data(problem);
+  d.beta = data->beta;
+  d.i = 0;
+  d.n = problem->number_of_variables;
 
-  d->beta = data->beta;
-  d->n = problem->number_of_variables;
-
-  j = 0;
-  while (1) {
-
-    for (i = 0; i < problem->number_of_variables; ++i) {
-      d->i = i;
-      di = tasy_uv_inv(problem->initial_solution[i] * pow(halving_factor, (double) (long) j), d);
-      xi = di + xopt[i];
-      is_in_bounds = (int) (-5.0 < xi  && xi < 5.0);
-      /* Line search for the inverse-transformed feasible initial solution
-         to remain within the bounds
-        */
-      if (!is_in_bounds) {
-        j = j + 1;
-        break;
-      }
-      sol[i] = di;
-    }
-    if (!is_in_bounds && !coco_is_nan(di)){
-      continue;
-    }
-    else {
-      break;
-    }   
-  }
-  if (!coco_vector_contains_nan(sol, problem->number_of_variables)) {
-    for (i = 0; i < problem->number_of_variables; ++i) {
-      problem->initial_solution[i] = sol[i];
-    }
-  }
-  
-  coco_free_memory(d);
-  coco_free_memory(sol);
+  transform_inv_initial_apply(problem, xopt, tasy_uv_of_coordinate, tasy_uv_inv_of_coordinate, &d);
 }
@@ -19,62 +19,28 @@
  * @brief Data type for transform_vars_blockrotation.
  */
 typedef struct {
-  double **B; /**< @brief the block-diagonal matrices*/
+  double *B; /**< @brief the block-diagonal matrix, packed by coco_pack_block_matrix */
   double *Bx;
   size_t dimension;
   size_t *block_sizes; /**< @brief the list of block-sizes*/
   size_t nb_blocks;    /**< @brief the number of blocks in the matrix */
-  size_t
-      *block_size_map; /**< @brief maps a row to the block-size of the block to
-                          which it belong, keep until better way is found */
-  size_t *first_non_zero_map; /**< @brief maps a row to the index of its first
-                                 non zero element */
+  size_t *number_of_owners; /**< @brief Number of clones sharing B and block_sizes (NULL if not shared) */
 } transform_vars_blockrotation_t;
 
-/*
- * @brief return i-th row of blockrotation problem->data->B in y.
- */
-static void transform_vars_blockrotation_get_row(coco_problem_t *problem,
-                                                 size_t i, double *y) {
-  size_t j, current_blocksize, first_non_zero_ind; /* cp-paste from apply */
-  transform_vars_blockrotation_t *data;
-
-  data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(
-      problem);
-  current_blocksize = data->block_size_map[i];
-  first_non_zero_ind = data->first_non_zero_map[i];
-
-  for (j = 0; j < data->dimension; ++j) {
-    y[j] =
-        (j < first_non_zero_ind || j >= first_non_zero_ind + current_blocksize)
-            ? 0
-            : data->B[i][j - first_non_zero_ind]; /*all B lines start at 0*/
-  }
-}
-
 /*
  * @brief Computes y = Bx, where all the pertinent information about B is given
  * in the problem data.
  */
 static void transform_vars_blockrotation_apply(coco_problem_t *problem,
                                                const double *x, double *y) {
-  size_t i, j, current_blocksize, first_non_zero_ind;
+  size_t i;
   transform_vars_blockrotation_t *data;
 
   data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(
       problem);
   assert(x != data->Bx);
-  for (i = 0; i < data->dimension; ++i) {
-    current_blocksize = data->block_size_map[i];
-    first_non_zero_ind = data->first_non_zero_map[i];
-    data->Bx[i] = 0;
-    /*compute y[i] = < B[i,:] , x >  */
-    for (j = first_non_zero_ind; j < first_non_zero_ind + current_blocksize;
-         ++j) {
-      data->Bx[i] +=
-          data->B[i][j - first_non_zero_ind] * x[j]; /*all B lines start at 0*/
-    }
-  }
+  coco_apply_packed_block_matrix(data->B, data->block_sizes, data->nb_blocks,
+                                 x, data->Bx);
   if (y != data->Bx) {
     for (i = 0; i < data->dimension; ++i) {
       y[i] = data->Bx[i];
@@ -96,39 +62,47 @@ static void transform_vars_blockrotation_evaluate(coco_problem_t *problem,
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function, which is B^T times the inner gradient.
+ */
+static void transform_vars_blockrotation_evaluate_gradient(coco_problem_t *problem,
+                                                           const double *x, double *y) {
+  transform_vars_blockrotation_t *data;
+  size_t i;
+  data = (transform_vars_blockrotation_t *)coco_problem_transformed_get_data(
+      problem);
+
+  transform_vars_blockrotation_apply(problem, x, data->Bx);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem),
+                         data->Bx, y);
+  for (i = 0; i < data->dimension; ++i) {
+    data->Bx[i] = y[i];
+  }
+  coco_apply_packed_block_matrix_transpose(data->B, data->block_sizes,
+                                           data->nb_blocks, data->Bx, y);
+}
+
 static void transform_vars_blockrotation_free(void *stuff) {
   transform_vars_blockrotation_t *data =
       (transform_vars_blockrotation_t *)stuff;
-  coco_free_block_matrix(data->B, data->dimension);
-  coco_free_memory(data->block_sizes);
   coco_free_memory(data->Bx);
-  coco_free_memory(data->block_size_map);
-  coco_free_memory(data->first_non_zero_map);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_shared_data_free(data->B);
+    coco_free_memory(data->block_sizes);
+  }
 }
 
-/*
- * @brief test blockrotation on its own rows and raise coco_error in case
+/**
+ * @brief Clones the data object, sharing B and block_sizes.
  */
-static void transform_vars_blockrotation_test(coco_problem_t *problem,
-                                              double precision) {
-  size_t i, j;
-  size_t number_of_variables = coco_problem_get_dimension(problem);
-  double *y = coco_allocate_vector(number_of_variables);
-
-  for (i = 0; i < number_of_variables; ++i) { /* for each row */
-    transform_vars_blockrotation_get_row(problem, i, y);
-    transform_vars_blockrotation_apply(problem, y, y);
-    for (j = 0; j < number_of_variables; ++j) { /* check result */
-      if (!coco_double_almost_equal(y[j], (i == j) ? 1.0 : 0.0, precision)) {
-        coco_error("transform_vars_blockrotation_test() with precision %e "
-                   "failed on row %i",
-                   precision, i);
-      }
-      /* printf("%f ", y[j]); */
-    }
-    /* printf("\n"); */
-  }
-  coco_free_memory(y);
+static void *transform_vars_blockrotation_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_blockrotation_t *data = (transform_vars_blockrotation_t *) thing;
+  transform_vars_blockrotation_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_blockrotation_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->Bx = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 static coco_problem_t *transform_vars_blockrotation(
@@ -137,32 +111,15 @@ static coco_problem_t *transform_vars_blockrotation(
     const size_t nb_blocks) {
   coco_problem_t *problem;
   transform_vars_blockrotation_t *data;
-  size_t idx_blocksize, next_bs_change, current_blocksize;
-  size_t i;
   assert(number_of_variables > 0); /*tmp*/
   data = (transform_vars_blockrotation_t *)coco_allocate_memory(sizeof(*data));
   data->dimension = number_of_variables;
-  data->B =
-      coco_copy_block_matrix(B, number_of_variables, block_sizes, nb_blocks);
+  data->B = coco_pack_block_matrix(B, number_of_variables, block_sizes, nb_blocks);
   data->Bx = coco_allocate_vector(inner_problem->number_of_variables);
+  data->number_of_owners = NULL;
   data->block_sizes = coco_duplicate_size_t_vector(block_sizes, nb_blocks);
   data->nb_blocks = nb_blocks;
-  data->block_size_map = coco_allocate_vector_size_t(number_of_variables);
-  data->first_non_zero_map = coco_allocate_vector_size_t(number_of_variables);
 
-  idx_blocksize = 0;
-  next_bs_change = block_sizes[idx_blocksize];
-  for (i = 0; i < number_of_variables; i++) {
-    if (i >= next_bs_change) {
-      idx_blocksize++;
-      next_bs_change += block_sizes[idx_blocksize];
-    }
-    current_blocksize = block_sizes[idx_blocksize];
-    data->block_size_map[i] = current_blocksize;
-    data->first_non_zero_map[i] =
-        next_bs_change - current_blocksize; /* next_bs_change serves also as a
-                                               cumsum for blocksizes*/
-  }
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_debug("transform_vars_blockrotation(): 'best_parameter' not updated, "
                "set to NAN");
@@ -172,11 +129,14 @@ static coco_problem_t *transform_vars_blockrotation(
   problem = coco_problem_transformed_allocate(inner_problem, data,
                                               transform_vars_blockrotation_free,
                                               "transform_vars_blockrotation");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_blockrotation_clone);
   problem->evaluate_function = transform_vars_blockrotation_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_blockrotation_evaluate_gradient;
 
   if (number_of_variables < 100) {
     /* 1e-11 still passes and 1e-12 fails under macOS */
-    transform_vars_blockrotation_test(problem, 1e-5);
+    coco_test_packed_block_matrix(data->B, data->block_sizes, data->nb_blocks, 1e-5);
   }
   return problem;
 }
@@ -9,6 +9,7 @@
 
 #include "coco_random.c" /*tmp*/
 #include "suite_bbob_legacy_code.c" /*tmp*/
+#include "coco_shared_data.c"
 
 #include <time.h> /*tmp*/
 
@@ -83,35 +84,69 @@ static void coco_free_block_matrix(double **matrix, const size_t n) {
 /**
  * @brief Compute a ${DIM}x${DIM} block-diagonal matrix based on ${seed} and block_sizes and stores it in ${B}.
  * B is a 2D vector with DIM lines and each line has blocksize(line) elements (the zeros are not stored)
+ *
+ * If data is shared between processes (see coco_shared_data.c), the blocks computed by another process for
+ * the same seed and block sizes are read instead of being computed anew.
  */
 static void coco_compute_blockrotation(double **B, long seed, COCO_UNUSED size_t n, size_t *block_sizes, size_t nb_blocks) {
   double **current_block;
+  double *shared_blocks = NULL, *current_shared_block = NULL;
+  char *key = NULL;
   size_t i, j;
-  size_t idx_block, current_blocksize, cumsum_prev_block_sizes;
+  size_t idx_block, current_blocksize, cumsum_prev_block_sizes, number_of_entries;
+  int is_shared = 0;
   COCO_UNUSED size_t sum_block_sizes;
   sum_block_sizes = 0;
+  number_of_entries = 0;
   for (i = 0; i < nb_blocks; i++){
     sum_block_sizes += block_sizes[i];
+    number_of_entries += block_sizes[i] * block_sizes[i];
   }
   assert(sum_block_sizes == n);
 
+  if (coco_shared_data_get_folder() != NULL) {
+    key = coco_strdupf("blockrotation-%ld-%lx", seed,
+        coco_shared_data_checksum(block_sizes, nb_blocks * sizeof(size_t)));
+    shared_blocks = coco_allocate_vector(number_of_entries);
+    is_shared = coco_shared_data_read(key, shared_blocks, number_of_entries * sizeof(double));
+  }
+
   cumsum_prev_block_sizes = 0;/* shift in rows to account for the previous blocks */
+  current_shared_block = shared_blocks;
   for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
     current_blocksize = block_sizes[idx_block];
-    current_block = bbob2009_allocate_matrix(current_blocksize, current_blocksize);
-    assert(current_blocksize <= 44);
-    bbob2009_compute_rotation(current_block, seed + (long) 1000000 * (long) idx_block, current_blocksize);
+    if (is_shared) {
+      for (i = 0 ; i < current_blocksize; i++) {
+        for (j = 0; j < current_blocksize; j++) {
+          B[i + cumsum_prev_block_sizes][j] = current_shared_block[i * current_blocksize + j];
+        }
+      }
+    } else {
+      current_block = bbob2009_allocate_matrix(current_blocksize, current_blocksize);
+      assert(current_blocksize <= 44);
+      bbob2009_compute_rotation(current_block, seed + (long) 1000000 * (long) idx_block, current_blocksize);
 
-    /* now fill the block matrix*/
-    for (i = 0 ; i < current_blocksize; i++) {
-      for (j = 0; j < current_blocksize; j++) {
-        B[i + cumsum_prev_block_sizes][j] = current_block[i][j];
+      /* now fill the block matrix*/
+      for (i = 0 ; i < current_blocksize; i++) {
+        for (j = 0; j < current_blocksize; j++) {
+          B[i + cumsum_prev_block_sizes][j] = current_block[i][j];
+          if (shared_blocks != NULL)
+            current_shared_block[i * current_blocksize + j] = current_block[i][j];
+        }
       }
+      coco_free_block_matrix(current_block, current_blocksize);
     }
 
     cumsum_prev_block_sizes+=current_blocksize;
-    /*current_gvect_pos += current_blocksize * current_blocksize;*/
-    coco_free_block_matrix(current_block, current_blocksize);
+    if (shared_blocks != NULL)
+      current_shared_block += current_blocksize * current_blocksize;
+  }
+
+  if (shared_blocks != NULL) {
+    if (!is_shared)
+      coco_shared_data_store(key, shared_blocks, number_of_entries * sizeof(double));
+    coco_free_memory(shared_blocks);
+    coco_free_memory(key);
   }
 }
 
@@ -163,3 +198,149 @@ static size_t *coco_get_block_sizes(size_t *nb_blocks, size_t dimension, const c
     return NULL;
   }
 }
+
+/**
+ * @brief Packs a block-diagonal matrix (as allocated by coco_allocate_blockmatrix) into a single contiguous
+ * vector, in which the blocks follow each other and each block is stored column by column.
+ *
+ * The result is shared with other processes if possible (see coco_shared_data.c) and must be freed with
+ * coco_shared_data_free.
+ */
+static double *coco_pack_block_matrix(const double *const *B,
+                                      const size_t dimension,
+                                      const size_t *block_sizes,
+                                      const size_t nb_blocks) {
+  double *packed, *current_block;
+  size_t i, j, idx_block, current_blocksize, first_row, number_of_entries;
+
+  number_of_entries = 0;
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    number_of_entries += block_sizes[idx_block] * block_sizes[idx_block];
+  }
+  packed = coco_allocate_vector(number_of_entries);
+
+  current_block = packed;
+  first_row = 0;
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    current_blocksize = block_sizes[idx_block];
+    for (i = 0; i < current_blocksize; i++) {
+      for (j = 0; j < current_blocksize; j++) {
+        current_block[j * current_blocksize + i] = B[first_row + i][j];
+      }
+    }
+    current_block += current_blocksize * current_blocksize;
+    first_row += current_blocksize;
+  }
+  assert(first_row == dimension);
+  (void) dimension; /* silence (C89) compilers */
+  return (double *) coco_shared_data_share(packed, number_of_entries * sizeof(double));
+}
+
+/**
+ * @brief Computes y = Bx for a block-diagonal matrix B packed by coco_pack_block_matrix.
+ *
+ * Each block is a small dense matrix-vector product. Four rows are computed at a time, so that their sums
+ * stay in registers and every loaded x[j] is used four times, while the four entries of a column are
+ * contiguous in memory (and can be vectorized). Every y[i] is still summed up in the order of the columns.
+ */
+static void coco_apply_packed_block_matrix(const double *packed,
+                                           const size_t *block_sizes,
+                                           const size_t nb_blocks,
+                                           const double *x,
+                                           double *y) {
+  const double *current_block = packed, *column;
+  size_t i, j, idx_block, current_blocksize;
+  double y0, y1, y2, y3, x_j;
+
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    current_blocksize = block_sizes[idx_block];
+    for (i = 0; i + 4 <= current_blocksize; i += 4) {
+      y0 = y1 = y2 = y3 = 0;
+      column = current_block + i;
+      for (j = 0; j < current_blocksize; j++, column += current_blocksize) {
+        x_j = x[j];
+        y0 += column[0] * x_j;
+        y1 += column[1] * x_j;
+        y2 += column[2] * x_j;
+        y3 += column[3] * x_j;
+      }
+      y[i] = y0;
+      y[i + 1] = y1;
+      y[i + 2] = y2;
+      y[i + 3] = y3;
+    }
+    for (; i < current_blocksize; i++) {
+      y0 = 0;
+      column = current_block + i;
+      for (j = 0; j < current_blocksize; j++, column += current_blocksize) {
+        y0 += column[0] * x[j];
+      }
+      y[i] = y0;
+    }
+    current_block += current_blocksize * current_blocksize;
+    x += current_blocksize;
+    y += current_blocksize;
+  }
+}
+
+/**
+ * @brief Computes y = B^T x for a block-diagonal matrix B packed by coco_pack_block_matrix.
+ *
+ * The columns of B are the rows of B^T and are contiguous in memory, so that each y[j] is a plain dot
+ * product.
+ */
+static void coco_apply_packed_block_matrix_transpose(const double *packed,
+                                                     const size_t *block_sizes,
+                                                     const size_t nb_blocks,
+                                                     const double *x,
+                                                     double *y) {
+  const double *column = packed;
+  size_t i, j, idx_block, current_blocksize;
+  double y0;
+
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    current_blocksize = block_sizes[idx_block];
+    for (j = 0; j < current_blocksize; j++, column += current_blocksize) {
+      y0 = 0;
+      for (i = 0; i < current_blocksize; i++) {
+        y0 += column[i] * x[i];
+      }
+      y[j] = y0;
+    }
+    x += current_blocksize;
+    y += current_blocksize;
+  }
+}
+
+/**
+ * @brief Checks that the blocks of a packed block-diagonal matrix are orthogonal and raises coco_error
+ * otherwise.
+ */
+static void coco_test_packed_block_matrix(const double *packed,
+                                          const size_t *block_sizes,
+                                          const size_t nb_blocks,
+                                          const double precision) {
+  const double *current_block = packed;
+  size_t i, k, j, idx_block, current_blocksize, first_row;
+  double product;
+
+  first_row = 0;
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    current_blocksize = block_sizes[idx_block];
+    for (i = 0; i < current_blocksize; i++) {
+      for (k = 0; k < current_blocksize; k++) {
+        /* product of the rows i and k of the block */
+        product = 0;
+        for (j = 0; j < current_blocksize; j++) {
+          product += current_block[j * current_blocksize + k] * current_block[j * current_blocksize + i];
+        }
+        if (!coco_double_almost_equal(product, (i == k) ? 1.0 : 0.0, precision)) {
+          coco_error("coco_test_packed_block_matrix() with precision %e failed on row %lu",
+              precision, (unsigned long) (first_row + i));
+        }
+      }
+    }
+    current_block += current_blocksize * current_blocksize;
+    first_row += current_blocksize;
+  }
+}
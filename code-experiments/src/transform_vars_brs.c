@@ -52,6 +52,44 @@ static void transform_vars_brs_evaluate(coco_problem_t *problem, const double *x
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function.
+ */
+static double transform_vars_brs_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  double factor;
+
+  factor = pow(sqrt(10.0), (double) (long) i / ((double) (long) problem->number_of_variables - 1.0));
+  if (x_i > 0.0 && i % 2 == 0) {
+    factor *= 10.0;
+  }
+  return inner_problem->evaluate_term(inner_problem, i, factor * x_i);
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_brs_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_brs_data_t *data;
+  double *factors;
+
+  data = (transform_vars_brs_data_t *) coco_problem_transformed_get_data(problem);
+  factors = coco_allocate_vector(problem->number_of_variables);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    factors[i] = pow(sqrt(10.0), (double) (long) i / ((double) (long) problem->number_of_variables - 1.0));
+    if (x[i] > 0.0 && i % 2 == 0) {
+      factors[i] *= 10.0;
+    }
+    data->x[i] = factors[i] * x[i];
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= factors[i];
+  }
+  coco_free_memory(factors);
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -60,6 +98,17 @@ static void transform_vars_brs_free(void *thing) {
   coco_free_memory(data->x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_brs_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_brs_data_t *clone_data;
+  clone_data = (transform_vars_brs_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *(transform_vars_brs_data_t *) thing;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -70,7 +119,12 @@ static coco_problem_t *transform_vars_brs(coco_problem_t *inner_problem) {
   data = (transform_vars_brs_data_t *) coco_allocate_memory(sizeof(*data));
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_brs_free, "transform_vars_brs");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_brs_clone);
   problem->evaluate_function = transform_vars_brs_evaluate;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_vars_brs_evaluate_term;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_brs_evaluate_gradient;
 
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_warning("transform_vars_brs(): 'best_parameter' not updated, set to NAN");
@@ -44,6 +44,19 @@ static void transform_vars_conditioning_evaluate(coco_problem_t *problem, const
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function.
+ */
+static double transform_vars_conditioning_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  transform_vars_conditioning_data_t *data;
+  coco_problem_t *inner_problem;
+
+  data = (transform_vars_conditioning_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  return inner_problem->evaluate_term(inner_problem, i,
+      pow(data->alpha, 0.5 * (double) (long) i / ((double) (long) problem->number_of_variables - 1.0)) * x_i);
+}
+
 /**
  * @brief Evaluates the gradient of the transformed function.
  */
@@ -83,6 +96,17 @@ static void transform_vars_conditioning_free(void *thing) {
   coco_free_memory(data->x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_conditioning_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_conditioning_data_t *clone_data;
+  clone_data = (transform_vars_conditioning_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *(transform_vars_conditioning_data_t *) thing;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -94,8 +118,12 @@ static coco_problem_t *transform_vars_conditioning(coco_problem_t *inner_problem
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
   data->alpha = alpha;
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_conditioning_free, "transform_vars_conditioning");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_conditioning_clone);
   problem->evaluate_function = transform_vars_conditioning_evaluate;
-  problem->evaluate_gradient = transform_vars_conditioning_evaluate_gradient;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_conditioning_evaluate_gradient;
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_vars_conditioning_evaluate_term;
 
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_warning("transform_vars_conditioning(): 'best_parameter' not updated, set to NAN");
@@ -16,6 +16,12 @@
  *
  * When evaluating such a problem, the x values of the integer variables are first discretized. Any value
  * x < 0 is mapped to 0 and any value x > (n-1) is mapped to (n-1).
+ *
+ * Since the number of integer values per variable is small, the inner-problem value of each of them is
+ * computed once when the transformation is created and evaluation reduces to a table lookup. When the problem
+ * is evaluated with coco_evaluate_function_mixint, the problems wrapping the transformation reach its data
+ * directly (see coco_problem_s.discretization), so that the integers index the table and the rounding is
+ * skipped as well.
  */
 
 #include <assert.h>
@@ -28,8 +34,36 @@
  */
 typedef struct {
   double *offset;
+  double *inner_values;        /**< @brief Inner-problem values of all integers, one block per variable */
+  size_t *inner_values_start;  /**< @brief Position of the block of each integer variable in inner_values */
+  double *discretized_x;       /**< @brief Preallocated buffer for the transformed decision vector */
+  double *integer_x;           /**< @brief Preallocated buffer for the decision vector given by integers */
+  int is_prepared;             /**< @brief Whether discretized_x holds the next decision vector to evaluate */
+  double *smallest_integers;   /**< @brief The smallest value of each integer variable */
+  double *largest_integers;    /**< @brief The largest value of each integer variable */
+  size_t number_of_variables;
+  size_t number_of_integer_variables;
+  size_t *number_of_owners; /**< @brief Number of clones sharing the offsets, bounds and inner values (NULL if not shared) */
 } transform_vars_discretize_data_t;
 
+/**
+ * @brief Returns the inner-problem value of the i-th (integer) variable with the integer value x_i.
+ */
+static double transform_vars_discretize_value(const transform_vars_discretize_data_t *data,
+                                              const size_t i,
+                                              const double x_i) {
+  const double outer_l = data->smallest_integers[i];
+  const double outer_u = data->largest_integers[i];
+  double bounded_x = x_i;
+
+  /* Make sure you the bounds are respected */
+  if (bounded_x < outer_l)
+    bounded_x = outer_l;
+  if (bounded_x > outer_u)
+    bounded_x = outer_u;
+  return data->inner_values[data->inner_values_start[i] + (size_t) (bounded_x - outer_l)];
+}
+
 /**
  * @brief Evaluates the transformed objective function.
  */
@@ -38,39 +72,45 @@ static void transform_vars_discretize_evaluate_function(coco_problem_t *problem,
   transform_vars_discretize_data_t *data;
   coco_problem_t *inner_problem;
   double *discretized_x;
-  double l, u, inner_l, inner_u, outer_l, outer_u;
-  int n;
+  int is_prepared;
+
+  data = (transform_vars_discretize_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  is_prepared = data->is_prepared;
+  data->is_prepared = 0;
 
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
     coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
     return;
   }
 
-  data = (transform_vars_discretize_data_t *) coco_problem_transformed_get_data(problem);
-  inner_problem = coco_problem_transformed_get_inner_problem(problem);
-
-  /* Transform x to fit in the discretized space */
-  discretized_x = coco_duplicate_vector(x, problem->number_of_variables);
-  for (i = 0; i < problem->number_of_integer_variables; ++i) {
-    outer_l = problem->smallest_values_of_interest[i];
-    outer_u = problem->largest_values_of_interest[i];
-    l = inner_problem->smallest_values_of_interest[i];
-    u = inner_problem->largest_values_of_interest[i];
-    n = coco_double_to_int(outer_u) - coco_double_to_int(outer_l) + 1; /* number of integer values in this coordinate */
-    assert(n > 1);
-    inner_l = l + (u - l) / (n + 1);
-    inner_u = u - (u - l) / (n + 1);
-    /* Make sure you the bounds are respected */
-    discretized_x[i] = coco_double_round(x[i]);
-    if (discretized_x[i] < outer_l)
-      discretized_x[i] = outer_l;
-    if (discretized_x[i] > outer_u)
-      discretized_x[i] = outer_u;
-    discretized_x[i] = inner_l + (inner_u - inner_l) * (discretized_x[i] - outer_l) / (outer_u - outer_l) - data->offset[i];
+  /* Transform x to fit in the discretized space (unless this was done from its integers) */
+  discretized_x = data->discretized_x;
+  if (!is_prepared) {
+    for (i = 0; i < problem->number_of_integer_variables; ++i) {
+      discretized_x[i] = transform_vars_discretize_value(data, i, coco_double_round(x[i]));
+    }
+    for (i = problem->number_of_integer_variables; i < problem->number_of_variables; ++i) {
+      discretized_x[i] = x[i];
+    }
   }
 
   coco_evaluate_function(inner_problem, discretized_x, y);
-  coco_free_memory(discretized_x);
+}
+
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function.
+ */
+static double transform_vars_discretize_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  transform_vars_discretize_data_t *data;
+  coco_problem_t *inner_problem;
+
+  data = (transform_vars_discretize_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  if (i < problem->number_of_integer_variables)
+    return inner_problem->evaluate_term(inner_problem, i, transform_vars_discretize_value(data, i,
+        coco_double_round(x_i)));
+  return inner_problem->evaluate_term(inner_problem, i, x_i);
 }
 
 /**
@@ -78,7 +118,60 @@ static void transform_vars_discretize_evaluate_function(coco_problem_t *problem,
  */
 static void transform_vars_discretize_free(void *thing) {
   transform_vars_discretize_data_t *data = (transform_vars_discretize_data_t *) thing;
-  coco_free_memory(data->offset);
+  coco_free_memory(data->discretized_x);
+  coco_free_memory(data->integer_x);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->offset);
+    coco_free_memory(data->inner_values);
+    coco_free_memory(data->inner_values_start);
+    coco_free_memory(data->smallest_integers);
+    coco_free_memory(data->largest_integers);
+  }
+}
+
+/**
+ * @brief Clones the data object, sharing the offsets, bounds and inner values.
+ */
+static void *transform_vars_discretize_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_discretize_data_t *data = (transform_vars_discretize_data_t *) thing;
+  transform_vars_discretize_data_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_discretize_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->discretized_x = coco_allocate_vector(problem->number_of_variables);
+  clone_data->integer_x = coco_allocate_vector(problem->number_of_variables);
+  clone_data->is_prepared = 0;
+  return clone_data;
+}
+
+/**
+ * @brief Prepares the discretization for the evaluation in the point given by its integer and continuous
+ * parts (see coco_evaluate_function_mixint) and returns the decision vector in which to evaluate the problem.
+ *
+ * The integers are mapped straight to their tabulated inner values, which the next evaluation of the
+ * transformation uses instead of rounding the decision vector.
+ */
+static double *transform_vars_discretize_prepare_integers(void *discretization,
+                                                          const int32_t *x_int32,
+                                                          const int64_t *x_int64,
+                                                          const double *x_cont) {
+  transform_vars_discretize_data_t *data = (transform_vars_discretize_data_t *) discretization;
+  size_t i;
+
+  data->is_prepared = 0;
+  if ((x_int32 == NULL) && (x_int64 == NULL))
+    return NULL;
+
+  for (i = 0; i < data->number_of_integer_variables; i++) {
+    data->integer_x[i] = (x_int32 != NULL) ? (double) x_int32[i] : (double) x_int64[i];
+    data->discretized_x[i] = transform_vars_discretize_value(data, i, data->integer_x[i]);
+  }
+  for (i = data->number_of_integer_variables; i < data->number_of_variables; i++) {
+    data->integer_x[i] = x_cont[i - data->number_of_integer_variables];
+    data->discretized_x[i] = data->integer_x[i];
+  }
+  data->is_prepared = 1;
+  return data->integer_x;
 }
 
 /**
@@ -94,14 +187,35 @@ static coco_problem_t *transform_vars_discretize(coco_problem_t *inner_problem,
   double outer_xopt, inner_xopt, inner_approx_xopt;
   const double precision_offset = 1e-7; /* Needed to avoid issues with rounding doubles */
   int n;
-  size_t i;
+  size_t i, k, number_of_values;
 
   data = (transform_vars_discretize_data_t *) coco_allocate_memory(sizeof(*data));
   data->offset = coco_allocate_vector(inner_problem->number_of_variables);
+  data->discretized_x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->integer_x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->is_prepared = 0;
+  data->smallest_integers = coco_duplicate_vector(smallest_values_of_interest, number_of_integer_variables);
+  data->largest_integers = coco_duplicate_vector(largest_values_of_interest, number_of_integer_variables);
+  data->number_of_variables = inner_problem->number_of_variables;
+  data->number_of_integer_variables = number_of_integer_variables;
+  data->number_of_owners = NULL;
+  data->inner_values_start = coco_allocate_vector_size_t(number_of_integer_variables);
+
+  /* Count the integer values of all integer variables */
+  number_of_values = 0;
+  for (i = 0; i < number_of_integer_variables; i++) {
+    data->inner_values_start[i] = number_of_values;
+    number_of_values += (size_t) (coco_double_to_int(largest_values_of_interest[i])
+        - coco_double_to_int(smallest_values_of_interest[i]) + 1);
+  }
+  data->inner_values = coco_allocate_vector(number_of_values);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_discretize_free, "transform_vars_discretize");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_discretize_clone);
   assert(number_of_integer_variables > 0);
   problem->number_of_integer_variables = number_of_integer_variables;
+  problem->prepare_integers = transform_vars_discretize_prepare_integers;
+  problem->discretization = data;
 
   for (i = 0; i < problem->number_of_variables; i++) {
     assert(smallest_values_of_interest[i] < largest_values_of_interest[i]);
@@ -132,12 +246,20 @@ static coco_problem_t *transform_vars_discretize(coco_problem_t *inner_problem,
       inner_approx_xopt = inner_l + (inner_u - inner_l) * (outer_xopt - outer_l) / (outer_u - outer_l);
       /* Compute the difference between the inner_approx_xopt and inner_xopt */
       data->offset[i] = inner_approx_xopt - inner_xopt;
+      /* Tabulate the inner-problem value of each of the n integer values */
+      for (k = 0; k < (size_t) n; k++) {
+        data->inner_values[data->inner_values_start[i] + k] = inner_l + (inner_u - inner_l)
+            * ((outer_l + (double) k) - outer_l) / (outer_u - outer_l) - data->offset[i];
+      }
     }
   }
     
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_discretize_evaluate_function;
 
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_vars_discretize_evaluate_term;
+
   if (problem->number_of_constraints > 0)
     coco_error("transform_vars_discretize(): Constraints not supported yet.");
 
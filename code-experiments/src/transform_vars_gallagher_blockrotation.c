@@ -28,6 +28,17 @@ static void transform_vars_gallagher_blockrotation_free(void *thing) {
   coco_free_memory(data->x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_gallagher_blockrotation_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_gallagher_blockrotation_t *clone_data;
+  (void) thing; /* To silence the compiler */
+  clone_data = (transform_vars_gallagher_blockrotation_t *) coco_allocate_memory(sizeof(*clone_data));
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
+}
+
 /**
  * @brief Data type in problem->versatile_data of f_gallagher.c
  */
@@ -38,6 +49,7 @@ typedef struct {
   double *rotated_x;
   size_t nb_blocks, *block_sizes, *block_size_map, *first_non_zero_map;
   double **B;
+  size_t *number_of_owners; /**< @brief Number of clones sharing the block-rotation fields (NULL if not shared) */
 } f_gallagher_versatile_data_t;
 
 /**
@@ -55,17 +67,19 @@ static void f_gallagher_versatile_data_free(coco_problem_t *problem) {
   if (versatile_data->rotated_x != NULL) {
     coco_free_memory(versatile_data->rotated_x);
   }
-  if (versatile_data->block_sizes != NULL) {
-    coco_free_memory(versatile_data->block_sizes);
-  }
-  if (versatile_data->block_size_map != NULL) {
-    coco_free_memory(versatile_data->block_size_map);
-  }
-  if (versatile_data->first_non_zero_map != NULL) {
-    coco_free_memory(versatile_data->first_non_zero_map);
-  }
-  if (versatile_data->B != NULL) {
-    coco_free_block_matrix(versatile_data->B, problem->number_of_variables);
+  if (coco_shared_references_decrease(&versatile_data->number_of_owners)) {
+    if (versatile_data->block_sizes != NULL) {
+      coco_free_memory(versatile_data->block_sizes);
+    }
+    if (versatile_data->block_size_map != NULL) {
+      coco_free_memory(versatile_data->block_size_map);
+    }
+    if (versatile_data->first_non_zero_map != NULL) {
+      coco_free_memory(versatile_data->first_non_zero_map);
+    }
+    if (versatile_data->B != NULL) {
+      coco_free_block_matrix(versatile_data->B, problem->number_of_variables);
+    }
   }
   coco_free_memory(versatile_data);
   problem->versatile_data = NULL;
@@ -74,6 +88,30 @@ static void f_gallagher_versatile_data_free(coco_problem_t *problem) {
 }
 
 
+/**
+ * @brief Clones the gallagher_versatile_data part of the problem: the sub-problems are cloned, while the
+ * block-rotation is shared.
+ */
+static void f_gallagher_versatile_data_clone(coco_problem_t *clone, coco_problem_t *problem) {
+  size_t i;
+  f_gallagher_versatile_data_t *versatile_data, *clone_versatile_data;
+  versatile_data = (f_gallagher_versatile_data_t *) problem->versatile_data;
+  coco_shared_references_increase(&versatile_data->number_of_owners);
+  clone_versatile_data = (f_gallagher_versatile_data_t *) coco_allocate_memory(sizeof(*clone_versatile_data));
+  *clone_versatile_data = *versatile_data;
+  if (versatile_data->sub_problems != NULL) {
+    clone_versatile_data->sub_problems = (coco_problem_t **) coco_allocate_memory(
+        versatile_data->number_of_peaks * sizeof(coco_problem_t *));
+    for (i = 0; i < versatile_data->number_of_peaks; i++) {
+      clone_versatile_data->sub_problems[i] = coco_problem_clone(versatile_data->sub_problems[i]);
+    }
+  }
+  if (versatile_data->rotated_x != NULL) {
+    clone_versatile_data->rotated_x = coco_allocate_vector(problem->number_of_variables);
+  }
+  clone->versatile_data = clone_versatile_data;
+}
+
 /**
  * @brief Evaluates the transformation.
  */
@@ -117,6 +155,9 @@ static coco_problem_t *transform_vars_gallagher_blockrotation(coco_problem_t *in
   }
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_gallagher_blockrotation_free, "transform_vars_gallagher_blockrotation");
   problem->evaluate_function = transform_vars_gallagher_blockrotation_evaluate;
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_gallagher_blockrotation_clone);
+  /* The rotation is only visible to the sub-problems through versatile_data */
+  problem->evaluate_gradient = NULL;
   return problem;
 }
 
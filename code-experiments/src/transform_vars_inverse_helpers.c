@@ -0,0 +1,137 @@
+/**
+ * @file transform_vars_inverse_helpers.c
+ * @brief Implements the functions needed to apply the inverse of the coordinate-wise non-linear
+ * transformations (tosz, tasy and their composition) to the initial solution.
+ */
+
+#include <math.h>
+#include <float.h>
+
+#include "coco.h"
+#include "coco_problem.c"
+
+/**
+ * @brief Type of an increasing univariate function that also returns its derivative.
+ */
+typedef double (*transform_inv_function_type)(double u, const void *data, double *derivative);
+
+/**
+ * @brief Type of a coordinate-wise univariate transformation (or its inverse) of the i-th coordinate.
+ */
+typedef double (*transform_inv_uv_type)(double xi, size_t i, void *data);
+
+/**
+ * @brief Returns u in [lower, upper] such that f(u) = v, where f is increasing and f(lower) <= v <= f(upper).
+ *
+ * Newton's method safeguarded by bisection: the root stays bracketed, so that the method converges even
+ * where the derivative is small, and the result is accurate up to a few ulps.
+ */
+static double transform_inv_newton(transform_inv_function_type f,
+                                   const double v,
+                                   double lower,
+                                   double upper,
+                                   const void *data) {
+  double u, u_next, fu, derivative;
+  size_t iteration;
+
+  u = (lower + upper) / 2.0;
+  for (iteration = 0; iteration < 100; ++iteration) {
+    fu = f(u, data, &derivative) - v;
+    if (fu == 0.0)
+      return u;
+    if (fu < 0.0)
+      lower = u;
+    else
+      upper = u;
+    u_next = u - fu / derivative;
+    if (!(lower < u_next && u_next < upper))
+      u_next = (lower + upper) / 2.0;
+    if (fabs(u_next - u) <= 2.0 * DBL_EPSILON * (1.0 + fabs(u)))
+      return u_next;
+    u = u_next;
+  }
+  return u;
+}
+
+/**
+ * @brief Returns the smallest j such that yi * halving_factor^j lies in the open interval (lower, upper),
+ * which is assumed to contain 0.
+ */
+static size_t transform_inv_halving_exponent(const double yi,
+                                             const double lower,
+                                             const double upper,
+                                             const double halving_factor) {
+  double bound;
+  size_t j = 0;
+
+  if (lower < yi && yi < upper)
+    return 0;
+  bound = (yi > 0.0) ? upper : lower;
+  /* The estimate is only corrected by a step or two because of rounding */
+  if (yi / bound > 1.0)
+    j = (size_t) (log(yi / bound) / -log(halving_factor));
+  while (j > 0 && lower < yi * pow(halving_factor, (double) (long) (j - 1))
+      && yi * pow(halving_factor, (double) (long) (j - 1)) < upper)
+    j--;
+  while (!(lower < yi * pow(halving_factor, (double) (long) j) && yi * pow(halving_factor, (double) (long) j) < upper))
+    j++;
+  return j;
+}
+
+/**
+ * @brief Applies the inverse of a coordinate-wise increasing transformation with fixed point 0 to the
+ * initial solution.
+ *
+ * Takes xopt as input to check the solution remains in the bounds [-5, 5]. If not, the initial solution is
+ * multiplied by the smallest power of halving_factor for which all its coordinates do. Because the
+ * transformation is increasing, this power is found for each coordinate by mapping the bounds forward
+ * instead of inverting the transformation for each trial power, so that the inverse is computed only once
+ * per coordinate.
+ */
+static void transform_inv_initial_apply(coco_problem_t *problem,
+                                        const double *xopt,
+                                        transform_inv_uv_type transform,
+                                        transform_inv_uv_type transform_inv,
+                                        void *data) {
+  size_t i, j, j_i;
+  double lower, upper;
+  double *sol = NULL;
+  double halving_factor = .5;
+  int is_in_bounds = 0;
+
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    if (!(-5.0 < xopt[i] && xopt[i] < 5.0) || coco_is_nan(problem->initial_solution[i]))
+      return;
+  }
+
+  j = 0;
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    lower = transform(-5.0 - xopt[i], i, data);
+    upper = transform(5.0 - xopt[i], i, data);
+    j_i = transform_inv_halving_exponent(problem->initial_solution[i], lower, upper, halving_factor);
+    if (j_i > j)
+      j = j_i;
+  }
+
+  sol = coco_allocate_vector(problem->number_of_variables);
+  /* Guards against rounding in the inverse right at the bounds */
+  while (!is_in_bounds) {
+    is_in_bounds = 1;
+    for (i = 0; i < problem->number_of_variables; ++i) {
+      sol[i] = transform_inv(problem->initial_solution[i] * pow(halving_factor, (double) (long) j), i, data);
+      if (coco_is_nan(sol[i]))
+        break;
+      if (!(-5.0 < sol[i] + xopt[i] && sol[i] + xopt[i] < 5.0)) {
+        is_in_bounds = 0;
+        j++;
+        break;
+      }
+    }
+  }
+  if (!coco_vector_contains_nan(sol, problem->number_of_variables)) {
+    for (i = 0; i < problem->number_of_variables; ++i) {
+      problem->initial_solution[i] = sol[i];
+    }
+  }
+  coco_free_memory(sol);
+}
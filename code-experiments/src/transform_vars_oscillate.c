@@ -12,6 +12,7 @@
 #include "coco.h"
 #include "coco_problem.c"
 #include "brentq.c"
+#include "transform_vars_inverse_helpers.c"
 
 /**
  * @brief Data type for transform_vars_oscillate.
@@ -49,12 +50,78 @@ static double tosz_uv(double xi, tosz_data *d) {
 }
 
 /**
- * @brief Inverse of oscillating non-linear transformation tosz_uv obtained with brentq.
+ * @brief Derivative of the univariate oscillating non-linear transformation tosz_uv.
+ *
+ * The derivative does not exist in 0, where 1 (the derivative of the identity that tosz_uv oscillates
+ * around) is returned.
+ */
+static double tosz_uv_derivative(double xi, tosz_data *d) {
+  double tmp;
+  if (xi > 0.0) {
+    tmp = log(xi) / d->alpha;
+    return tosz_uv(xi, d) / xi * (1.0 + 0.49 * (cos(tmp) + 0.79 * cos(0.79 * tmp)));
+  } else if (xi < 0.0) {
+    tmp = log(-xi) / d->alpha;
+    return tosz_uv(xi, d) / xi * (1.0 + 0.49 * (0.55 * cos(0.55 * tmp) + 0.31 * cos(0.31 * tmp)));
+  }
+  return 1.0;
+}
+
+/**
+ * @brief Logarithm of tosz_uv as a function of u = log(xi) for xi > 0 (and its derivative).
+ */
+static double tosz_uv_log_positive(double u, const void *data, double *derivative) {
+  const tosz_data *d = (const tosz_data *) data;
+  double tmp = u / d->alpha;
+  *derivative = 1.0 + 0.49 * (cos(tmp) + 0.79 * cos(0.79 * tmp));
+  return u + 0.49 * d->alpha * (sin(tmp) + sin(0.79 * tmp));
+}
+
+/**
+ * @brief Logarithm of -tosz_uv as a function of u = log(-xi) for xi < 0 (and its derivative).
+ */
+static double tosz_uv_log_negative(double u, const void *data, double *derivative) {
+  const tosz_data *d = (const tosz_data *) data;
+  double tmp = u / d->alpha;
+  *derivative = 1.0 + 0.49 * (0.55 * cos(0.55 * tmp) + 0.31 * cos(0.31 * tmp));
+  return u + 0.49 * d->alpha * (sin(0.55 * tmp) + sin(0.31 * tmp));
+}
+
+/**
+ * @brief Inverse of oscillating non-linear transformation tosz_uv.
+ *
+ * In log space, tosz_uv is the identity plus an oscillation of amplitude at most 0.98 * alpha and its
+ * derivative is at least 1 - 0.49 * 1.79 > 0, so the inverse is bracketed around log(|yi|) and found with
+ * a safeguarded Newton's method.
  */
 static double tosz_uv_inv(double yi, tosz_data *d) {
-  double xi;
-  xi = brentinv((callback_type) &tosz_uv, yi, d);
-  return xi;
+  double v;
+  if (yi > 0.0) {
+    v = log(yi);
+    return exp(transform_inv_newton(tosz_uv_log_positive, v,
+        v - 0.98 * d->alpha, v + 0.98 * d->alpha, d));
+  } else if (yi < 0.0) {
+    v = log(-yi);
+    return -exp(transform_inv_newton(tosz_uv_log_negative, v,
+        v - 0.98 * d->alpha, v + 0.98 * d->alpha, d));
+  }
+  return yi;
+}
+
+/**
+ * @brief Wraps tosz_uv to be used by transform_inv_initial_apply.
+ */
+static double tosz_uv_of_coordinate(double xi, size_t i, void *d) {
+  (void) i; /* To silence the compiler */
+  return tosz_uv(xi, (tosz_data *) d);
+}
+
+/**
+ * @brief Wraps tosz_uv_inv to be used by transform_inv_initial_apply.
+ */
+static double tosz_uv_inv_of_coordinate(double yi, size_t i, void *d) {
+  (void) i; /* To silence the compiler */
+  return tosz_uv_inv(yi, (tosz_data *) d);
 }
 
 /**
@@ -108,6 +175,38 @@ static void transform_vars_oscillate_evaluate_function(coco_problem_t *problem,
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_oscillate_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_oscillate_data_t *data;
+  tosz_data d;
+
+  data = (transform_vars_oscillate_data_t *) coco_problem_transformed_get_data(problem);
+  d.alpha = data->alpha;
+
+  tosz(data, x, problem->number_of_variables);
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->oscillated_x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= tosz_uv_derivative(x[i], &d);
+  }
+}
+
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function.
+ */
+static double transform_vars_oscillate_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  transform_vars_oscillate_data_t *data;
+  coco_problem_t *inner_problem;
+  tosz_data d;
+
+  data = (transform_vars_oscillate_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  d.alpha = data->alpha;
+  return inner_problem->evaluate_term(inner_problem, i, tosz_uv(x_i, &d));
+}
+
 /**
  * @brief Evaluates the transformed constraints.
  */
@@ -154,6 +253,17 @@ static void transform_vars_oscillate_free(void *thing) {
   coco_free_memory(data->oscillated_x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_oscillate_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_oscillate_data_t *clone_data;
+  clone_data = (transform_vars_oscillate_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *(transform_vars_oscillate_data_t *) thing;
+  clone_data->oscillated_x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -166,9 +276,16 @@ static coco_problem_t *transform_vars_oscillate(coco_problem_t *inner_problem) {
 
   problem = coco_problem_transformed_allocate(inner_problem, data, 
     transform_vars_oscillate_free, "transform_vars_oscillate");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_oscillate_clone);
     
   if (inner_problem->number_of_objectives > 0)
     problem->evaluate_function = transform_vars_oscillate_evaluate_function;
+
+  if (inner_problem->evaluate_term != NULL)
+    problem->evaluate_term = transform_vars_oscillate_evaluate_term;
+
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_oscillate_evaluate_gradient;
     
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_oscillate_evaluate_constraint;
@@ -177,60 +294,19 @@ static coco_problem_t *transform_vars_oscillate(coco_problem_t *inner_problem) {
 }
 
 /**
- * @brief Applies the inverse of the oscillating transformation tasy(tosz(.)) to the initial solution.
- * 
+ * @brief Applies the inverse of the oscillating transformation tosz to the initial solution.
+ *
  *        Takes xopt as input to check the solution remains in the bounds
- *        If not, a curve search is performed
+ *        If not, the initial solution is halved until it does (see transform_inv_initial_apply)
  *        xopt is needed because transform_vars_shift is not yet called
  *        in f_{function}_rotated_c_linear_cons_bbob_problem_allocate
  */
 static void transform_inv_initial_oscillate(coco_problem_t *problem, const double *xopt) {
-  size_t i;
-  size_t j;
-  int is_in_bounds;
-  double di = 0.0;
-  double xi;
-  double *sol = NULL;
-  double halving_factor = .5;
-
   transform_vars_oscillate_data_t *data;
-  tosz_data *d;
-
-  sol = coco_allocate_vector(problem->number_of_variables);
-  d = coco_allocate_memory(sizeof(*d));
+  tosz_data d;
 
   data = (transform_vars_oscillate_data_t *) coco_problem_transformed_get_data(problem);
-  d->alpha = data->alpha;
+  d.alpha = data->alpha;
 
-  j = 0;
-  while (1) {
-
-    for (i = 0; i < problem->number_of_variables; ++i) {
-      di = tosz_uv_inv(problem->initial_solution[i] * pow(halving_factor, (double) (long) j), d);
-      xi = di + xopt[i];
-      is_in_bounds = (int) (-5.0 < xi  && xi < 5.0);
-      /* Line search for the inverse-transformed feasible initial solution
-         to remain within the bounds
-        */
-      if (!is_in_bounds) {
-        j = j + 1;
-        break;
-      }
-      sol[i] = di;
-    }
-    if (!is_in_bounds && !coco_is_nan(di)){
-      continue;
-    }
-    else {
-      break;
-    }   
-  }
-  if (!coco_vector_contains_nan(sol, problem->number_of_variables)) {
-    for (i = 0; i < problem->number_of_variables; ++i) {
-      problem->initial_solution[i] = sol[i];
-    }
-  }
-  coco_free_memory(d);
-  coco_free_memory(sol);
+  transform_inv_initial_apply(problem, xopt, tosz_uv_of_coordinate, tosz_uv_inv_of_coordinate, &d);
 }
-
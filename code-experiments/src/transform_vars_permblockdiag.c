@@ -1,5 +1,11 @@
 /**
  * @file transform_vars_permblockdiag.c
+ * @brief Implementation of applying a double permuted block-diagonal matrix to the decision values.
+ *
+ * x |-> P2 B P1 x
+ * Equivalent to (and replaces) a permutation of the variables by P1 wrapped around a
+ * transform_vars_blockrotation with B wrapped around a permutation of the variables by P2. The blocks of B
+ * are stored contiguously (see coco_pack_block_matrix).
  */
 
 #include <assert.h>
@@ -14,57 +20,101 @@
  * @brief Data type for transform_vars_permblockdiag.
  */
 typedef struct {
-  double **B;
-  double *x;
+  double *B;  /**< @brief the block-diagonal matrix, packed by coco_pack_block_matrix */
+  double *x;  /**< @brief the transformed decision vector */
+  double *P1x; /**< @brief the decision vector permuted by P1 */
+  double *BP1x; /**< @brief the block-diagonal matrix applied to P1x */
   size_t *P1; /*permutation matrices, P1 for the columns of B and P2 for its rows*/
   size_t *P2;
   size_t *block_sizes;
   size_t nb_blocks;
-  size_t *block_size_map; /* maps rows to blocksizes, keep until better way is found */
-  size_t *first_non_zero_map; /* maps a row to the index of its first non zero element */
+  size_t *number_of_owners; /**< @brief Number of clones sharing B, P1, P2 and block_sizes (NULL if not shared) */
 } transform_vars_permblockdiag_t;
 
 static void transform_vars_permblockdiag_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  size_t i, j, current_blocksize, first_non_zero_ind;
+  size_t i;
   transform_vars_permblockdiag_t *data;
   coco_problem_t *inner_problem;
-  
-  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
-  	coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
-  	return;
-  }
 
   data = (transform_vars_permblockdiag_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  /* gather x by P1 once, so that each block works on contiguous memory */
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    data->P1x[i] = x[data->P1[i]];
+  }
+  coco_apply_packed_block_matrix(data->B, data->block_sizes, data->nb_blocks, data->P1x, data->BP1x);
   for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    current_blocksize = data->block_size_map[data->P2[i]];  /* the block_size is that of the permuted line */
-    first_non_zero_ind = data->first_non_zero_map[data->P2[i]];
-    data->x[i] = 0;
-    /* compute data->x[i] = < B[P2[i]] , x[P1] > */
-    for (j = first_non_zero_ind; j < first_non_zero_ind + current_blocksize; ++j) {  /* blocksize[P2[i]] */
-      data->x[i] += data->B[data->P2[i]][j - first_non_zero_ind] * x[data->P1[j]];   /* all B lines start at 0 */
-    }
+    data->x[i] = data->BP1x[data->P2[i]];
   }
 
   coco_evaluate_function(inner_problem, data->x, y);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function, which is P1^T B^T P2^T times the inner
+ * gradient.
+ */
+static void transform_vars_permblockdiag_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_permblockdiag_t *data;
+  coco_problem_t *inner_problem;
+
+  data = (transform_vars_permblockdiag_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    data->P1x[i] = x[data->P1[i]];
+  }
+  coco_apply_packed_block_matrix(data->B, data->block_sizes, data->nb_blocks, data->P1x, data->BP1x);
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    data->x[i] = data->BP1x[data->P2[i]];
+  }
+  bbob_evaluate_gradient(inner_problem, data->x, y);
+
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    data->BP1x[data->P2[i]] = y[i];
+  }
+  coco_apply_packed_block_matrix_transpose(data->B, data->block_sizes, data->nb_blocks, data->BP1x, data->P1x);
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    y[data->P1[i]] = data->P1x[i];
+  }
+}
+
 static void transform_vars_permblockdiag_free(void *thing) {
   transform_vars_permblockdiag_t *data = (transform_vars_permblockdiag_t *) thing;
-  coco_free_memory(data->B);
-  coco_free_memory(data->P1);
-  coco_free_memory(data->P2);
-  coco_free_memory(data->block_sizes);
   coco_free_memory(data->x);
-  coco_free_memory(data->block_size_map);
+  coco_free_memory(data->P1x);
+  coco_free_memory(data->BP1x);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_shared_data_free(data->B);
+    coco_free_memory(data->P1);
+    coco_free_memory(data->P2);
+    coco_free_memory(data->block_sizes);
+  }
+}
+
+/**
+ * @brief Clones the data object, sharing B, P1, P2 and block_sizes.
+ */
+static void *transform_vars_permblockdiag_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_permblockdiag_t *data = (transform_vars_permblockdiag_t *) thing;
+  transform_vars_permblockdiag_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_permblockdiag_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  clone_data->P1x = coco_allocate_vector(problem->number_of_variables);
+  clone_data->BP1x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 /*
- * Apply a double permuted orthogonal block-diagonal transfromation matrix to the search space
+ * Apply a double permuted orthogonal block-diagonal transformation matrix to the search space
  *
  *
- * The matrix M is stored in row-major format.
+ * The matrix B is stored as in coco_allocate_blockmatrix.
  */
 static coco_problem_t *transform_vars_permblockdiag(coco_problem_t *inner_problem,
                                                     const double * const *B,
@@ -75,38 +125,33 @@ static coco_problem_t *transform_vars_permblockdiag(coco_problem_t *inner_proble
                                                     const size_t nb_blocks) {
   coco_problem_t *problem;
   transform_vars_permblockdiag_t *data;
-  size_t entries_in_M, idx_blocksize, next_bs_change, current_blocksize;
-  int i;
-  entries_in_M = 0;
   assert(number_of_variables > 0);/*tmp*/
-  for (i = 0; i < nb_blocks; i++) {
-    entries_in_M += block_sizes[i] * block_sizes[i];
-  }
+  assert(number_of_variables == inner_problem->number_of_variables);
+
   data = (transform_vars_permblockdiag_t *) coco_allocate_memory(sizeof(*data));
-  data->B = ls_copy_block_matrix(B, number_of_variables, block_sizes, nb_blocks);
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
-  data->P1 = coco_duplicate_size_t_vector(P1, inner_problem->number_of_variables);
-  data->P2 = coco_duplicate_size_t_vector(P2, inner_problem->number_of_variables);
+  data->B = coco_pack_block_matrix(B, number_of_variables, block_sizes, nb_blocks);
+  data->x = coco_allocate_vector(number_of_variables);
+  data->P1x = coco_allocate_vector(number_of_variables);
+  data->BP1x = coco_allocate_vector(number_of_variables);
+  data->P1 = coco_duplicate_size_t_vector(P1, number_of_variables);
+  data->P2 = coco_duplicate_size_t_vector(P2, number_of_variables);
   data->block_sizes = coco_duplicate_size_t_vector(block_sizes, nb_blocks);
   data->nb_blocks = nb_blocks;
-  data->block_size_map = coco_allocate_vector_size_t(number_of_variables);
-  data->first_non_zero_map = coco_allocate_vector_size_t(number_of_variables);
-  
-  idx_blocksize = 0;
-  next_bs_change = block_sizes[idx_blocksize];
-  for (i = 0; i < number_of_variables; i++) {
-    if (i >= next_bs_change) {
-      idx_blocksize++;
-      next_bs_change += block_sizes[idx_blocksize];
-    }
-    current_blocksize=block_sizes[idx_blocksize];
-    data->block_size_map[i] = current_blocksize;
-    data->first_non_zero_map[i] = next_bs_change - current_blocksize; /* next_bs_change serves also as a cumsum for blocksizes */
+  data->number_of_owners = NULL;
+
+  if (coco_problem_best_parameter_not_zero(inner_problem)) {
+    coco_debug("transform_vars_permblockdiag(): 'best_parameter' not updated, set to NAN");
+    coco_vector_set_to_nan(inner_problem->best_parameter, inner_problem->number_of_variables);
   }
-  
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permblockdiag_free, "transform_vars_permblockdiag");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_permblockdiag_clone);
   problem->evaluate_function = transform_vars_permblockdiag_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_permblockdiag_evaluate_gradient;
+
+  if (number_of_variables < 100) {
+    /* 1e-11 still passes and 1e-12 fails under macOS */
+    coco_test_packed_block_matrix(data->B, data->block_sizes, data->nb_blocks, 1e-5);
+  }
   return problem;
 }
-
-
@@ -1,6 +1,6 @@
 /**
  * @file transform_vars_permutation.c
- * @brief Implementation of permuting the decision values.
+ * @brief Implementation of permuting the decision values by the inverse of a given permutation.
  */
 
 #include <assert.h>
@@ -16,45 +16,28 @@
 typedef struct {
   double *x;
   size_t *P; /**< @brief the permutation matrices*/
+  size_t *number_of_owners; /**< @brief Number of clones sharing P (NULL if not shared) */
 } transform_vars_permutation_t;
 
-static void transform_vars_permutation_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  size_t i;
-  transform_vars_permutation_t *data;
-  coco_problem_t *inner_problem;
-
-  data = (transform_vars_permutation_t *) coco_problem_transformed_get_data(problem);
-  inner_problem = coco_problem_transformed_get_inner_problem(problem);
-  for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    data->x[i] = x[data->P[i]];
-  }
-
-  coco_evaluate_function(inner_problem, data->x, y);
-  assert(y[0] + 1e-13 >= problem->best_value[0]);
-}
-
 static void transform_vars_permutation_free(void *thing) {
   transform_vars_permutation_t *data = (transform_vars_permutation_t *) thing;
   coco_free_memory(data->x);
-  coco_free_memory(data->P);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->P);
+  }
 }
 
-
-static coco_problem_t *transform_vars_permutation(coco_problem_t *inner_problem,
-                                                    const size_t *P,
-                                                    const size_t number_of_variables) {
-  coco_problem_t *problem;
-  transform_vars_permutation_t *data;
-  
-  assert(number_of_variables == inner_problem->number_of_variables);/*tmp*/
-
-  data = (transform_vars_permutation_t *) coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(number_of_variables);
-  data->P = coco_duplicate_size_t_vector(P, number_of_variables);
-
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permutation_free, "transform_vars_permutation");
-  problem->evaluate_function = transform_vars_permutation_evaluate;
-  return problem;
+/**
+ * @brief Clones the data object, sharing P.
+ */
+static void *transform_vars_permutation_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_permutation_t *data = (transform_vars_permutation_t *) thing;
+  transform_vars_permutation_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_permutation_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 
@@ -74,6 +57,27 @@ static void transform_vars_inverse_permutation_evaluate(coco_problem_t *problem,
 }
 
 
+static void transform_vars_inverse_permutation_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+    size_t i;
+    transform_vars_permutation_t *data;
+    coco_problem_t *inner_problem;
+
+    data = (transform_vars_permutation_t *) coco_problem_transformed_get_data(problem);
+    inner_problem = coco_problem_transformed_get_inner_problem(problem);
+    for (i = 0; i < inner_problem->number_of_variables; ++i) {
+        data->x[data->P[i]] = x[i];
+    }
+    bbob_evaluate_gradient(inner_problem, data->x, y);
+    /* the gradient is permuted back, using data->x as workspace */
+    for (i = 0; i < inner_problem->number_of_variables; ++i) {
+        data->x[i] = y[data->P[i]];
+    }
+    for (i = 0; i < inner_problem->number_of_variables; ++i) {
+        y[i] = data->x[i];
+    }
+}
+
+
 static coco_problem_t *transform_vars_inverse_permutation(coco_problem_t *inner_problem,
                                                   const size_t *P,
                                                   const size_t number_of_variables) {
@@ -85,8 +89,12 @@ static coco_problem_t *transform_vars_inverse_permutation(coco_problem_t *inner_
     data = (transform_vars_permutation_t *) coco_allocate_memory(sizeof(*data));
     data->x = coco_allocate_vector(number_of_variables);
     data->P = coco_duplicate_size_t_vector(P, number_of_variables);
+    data->number_of_owners = NULL;
     
     problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permutation_free, "transform_vars_inverse_permutation");
+    coco_problem_transformed_set_data_clone_function(problem, transform_vars_permutation_clone);
     problem->evaluate_function = transform_vars_inverse_permutation_evaluate;
+    if (inner_problem->evaluate_gradient != NULL)
+        problem->evaluate_gradient = transform_vars_inverse_permutation_evaluate_gradient;
     return problem;
 }
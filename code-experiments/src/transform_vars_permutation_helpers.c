@@ -14,35 +14,67 @@
 
 /* TODO: Document this file in doxygen style! */
 
-static double *perm_random_data;/* global variable used to generate the random permutations */
+/**
+ * @brief A random key together with the index it belongs to (used to generate the random permutations).
+ */
+typedef struct {
+  double key;
+  size_t index;
+} coco_permutation_key_t;
 
 /**
  * @brief Comparison function used for sorting. In our case, it serves as a random permutation generator
+ *
+ * Equal keys are ordered by their index, so that the result does not depend on the qsort implementation.
  */
 static int f_compare_doubles_for_random_permutation(const void *a, const void *b) {
-  double temp = perm_random_data[*(const size_t *) a] - perm_random_data[*(const size_t *) b];
+  const coco_permutation_key_t *key_a = (const coco_permutation_key_t *) a;
+  const coco_permutation_key_t *key_b = (const coco_permutation_key_t *) b;
+  double temp = key_a->key - key_b->key;
   if (temp > 0)
     return 1;
   else if (temp < 0)
     return -1;
+  else if (key_a->index > key_b->index)
+    return 1;
+  else if (key_a->index < key_b->index)
+    return -1;
   else
     return 0;
 }
 
+/**
+ * @brief Puts in P the indices 0, ..., n - 1 sorted by the values of keys (the argsort of keys)
+ *
+ * Reentrant replacement of sorting the indices with a comparator reading the keys from a global variable.
+ */
+static void coco_compute_permutation_from_keys(size_t *P, const double *keys, size_t n) {
+  size_t i;
+  coco_permutation_key_t *sorted_keys;
+
+  sorted_keys = (coco_permutation_key_t *) coco_allocate_memory(n * sizeof(coco_permutation_key_t));
+  for (i = 0; i < n; i++) {
+    sorted_keys[i].key = keys[i];
+    sorted_keys[i].index = i;
+  }
+  qsort(sorted_keys, n, sizeof(coco_permutation_key_t), f_compare_doubles_for_random_permutation);
+  for (i = 0; i < n; i++) {
+    P[i] = sorted_keys[i].index;
+  }
+  coco_free_memory(sorted_keys);
+}
+
 /**
  * @brief generates a random, uniformly sampled, permutation and puts it in P
  * Wassim: move to coco_utilities?
  */
 static void coco_compute_random_permutation(size_t *P, long seed, size_t n) {
-  size_t i;
+  double *random_data;
 
-  perm_random_data = coco_allocate_vector(n);
-  bbob2009_gauss(perm_random_data, n, seed);
-  for (i = 0; i < n; i++){
-    P[i] = i;
-  }
-  qsort(P, n, sizeof(size_t), f_compare_doubles_for_random_permutation);
-  coco_free_memory(perm_random_data);
+  random_data = coco_allocate_vector(n);
+  bbob2009_gauss(random_data, n, seed);
+  coco_compute_permutation_from_keys(P, random_data, n);
+  coco_free_memory(random_data);
 }
 
 
@@ -50,32 +82,39 @@ static void coco_compute_random_permutation(size_t *P, long seed, size_t n) {
  * @brief generates a permutation by sorting a sequence and puts it in P
  */
 static void coco_compute_permutation_from_sequence(size_t *P, double *seq, size_t length) {
-  size_t i;
-    
-  perm_random_data = coco_allocate_vector(length);
-  for (i = 0; i < length; i++){
-      P[i] = i;
-      perm_random_data[i] = seq[i];
-  }
-  qsort(P, length, sizeof(size_t), f_compare_doubles_for_random_permutation);
-  coco_free_memory(perm_random_data);
+  coco_compute_permutation_from_keys(P, seq, length);
 }
 
 
 /**
- * @brief returns a uniformly distributed integer between lower_bound and upper_bound using seed
- * without using coco_random_new.
- * Move to coco_utilities?
+ * @brief Swaps P[first_swap_var] with another entry at most swap_range away, chosen by unif in [0, 1)
  */
-static long coco_random_unif_integer(long lower_bound, long upper_bound, long seed){
-  long range, rand_int;
-  double *tmp_uniform;
-  tmp_uniform = coco_allocate_vector(1);
-  bbob2009_unif(tmp_uniform, 1, seed);
-  range = upper_bound - lower_bound + 1;
-  rand_int = ((long)(tmp_uniform[0] * (double) range)) + lower_bound;
-  coco_free_memory(tmp_uniform);
-  return rand_int;
+static void coco_truncated_uniform_swap(size_t *P, size_t n, size_t first_swap_var, size_t swap_range,
+                                        double unif) {
+  size_t lower_bound, upper_bound, second_swap_var, tmp;
+
+  if (first_swap_var < swap_range) {
+    lower_bound = 0;
+  }
+  else{
+    lower_bound = first_swap_var - swap_range;
+  }
+  if (first_swap_var + swap_range > n - 1) {
+    upper_bound = n - 1;
+  }
+  else{
+    upper_bound = first_swap_var + swap_range;
+  }
+
+  /* uniform integer in [lower_bound, upper_bound - 1] */
+  second_swap_var = (size_t) (((long)(unif * (double) (upper_bound - lower_bound))) + (long) lower_bound);
+  if (second_swap_var >= first_swap_var) {
+    second_swap_var += 1;
+  }
+  /* swap*/
+  tmp = P[first_swap_var];
+  P[first_swap_var] = P[second_swap_var];
+  P[second_swap_var] = tmp;
 }
 
 
@@ -87,8 +126,8 @@ static long coco_random_unif_integer(long lower_bound, long upper_bound, long se
  */
 static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed, size_t n, size_t nb_swaps, size_t swap_range) {
   size_t i, idx_swap;
-  size_t lower_bound, upper_bound, first_swap_var, second_swap_var, tmp;
   size_t *idx_order;
+  double *random_data, unif;
 
   if (n <= 40) {
     /* Do an identity permutation for dimensions <= 40 */
@@ -97,54 +136,112 @@ static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed
     return;
   }
 
-  perm_random_data = coco_allocate_vector(n);
-  bbob2009_unif(perm_random_data, n, seed);
+  if (swap_range > 0) {
+    for (i = 0; i < n; i++) {
+      P[i] = i;
+    }
+    /*sort the random data and arrange idx_order accordingly*/
+    /*did not use coco_compute_random_permutation to only use the seed once*/
+    random_data = coco_allocate_vector(n);
+    bbob2009_unif(random_data, n, seed);
+    idx_order = coco_allocate_vector_size_t(n);
+    coco_compute_permutation_from_keys(idx_order, random_data, n);
+    for (idx_swap = 0; idx_swap < nb_swaps; idx_swap++) {
+      bbob2009_unif(&unif, 1, seed + (long) (1 + idx_swap) * 1000);
+      coco_truncated_uniform_swap(P, n, idx_order[idx_swap], swap_range, unif);
+    }
+    coco_free_memory(idx_order);
+    coco_free_memory(random_data);
+  } else {
+    /* generate random permutation instead */
+    coco_compute_random_permutation(P, seed, n);
+  }
+}
 
-  idx_order = coco_allocate_vector_size_t(n);
+
+/**
+ * @brief generates a random, uniformly sampled, permutation with an O(n) Fisher-Yates shuffle and puts it
+ * in P
+ *
+ * Faster than coco_compute_random_permutation, but generates different permutations, so it should only be
+ * used in new suites.
+ */
+static void coco_compute_random_permutation_fast(size_t *P, long seed, size_t n) {
+  coco_random_state_t *random_generator;
+  size_t i, j, tmp;
+
+  random_generator = coco_random_new((uint32_t) seed);
   for (i = 0; i < n; i++) {
     P[i] = i;
-    idx_order[i] = i;
+  }
+  for (i = n; i > 1; i--) {
+    j = (size_t) (coco_random_uniform(random_generator) * (double) i);
+    if (j >= i) /* guard against rounding */
+      j = i - 1;
+    tmp = P[i - 1];
+    P[i - 1] = P[j];
+    P[j] = tmp;
+  }
+  coco_random_free(random_generator);
+}
+
+
+/**
+ * @brief generates a random permutation resulting from nb_swaps truncated uniform swaps of range swap_range
+ * in O(n + nb_swaps) and puts it in P
+ *
+ * Same as coco_compute_truncated_uniform_swap_permutation, but the order of the swaps and the swapped
+ * variables are drawn from a single random stream, so that the permutations differ. It should only be used
+ * in new suites.
+ */
+static void coco_compute_truncated_uniform_swap_permutation_fast(size_t *P, long seed, size_t n, size_t nb_swaps,
+                                                                 size_t swap_range) {
+  coco_random_state_t *random_generator;
+  size_t i, idx_swap;
+  size_t *idx_order;
+
+  if (n <= 40) {
+    /* Do an identity permutation for dimensions <= 40 */
+    for (i = 0; i < n; i++)
+      P[i] = i;
+    return;
   }
 
   if (swap_range > 0) {
-    /*sort the random data in perm_random_data and arrange idx_order accordingly*/
-    /*did not use coco_compute_random_permutation to only use the seed once*/
-    qsort(idx_order, n, sizeof(size_t), f_compare_doubles_for_random_permutation);
+    for (i = 0; i < n; i++) {
+      P[i] = i;
+    }
+    idx_order = coco_allocate_vector_size_t(n);
+    coco_compute_random_permutation_fast(idx_order, seed, n);
+    random_generator = coco_random_new((uint32_t) seed + 1);
     for (idx_swap = 0; idx_swap < nb_swaps; idx_swap++) {
-      first_swap_var = idx_order[idx_swap];
-      if (first_swap_var < swap_range) {
-        lower_bound = 0;
-      }
-      else{
-        lower_bound = first_swap_var - swap_range;
-      }
-      if (first_swap_var + swap_range > n - 1) {
-        upper_bound = n - 1;
-      }
-      else{
-        upper_bound = first_swap_var + swap_range;
-      }
-
-      second_swap_var = (size_t) coco_random_unif_integer((long) lower_bound,
-                                                          (long) upper_bound - 1,
-                                                          seed + (long) (1 + idx_swap) * 1000);
-      if (second_swap_var >= first_swap_var) {
-        second_swap_var += 1;
-      }
-      /* swap*/
-      tmp = P[first_swap_var];
-      P[first_swap_var] = P[second_swap_var];
-      P[second_swap_var] = tmp;
+      coco_truncated_uniform_swap(P, n, idx_order[idx_swap % n], swap_range,
+          coco_random_uniform(random_generator));
     }
+    coco_random_free(random_generator);
+    coco_free_memory(idx_order);
   } else {
     /* generate random permutation instead */
-    coco_compute_random_permutation(P, seed, n);
+    coco_compute_random_permutation_fast(P, seed, n);
   }
-  coco_free_memory(idx_order);
-  coco_free_memory(perm_random_data);
 }
 
 
+/**
+ * @brief generates the truncated uniform swap permutation of the problems in the given suite and puts it in P
+ *
+ * The existing suites keep coco_compute_truncated_uniform_swap_permutation so that their instances do not
+ * change, while new suites use the O(n) coco_compute_truncated_uniform_swap_permutation_fast.
+ */
+static void coco_compute_swap_permutation(size_t *P, long seed, size_t n, size_t nb_swaps, size_t swap_range,
+                                          const char *suite_name) {
+  if (strcmp(suite_name, "bbob-largescale") == 0) {
+    coco_compute_truncated_uniform_swap_permutation(P, seed, n, nb_swaps, swap_range);
+  } else {
+    coco_compute_truncated_uniform_swap_permutation_fast(P, seed, n, nb_swaps, swap_range);
+  }
+}
+
 
 /**
  * @brief duplicates a size_t vector
@@ -57,6 +57,17 @@ static void transform_vars_round_step_free(void *thing) {
   coco_free_memory(data->rounded_x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_round_step_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_round_step_data_t *clone_data;
+  clone_data = (transform_vars_round_step_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *(transform_vars_round_step_data_t *) thing;
+  clone_data->rounded_x = coco_allocate_vector(problem->number_of_variables + 1);
+  return clone_data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -70,7 +81,10 @@ static coco_problem_t *transform_vars_round_step(coco_problem_t *inner_problem,
   data->alpha = alpha;
   
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_round_step_free, "transform_vars_round_step");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_round_step_clone);
   problem->evaluate_function = transform_vars_round_step_evaluate;
+  /* The gradient of the rounded variables is not that of the original ones */
+  problem->evaluate_gradient = NULL;
   /* Compute best parameter */
   for (i = 0; i < problem->number_of_variables; i++) {
     if (fabs(problem->best_parameter[i]) > 0.5) {
@@ -42,6 +42,23 @@ static void transform_vars_scale_evaluate(coco_problem_t *problem, const double
   } while (0);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_scale_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_scale_data_t *data;
+
+  data = (transform_vars_scale_data_t *) coco_problem_transformed_get_data(problem);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    data->x[i] = data->factor * x[i];
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= data->factor;
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -50,6 +67,17 @@ static void transform_vars_scale_free(void *thing) {
   coco_free_memory(data->x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_scale_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_scale_data_t *clone_data;
+  clone_data = (transform_vars_scale_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *(transform_vars_scale_data_t *) thing;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -62,7 +90,10 @@ static coco_problem_t *transform_vars_scale(coco_problem_t *inner_problem, const
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_scale_free, "transform_vars_scale");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_scale_clone);
   problem->evaluate_function = transform_vars_scale_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_scale_evaluate_gradient;
   /* Compute best parameter */
   if (data->factor != 0.) {
       for (i = 0; i < problem->number_of_variables; i++) {
@@ -15,6 +15,7 @@ typedef struct {
   double *offset;
   double *shifted_x;
   coco_problem_free_function_t old_free_problem;
+  size_t *number_of_owners; /**< @brief Number of clones sharing the offset (NULL if not shared) */
 } transform_vars_shift_data_t;
 
 /**
@@ -51,6 +52,16 @@ static void transform_vars_shift_evaluate_function(coco_problem_t *problem, cons
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Returns the contribution of the i-th variable to the transformed function.
+ */
+static double transform_vars_shift_evaluate_term(coco_problem_t *problem, const size_t i, const double x_i) {
+  transform_vars_shift_data_t *data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  return inner_problem->evaluate_term(inner_problem, i, x_i - data->offset[i]);
+}
+
 /**
  * @brief Evaluates the transformed constraint function.
  */
@@ -102,7 +113,22 @@ static void transform_vars_shift_evaluate_gradient(coco_problem_t *problem, cons
 static void transform_vars_shift_free(void *thing) {
   transform_vars_shift_data_t *data = (transform_vars_shift_data_t *) thing;
   coco_free_memory(data->shifted_x);
-  coco_free_memory(data->offset);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->offset);
+  }
+}
+
+/**
+ * @brief Clones the data object, sharing the offset.
+ */
+static void *transform_vars_shift_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_shift_data_t *data = (transform_vars_shift_data_t *) thing;
+  transform_vars_shift_data_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_shift_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->shifted_x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 /**
@@ -121,17 +147,22 @@ static coco_problem_t *transform_vars_shift(coco_problem_t *inner_problem,
   data = (transform_vars_shift_data_t *) coco_allocate_memory(sizeof(*data));
   data->offset = coco_duplicate_vector(offset, inner_problem->number_of_variables);
   data->shifted_x = coco_allocate_vector(inner_problem->number_of_variables);
+  data->number_of_owners = NULL;
 
   problem = coco_problem_transformed_allocate(inner_problem, data, 
     transform_vars_shift_free, "transform_vars_shift");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_shift_clone);
     
-  if (inner_problem->number_of_objectives > 0 && shift_constraint_only == 0)
+  if (inner_problem->number_of_objectives > 0 && shift_constraint_only == 0) {
     problem->evaluate_function = transform_vars_shift_evaluate_function;
+    if (inner_problem->evaluate_term != NULL)
+      problem->evaluate_term = transform_vars_shift_evaluate_term;
+    if (inner_problem->evaluate_gradient != NULL)
+      problem->evaluate_gradient = transform_vars_shift_evaluate_gradient;
+  }
     
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_shift_evaluate_constraint;
-    
-  problem->evaluate_gradient = transform_vars_shift_evaluate_gradient;
   
   /* Update the best parameter */
   for (i = 0; i < problem->number_of_variables; i++)
@@ -48,6 +48,28 @@ static void transform_vars_x_hat_evaluate(coco_problem_t *problem, const double
   } while (0);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_x_hat_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_x_hat_data_t *data;
+  double *signs;
+
+  data = (transform_vars_x_hat_data_t *) coco_problem_transformed_get_data(problem);
+  signs = coco_allocate_vector(problem->number_of_variables);
+  bbob2009_unif(signs, problem->number_of_variables, data->seed);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    signs[i] = (signs[i] < 0.5) ? -1.0 : 1.0;
+    data->x[i] = signs[i] * x[i];
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= signs[i];
+  }
+  coco_free_memory(signs);
+}
+
 /**
  * @brief Frees the data object.
  */
@@ -56,6 +78,17 @@ static void transform_vars_x_hat_free(void *thing) {
   coco_free_memory(data->x);
 }
 
+/**
+ * @brief Clones the data object.
+ */
+static void *transform_vars_x_hat_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_x_hat_data_t *clone_data;
+  clone_data = (transform_vars_x_hat_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *(transform_vars_x_hat_data_t *) thing;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -69,7 +102,10 @@ static coco_problem_t *transform_vars_x_hat(coco_problem_t *inner_problem, const
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_x_hat_free, "transform_vars_x_hat");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_x_hat_clone);
   problem->evaluate_function = transform_vars_x_hat_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_x_hat_evaluate_gradient;
   if (coco_problem_best_parameter_not_zero(problem)) {
     bbob2009_unif(data->x, problem->number_of_variables, data->seed);
 	for (i = 0; i < problem->number_of_variables; ++i)
@@ -17,6 +17,7 @@ typedef struct {
   double *sign_vector;
   double *x;
   coco_problem_free_function_t old_free_problem;
+  size_t *number_of_owners; /**< @brief Number of clones sharing the sign vector (NULL if not shared) */
 } transform_vars_x_hat_generic_data_t;
 
 /**
@@ -47,13 +48,46 @@ static void transform_vars_x_hat_generic_evaluate(coco_problem_t *problem, const
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_x_hat_generic_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_x_hat_generic_data_t *data;
+
+  data = (transform_vars_x_hat_generic_data_t *) coco_problem_transformed_get_data(problem);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    data->x[i] = 2.0 * data->sign_vector[i] * x[i];
+    ((f_lunacek_bi_rastrigin_versatile_data_t *) problem->versatile_data)->x_hat[i] = data->x[i];
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->x, y);
+  for (i = 0; i < problem->number_of_variables; ++i) {
+    y[i] *= 2.0 * data->sign_vector[i];
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
 static void transform_vars_x_hat_generic_free(void *thing) {
   transform_vars_x_hat_generic_data_t *data = (transform_vars_x_hat_generic_data_t *) thing;
   coco_free_memory(data->x);
-  coco_free_memory(data->sign_vector);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->sign_vector);
+  }
+}
+
+/**
+ * @brief Clones the data object, sharing the sign vector.
+ */
+static void *transform_vars_x_hat_generic_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_x_hat_generic_data_t *data = (transform_vars_x_hat_generic_data_t *) thing;
+  transform_vars_x_hat_generic_data_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_x_hat_generic_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->x = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 /**
@@ -67,12 +101,16 @@ static coco_problem_t *transform_vars_x_hat_generic(coco_problem_t *inner_proble
   data = (transform_vars_x_hat_generic_data_t *) coco_allocate_memory(sizeof(*data));
   data->x = coco_allocate_vector(inner_problem->number_of_variables);
   data->sign_vector = coco_allocate_vector(inner_problem->number_of_variables);
+  data->number_of_owners = NULL;
   for (i = 0; i < inner_problem->number_of_variables; ++i) {
     data->sign_vector[i] = sign_vector[i];
   }
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_x_hat_generic_free, "transform_vars_x_hat_generic");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_x_hat_generic_clone);
   problem->evaluate_function = transform_vars_x_hat_generic_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_x_hat_generic_evaluate_gradient;
 
   return problem;
 }
@@ -15,6 +15,7 @@ typedef struct {
   double *xopt;
   double *z;
   coco_problem_free_function_t old_free_problem;
+  size_t *number_of_owners; /**< @brief Number of clones sharing xopt (NULL if not shared) */
 } transform_vars_z_hat_data_t;
 
 /**
@@ -42,13 +43,47 @@ static void transform_vars_z_hat_evaluate(coco_problem_t *problem, const double
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the gradient of the transformed function.
+ */
+static void transform_vars_z_hat_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+  transform_vars_z_hat_data_t *data;
+
+  data = (transform_vars_z_hat_data_t *) coco_problem_transformed_get_data(problem);
+  data->z[0] = x[0];
+  for (i = 1; i < problem->number_of_variables; ++i) {
+    data->z[i] = x[i] + 0.25 * (x[i - 1] - 2.0 * fabs(data->xopt[i - 1]));
+  }
+  bbob_evaluate_gradient(coco_problem_transformed_get_inner_problem(problem), data->z, y);
+  /* dz_{i+1}/dx_i = 0.25 */
+  for (i = 0; i + 1 < problem->number_of_variables; ++i) {
+    y[i] += 0.25 * y[i + 1];
+  }
+}
+
 /**
  * @brief Frees the data object.
  */
 static void transform_vars_z_hat_free(void *thing) {
   transform_vars_z_hat_data_t *data = (transform_vars_z_hat_data_t *) thing;
-  coco_free_memory(data->xopt);
   coco_free_memory(data->z);
+  if (coco_shared_references_decrease(&data->number_of_owners)) {
+    coco_free_memory(data->xopt);
+  }
+}
+
+/**
+ * @brief Clones the data object, sharing xopt.
+ */
+static void *transform_vars_z_hat_clone(coco_problem_t *problem, void *thing) {
+  transform_vars_z_hat_data_t *data = (transform_vars_z_hat_data_t *) thing;
+  transform_vars_z_hat_data_t *clone_data;
+  coco_shared_references_increase(&data->number_of_owners);
+  clone_data = (transform_vars_z_hat_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  *clone_data = *data;
+  clone_data->z = coco_allocate_vector(problem->number_of_variables);
+  return clone_data;
 }
 
 /**
@@ -60,9 +95,13 @@ static coco_problem_t *transform_vars_z_hat(coco_problem_t *inner_problem, const
   data = (transform_vars_z_hat_data_t *) coco_allocate_memory(sizeof(*data));
   data->xopt = coco_duplicate_vector(xopt, inner_problem->number_of_variables);
   data->z = coco_allocate_vector(inner_problem->number_of_variables);
+  data->number_of_owners = NULL;
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_z_hat_free, "transform_vars_z_hat");
+  coco_problem_transformed_set_data_clone_function(problem, transform_vars_z_hat_clone);
   problem->evaluate_function = transform_vars_z_hat_evaluate;
+  if (inner_problem->evaluate_gradient != NULL)
+    problem->evaluate_gradient = transform_vars_z_hat_evaluate_gradient;
   /* TODO: implement best_parameter transformation if needed in the case of not zero:
      see also issue #814.
   The correct update of best_parameter seems not too difficult and should not anymore
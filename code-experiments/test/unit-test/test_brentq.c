@@ -1,5 +1,6 @@
 #include "minunit.h"
 
+#define COCO_BRENTQ
 #include "coco.c"
 
 /**
@@ -23,12 +24,78 @@ MU_TEST(test_brentinv) {
   mu_assert_double_eq(16.0, y);
 }
 
+/**
+ * Tests that tosz_uv_inv and tasy_uv_inv invert tosz_uv and tasy_uv to machine precision.
+ */
+MU_TEST(test_tosz_tasy_uv_inv) {
+  tosz_data dosz;
+  tasy_data dasy;
+  double y, x;
+  int k;
+
+  dosz.alpha = 0.1;
+  dasy.beta = 0.2;
+  dasy.n = 10;
+  dasy.i = 9;
+  for (k = -1000; k <= 1000; k++) {
+    y = k / 100.0 + 1e-3;
+    x = tosz_uv_inv(y, &dosz);
+    mu_check(fabs(tosz_uv(x, &dosz) - y) <= 1e-14 * fabs(y));
+    mu_check(fabs(x - brentinv((callback_type) &tosz_uv, y, &dosz)) <= 1e-9 * fabs(x));
+    x = tasy_uv_inv(y, &dasy);
+    mu_check(fabs(tasy_uv(x, &dasy) - y) <= 1e-14 * fabs(y));
+    mu_check(fabs(x - brentinv((callback_type) &tasy_uv, y, &dasy)) <= 1e-9 * fabs(x));
+  }
+  mu_assert_double_eq(0.0, tosz_uv_inv(0.0, &dosz));
+  mu_assert_double_eq(0.0, tasy_uv_inv(0.0, &dasy));
+}
+
+/**
+ * Tests that the initial solutions of the bbob-constrained problems, which are obtained by inverting tosz_uv
+ * and tasy_uv, stay within a relative difference of 5.25e-8 of the ones computed with brentinv. The largest
+ * difference (5.21e-8, on the coordinate close to 0 of f23, instance 3, in 3-D) is included.
+ */
+MU_TEST(test_cons_bbob_initial_solution) {
+  /* Function, instance and dimension of the problems */
+  const size_t problems[6][3] = {{23, 3, 3}, {8, 1, 5}, {26, 2, 5}, {33, 4, 5}, {45, 5, 10}, {52, 6, 10}};
+  /* The initial solutions computed with brentinv */
+  const double expected[38] = {
+      -0.0003415274379743316, -1.2693087345239831, -4.1806973270630854,
+      -0.073589549799227175, -0.49452487059863764, 0.020799828785659197, 2.6357251152381456,
+      3.0562533107066669,
+      4.6569050791058153, 1.9367961608485886, -1.6175491096992767, 1.6228182505016473,
+      3.7545152438379668,
+      4.7673414091315767, -4.691432550390056, -0.13232730801622505, -3.020804732805435,
+      1.503542239695389,
+      3.9987539654563728, -1.3431044248379727, -3.1132134264047133, -0.4850288567842318,
+      -2.8825064095669979, -0.27280000000000015, -0.92478040635085423, 0.50838715150407576,
+      1.4777139559699548, -0.25761588981065409,
+      3.356207478311811, 3.8081061582556095, -3.009719183762587, -2.5296022948414225,
+      -0.64761928934903579, -2.4224363160247595, -1.9693944265789056, 4.8916788051138411,
+      -2.6057455142281318, -0.84348769250405664};
+  coco_problem_t *problem;
+  double x[10];
+  size_t k, i, offset = 0;
+
+  for (k = 0; k < 6; k++) {
+    problem = coco_get_suite_problem("bbob-constrained", problems[k][0], problems[k][2], problems[k][1]);
+    coco_problem_get_initial_solution(problem, x);
+    for (i = 0; i < problems[k][2]; i++)
+      mu_check(fabs(x[i] - expected[offset + i]) <= 5.25e-8 * fabs(expected[offset + i]));
+    offset += problems[k][2];
+    coco_problem_free(problem);
+  }
+  mu_check(offset == 38);
+}
+
 /**
  * Run all tests in this file.
  */
 int main(void) {
   MU_RUN_TEST(test_brentq);
   MU_RUN_TEST(test_brentinv);
+  MU_RUN_TEST(test_tosz_tasy_uv_inv);
+  MU_RUN_TEST(test_cons_bbob_initial_solution);
 
   MU_REPORT();
 
@@ -260,10 +260,197 @@ MU_TEST(test_coco_archive_precision_issues) {
   coco_archive_free(archive);
 }
 
+/**
+ * Tests that reading solutions from an archive file gives the same archive as adding them one by one.
+ */
+MU_TEST(test_coco_archive_add_solutions_from_file) {
+
+  char file_name[] = "test_coco_archive_tmp.adat";
+  coco_archive_t *archive, *archive_from_file;
+  coco_random_state_t *random_generator;
+  FILE *f;
+  size_t i, instance;
+  double y[2], u;
+  char *line;
+  const char *text, *text_from_file;
+  long number_of_solutions;
+
+  random_generator = coco_random_new(12345);
+  archive = coco_archive("bbob-biobj", 23, 2, 5);
+
+  /* Write a file with two instances, comments, empty and malformed lines and many duplicates */
+  f = fopen(file_name, "w");
+  fprintf(f, "%% instance = 4\n%%\n");
+  fprintf(f, "1\t%.15e\t%.15e\n", archive->ideal[0], archive->ideal[1]);
+  fprintf(f, "%% instance = 5\n%%\n");
+  for (i = 0; i < 2000; i++) {
+    u = coco_random_uniform(random_generator);
+    y[0] = archive->ideal[0] + (1.1 * u - 0.05) * (archive->nadir[0] - archive->ideal[0]);
+    y[1] = archive->ideal[1] + (1.05 - u + 0.2 * coco_random_uniform(random_generator))
+        * (archive->nadir[1] - archive->ideal[1]);
+    if (i % 3 == 0)
+      fprintf(f, "%lu\t%.15e\t%.15e\t0.5\t0.5\n", (unsigned long) i, y[0], y[1]);
+    else if (i % 3 == 1)
+      fprintf(f, "%lu %.17g %.17g\r\n", (unsigned long) i, y[0], y[1]);
+    else
+      fprintf(f, "%lu\t%.3e\t%.3e\n", (unsigned long) i, y[0], y[1]);
+    if (i % 500 == 0)
+      fprintf(f, "%% a comment\n\n  \nmalformed line\n");
+  }
+  fprintf(f, "%% instance = 6\n");
+  fprintf(f, "1\t%.15e\t%.15e\n", archive->ideal[0], archive->ideal[1]);
+  fclose(f);
+
+  /* Add the same solutions one by one */
+  f = fopen(file_name, "r");
+  instance = 0;
+  line = coco_allocate_memory(1000);
+  while (fgets(line, 1000, f) != NULL) {
+    if (line[0] == '%') {
+      if (strstr(line, "instance") != NULL)
+        instance = (size_t) strtol(strchr(line, '=') + 1, NULL, 10);
+      continue;
+    }
+    if ((instance != 5) || (sscanf(line, "%*s %lf %lf", &y[0], &y[1]) != 2))
+      continue;
+    if (strstr(line, "\r\n") != NULL)
+      strcpy(strstr(line, "\r\n"), "\n");
+    coco_archive_add_solution(archive, y[0], y[1], line);
+  }
+  coco_free_memory(line);
+  fclose(f);
+
+  archive_from_file = coco_archive("bbob-biobj", 23, 2, 5);
+  number_of_solutions = coco_archive_add_solutions_from_file(archive_from_file, file_name, 5, 0);
+  mu_check(number_of_solutions == 2000);
+  mu_check(coco_archive_add_solutions_from_file(archive_from_file, file_name, 7, 0) == -1);
+
+  mu_check(coco_archive_get_number_of_solutions(archive) > 2);
+  mu_check(coco_archive_get_number_of_solutions(archive) ==
+      coco_archive_get_number_of_solutions(archive_from_file));
+  mu_check(coco_archive_get_hypervolume(archive) == coco_archive_get_hypervolume(archive_from_file));
+  do {
+    text = coco_archive_get_next_solution_text(archive);
+    text_from_file = coco_archive_get_next_solution_text(archive_from_file);
+    mu_check(strcmp(text, text_from_file) == 0);
+  } while (strcmp(text, "") != 0);
+
+  /* Long numbers are read as well and a missing file is reported */
+  f = fopen(file_name, "w");
+  fprintf(f, "1\t%.80e\t%.15e\n", archive->ideal[0], archive->nadir[1]);
+  fclose(f);
+  mu_check(coco_archive_add_solutions_from_file(archive_from_file, file_name, 5, 1) == 1);
+  remove(file_name);
+  mu_check(coco_archive_add_solutions_from_file(archive_from_file, file_name, 5, 1) == -2);
+
+  coco_archive_free(archive);
+  coco_archive_free(archive_from_file);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests that adding solutions in bulk gives the same archive as adding them one by one.
+ */
+MU_TEST(test_coco_archive_add_solutions) {
+
+  const size_t number_of_solutions = 3000;
+  coco_archive_t *archive, *archive_bulk;
+  coco_random_state_t *random_generator;
+  size_t i, length = 0;
+  double *y1, *y2, u;
+  size_t *text_offsets;
+  char *text_buffer, *line;
+  const char *text, *text_bulk;
+
+  random_generator = coco_random_new(54321);
+  archive = coco_archive("bbob-biobj", 12, 10, 7);
+  archive_bulk = coco_archive("bbob-biobj", 12, 10, 7);
+
+  y1 = coco_allocate_vector(number_of_solutions);
+  y2 = coco_allocate_vector(number_of_solutions);
+  text_offsets = coco_allocate_vector_size_t(number_of_solutions);
+  text_buffer = coco_allocate_memory(number_of_solutions * 100);
+  for (i = 0; i < number_of_solutions; i++) {
+    u = coco_random_uniform(random_generator);
+    /* Round the values to produce equal and nearly equal solutions */
+    y1[i] = archive->ideal[0] + coco_double_round(1000 * u) / 900 * (archive->nadir[0] - archive->ideal[0]);
+    y2[i] = archive->ideal[1] + (1 - u + 0.1 * coco_random_uniform(random_generator))
+        * (archive->nadir[1] - archive->ideal[1]);
+    if (i % 7 == 0)
+      y2[i] = archive->ideal[1] + coco_double_round(100 * (1 - u)) / 100 * (archive->nadir[1] - archive->ideal[1]);
+    line = coco_strdupf("%lu\t%.15e\t%.15e\n", (unsigned long) i, y1[i], y2[i]);
+    coco_archive_add_solution(archive, y1[i], y2[i], line);
+    text_offsets[i] = length;
+    strcpy(text_buffer + length, line);
+    length += strlen(line);
+    coco_free_memory(line);
+  }
+  mu_check(coco_archive_add_solutions(archive_bulk, number_of_solutions, y1, y2, text_buffer, text_offsets) > 0);
+
+  mu_check(coco_archive_get_number_of_solutions(archive) > 2);
+  mu_check(coco_archive_get_number_of_solutions(archive) == coco_archive_get_number_of_solutions(archive_bulk));
+  mu_check(coco_archive_get_hypervolume(archive) == coco_archive_get_hypervolume(archive_bulk));
+  do {
+    text = coco_archive_get_next_solution_text(archive);
+    text_bulk = coco_archive_get_next_solution_text(archive_bulk);
+    mu_check(strcmp(text, text_bulk) == 0);
+  } while (strcmp(text, "") != 0);
+
+  coco_archive_free(archive);
+  coco_archive_free(archive_bulk);
+  coco_free_memory(y1);
+  coco_free_memory(y2);
+  coco_free_memory(text_offsets);
+  coco_free_memory(text_buffer);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests that the ideal and nadir points computed for the archive match those of the suite problems.
+ */
+MU_TEST(test_coco_archive_get_ideal_and_nadir) {
+
+  const char *suite_names[] = { "bbob-biobj", "bbob-biobj-ext" };
+  const size_t functions[] = { 1, 17, 55, 56, 70, 92 };
+  const size_t dimensions[] = { 2, 10, 40 };
+  const size_t instances[] = { 1, 8, 15 };
+  double ideal[2], nadir[2];
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  size_t s, f, d, i, count = 0;
+
+  for (s = 0; s < 2; s++) {
+    suite = coco_suite(suite_names[s], "instances: 1,8,15", "dimensions: 2,10,40");
+    while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+      for (f = 0; f < 6; f++) {
+        for (d = 0; d < 3; d++) {
+          for (i = 0; i < 3; i++) {
+            if ((coco_problem_get_suite_dep_function(problem) != functions[f])
+                || (coco_problem_get_dimension(problem) != dimensions[d])
+                || (coco_problem_get_suite_dep_instance(problem) != instances[i]))
+              continue;
+            coco_archive_get_ideal_and_nadir(suite_names[s], functions[f], dimensions[d], instances[i], ideal, nadir);
+            mu_check(ideal[0] == problem->best_value[0]);
+            mu_check(ideal[1] == problem->best_value[1]);
+            mu_check(nadir[0] == problem->nadir_value[0]);
+            mu_check(nadir[1] == problem->nadir_value[1]);
+            count++;
+          }
+        }
+      }
+    }
+    coco_suite_free(suite);
+  }
+  mu_check(count == 3 * 3 * 3 + 6 * 3 * 3);
+}
+
 int main(void) {
   MU_RUN_TEST(test_coco_archive);
   MU_RUN_TEST(test_coco_archive_extreme_solutions);
   MU_RUN_TEST(test_coco_archive_precision_issues);
+  MU_RUN_TEST(test_coco_archive_add_solutions_from_file);
+  MU_RUN_TEST(test_coco_archive_add_solutions);
+  MU_RUN_TEST(test_coco_archive_get_ideal_and_nadir);
 	
 	MU_REPORT();
 
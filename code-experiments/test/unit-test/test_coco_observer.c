@@ -3,6 +3,10 @@
 #include "coco.c"
 #include "about_equal.h"
 
+#if defined(HAVE_STAT)
+#include <sys/wait.h>
+#endif
+
 /**
  * Tests the function coco_observer_targets_trigger.
  */
@@ -223,13 +227,428 @@ MU_TEST(test_coco_observer_evaluations_trigger) {
   coco_observer_evaluations_free(evaluations);
 }
 
+/**
+ * Tests that the evaluation cache returns the same values, keeps the evaluation counts, reports the exact
+ * numbers of lookups and hits and evicts the least recently used solution.
+ */
+MU_TEST(test_coco_observer_evaluation_cache) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  double x[2], y1[1], y2[1], c1[10], c2[10];
+  size_t number_of_constraints;
+
+  suite = coco_suite("bbob-constrained", NULL, "dimensions: 2 function_indices: 2 instance_indices: 1");
+  observer = coco_observer("bbob", "result_folder: test_evaluation_cache evaluation_cache_size: 4");
+  problem = coco_suite_get_next_problem(suite, observer);
+  number_of_constraints = coco_problem_get_number_of_constraints(problem);
+  mu_check(number_of_constraints <= 10);
+
+  /* The logger looks up the constraints of each solution too (to check and log its feasibility): the
+   * first evaluation of x makes 5 lookups, of which only the first two (constraints, then objective) miss */
+  x[0] = 0.5;
+  x[1] = -1.5;
+  coco_evaluate_function(problem, x, y1);
+  mu_check(coco_observer_get_evaluation_cache_lookups(observer) == 5);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 3);
+  coco_evaluate_constraint(problem, x, c1);
+  coco_evaluate_function(problem, x, y2);
+  coco_evaluate_constraint(problem, x, c2);
+  mu_check(y1[0] == y2[0]);
+  mu_check(about_equal_vector(c1, c2, number_of_constraints));
+  mu_check(coco_problem_get_evaluations(problem) == 2);
+  mu_check(coco_problem_get_evaluations_constraints(problem) == 2);
+  mu_check(coco_observer_get_evaluation_cache_lookups(observer) == 5 + 1 + 3 + 1);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 3 + 1 + 3 + 1);
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  /* Without constraints, each evaluation is a single lookup */
+  suite = coco_suite("bbob", NULL, "dimensions: 2 function_indices: 1 instance_indices: 1");
+  observer = coco_observer("bbob", "result_folder: test_evaluation_cache evaluation_cache_size: 4");
+  problem = coco_suite_get_next_problem(suite, observer);
+  x[1] = -1.5;
+
+  /* Fill the cache with x0, ..., x3, where xi = (0.5 + i, -1.5) */
+  for (x[0] = 0.5; x[0] < 4; x[0] += 1)
+    coco_evaluate_function(problem, x, y2);
+  mu_check(coco_observer_get_evaluation_cache_lookups(observer) == 4);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 0);
+
+  /* Using x0 again makes x1 the least recently used solution, so that x4 evicts x1 and not x0 */
+  x[0] = 0.5;
+  coco_evaluate_function(problem, x, y1);
+  x[0] = 4.5;
+  coco_evaluate_function(problem, x, y2);
+  mu_check(coco_observer_get_evaluation_cache_lookups(observer) == 6);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 1);
+  x[0] = 0.5;
+  coco_evaluate_function(problem, x, y2);
+  mu_check(y1[0] == y2[0]);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 2);
+  x[0] = 1.5;
+  coco_evaluate_function(problem, x, y2);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 2);
+
+  /* The order is now x3, x4, x0, x1: x2 was evicted by x1, x3 was not */
+  x[0] = 3.5;
+  coco_evaluate_function(problem, x, y2);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 3);
+  x[0] = 2.5;
+  coco_evaluate_function(problem, x, y2);
+  mu_check(coco_observer_get_evaluation_cache_hits(observer) == 3);
+  mu_check(coco_observer_get_evaluation_cache_lookups(observer) == 10);
+  mu_check(coco_problem_get_evaluations(problem) == 10);
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  observer = coco_observer("bbob", "result_folder: test_evaluation_cache");
+  mu_check(coco_observer_get_evaluation_cache_lookups(observer) == 0);
+  coco_observer_free(observer);
+}
+
+/**
+ * Tests that the profile writes the stages of the problem (including the logger) when it is removed and
+ * that, when compiled with COCO_PROFILE, it leaves out the evaluations done before profiling.
+ */
+MU_TEST(test_coco_observer_profile) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem, *profiled_problem;
+  double x[2] = {0.5, -1.5}, y[1];
+  char file_name[COCO_PATH_MAX + 1], line[4096];
+  char *result_folder, *position;
+  FILE *file;
+  size_t i;
+#if defined(COCO_PROFILE)
+  double ticks = 0;
+#endif
+
+  coco_remove_directory("exdata/test_profile");
+  suite = coco_suite("bbob", NULL, "dimensions: 2 function_indices: 1 instance_indices: 1");
+  observer = coco_observer("bbob", "result_folder: test_profile");
+  result_folder = coco_strdup(observer->result_folder);
+  file_name[0] = '\0';
+  coco_join_path(file_name, sizeof(file_name), result_folder, "profile.jsonl", NULL);
+
+  problem = coco_suite_get_next_problem(suite, NULL);
+  coco_evaluate_function(problem, x, y);
+  problem = profiled_problem = transform_obj_profile(problem, file_name);
+  problem = coco_problem_add_observer(problem, observer);
+  transform_obj_profile_set_outer_problem(profiled_problem, problem);
+  for (i = 0; i < 3; i++)
+    coco_evaluate_function(problem, x, y);
+  problem = coco_problem_remove_observer(problem, observer);
+  mu_check(problem != profiled_problem);
+  mu_check(problem->problem_free_function == coco_problem_transformed_free);
+
+  file = fopen(file_name, "r");
+  mu_check(file != NULL);
+  mu_check(fgets(line, sizeof(line), file) != NULL);
+  fclose(file);
+  mu_check(strstr(line, "\"problem_id\": \"bbob_f001_i01_d02\"") != NULL);
+  mu_check(strstr(line, "transform_obj_profile") == NULL);
+#if defined(COCO_PROFILE)
+  mu_check(strstr(line, "{\"name\": \"bbob\", \"depth\": 0, \"evaluations\": 3,") != NULL);
+  mu_check(strstr(line, "{\"name\": \"transform_vars_shift\", \"depth\": 2, \"evaluations\": 3,") != NULL);
+  position = strstr(line, "\"ticks\": ");
+  mu_check((position != NULL) && (sscanf(position, "\"ticks\": %lf", &ticks) == 1) && (ticks > 0));
+#else
+  mu_check(strstr(line, "{\"name\": \"bbob\", \"depth\": 0, \"evaluations\": 4, \"ticks\": 0,") != NULL);
+  mu_check(strstr(line, "{\"name\": \"transform_vars_shift\", \"depth\": 2, \"evaluations\": 4,") != NULL);
+  position = strstr(line, "\"tick_unit\": \"none\"");
+  mu_check(position != NULL);
+#endif
+
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_remove_directory(result_folder);
+  coco_free_memory(result_folder);
+}
+
+/**
+ * Evaluates the next number_of_problems problems of the suite at a few deterministic solutions.
+ */
+static void test_coco_observer_checkpoint_run(coco_suite_t *suite, coco_observer_t *observer,
+                                              const size_t number_of_problems) {
+  coco_problem_t *problem;
+  double x[3], y[1];
+  size_t i, j, k;
+
+  for (i = 0; i < number_of_problems; i++) {
+    problem = coco_suite_get_next_problem(suite, observer);
+    if (problem == NULL)
+      return;
+    for (j = 0; j < 30; j++) {
+      for (k = 0; k < coco_problem_get_dimension(problem); k++)
+        x[k] = 4 * sin((double) (j * (k + 1) + coco_problem_get_suite_dep_index(problem)));
+      coco_evaluate_function(problem, x, y);
+    }
+  }
+}
+
+/**
+ * Returns 1 if the files in the two folders with the given relative path have the same contents.
+ */
+static int test_coco_observer_checkpoint_same_file(const char *folder1, const char *folder2, const char *path) {
+  char path1[COCO_PATH_MAX + 1] = { 0 }, path2[COCO_PATH_MAX + 1] = { 0 };
+  FILE *file1, *file2;
+  int c1, c2;
+
+  coco_join_path(path1, sizeof(path1), folder1, path, NULL);
+  coco_join_path(path2, sizeof(path2), folder2, path, NULL);
+  file1 = fopen(path1, "rb");
+  file2 = fopen(path2, "rb");
+  if ((file1 == NULL) || (file2 == NULL)) {
+    if (file1 != NULL)
+      fclose(file1);
+    if (file2 != NULL)
+      fclose(file2);
+    return 0;
+  }
+  do {
+    c1 = fgetc(file1);
+    c2 = fgetc(file2);
+  } while ((c1 == c2) && (c1 != EOF));
+  fclose(file1);
+  fclose(file2);
+  return c1 == c2;
+}
+
+/**
+ * Tests that an experiment that is interrupted while a problem is being written and then resumed produces
+ * the same output as an uninterrupted experiment.
+ */
+MU_TEST(test_coco_observer_checkpoint) {
+
+  const char *suite_options = "dimensions: 2,3 function_indices: 1,2 instance_indices: 1,2";
+  const char *files[] = { "bbobexp_f1.info", "bbobexp_f2.info",
+      "data_f1/bbobexp_f1_DIM2.dat", "data_f1/bbobexp_f1_DIM2.tdat", "data_f1/bbobexp_f1_DIM3.dat",
+      "data_f1/bbobexp_f1_DIM3.tdat", "data_f1/bbobexp_f1_DIM3.rdat", "data_f1/bbobexp_f1_DIM3.mdat",
+      "data_f2/bbobexp_f2_DIM3.dat", "data_f2/bbobexp_f2_DIM3.tdat" };
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  char *reference_folder, *result_folder, path[COCO_PATH_MAX + 1] = { 0 }, line[4096];
+  long size, done_size = -1;
+  FILE *file;
+  size_t i;
+
+  /* The resumed experiment must not find the output of an earlier test (nor the reference get a suffix) */
+  coco_remove_directory("exdata/test_checkpoint");
+  coco_remove_directory("exdata/test_checkpoint_reference");
+
+  /* The uninterrupted experiment */
+  suite = coco_suite("bbob", NULL, suite_options);
+  observer = coco_observer("bbob", "result_folder: test_checkpoint_reference");
+  reference_folder = coco_strdup(observer->result_folder);
+  test_coco_observer_checkpoint_run(suite, observer, 8);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  /* The experiment is interrupted while the sixth problem is written, which is simulated by removing its
+   * "done" record from the checkpoint and appending some output to its files */
+  suite = coco_suite("bbob", NULL, suite_options);
+  observer = coco_observer("bbob", "result_folder: test_checkpoint checkpoint: 1");
+  result_folder = coco_strdup(observer->result_folder);
+  test_coco_observer_checkpoint_run(suite, observer, 6);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  coco_join_path(path, sizeof(path), result_folder, "checkpoint.txt", NULL);
+  file = fopen(path, "rb");
+  mu_check(file != NULL);
+  size = 0;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (strncmp(line, "done ", 5) == 0)
+      done_size = size;
+    size += (long) strlen(line);
+  }
+  fclose(file);
+  mu_check(strncmp(line, "done 1 3 2 ", 11) == 0);
+  coco_observer_checkpoint_truncate_file(path, done_size);
+  for (i = 0; i < 2; i++) {
+    path[0] = '\0';
+    coco_join_path(path, sizeof(path), result_folder, i == 0 ? files[0] : files[4], NULL);
+    file = fopen(path, "a");
+    mu_check(file != NULL);
+    fprintf(file, "\n30\t1.0e+00 interrupted");
+    fclose(file);
+  }
+
+  /* The resumed experiment continues with the sixth problem */
+  suite = coco_suite("bbob", NULL, suite_options);
+  observer = coco_observer("bbob", "result_folder: test_checkpoint resume: 1");
+  mu_check(strcmp(observer->result_folder, result_folder) == 0);
+  problem = coco_suite_get_next_problem(suite, observer);
+  mu_check(coco_problem_get_suite_dep_function(problem) == 1);
+  mu_check(coco_problem_get_dimension(problem) == 3);
+  mu_check(coco_problem_get_suite_dep_instance(problem) == 2);
+  coco_suite_free(suite);
+  coco_observer_free(observer);
+
+  suite = coco_suite("bbob", NULL, suite_options);
+  observer = coco_observer("bbob", "result_folder: test_checkpoint resume: 1");
+  test_coco_observer_checkpoint_run(suite, observer, 8);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  for (i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+    mu_check(test_coco_observer_checkpoint_same_file(reference_folder, result_folder, files[i]));
+
+  coco_free_memory(reference_folder);
+  coco_free_memory(result_folder);
+}
+
+/**
+ * Tests that the merged output of two workers that share a work queue is the same as the output of one
+ * uninterrupted experiment.
+ */
+MU_TEST(test_coco_observer_work_queue) {
+
+  const char *suite_options = "dimensions: 2,3 function_indices: 1,2 instance_indices: 1,2";
+  const char *files[] = { "bbobexp_f1.info", "bbobexp_f2.info",
+      "data_f1/bbobexp_f1_DIM2.dat", "data_f1/bbobexp_f1_DIM2.tdat", "data_f1/bbobexp_f1_DIM3.dat",
+      "data_f1/bbobexp_f1_DIM3.tdat", "data_f1/bbobexp_f1_DIM3.rdat", "data_f1/bbobexp_f1_DIM3.mdat",
+      "data_f2/bbobexp_f2_DIM3.dat", "data_f2/bbobexp_f2_DIM3.tdat" };
+  coco_suite_t *suite1, *suite2;
+  coco_observer_t *observer1, *observer2;
+  char *reference_folder;
+  size_t i;
+
+  /* The workers must not find the output of an earlier test (nor the reference get a suffix) */
+  coco_remove_directory("exdata/test_work_queue");
+  coco_remove_directory("exdata/test_work_queue_merged");
+  coco_remove_directory("exdata/test_work_queue_reference");
+
+  /* The uninterrupted experiment */
+  suite1 = coco_suite("bbob", NULL, suite_options);
+  observer1 = coco_observer("bbob", "result_folder: test_work_queue_reference");
+  reference_folder = coco_strdup(observer1->result_folder);
+  test_coco_observer_checkpoint_run(suite1, observer1, 8);
+  coco_observer_free(observer1);
+  coco_suite_free(suite1);
+
+  /* The workers take turns in claiming the next problem */
+  suite1 = coco_suite("bbob", NULL, suite_options);
+  observer1 = coco_observer("bbob", "result_folder: test_work_queue work_queue: 1");
+  suite2 = coco_suite("bbob", NULL, suite_options);
+  observer2 = coco_observer("bbob", "result_folder: test_work_queue work_queue: 1");
+  mu_check(strcmp(observer1->result_folder, "exdata/test_work_queue/worker-0001") == 0);
+  mu_check(strcmp(observer2->result_folder, "exdata/test_work_queue/worker-0002") == 0);
+  for (i = 0; i < 5; i++) {
+    test_coco_observer_checkpoint_run(suite1, observer1, 1);
+    test_coco_observer_checkpoint_run(suite2, observer2, 1);
+  }
+  coco_observer_free(observer1);
+  coco_suite_free(suite1);
+  coco_observer_free(observer2);
+  coco_suite_free(suite2);
+
+  mu_check(coco_observer_merge_workers("exdata/test_work_queue", "exdata/test_work_queue_merged") == 8);
+  for (i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+    mu_check(test_coco_observer_checkpoint_same_file(reference_folder, "exdata/test_work_queue_merged", files[i]));
+
+  coco_free_memory(reference_folder);
+}
+
+/**
+ * Tests that two worker processes that share a work queue at the same time claim each problem exactly once
+ * and that their merged output is the same as the output of one uninterrupted experiment (only where fork
+ * is available).
+ */
+MU_TEST(test_coco_observer_work_queue_processes) {
+#if defined(HAVE_STAT)
+  const char *suite_options = "dimensions: 2,3 function_indices: 1,2 instance_indices: 1,2";
+  const char *files[] = { "bbobexp_f1.info", "bbobexp_f2.info",
+      "data_f1/bbobexp_f1_DIM2.dat", "data_f1/bbobexp_f1_DIM3.tdat", "data_f2/bbobexp_f2_DIM2.dat",
+      "data_f2/bbobexp_f2_DIM3.dat", "data_f2/bbobexp_f2_DIM3.tdat" };
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  char *reference_folder, path[COCO_PATH_MAX + 1];
+  pid_t workers[2];
+  int status, number_of_owners;
+  size_t i, number_of_problems = 0;
+
+  /* The workers must not find the output of an earlier test (nor the reference get a suffix) */
+  coco_remove_directory("exdata/test_work_queue_processes");
+  coco_remove_directory("exdata/test_work_queue_processes_merged");
+  coco_remove_directory("exdata/test_work_queue_processes_reference");
+
+  /* The uninterrupted experiment */
+  suite = coco_suite("bbob", NULL, suite_options);
+  observer = coco_observer("bbob", "result_folder: test_work_queue_processes_reference");
+  reference_folder = coco_strdup(observer->result_folder);
+  test_coco_observer_checkpoint_run(suite, observer, 8);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+
+  /* The workers run at the same time until no problem is left */
+  fflush(stdout);
+  fflush(stderr);
+  for (i = 0; i < 2; i++) {
+    workers[i] = fork();
+    mu_check(workers[i] >= 0);
+    if (workers[i] == 0) {
+      suite = coco_suite("bbob", NULL, suite_options);
+      observer = coco_observer("bbob", "result_folder: test_work_queue_processes work_queue: 1");
+      test_coco_observer_checkpoint_run(suite, observer, 8);
+      coco_observer_free(observer);
+      coco_suite_free(suite);
+      _exit(0);
+    }
+  }
+  for (i = 0; i < 2; i++) {
+    mu_check(waitpid(workers[i], &status, 0) == workers[i]);
+    mu_check(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+  }
+
+  /* Each problem was claimed by exactly one of the workers */
+  suite = coco_suite("bbob", NULL, suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    number_of_owners = 0;
+    for (i = 1; i <= 2; i++) {
+      sprintf(path, "exdata/test_work_queue_processes/queue/f%lu_d%lu_i%lu/worker-%04lu",
+          (unsigned long) coco_problem_get_suite_dep_function(problem),
+          (unsigned long) coco_problem_get_dimension(problem),
+          (unsigned long) coco_problem_get_suite_dep_instance(problem), (unsigned long) i);
+      number_of_owners += coco_file_exists(path);
+    }
+    mu_check(number_of_owners == 1);
+    number_of_problems++;
+  }
+  coco_suite_free(suite);
+  mu_check(number_of_problems == 8);
+
+  mu_check(coco_observer_merge_workers("exdata/test_work_queue_processes",
+      "exdata/test_work_queue_processes_merged") == 8);
+  for (i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+    mu_check(test_coco_observer_checkpoint_same_file(reference_folder, "exdata/test_work_queue_processes_merged",
+        files[i]));
+
+  coco_free_memory(reference_folder);
+#endif
+}
+
 int main(void) {
   MU_RUN_TEST(test_coco_observer_targets_trigger);
   MU_RUN_TEST(test_coco_observer_log_targets_trigger);
   MU_RUN_TEST(test_coco_observer_lin_targets_trigger);
   MU_RUN_TEST(test_coco_observer_evaluations_trigger);
+  MU_RUN_TEST(test_coco_observer_evaluation_cache);
+  MU_RUN_TEST(test_coco_observer_profile);
+  MU_RUN_TEST(test_coco_observer_checkpoint);
+  MU_RUN_TEST(test_coco_observer_work_queue);
+  MU_RUN_TEST(test_coco_observer_work_queue_processes);
 	
 	MU_REPORT();
 
+  coco_remove_directory("exdata");
+
   return minunit_status;
 }
@@ -1,6 +1,7 @@
 #include "minunit.h"
 
 #include "coco.c"
+#include "about_equal.h"
 
 /**
  * Tests whether the coco_evaluate_function returns a vector of NANs when given a vector with one or more
@@ -143,11 +144,584 @@ MU_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext) {
   coco_suite_free(suite);
 }
 
+/**
+ * Tests whether coco_evaluate_function_mixint and coco_evaluate_function_mixint64 give the same results
+ * and count the evaluations in the same way as coco_evaluate_function.
+ */
+MU_TEST(test_coco_evaluate_function_mixint) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem, *clone;
+  double *x, *y, *y_mixint;
+  int32_t *x_int32;
+  int64_t *x_int64;
+  size_t i, dimension, number_of_integer_variables, number_of_objectives;
+  const size_t max_dimension = 10;
+
+  x = coco_allocate_vector(max_dimension);
+  y = coco_allocate_vector(2);
+  y_mixint = coco_allocate_vector(2);
+  x_int32 = (int32_t *) coco_allocate_memory(max_dimension * sizeof(int32_t));
+  x_int64 = (int64_t *) coco_allocate_memory(max_dimension * sizeof(int64_t));
+
+  suite = coco_suite("bbob-mixint", NULL, "dimensions: 5,10 instance_indices: 1");
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    dimension = coco_problem_get_dimension(problem);
+    number_of_integer_variables = coco_problem_get_number_of_integer_variables(problem);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    mu_check(number_of_integer_variables > 0);
+    for (i = 0; i < dimension; i++) {
+      x[i] = (i < number_of_integer_variables) ? (double) (i % 3) : 0.1 * (double) i;
+      x_int32[i] = (int32_t) (i % 3);
+      x_int64[i] = (int64_t) (i % 3);
+    }
+    /* Integers outside the bounds are mapped to the closest bound */
+    x[0] = x_int32[0] = x_int64[0] = -5;
+    x[1] = x_int32[1] = 1000;
+    x_int64[1] = (int64_t) 1 << 40;
+    coco_evaluate_function(problem, x, y);
+    coco_evaluate_function_mixint(problem, x_int32, &x[number_of_integer_variables], y_mixint);
+    mu_check(about_equal_vector(y, y_mixint, number_of_objectives));
+    coco_evaluate_function_mixint64(problem, x_int64, &x[number_of_integer_variables], y_mixint);
+    mu_check(about_equal_vector(y, y_mixint, number_of_objectives));
+    mu_check(coco_problem_get_evaluations(problem) == 3);
+  }
+  coco_suite_free(suite);
+
+  suite = coco_suite("bbob-biobj-mixint", NULL, "dimensions: 5 function_indices: 1,50 instance_indices: 1");
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    dimension = coco_problem_get_dimension(problem);
+    number_of_integer_variables = coco_problem_get_number_of_integer_variables(problem);
+    for (i = 0; i < dimension; i++) {
+      x[i] = (i < number_of_integer_variables) ? 1.0 : -0.5;
+      x_int32[i] = 1;
+    }
+    coco_evaluate_function(problem, x, y);
+    coco_evaluate_function_mixint(problem, x_int32, &x[number_of_integer_variables], y_mixint);
+    mu_check(about_equal_vector(y, y_mixint, 2));
+    /* A clone reaches its own discretizations */
+    clone = coco_problem_clone(problem);
+    coco_evaluate_function_mixint(clone, x_int32, &x[number_of_integer_variables], y_mixint);
+    mu_check(about_equal_vector(y, y_mixint, 2));
+    coco_problem_free(clone);
+  }
+  coco_suite_free(suite);
+
+  coco_free_memory(x);
+  coco_free_memory(y);
+  coco_free_memory(y_mixint);
+  coco_free_memory(x_int32);
+  coco_free_memory(x_int64);
+}
+
+/**
+ * Checks that coco_evaluate_delta agrees with coco_evaluate_function on all problems of the given suite.
+ */
+static void test_coco_evaluate_delta_on_suite(const char *suite_name, const char *suite_options) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_evaluation_handle_t *handle;
+  coco_random_state_t *random_generator;
+  double *x, y_delta, y_full, best_value;
+  size_t i, j, dimension, indices[2];
+  double values[2];
+  const size_t number_of_steps = 50;
+
+  random_generator = coco_random_new(12345);
+  suite = coco_suite(suite_name, NULL, suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    dimension = coco_problem_get_dimension(problem);
+    best_value = coco_problem_get_best_value(problem);
+    x = coco_allocate_vector(dimension);
+    for (i = 0; i < dimension; i++)
+      x[i] = 12.0 * coco_random_uniform(random_generator) - 6.0; /* Partly outside of the ROI */
+
+    handle = coco_evaluation_handle_allocate(problem, x, &y_delta);
+    coco_evaluate_function(problem, x, &y_full);
+    mu_check(y_delta == y_full);
+
+    for (j = 0; j < number_of_steps; j++) {
+      indices[0] = (size_t) ((double) dimension * coco_random_uniform(random_generator));
+      indices[1] = (indices[0] + j + 1) % dimension;
+      values[0] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+      values[1] = 10.0 * coco_random_uniform(random_generator) - 5.0;
+      coco_evaluate_delta(problem, handle, 1 + j % 2, indices, values, &y_delta);
+      coco_evaluate_function(problem, coco_evaluation_handle_get_x(handle), &y_full);
+      mu_check(fabs(y_delta - y_full) <= 1e-11 * (1 + fabs(y_full - best_value)));
+    }
+
+    /* Move to the optimum coordinate by coordinate */
+    for (i = 0; i < dimension; i++)
+      coco_evaluate_delta(problem, handle, 1, &i, &problem->best_parameter[i], &y_delta);
+    mu_check(fabs(y_delta - best_value) < 1e-12);
+
+    mu_check(coco_problem_get_evaluations(problem) == 2 + 2 * number_of_steps + dimension);
+    coco_evaluation_handle_free(handle);
+    coco_free_memory(x);
+  }
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests the incremental evaluation of separable problems and its fallback on other problems.
+ */
+MU_TEST(test_coco_evaluate_delta) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_observer_t *observer;
+  coco_evaluation_handle_t *handle;
+  double x[2] = {1.0, -2.0}, other_x[2] = {-1.0, 0.5}, y_delta[2], y_full[2];
+  size_t index = 1;
+  double value = 3.0;
+  char *result_folder;
+
+  test_coco_evaluate_delta_on_suite("bbob", "function_indices: 1-6 dimensions: 2,10,40 instance_indices: 1,2");
+  test_coco_evaluate_delta_on_suite("bbob-largescale", "function_indices: 1-5,10 dimensions: 80 instance_indices: 1");
+  test_coco_evaluate_delta_on_suite("bbob-mixint", "function_indices: 1-5 dimensions: 10 instance_indices: 1");
+
+  /* Separable problems with an observer */
+  suite = coco_suite("bbob", NULL, "function_indices: 2,3 dimensions: 2 instance_indices: 1");
+  observer = coco_observer("bbob", "result_folder: delta_test evaluation_cache_size: 10");
+  result_folder = coco_strdup(observer->result_folder);
+  while ((problem = coco_suite_get_next_problem(suite, observer)) != NULL) {
+    handle = coco_evaluation_handle_allocate(problem, x, y_delta);
+    coco_evaluate_delta(problem, handle, 1, &index, &value, y_delta);
+    coco_evaluate_function(problem, coco_evaluation_handle_get_x(handle), y_full);
+    mu_check(about_equal_value(y_delta[0], y_full[0]));
+    mu_check(coco_problem_get_evaluations(problem) == 3);
+    /* When the cache answers, the problem still evaluates the next point in full */
+    coco_evaluate_delta(problem, handle, 1, &index, &value, y_delta);
+    coco_evaluate_function(problem, other_x, y_full);
+    mu_check(!about_equal_value(y_delta[0], y_full[0]));
+    coco_evaluation_handle_free(handle);
+  }
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_remove_directory(result_folder);
+  coco_free_memory(result_folder);
+
+  /* Multiobjective problems are evaluated in full */
+  suite = coco_suite("bbob-biobj", NULL, "function_indices: 1 dimensions: 2 instance_indices: 1");
+  problem = coco_suite_get_next_problem(suite, NULL);
+  handle = coco_evaluation_handle_allocate(problem, x, y_delta);
+  coco_evaluate_delta(problem, handle, 1, &index, &value, y_delta);
+  coco_evaluate_function(problem, coco_evaluation_handle_get_x(handle), y_full);
+  mu_check(about_equal_vector(y_delta, y_full, 2));
+  coco_evaluation_handle_free(handle);
+  coco_suite_free(suite);
+}
+
+/**
+ * Tests that the composed affine transformation of the Lunacek bi-Rastrigin function agrees with applying
+ * rot2, the conditioning and rot1 one after another.
+ */
+MU_TEST(test_coco_evaluate_function_lunacek_composed) {
+
+  coco_problem_t *problem;
+  f_lunacek_bi_rastrigin_data_t *data;
+  const size_t dimensions[4] = {2, 5, 20, 40};
+  double **rot1, **rot2, *x, *tmpvect, z, y;
+  size_t d, n, i, j, point;
+  coco_random_state_t *random_generator = coco_random_new(0xC0C0);
+
+  for (d = 0; d < 4; d++) {
+    n = dimensions[d];
+    problem = coco_get_suite_problem("bbob", 24, n, 3);
+    data = (f_lunacek_bi_rastrigin_data_t *) coco_problem_transformed_get_inner_problem(problem)->data;
+    rot1 = bbob2009_allocate_matrix(n, n);
+    rot2 = bbob2009_allocate_matrix(n, n);
+    bbob2009_compute_rotation(rot1, data->rseed + 1000000, n);
+    bbob2009_compute_rotation(rot2, data->rseed, n);
+    x = coco_allocate_vector(n);
+    tmpvect = coco_allocate_vector(n);
+
+    for (point = 0; point < 10; point++) {
+      for (i = 0; i < n; i++)
+        x[i] = 10 * coco_random_uniform(random_generator) - 5;
+      coco_evaluate_function(problem, x, &y);
+      /* data->x_hat and data->z now hold the values of this evaluation */
+      for (i = 0; i < n; i++) {
+        tmpvect[i] = 0.0;
+        for (j = 0; j < n; j++)
+          tmpvect[i] += pow(10., (double) i / (double) (n - 1)) * rot2[i][j] * (data->x_hat[j] - 2.5);
+      }
+      for (i = 0; i < n; i++) {
+        z = 0.0;
+        for (j = 0; j < n; j++)
+          z += rot1[i][j] * tmpvect[j];
+        mu_check(fabs(data->z[i] - z) <= 1e-12 * (1 + fabs(z)));
+      }
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(tmpvect);
+    bbob2009_free_matrix(rot1, n);
+    bbob2009_free_matrix(rot2, n);
+    coco_problem_free(problem);
+  }
+  coco_random_free(random_generator);
+}
+
+/**
+ * Computes the Gallagher function by evaluating all peaks completely.
+ */
+static double test_f_gallagher_reference(const double *x, const size_t n, f_gallagher_data_t *data) {
+  size_t i, j;
+  double tmp, tmp2, f = 0., f_pen = 0., f_true;
+  double *tmx = coco_allocate_vector(n);
+
+  for (i = 0; i < n; ++i) {
+    tmp = fabs(x[i]) - 5.;
+    if (tmp > 0.)
+      f_pen += tmp * tmp;
+    tmx[i] = 0;
+    for (j = 0; j < n; ++j)
+      tmx[i] += data->rotation[i][j] * x[j];
+  }
+  for (i = 0; i < data->number_of_peaks; ++i) {
+    tmp2 = 0.;
+    for (j = 0; j < n; ++j) {
+      tmp = (tmx[j] - data->x_local[i * n + j]);
+      tmp2 += data->arr_scales[i * n + j] * tmp * tmp;
+    }
+    f = coco_double_max(f, data->peak_values[i] * exp(-0.5 / (double) n * tmp2));
+  }
+  coco_free_memory(tmx);
+
+  f = 10. - f;
+  if (f > 0) {
+    f_true = log(f) / 0.1;
+    f_true = pow(exp(f_true + 0.49 * (sin(f_true) + sin(0.79 * f_true))), 0.1);
+  } else if (f < 0) {
+    f_true = log(-f) / 0.1;
+    f_true = -pow(exp(f_true + 0.49 * (sin(0.55 * f_true) + sin(0.31 * f_true))), 0.1);
+  } else
+    f_true = f;
+  return f_true * f_true + f_pen * data->penalty_scale;
+}
+
+/**
+ * Tests that the early termination in the Gallagher functions does not change their values.
+ */
+MU_TEST(test_coco_evaluate_function_gallagher_early_termination) {
+
+  coco_problem_t *problem;
+  f_gallagher_data_t *data;
+  const size_t dimensions[3] = {2, 5, 20};
+  double x[20];
+  size_t function, d, n, i, point;
+  coco_random_state_t *random_generator = coco_random_new(0xC0C0);
+
+  for (function = 21; function <= 22; function++) {
+    for (d = 0; d < 3; d++) {
+      n = dimensions[d];
+      problem = coco_get_suite_problem("bbob", function, n, 2);
+      data = (f_gallagher_data_t *) coco_problem_transformed_get_inner_problem(problem)->data;
+      for (point = 0; point < 200; point++) {
+        /* Points spread over the domain and points close to the peaks */
+        for (i = 0; i < n; i++) {
+          if (point % 2 == 0)
+            x[i] = 12 * coco_random_uniform(random_generator) - 6;
+          else
+            x[i] = data->xopt[i] + 0.1 * (double) (point % 10) * coco_random_normal(random_generator);
+        }
+        mu_check(f_gallagher_raw(x, n, data) == test_f_gallagher_reference(x, n, data));
+      }
+      coco_problem_free(problem);
+    }
+  }
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests that evaluating a batch of points gives the same results as evaluating them one by one.
+ */
+MU_TEST(test_coco_evaluate_function_batch) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  const size_t number_of_points = 5;
+  double x[5 * 3] = {0, 0, 0, 1, 2, 3, -4, 5, 1, 0.5, 0.25, -1, 4.5, 4.5, 4.5};
+  double y_batch[5 * 2], y[2];
+  size_t i, j, number_of_objectives;
+
+  suite = coco_suite("bbob-biobj", "instances: 1", "function_indices: 1,10 dimensions: 3");
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    coco_evaluate_function_batch(problem, x, number_of_points, y_batch);
+    mu_check(coco_problem_get_evaluations(problem) == number_of_points);
+    for (i = 0; i < number_of_points; i++) {
+      coco_evaluate_function(problem, x + 3 * i, y);
+      for (j = 0; j < number_of_objectives; j++)
+        mu_check(y[j] == y_batch[i * number_of_objectives + j]);
+    }
+  }
+  coco_suite_free(suite);
+}
+
+/**
+ * Returns the largest difference between the gradient and central finite differences of the problem in x,
+ * relative to the largest absolute value of the gradient (plus 1).
+ */
+static double test_coco_evaluate_gradient_error(coco_problem_t *problem, double *x, const double h) {
+  const size_t n = coco_problem_get_dimension(problem);
+  double *gradient = coco_allocate_vector(n);
+  double y_plus, y_minus, x_i, max_gradient = 0, max_error = 0;
+  size_t i;
+
+  coco_evaluate_gradient(problem, x, gradient);
+  for (i = 0; i < n; i++) {
+    x_i = x[i];
+    x[i] = x_i + h;
+    coco_evaluate_function(problem, x, &y_plus);
+    x[i] = x_i - h;
+    coco_evaluate_function(problem, x, &y_minus);
+    x[i] = x_i;
+    max_error = coco_double_max(max_error, fabs(gradient[i] - (y_plus - y_minus) / (2 * h)));
+    max_gradient = coco_double_max(max_gradient, fabs(gradient[i]));
+  }
+  coco_free_memory(gradient);
+  return max_error / (1 + max_gradient);
+}
+
+/**
+ * Tests the gradients of the bbob functions against finite differences and the separate counting of their
+ * evaluations. The Katsuura function (f23), whose kinks are too close to each other for finite differences in
+ * random points, is tested without transformations in points x_i = k + 1/7, k + 3/7 or k + 5/7, at which
+ * each 2^j x_i is at least 1/14 away from its kinks.
+ */
+MU_TEST(test_coco_evaluate_gradient) {
+
+  coco_problem_t *problem;
+  const size_t dimensions[3] = {2, 5, 20};
+  const size_t instances[2] = {1, 7};
+  double x[20 * 3], gradient_batch[20 * 3], gradient[20], h;
+  size_t function, d, k, i, point;
+  coco_random_state_t *random_generator = coco_random_new(4321);
+
+  for (function = 1; function <= 24; function++) {
+    if (function == 23)
+      continue;
+    /* The Weierstrass function oscillates with a frequency of up to 3^11 and the Griewank-Rosenbrock
+     * function (with the cosine of a quartic) almost as fast */
+    h = (function == 16) ? 1e-9 : (function == 19) ? 1e-8 : 1e-6;
+    for (d = 0; d < 3; d++) {
+      for (k = 0; k < 2; k++) {
+        problem = coco_get_suite_problem("bbob", function, dimensions[d], instances[k]);
+        for (point = 0; point < 5; point++) {
+          for (i = 0; i < dimensions[d]; i++)
+            x[i] = 8 * coco_random_uniform(random_generator) - 4;
+          mu_check(test_coco_evaluate_gradient_error(problem, x, h) < 1e-4);
+        }
+        coco_problem_free(problem);
+      }
+    }
+  }
+
+  for (d = 0; d < 3; d++) {
+    problem = f_katsuura_allocate(dimensions[d]);
+    for (point = 0; point < 5; point++) {
+      for (i = 0; i < dimensions[d]; i++)
+        x[i] = floor(8 * coco_random_uniform(random_generator) - 4) + (double) (1 + 2 * (i % 3)) / 7.0;
+      mu_check(test_coco_evaluate_gradient_error(problem, x, 1e-11) < 1e-4);
+    }
+    coco_problem_free(problem);
+  }
+
+  /* The gradient evaluations are counted separately */
+  problem = coco_get_suite_problem("bbob", 8, 20, 1);
+  for (i = 0; i < 20 * 3; i++)
+    x[i] = 8 * coco_random_uniform(random_generator) - 4;
+  coco_evaluate_gradient(problem, x, gradient);
+  mu_check(coco_problem_get_evaluations(problem) == 0);
+  mu_check(coco_problem_get_evaluations_gradient(problem) == 1);
+  coco_evaluate_gradient_batch(problem, x, 3, gradient_batch);
+  mu_check(coco_problem_get_evaluations(problem) == 0);
+  mu_check(coco_problem_get_evaluations_gradient(problem) == 4);
+  for (point = 0; point < 3; point++) {
+    coco_evaluate_gradient(problem, x + 20 * point, gradient);
+    for (i = 0; i < 20; i++)
+      mu_check(gradient[i] == gradient_batch[20 * point + i]);
+  }
+  coco_problem_free(problem);
+
+  /* The gradients of the other suites are passed through their transformations as well */
+  problem = coco_get_suite_problem("bbob-constrained", 3, 5, 2);
+  mu_check(test_coco_evaluate_gradient_error(problem, x, 1e-6) < 1e-4);
+  coco_problem_free(problem);
+  problem = coco_get_suite_problem("bbob-largescale", 8, 40, 2);
+  mu_check(test_coco_evaluate_gradient_error(problem, x, 1e-6) < 1e-4);
+  coco_problem_free(problem);
+
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests that the problems without a gradient are recognized and that their gradient is set to NAN values.
+ */
+MU_TEST(test_coco_problem_has_gradient) {
+
+  coco_problem_t *problem;
+  double x[40] = { 0 }, gradient[40];
+  size_t i, function;
+
+  problem = coco_get_suite_problem("bbob", 23, 5, 1);
+  mu_check(coco_problem_has_gradient(problem));
+  coco_problem_free(problem);
+  problem = coco_get_suite_problem("bbob-constrained", 3, 5, 2);
+  mu_check(coco_problem_has_gradient(problem));
+  coco_problem_free(problem);
+
+  problem = coco_get_suite_problem("bbob-noisy", 101, 5, 1);
+  mu_check(!coco_problem_has_gradient(problem));
+  coco_evaluate_gradient(problem, x, gradient);
+  for (i = 0; i < 5; i++)
+    mu_check(coco_is_nan(gradient[i]));
+  mu_check(coco_problem_get_evaluations_gradient(problem) == 0);
+  coco_problem_free(problem);
+  problem = coco_get_suite_problem("bbob-mixint", 1, 5, 1);
+  mu_check(!coco_problem_has_gradient(problem));
+  coco_problem_free(problem);
+  problem = coco_get_suite_problem("bbob-biobj", 1, 2, 1);
+  mu_check(!coco_problem_has_gradient(problem));
+  coco_problem_free(problem);
+  for (function = 21; function <= 24; function++) {
+    problem = coco_get_suite_problem("bbob-largescale", function, 40, 1);
+    mu_check(coco_problem_has_gradient(problem) == (function == 23));
+    coco_problem_free(problem);
+  }
+}
+
+/**
+ * Tests that the problems constructed by coco_get_suite_problem equal the problems of the suites.
+ */
+MU_TEST(test_coco_get_suite_problem) {
+
+  const char *suite_names[] = { "bbob", "bbob-biobj", "bbob-biobj-ext", "bbob-largescale", "bbob-constrained",
+      "bbob-mixint", "bbob-biobj-mixint", "bbob-noisy" };
+  const char *suite_options[] = { "dimensions: 2,10", "dimensions: 3", "function_indices: 60,92 dimensions: 5",
+      "function_indices: 1,24 dimensions: 40", "function_indices: 1,54 dimensions: 2", "dimensions: 5",
+      "function_indices: 1,92 dimensions: 10", "function_indices: 1,30 dimensions: 2" };
+  coco_suite_t *suite;
+  coco_problem_t *problem, *suite_problem;
+  double *x, y[2], y_suite[2], *z, *z_suite;
+  size_t i, j, number_of_constraints;
+  coco_random_state_t *random_generator = coco_random_new(777);
+
+  for (i = 0; i < sizeof(suite_names) / sizeof(suite_names[0]); i++) {
+    suite = coco_suite(suite_names[i], "instances: 3", suite_options[i]);
+    while ((suite_problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+      problem = coco_get_suite_problem(suite_names[i], coco_problem_get_suite_dep_function(suite_problem),
+          coco_problem_get_dimension(suite_problem), coco_problem_get_suite_dep_instance(suite_problem));
+      mu_check(problem != NULL);
+      mu_check(strcmp(coco_problem_get_id(problem), coco_problem_get_id(suite_problem)) == 0);
+      x = coco_allocate_vector(coco_problem_get_dimension(problem));
+      number_of_constraints = coco_problem_get_number_of_constraints(problem);
+      z = coco_allocate_vector(number_of_constraints + 1);
+      z_suite = coco_allocate_vector(number_of_constraints + 1);
+      for (j = 0; j < coco_problem_get_dimension(problem); j++)
+        x[j] = 8 * coco_random_uniform(random_generator) - 4;
+      coco_evaluate_function(problem, x, y);
+      coco_evaluate_function(suite_problem, x, y_suite);
+      /* The noisy functions draw new noise in each evaluation */
+      if (strcmp(suite_names[i], "bbob-noisy") != 0) {
+        for (j = 0; j < coco_problem_get_number_of_objectives(problem); j++)
+          mu_check(y[j] == y_suite[j]);
+      }
+      mu_check(problem->best_value[0] == suite_problem->best_value[0]);
+      if (number_of_constraints > 0) {
+        coco_evaluate_constraint(problem, x, z);
+        coco_evaluate_constraint(suite_problem, x, z_suite);
+        for (j = 0; j < number_of_constraints; j++)
+          mu_check(z[j] == z_suite[j]);
+      }
+      coco_free_memory(x);
+      coco_free_memory(z);
+      coco_free_memory(z_suite);
+      coco_problem_free(problem);
+    }
+    coco_suite_free(suite);
+  }
+
+  mu_check(coco_get_suite_problem("bbob", 25, 2, 1) == NULL);
+  mu_check(coco_get_suite_problem("bbob-noisy", 1, 2, 1) == NULL);
+  mu_check(coco_get_suite_problem("toy", 1, 2, 1) == NULL);
+  mu_check(coco_get_suite_problem("no-such-suite", 1, 2, 1) == NULL);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests that clones evaluate like the suite problems, count their own evaluations and outlive the problems
+ * they were cloned from.
+ */
+MU_TEST(test_coco_problem_clone) {
+
+  const char *suite_names[] = { "bbob", "bbob-biobj", "bbob-largescale", "bbob-constrained", "bbob-mixint",
+      "bbob-biobj-mixint" };
+  const char *suite_options[] = { "dimensions: 2,10", "function_indices: 1,10,55,92 dimensions: 3",
+      "function_indices: 1,21,22,24 dimensions: 40", "dimensions: 2", "function_indices: 1,21,24 dimensions: 5",
+      "function_indices: 1,92 dimensions: 10" };
+  coco_suite_t *suite;
+  coco_problem_t *problem, *clone, *suite_problem;
+  double *x, y[2], y_suite[2], *z, *z_suite;
+  size_t i, j, number_of_constraints;
+  coco_random_state_t *random_generator = coco_random_new(4242);
+
+  for (i = 0; i < sizeof(suite_names) / sizeof(suite_names[0]); i++) {
+    suite = coco_suite(suite_names[i], "instances: 1", suite_options[i]);
+    while ((suite_problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+      x = coco_allocate_vector(coco_problem_get_dimension(suite_problem));
+      number_of_constraints = coco_problem_get_number_of_constraints(suite_problem);
+      z = coco_allocate_vector(number_of_constraints + 1);
+      z_suite = coco_allocate_vector(number_of_constraints + 1);
+      for (j = 0; j < coco_problem_get_dimension(suite_problem); j++)
+        x[j] = 8 * coco_random_uniform(random_generator) - 4;
+      coco_evaluate_function(suite_problem, x, y_suite);
+
+      /* Clone a clone of the suite problem and free the first one before using the second one */
+      problem = coco_problem_clone(suite_problem);
+      clone = coco_problem_clone(problem);
+      coco_problem_free(problem);
+      mu_check(strcmp(coco_problem_get_id(clone), coco_problem_get_id(suite_problem)) == 0);
+      mu_check(coco_problem_get_evaluations(clone) == 0);
+      coco_evaluate_function(clone, x, y);
+      for (j = 0; j < coco_problem_get_number_of_objectives(clone); j++)
+        mu_check(y[j] == y_suite[j]);
+      if (number_of_constraints > 0) {
+        coco_evaluate_constraint(clone, x, z);
+        coco_evaluate_constraint(suite_problem, x, z_suite);
+        for (j = 0; j < number_of_constraints; j++)
+          mu_check(z[j] == z_suite[j]);
+      }
+      mu_check(coco_problem_get_evaluations(clone) == 1);
+      mu_check(coco_problem_get_evaluations(suite_problem) == 1);
+      coco_free_memory(x);
+      coco_free_memory(z);
+      coco_free_memory(z_suite);
+      coco_problem_free(clone);
+    }
+    coco_suite_free(suite);
+  }
+  coco_random_free(random_generator);
+}
+
 int main(void) {
   MU_RUN_TEST(test_coco_evaluate_function);
   MU_RUN_TEST(test_coco_evaluate_constraint);
   MU_RUN_TEST(test_coco_is_feasible);
   MU_RUN_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext);
+  MU_RUN_TEST(test_coco_evaluate_function_mixint);
+  MU_RUN_TEST(test_coco_evaluate_delta);
+  MU_RUN_TEST(test_coco_evaluate_function_lunacek_composed);
+  MU_RUN_TEST(test_coco_evaluate_function_gallagher_early_termination);
+  MU_RUN_TEST(test_coco_evaluate_function_batch);
+  MU_RUN_TEST(test_coco_evaluate_gradient);
+  MU_RUN_TEST(test_coco_problem_has_gradient);
+  MU_RUN_TEST(test_coco_get_suite_problem);
+  MU_RUN_TEST(test_coco_problem_clone);
 	
 	MU_REPORT();
 
@@ -1,6 +1,7 @@
-#include "coco.h"
 #include "minunit.h"
 
+#include "coco.c"
+
 /**
  * Tests the function coco_suite_get_problem.
  */
@@ -33,11 +34,120 @@ MU_TEST(test_coco_suite_encode_problem_index) {
   coco_suite_free(suite);
 }
 
+/**
+ * Tests that the suite option "order: cost-desc" iterates the same problems as the default order, with the
+ * same problem indices, from the most to the least expensive one.
+ */
+MU_TEST(test_coco_suite_order) {
+
+  const char *suite_options = "dimensions: 2,5 function_indices: 1,2 instance_indices: 1,2";
+  const char *ordered_suite_options = "order: cost-desc dimensions: 2,5 function_indices: 1,2 "
+      "instance_indices: 1,2";
+  coco_suite_t *suite, *ordered_suite;
+  coco_problem_t *problem;
+  size_t i, problem_index, number_of_problems = 0, default_sum = 0, ordered_sum = 0;
+  double previous_cost = 0;
+
+  suite = coco_suite("bbob", "instances: 1-3", suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL)
+    default_sum += coco_problem_get_suite_dep_index(problem);
+  mu_check(coco_suite_get_ordered_problem_index(suite, 0) == 0);
+  mu_check(coco_suite_get_ordered_problem_index(suite, 7) == 2 * 3 * 24 + 3 + 1);
+  mu_check(coco_suite_get_ordered_problem_index(suite, 8) == coco_suite_get_number_of_problems(suite));
+
+  ordered_suite = coco_suite("bbob", "instances: 1-3", ordered_suite_options);
+  while ((problem = coco_suite_get_next_problem(ordered_suite, NULL)) != NULL) {
+    problem_index = coco_problem_get_suite_dep_index(problem);
+    mu_check(problem_index == coco_suite_get_ordered_problem_index(ordered_suite, number_of_problems));
+    mu_check(coco_problem_get_dimension(problem) == ((number_of_problems < 4) ? 5 : 2));
+    if (number_of_problems > 0)
+      mu_check(coco_suite_get_problem_cost(ordered_suite, problem_index) <= previous_cost);
+    previous_cost = coco_suite_get_problem_cost(ordered_suite, problem_index);
+    mu_check(previous_cost == coco_suite_get_problem_cost(suite, problem_index));
+    ordered_sum += problem_index;
+    number_of_problems++;
+  }
+  mu_check(number_of_problems == 8);
+  mu_check(ordered_sum == default_sum);
+
+  /* The order is deterministic */
+  coco_suite_free(ordered_suite);
+  ordered_suite = coco_suite("bbob", "instances: 1-3", ordered_suite_options);
+  for (i = 0; i < number_of_problems; i++) {
+    problem = coco_suite_get_next_problem(ordered_suite, NULL);
+    mu_check(coco_problem_get_suite_dep_index(problem) == coco_suite_get_ordered_problem_index(ordered_suite, i));
+  }
+  mu_check(coco_suite_get_ordered_problem_index(ordered_suite, 0) == 2 * 3 * 24);
+  mu_check(coco_suite_get_ordered_problem_index(ordered_suite, 1) == 2 * 3 * 24 + 1);
+
+  coco_suite_free(ordered_suite);
+  coco_suite_free(suite);
+}
+
+/**
+ * Tests that the suite option "cost_profile" replaces the estimated costs by the measured ones.
+ */
+MU_TEST(test_coco_suite_order_cost_profile) {
+
+  const char *file_name = "test_coco_suite_order_profile.jsonl";
+  coco_suite_t *suite, *profiled_suite;
+  FILE *file;
+
+  /* One evaluation of f1 takes 100 ticks and one of f2 takes 10^8 ticks in dimension 2 */
+  file = fopen(file_name, "w");
+  mu_check(file != NULL);
+  fprintf(file, "{\"problem_id\": \"bbob_f001_i01_d02\", \"tick_unit\": \"ns\", \"stages\": ["
+      "{\"name\": \"bbob_f001_i01_d02\", \"depth\": 0, \"evaluations\": 10, \"ticks\": 1000, "
+      "\"self_ticks\": 1000}]}\n");
+  fprintf(file, "{\"problem_id\": \"bbob_f002_i01_d02\", \"tick_unit\": \"ns\", \"stages\": ["
+      "{\"name\": \"bbob_f002_i01_d02\", \"depth\": 0, \"evaluations\": 10, \"ticks\": 1000000000, "
+      "\"self_ticks\": 1000000000}]}\n");
+  fclose(file);
+
+  suite = coco_suite("bbob", "instances: 1-3", "order: cost-desc dimensions: 2,5 function_indices: 1,2 "
+      "instance_indices: 1,2");
+  profiled_suite = coco_suite("bbob", "instances: 1-3", "order: cost-desc dimensions: 2,5 "
+      "function_indices: 1,2 instance_indices: 1,2 cost_profile: test_coco_suite_order_profile.jsonl");
+  remove(file_name);
+
+  /* Without a profile, the cost of a problem in dimension d is d^3 */
+  mu_check(coco_suite_get_problem_cost(suite, 0) == 8);
+  mu_check(coco_suite_get_problem_cost(suite, 3) == 8);
+  mu_check(coco_suite_get_problem_cost(suite, 2 * 3 * 24 + 3) == 125);
+
+  /* With the profile, the measured problems cost d times their time per evaluation and the others are
+   * extrapolated from their function */
+  mu_check(coco_suite_get_problem_cost(profiled_suite, 0) == 2 * 100);
+  mu_check(coco_suite_get_problem_cost(profiled_suite, 3) == 2 * 100000000);
+  mu_check(coco_suite_get_problem_cost(profiled_suite, 2 * 3 * 24)
+      == coco_suite_get_problem_cost(profiled_suite, 0) * 125 / 8);
+  mu_check(coco_suite_get_problem_cost(profiled_suite, 2 * 3 * 24 + 3)
+      == coco_suite_get_problem_cost(profiled_suite, 3) * 125 / 8);
+
+  /* Which changes the order: f2 comes first in both dimensions */
+  mu_check(coco_suite_get_ordered_problem_index(suite, 0) == 2 * 3 * 24);
+  mu_check(coco_suite_get_ordered_problem_index(profiled_suite, 0) == 2 * 3 * 24 + 3);
+  mu_check(coco_suite_get_ordered_problem_index(profiled_suite, 2) == 3);
+  mu_check(coco_suite_get_ordered_problem_index(profiled_suite, 4) == 2 * 3 * 24);
+
+  coco_suite_free(profiled_suite);
+  coco_suite_free(suite);
+}
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_coco_suite) {
   MU_RUN_TEST(test_coco_suite_encode_problem_index);
   MU_RUN_TEST(test_coco_suite_get_problem);
+  MU_RUN_TEST(test_coco_suite_order);
+  MU_RUN_TEST(test_coco_suite_order_cost_profile);
+}
+
+int main(void) {
+  MU_RUN_SUITE(test_all_coco_suite);
+  MU_REPORT();
+
+  return minunit_status;
 }
 
@@ -538,6 +538,284 @@ MU_TEST(test_coco_is_orthogonal) {
   coco_free_memory(M);
 }
 
+static double *legacy_random_data;
+
+/**
+ * The comparison function of the original (non-reentrant) permutation generators.
+ */
+static int legacy_compare(const void *a, const void *b) {
+  double temp = legacy_random_data[*(const size_t *) a] - legacy_random_data[*(const size_t *) b];
+  if (temp > 0)
+    return 1;
+  else if (temp < 0)
+    return -1;
+  else
+    return 0;
+}
+
+/**
+ * Returns whether P is a permutation of 0, ..., n - 1.
+ */
+static int is_permutation(const size_t *P, const size_t n) {
+  size_t i;
+  int result = 1;
+  size_t *count = coco_allocate_vector_size_t(n);
+
+  for (i = 0; i < n; i++)
+    count[i] = 0;
+  for (i = 0; i < n; i++) {
+    if (P[i] >= n || count[P[i]]++ > 0)
+      result = 0;
+  }
+  coco_free_memory(count);
+  return result;
+}
+
+/**
+ * Tests that the permutation generators produce the same permutations as the original implementation,
+ * that the fast ones produce valid permutations and that only new suites select the fast ones.
+ */
+MU_TEST(test_coco_compute_permutations) {
+
+  const size_t n = 640;
+  size_t i, idx_swap, first, second, lower, upper, tmp;
+  size_t *P, *P_legacy, *idx_order;
+  double u;
+  long seed;
+
+  P = coco_allocate_vector_size_t(n);
+  P_legacy = coco_allocate_vector_size_t(n);
+  idx_order = coco_allocate_vector_size_t(n);
+  legacy_random_data = coco_allocate_vector(n);
+
+  for (seed = 1; seed < 1000000; seed += 123457) {
+    /* Random permutation */
+    bbob2009_gauss(legacy_random_data, n, seed);
+    for (i = 0; i < n; i++)
+      P_legacy[i] = i;
+    qsort(P_legacy, n, sizeof(size_t), legacy_compare);
+    coco_compute_random_permutation(P, seed, n);
+    for (i = 0; i < n; i++)
+      mu_check(P[i] == P_legacy[i]);
+
+    /* Truncated uniform swap permutation as used in bbob-largescale */
+    bbob2009_unif(legacy_random_data, n, seed);
+    for (i = 0; i < n; i++) {
+      P_legacy[i] = i;
+      idx_order[i] = i;
+    }
+    qsort(idx_order, n, sizeof(size_t), legacy_compare);
+    for (idx_swap = 0; idx_swap < n; idx_swap++) {
+      first = idx_order[idx_swap];
+      lower = (first < n / 3) ? 0 : first - n / 3;
+      upper = (first + n / 3 > n - 1) ? n - 1 : first + n / 3;
+      bbob2009_unif(&u, 1, seed + (long) (1 + idx_swap) * 1000);
+      second = (size_t) ((long) (u * (double) (upper - lower)) + (long) lower);
+      if (second >= first)
+        second++;
+      tmp = P_legacy[first];
+      P_legacy[first] = P_legacy[second];
+      P_legacy[second] = tmp;
+    }
+    coco_compute_truncated_uniform_swap_permutation(P, seed, n, n, n / 3);
+    for (i = 0; i < n; i++)
+      mu_check(P[i] == P_legacy[i]);
+    coco_compute_swap_permutation(P, seed, n, n, n / 3, "bbob-largescale");
+    for (i = 0; i < n; i++)
+      mu_check(P[i] == P_legacy[i]);
+
+    /* Fast permutations are valid and reproducible */
+    coco_compute_random_permutation_fast(P, seed, n);
+    mu_check(is_permutation(P, n));
+    coco_compute_random_permutation_fast(P_legacy, seed, n);
+    for (i = 0; i < n; i++)
+      mu_check(P[i] == P_legacy[i]);
+    coco_compute_truncated_uniform_swap_permutation_fast(P, seed, n, n, n / 3);
+    mu_check(is_permutation(P, n));
+    coco_compute_swap_permutation(P_legacy, seed, n, n, n / 3, "new-suite");
+    for (i = 0; i < n; i++)
+      mu_check(P[i] == P_legacy[i]);
+  }
+
+  coco_free_memory(P);
+  coco_free_memory(P_legacy);
+  coco_free_memory(idx_order);
+  coco_free_memory(legacy_random_data);
+}
+
+/**
+ * Task used by test_coco_run_tasks: stores the square of the task number.
+ */
+static void test_coco_run_tasks_square(void *data, const size_t task) {
+  ((size_t *) data)[task] = task * task;
+}
+
+/**
+ * Tests that coco_run_tasks runs every task exactly once.
+ */
+MU_TEST(test_coco_run_tasks) {
+
+  const size_t number_of_tasks = 1000;
+  size_t *results = coco_allocate_vector_size_t(number_of_tasks);
+  size_t i;
+
+  for (i = 0; i < number_of_tasks; i++)
+    results[i] = 1;
+  coco_run_tasks(test_coco_run_tasks_square, results, number_of_tasks);
+  for (i = 0; i < number_of_tasks; i++)
+    mu_check(results[i] == i * i);
+
+  coco_run_tasks(test_coco_run_tasks_square, results, 0);
+  coco_free_memory(results);
+}
+
+/**
+ * Tests sharing data through memory-mapped files, including the fallback on stale files.
+ */
+MU_TEST(test_coco_shared_data) {
+
+#if defined(HAVE_MMAP)
+  const char *folder = "shared_data_test";
+  const size_t size = 1000;
+  double *data, *shared_data, *other_data, *read_data;
+  char *file_name;
+  FILE *file;
+  size_t i;
+
+  /* Without the folder the data is not shared */
+  data = coco_allocate_vector(size);
+  for (i = 0; i < size; i++)
+    data[i] = (double) i / 3.0;
+  unsetenv("COCO_SHARED_DATA_FOLDER");
+  shared_data = (double *) coco_shared_data_share(data, size * sizeof(double));
+  mu_check(shared_data == data);
+
+  setenv("COCO_SHARED_DATA_FOLDER", folder, 1);
+  shared_data = (double *) coco_shared_data_share(data, size * sizeof(double));
+  mu_check(shared_data != data);
+  other_data = coco_allocate_vector(size);
+  memcpy(other_data, shared_data, size * sizeof(double));
+  other_data = (double *) coco_shared_data_share(other_data, size * sizeof(double));
+  for (i = 0; i < size; i++)
+    mu_check(shared_data[i] == (double) i / 3.0 && other_data[i] == shared_data[i]);
+  coco_shared_data_free(shared_data);
+  coco_shared_data_free(other_data);
+
+  /* Keyed data is found only with the same key and size */
+  read_data = coco_allocate_vector(size);
+  data = coco_allocate_vector(size);
+  for (i = 0; i < size; i++)
+    data[i] = (double) i;
+  mu_check(!coco_shared_data_read("test", read_data, size * sizeof(double)));
+  coco_shared_data_store("test", data, size * sizeof(double));
+  mu_check(coco_shared_data_read("test", read_data, size * sizeof(double)));
+  mu_check(memcmp(read_data, data, size * sizeof(double)) == 0);
+  mu_check(!coco_shared_data_read("test", read_data, (size - 1) * sizeof(double)));
+
+  /* A file that was changed is stale */
+  file_name = coco_shared_data_get_file_name(folder, "test");
+  file = fopen(file_name, "r+b");
+  fseek(file, -1, SEEK_END);
+  fputc(1, file);
+  fclose(file);
+  mu_check(!coco_shared_data_read("test", read_data, size * sizeof(double)));
+  coco_shared_data_store("test", data, size * sizeof(double));
+  mu_check(coco_shared_data_read("test", read_data, size * sizeof(double)));
+
+  unsetenv("COCO_SHARED_DATA_FOLDER");
+  coco_free_memory(file_name);
+  coco_free_memory(data);
+  coco_free_memory(read_data);
+  coco_remove_directory(folder);
+#endif
+}
+
+#if defined(HAVE_MMAP)
+/**
+ * Task used by test_coco_shared_data_tasks: constructs, evaluates and frees a bbob problem in 20D.
+ */
+static void test_coco_shared_data_tasks_evaluate(void *data, const size_t task) {
+  coco_problem_t *problem = coco_get_bbob_problem(task % 24 + 1, 20, task / 24 + 1);
+  double *x = coco_allocate_vector(20);
+  size_t i;
+
+  for (i = 0; i < 20; i++)
+    x[i] = 1.0 - (double) i / 10.0;
+  coco_evaluate_function(problem, x, &((double *) data)[task]);
+  coco_free_memory(x);
+  coco_problem_free(problem);
+}
+#endif
+
+/**
+ * Tests that problems using shared data can be constructed and freed by coco_run_tasks.
+ */
+MU_TEST(test_coco_shared_data_tasks) {
+
+#if defined(HAVE_MMAP)
+  const char *folder = "shared_data_tasks_test";
+  const size_t number_of_tasks = 4 * 24;
+  double *expected = coco_allocate_vector(number_of_tasks);
+  double *results = coco_allocate_vector(number_of_tasks);
+  size_t i, repetition;
+
+  unsetenv("COCO_SHARED_DATA_FOLDER");
+  for (i = 0; i < number_of_tasks; i++)
+    test_coco_shared_data_tasks_evaluate(expected, i);
+
+  /* The first repetition writes the files, the second one maps them */
+  setenv("COCO_SHARED_DATA_FOLDER", folder, 1);
+  for (repetition = 0; repetition < 2; repetition++) {
+    coco_run_tasks(test_coco_shared_data_tasks_evaluate, results, number_of_tasks);
+    for (i = 0; i < number_of_tasks; i++)
+      mu_check(results[i] == expected[i]);
+  }
+
+  unsetenv("COCO_SHARED_DATA_FOLDER");
+  coco_free_memory(expected);
+  coco_free_memory(results);
+  coco_remove_directory(folder);
+#endif
+}
+
+/**
+ * Tests that the bulk random functions agree with the single-value ones and that streams differ.
+ */
+MU_TEST(test_coco_random_fill) {
+
+  const size_t number = 2001;
+  coco_random_state_t *state1 = coco_random_new(2718), *state2 = coco_random_new(2718), *stream;
+  double *values = coco_allocate_vector(number);
+  size_t i;
+
+  /* Across several refills of the state, starting from a partly used state */
+  coco_random_uniform(state1);
+  coco_random_uniform(state2);
+  coco_random_uniform_fill(state1, values, number);
+  for (i = 0; i < number; i++)
+    mu_check(values[i] == coco_random_uniform(state2));
+  mu_check(coco_random_uniform(state1) == coco_random_uniform(state2));
+
+  /* Every other normal value is the one of coco_random_normal */
+  coco_random_normal_fill(state1, values, number);
+  for (i = 0; i < number; i += 2)
+    mu_check(values[i] == coco_random_normal(state2));
+  mu_check(coco_random_uniform(state1) == coco_random_uniform(state2));
+
+  stream = coco_random_new_stream(2718, 0);
+  coco_random_free(state1);
+  state1 = coco_random_new(2718);
+  mu_check(coco_random_uniform(stream) == coco_random_uniform(state1));
+  coco_random_free(stream);
+  stream = coco_random_new_stream(2718, 1);
+  mu_check(coco_random_uniform(stream) != coco_random_uniform(state1));
+
+  coco_random_free(stream);
+  coco_random_free(state1);
+  coco_random_free(state2);
+  coco_free_memory(values);
+}
+
 /**
  * Run all tests in this file.
  */
@@ -553,6 +831,11 @@ int main(void) {
   MU_RUN_TEST(test_coco_string_parse_ranges);
   MU_RUN_TEST(test_coco_create_remove_directory);
   MU_RUN_TEST(test_coco_is_orthogonal);
+  MU_RUN_TEST(test_coco_compute_permutations);
+  MU_RUN_TEST(test_coco_run_tasks);
+  MU_RUN_TEST(test_coco_shared_data);
+  MU_RUN_TEST(test_coco_shared_data_tasks);
+  MU_RUN_TEST(test_coco_random_fill);
 
   MU_REPORT();
 
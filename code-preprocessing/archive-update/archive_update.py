@@ -4,8 +4,9 @@ from __future__ import absolute_import, division, print_function, unicode_litera
 import os
 import sys
 import argparse
+from multiprocessing.pool import ThreadPool
 
-from cocoprep.archive_load_data import parse_range, read_best_values, write_best_values
+from cocoprep.archive_load_data import create_path, parse_range, read_best_values, write_best_values
 from cocoprep.archive_functions import ArchiveInfo
 from cocoprep.coco_archive import Archive, log_level
 
@@ -55,7 +56,7 @@ def update_best_hypervolume(old_best_files, new_best_data, new_best_file):
     sys.stdout.flush()
 
 
-def merge_archives(input_path, output_path, functions, instances, dimensions, crop_variables):
+def merge_archives(input_path, output_path, functions, instances, dimensions, crop_variables, jobs=1):
     """Merges all archives from the input_path (removes any dominated solutions) and stores the consolidated archives
        in the output_path. Returns problem names and their new best hypervolume values in the form of a dictionary.
        :param input_path: input path
@@ -64,6 +65,7 @@ def merge_archives(input_path, output_path, functions, instances, dimensions, cr
        :param instances: instances to be included in the merging
        :param dimensions: dimensions to be included in the merging
        :param crop_variables: whether output archives should contain information on solution variables
+       :param jobs: number of problem instances processed in parallel
     """
     result = {}
 
@@ -71,30 +73,42 @@ def merge_archives(input_path, output_path, functions, instances, dimensions, cr
     sys.stdout.flush()
     archive_info = ArchiveInfo(input_path, functions, instances, dimensions)
 
-    print('Processing archives...')
-    sys.stdout.flush()
+    problem_instance_infos = []
     while True:
         # Get information about the next problem instance
         problem_instance_info = archive_info.get_next_problem_instance_info()
         if problem_instance_info is None:
             break
+        problem_instance_infos.append(problem_instance_info)
 
-        old_level = log_level('warning')
-
+    def process_problem_instance(problem_instance_info):
         # Create an archive for this problem instance
         archive = Archive(problem_instance_info.suite_name, problem_instance_info.function,
                           problem_instance_info.instance, problem_instance_info.dimension)
 
-        # Read the solutions from the files and add them to the archive
+        # Read the solutions from the files and add them to the archive (the files are read without the GIL)
         problem_instance_info.fill_archive(archive)
 
         # Write the non-dominated solutions into output folder
         problem_instance_info.write_archive_solutions(output_path, archive, crop_variables)
 
-        result.update({str(problem_instance_info): archive.hypervolume})
-        print('{}: {:.15f}'.format(problem_instance_info, archive.hypervolume))
-        sys.stdout.flush()
+        return archive.hypervolume
 
+    print('Processing archives...')
+    sys.stdout.flush()
+    create_path(output_path)
+    old_level = log_level('warning')
+    pool = ThreadPool(max(1, jobs))
+    try:
+        # The results are returned (and printed) in the order of the problem instances
+        for problem_instance_info, hypervolume in zip(problem_instance_infos,
+                                                      pool.imap(process_problem_instance, problem_instance_infos)):
+            result.update({str(problem_instance_info): hypervolume})
+            print('{}: {:.15f}'.format(problem_instance_info, hypervolume))
+            sys.stdout.flush()
+    finally:
+        pool.close()
+        pool.join()
         log_level(old_level)
 
     return result
@@ -123,6 +137,8 @@ if __name__ == '__main__':
                         help='don\'t include information on the variables in the output archives')
     parser.add_argument('--hyp-file', default='new_best_values_hyp.c',
                         help='name of the file to store new hypervolume values')
+    parser.add_argument('-j', '--jobs', type=int, default=1,
+                        help='number of problem instances to process in parallel')
     parser.add_argument('output', help='path to the output folder')
     parser.add_argument('input', default=[], nargs='+', help='path(s) to the input folder(s)')
     args = parser.parse_args()
@@ -132,7 +148,7 @@ if __name__ == '__main__':
 
     # Merge the archives
     new_hypervolumes = merge_archives(args.input, args.output, args.functions, args.instances, args.dimensions,
-                                      args.crop_variables)
+                                      args.crop_variables, args.jobs)
 
     timing.log('Finished merging', timing.now())
 
@@ -15,6 +15,8 @@ cdef extern from "coco.h":
     coco_archive_t *coco_archive(char *suite_name, size_t function, 
                                  size_t dimension, size_t instance)
     int coco_archive_add_solution(coco_archive_t *archive, double f1, double f2, char *text)
+    long coco_archive_add_solutions_from_file(coco_archive_t *archive, char *file_name, size_t instance,
+                                              int single_instance) nogil
     size_t coco_archive_get_number_of_solutions(coco_archive_t *archive)
     double coco_archive_get_hypervolume(coco_archive_t *archive)
     char *coco_archive_get_next_solution_text(coco_archive_t *archive)
@@ -70,6 +72,24 @@ cdef class Archive:
             self.up_to_date = False            
         return updated
         
+    def add_solutions_from_file(self, file_name, instance, single_instance):
+        """Adds the solutions of the given instance from the archive file (all solutions in the file if
+           single_instance is True) and returns the number of solutions read or -1 if the file does not contain
+           the instance. Raises an IOError if the file cannot be read. Releases the GIL, so that archives can be
+           filled in parallel threads.
+        """
+        cdef bytes _file_name = _bstring(file_name)
+        cdef char *c_file_name = _file_name
+        cdef size_t _instance = instance
+        cdef int _single_instance = 1 if single_instance else 0
+        cdef long result
+        with nogil:
+            result = coco_archive_add_solutions_from_file(self.archive, c_file_name, _instance, _single_instance)
+        if result == -2:
+            raise IOError('Cannot read file \'{}\''.format(file_name))
+        self.up_to_date = False
+        return result
+
     def get_next_solution_text(self):
         self._tmp_text = coco_archive_get_next_solution_text(self.archive)
         tmp_text = self._tmp_text.decode('ascii')
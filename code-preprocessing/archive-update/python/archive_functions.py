@@ -4,7 +4,7 @@ import os
 import sys
 
 from .archive_exceptions import PreprocessingWarning, PreprocessingException
-from .archive_load_data import create_path, get_key_value, get_file_name_list, get_archive_file_info, get_range
+from .archive_load_data import create_path, get_file_name_list, get_archive_file_info, get_range
 
 
 class ProblemInstanceInfo:
@@ -50,52 +50,19 @@ class ProblemInstanceInfo:
         """Reads the solutions from the files and feeds them to the given archive. If a file contains a single
         instance, all comments are skipped. If a file contains multiple instances, only the solutions up to the next
         instance are read. If the file contains no solutions for the given problem instance, an exception is raised.
+        The files are parsed and filtered for nondominated solutions in C (see Archive.add_solutions_from_file).
            :param archive: archive to be filled with solutions
         """
         for f_info in self.file_info:
             f_name = f_info.get('file_name')
             single_instance = f_info.get('single_instance')
-            with open(f_name, 'r') as f:
-
-                instance_found = single_instance
-                solution_found = False
-
-                for line in f:
-                    if not line.strip() or (single_instance and line[0] == '%'):
-                        # Ignore empty lines and all comments if the file contains a single instance
-                        continue
-
-                    elif line[0] == '%' and 'instance' not in line:
-                        # If a file has multiple instances, ignore all comments not containing instance information
-                        continue
-
-                    elif not single_instance and line[0] == '%' and 'instance' in line:
-                        if instance_found:
-                            # If a file has multiple instances, stop when you encounter another instance
-                            break
-                        else:
-                            value = get_key_value(line[1:], 'instance')
-                            if int(value) == self.instance:
-                                instance_found = True
-
-                    elif instance_found:
-                        if line[0] != '%':
-                            # Solution found, feed it to the archive
-                            try:
-                                archive.add_solution(float(line.split()[1]), float(line.split()[2]), line)
-                                solution_found = True
-                            except IndexError:
-                                print('Problem in file {}, line {}, skipping line'.format(f_name, line))
-                                sys.stdout.flush()
-                                continue
-
-                f.close()
-                if not instance_found:
-                    raise PreprocessingException('File \'{}\' does not contain \'instance = {}\''.format(f_name,
-                                                                                                         self.instance))
-                if not solution_found:
-                    raise PreprocessingException('File \'{}\' contains no solutions for \'instance = {}\''.format(
-                        f_name, self.instance))
+            number_of_solutions = archive.add_solutions_from_file(f_name, self.instance, single_instance)
+            if number_of_solutions < 0:
+                raise PreprocessingException('File \'{}\' does not contain \'instance = {}\''.format(f_name,
+                                                                                                     self.instance))
+            if number_of_solutions == 0:
+                raise PreprocessingException('File \'{}\' contains no solutions for \'instance = {}\''.format(
+                    f_name, self.instance))
 
     # noinspection PyTypeChecker
     def write_archive_solutions(self, output_path, archive, crop_variables):
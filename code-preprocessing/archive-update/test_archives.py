@@ -156,6 +156,26 @@ def run_archive_update():
     assert almost_equal(new_hypervolumes.get('bbob-biobj_f52_i07_d02'), 0.920581303184137, precision)
 
 
+def run_archive_read_file():
+    """
+    Tests whether Archive.add_solutions_from_file() reads long numbers and raises an IOError for missing files.
+    """
+    from cocoprep.coco_archive import Archive
+
+    base_path = dirname(__file__)
+    file_name = abspath(join(base_path, 'test-data', 'archive-read-file.adat'))
+    with open(file_name, 'w') as f:
+        f.write('1\t{:.80e}\t{:.80e}\n'.format(1e10, 1e10))
+    archive = Archive('bbob-biobj', 1, 1, 2)
+    assert archive.add_solutions_from_file(file_name, 1, True) == 1
+    remove(file_name)
+    try:
+        archive.add_solutions_from_file(file_name, 1, True)
+        assert False
+    except IOError:
+        pass
+
+
 def run_archive_reformat():
     """
     Tests whether reformat_archives() from archive_reformat.py works correctly for the given input.
@@ -301,6 +321,9 @@ def test_all():
     run_archive_update()
     timing.log('run_archive_update done', timing.now())
 
+    run_archive_read_file()
+    timing.log('run_archive_read_file done', timing.now())
+
     run_archive_reformat()
     timing.log('run_archive_reformat done', timing.now())
 